@@ -48,6 +48,17 @@ typedef struct
 
 typedef _unity_zpq unity_zpq[1];
 
+/* Montgomery form data for odd n with R = 2^(FLINT_BITS*size) */
+typedef struct
+{
+    mp_ptr d;           /* the limbs of n */
+    mp_size_t size;
+    mp_limb_t ninv;     /* -1/n mod 2^FLINT_BITS */
+    fmpz_t r2;          /* R^2 mod n */
+} _unity_zp_mont;
+
+typedef _unity_zp_mont unity_zp_mont[1];
+
 /* Z[unity_root]/(n) struct */
 typedef struct
 {
@@ -55,6 +66,7 @@ typedef struct
     ulong p;
     ulong exp;
     fmpz_t n;
+    const _unity_zp_mont * mont; /* if not NULL, coefficients are c*R mod n */
 } _unity_zp;
 
 typedef _unity_zp unity_zp[1];
@@ -184,6 +196,9 @@ FLINT_DLL void unity_zp_coeff_inc(unity_zp f, ulong ind);
 
 FLINT_DLL void unity_zp_coeff_dec(unity_zp f, ulong ind);
 
+FLINT_DLL void _unity_zp_coeff_set_product(unity_zp f,
+        ulong ind, const fmpz_t x);
+
 /* Scalar multiplication */
 FLINT_DLL void unity_zp_mul_scalar_fmpz(unity_zp f,
         const unity_zp g, const fmpz_t s);
@@ -268,6 +283,19 @@ FLINT_DLL void unity_zp_pow_2k_ui(unity_zp f, const unity_zp g, ulong pow);
 FLINT_DLL void unity_zp_pow_sliding_fmpz(unity_zp f,
         unity_zp g, const fmpz_t pow);
 
+/* Montgomery form */
+FLINT_DLL void unity_zp_mont_init(unity_zp_mont m, const fmpz_t n);
+
+FLINT_DLL void unity_zp_mont_clear(unity_zp_mont m);
+
+FLINT_DLL void _unity_zp_mont_redc(fmpz_t r,
+        const fmpz_t x, const unity_zp_mont m);
+
+FLINT_DLL void unity_zp_to_mont(unity_zp f,
+        const unity_zp g, const unity_zp_mont m);
+
+FLINT_DLL void unity_zp_from_mont(unity_zp f, const unity_zp g);
+
 /* Cyclotimic reduction */
 FLINT_DLL void _unity_zp_reduce_cyclotomic_divmod(unity_zp f);
 
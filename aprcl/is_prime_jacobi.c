@@ -9,6 +9,7 @@
     (at your option) any later version.  See <http://www.gnu.org/licenses/>.
 */
 
+#include <pthread.h>
 #include "aprcl.h"
 
 /*
@@ -524,23 +525,303 @@ _is_prime_jacobi_additional_test(const fmpz_t n, ulong p)
     return result;
 }
 
+/*
+    (2.) is run for the pairs (p, q) with q | s and p | q - 1 in parallel,
+    taking the pairs with the largest p^k, which are the most expensive,
+    first, and stopping as soon as n is shown to be composite.
+*/
+typedef struct
+{
+    ulong q;
+    ulong p;
+    ulong k;        /* max k for which p^k | q - 1 */
+    int pind;       /* index of p in lambdas */
+}
+_is_prime_jacobi_pair_t;
+
+typedef struct
+{
+    const fmpz * n;
+    fmpz_t ndec;                        /* n - 1 */
+    fmpz_t ndecdiv;                     /* (n - 1) / 2 */
+    ulong nmod4;                        /* n % 4 */
+    int * lambdas;
+    _is_prime_jacobi_pair_t * pairs;
+    slong num;                          /* number of pairs */
+    slong next;                         /* next pair to test */
+    volatile int composite;             /* set once n is proven composite */
+    pthread_mutex_t mutex;
+}
+_is_prime_jacobi_shared_t;
+
+static int
+_is_prime_jacobi_pair_cmp(const void * a, const void * b)
+{
+    const _is_prime_jacobi_pair_t * x = a;
+    const _is_prime_jacobi_pair_t * y = b;
+    ulong rx = n_pow(x->p, x->k), ry = n_pow(y->p, y->k);
+
+    if (rx != ry)
+        return rx > ry ? -1 : 1;
+
+    return x->q < y->q ? -1 : x->q > y->q;
+}
+
+/*
+    Test pairs until they run out or n is proven composite. The unity_zp
+    for the jacobi sums of a thread are only reinitialised when p^k changes.
+*/
+static void *
+_is_prime_jacobi_worker(void * arg_ptr)
+{
+    _is_prime_jacobi_shared_t * sh = *((_is_prime_jacobi_shared_t **) arg_ptr);
+    const fmpz * n = sh->n;
+    _is_prime_jacobi_pair_t * pair;
+    unity_zp jacobi_sum, jacobi_sum2_1, jacobi_sum2_2;
+    ulong p = 0, k = 0, q, r, v;
+    fmpz_t u, q_pow;
+    slong h;
+    int lambda, composite;
+
+    fmpz_init(u);
+    fmpz_init(q_pow);
+
+    while (1)
+    {
+        pthread_mutex_lock(&sh->mutex);
+
+        pair = NULL;
+        if (!sh->composite && sh->next < sh->num)
+        {
+            pair = sh->pairs + sh->next++;
+            lambda = sh->lambdas[pair->pind];
+        }
+
+        pthread_mutex_unlock(&sh->mutex);
+
+        if (pair == NULL)
+            break;
+
+        if (pair->p != p || pair->k != k)
+        {
+            if (p != 0)
+            {
+                unity_zp_clear(jacobi_sum);
+                unity_zp_clear(jacobi_sum2_1);
+                unity_zp_clear(jacobi_sum2_2);
+            }
+
+            p = pair->p;
+            k = pair->k;
+
+            unity_zp_init(jacobi_sum, p, k, n);
+            unity_zp_init(jacobi_sum2_1, p, k, n);
+            unity_zp_init(jacobi_sum2_2, p, k, n);
+        }
+
+        q = pair->q;
+        r = n_pow(p, k);        /* set r = p^k */
+        composite = 0;
+
+        /* if lambdas_p == 0 set q_pow = q^{(n - 1) / 2} and p == 2 */
+        fmpz_set_ui(q_pow, q);
+        if (lambda == 0 && p == 2)
+            fmpz_powm(q_pow, q_pow, sh->ndecdiv, n);
+
+        /* compute u = n / r and v = n % r */
+        fmpz_tdiv_q_ui(u, n, r);
+        v = fmpz_tdiv_ui(n, r);
+
+        /* check (2.b) */
+        if (p == 2 && k == 1)
+        {
+            h = _is_prime_jacobi_check_21(q, n);
+
+            /* if h not found then n is composite */
+            if (h < 0)
+                composite = 1;
+
+            /* 
+                check (Lp); 
+                if h == 1 (unity root = -1) 
+                and n % 4 == 1 then lambdas_2 = 1 
+            */
+            if (lambda == 0 && h == 1 && sh->nmod4 == 1)
+                lambda = 1;
+        }
+
+        /* check (2.c) */
+        if (p == 2 && k == 2)
+        {
+            /* compute set jacobi_sum = J(p, q) */
+            unity_zp_jacobi_sum_pq(jacobi_sum, q, p);
+
+            h = _is_prime_jacobi_check_22(jacobi_sum, u, v, q);
+
+            /* if h not found then n is composite */
+            if (h < 0)
+                composite = 1;
+
+            /* 
+                check (Lp); 
+                if h == 1 or 3 (unity root = -i or i) 
+                and q^{(n - 1) / 2} = -1 mod n then lambdas_2 = 1
+            */
+            if (h % 2 != 0 && lambda == 0 && fmpz_equal(q_pow, sh->ndec))
+                lambda = 1;
+        }
+
+        /* check (2.d) */
+        if (p == 2 && k >= 3)
+        {
+            /* compute J(2, q), J_3(q) and J_2(q) */
+            unity_zp_jacobi_sum_pq(jacobi_sum, q, p);
+            unity_zp_jacobi_sum_2q_one(jacobi_sum2_1, q);
+            unity_zp_jacobi_sum_2q_two(jacobi_sum2_2, q);
+
+            h = _is_prime_jacobi_check_2k(jacobi_sum,
+                    jacobi_sum2_1, jacobi_sum2_2, u, v);
+
+            /* if h not found then n is composite */
+            if (h < 0)
+                composite = 1;
+
+            /* 
+                check (Lp); 
+                if h % 2 != 0 (primitive unity root) 
+                and q^{(n - 1) / 2} = -1 mod n then lambdas_2 = 1
+            */
+            if (h % 2 != 0 && lambda == 0 && fmpz_equal(q_pow, sh->ndec))
+                lambda = 1;
+        }
+
+        /* check (2.a) */
+        if (p != 2)
+        {
+            /* compute set jacobi_sum = J(p, q) */
+            unity_zp_jacobi_sum_pq(jacobi_sum, q, p);
+
+            h = _is_prime_jacobi_check_pk(jacobi_sum, u, v);
+
+            /* if h not found then n is composite */
+            if (h < 0)
+                composite = 1;
+
+            /* 
+                check (Lp); 
+                if h % p != 0 (primitive unity root) 
+                then lambdas_p = 1
+            */
+            if (h % p != 0 && lambda == 0)
+                lambda = 1;
+        }
+
+        pthread_mutex_lock(&sh->mutex);
+
+        if (composite)
+            sh->composite = 1;
+        if (lambda)
+            sh->lambdas[pair->pind] = 1;
+
+        pthread_mutex_unlock(&sh->mutex);
+    }
+
+    if (p != 0)
+    {
+        unity_zp_clear(jacobi_sum);
+        unity_zp_clear(jacobi_sum2_1);
+        unity_zp_clear(jacobi_sum2_2);
+    }
+
+    fmpz_clear(u);
+    fmpz_clear(q_pow);
+
+    return NULL;
+}
+
+/*
+    Runs (2.) for all pairs (p, q) on up to flint_get_num_threads() threads,
+    updating lambdas. Returns 1 if n is proven composite, otherwise 0.
+*/
+static int
+_is_prime_jacobi_pairs(int * lambdas, const fmpz_t n,
+        const aprcl_config config, ulong nmod4)
+{
+    _is_prime_jacobi_shared_t sh;
+    _is_prime_jacobi_shared_t ** args;
+    slong i, j, num_threads;
+
+    /* q - 1 < 2^64 has at most 15 distinct prime factors */
+    sh.pairs = flint_malloc(15 * config->qs->num * sizeof(_is_prime_jacobi_pair_t));
+    sh.num = 0;
+
+    for (i = 0; i < config->qs->num; i++)
+    {
+        n_factor_t q_factors;
+        ulong q;
+
+        if (config->qs_used[i] == 0)
+            continue;
+
+        q = fmpz_get_ui(config->qs->p + i); /* set q; q must get into ulong */
+
+        /* find prime factors of q - 1 */
+        n_factor_init(&q_factors);
+        n_factor(&q_factors, q - 1, 1);
+
+        for (j = 0; j < q_factors.num; j++)
+        {
+            sh.pairs[sh.num].q = q;
+            sh.pairs[sh.num].p = q_factors.p[j];
+            sh.pairs[sh.num].k = q_factors.exp[j];
+            sh.pairs[sh.num].pind = _p_ind(config, q_factors.p[j]);
+            sh.num++;
+        }
+    }
+
+    qsort(sh.pairs, sh.num, sizeof(_is_prime_jacobi_pair_t),
+                                                   _is_prime_jacobi_pair_cmp);
+
+    sh.n = n;
+    fmpz_init(sh.ndec);
+    fmpz_init(sh.ndecdiv);
+    fmpz_sub_ui(sh.ndec, n, 1);
+    fmpz_fdiv_q_2exp(sh.ndecdiv, sh.ndec, 1);
+    sh.nmod4 = nmod4;
+    sh.lambdas = lambdas;
+    sh.next = 0;
+    sh.composite = 0;
+    pthread_mutex_init(&sh.mutex, NULL);
+
+    num_threads = FLINT_MAX(1, FLINT_MIN(flint_get_num_threads(), sh.num));
+
+    args = flint_malloc(num_threads * sizeof(_is_prime_jacobi_shared_t *));
+    for (i = 0; i < num_threads; i++)
+        args[i] = &sh;
+
+    flint_parallel_do(_is_prime_jacobi_worker, args,
+                      sizeof(_is_prime_jacobi_shared_t *), num_threads);
+
+    pthread_mutex_destroy(&sh.mutex);
+    flint_free(args);
+    flint_free(sh.pairs);
+    fmpz_clear(sh.ndec);
+    fmpz_clear(sh.ndecdiv);
+
+    return sh.composite;
+}
+
 primality_test_status
 _is_prime_jacobi(const fmpz_t n, const aprcl_config config)
 {
     int *lambdas;
-    ulong i, j, nmod4;
+    ulong i, nmod4;
     primality_test_status result;
-    fmpz_t temp, p2, ndec, ndecdiv, u, q_pow;
+    fmpz_t temp, p2;
 
     /* initialization */
-    fmpz_init(q_pow);
-    fmpz_init(u);
     fmpz_init(temp);
     fmpz_init(p2);
-    fmpz_init(ndecdiv);
-    fmpz_init_set(ndec, n);
-    fmpz_sub_ui(ndec, ndec, 1);
-    fmpz_fdiv_q_2exp(ndecdiv, ndec, 1);
     
     result = PROBABPRIME;
 
@@ -586,152 +867,21 @@ _is_prime_jacobi(const fmpz_t n, const aprcl_config config)
 
     /* (2.) begin of Pseudoprime tests with Jacobi sums step. */
     /* for every prime q | s */
-    for (i = 0; i < config->qs->num; i++)
+    for (i = 0; i < config->qs->num && result != COMPOSITE; i++)
     {
-        n_factor_t q_factors;
-        ulong q;
-
-        if (config->qs_used[i] == 0)
-            continue;
-
-        if (result == COMPOSITE)
-            break;
-
-        q = fmpz_get_ui(config->qs->p + i); /* set q; q must get into ulong */
-
         /* if n == q; q - prime => n - prime */
-        if (fmpz_equal_ui(n, q))
+        if (config->qs_used[i] != 0 && fmpz_equal(n, config->qs->p + i))
         {
             result = PRIME;
             break;
         }
-
-        /* find prime factors of q - 1 */
-        n_factor_init(&q_factors);
-        n_factor(&q_factors, q - 1, 1);
-
-        /* for every prime p | q - 1 */
-        for (j = 0; j < q_factors.num; j++)
-        {
-            int pind;
-            slong h;
-            ulong v, p, r, k;
-            unity_zp jacobi_sum, jacobi_sum2_1, jacobi_sum2_2;
-
-            if (result == COMPOSITE)
-                break;
-
-            p = q_factors.p[j];     /* set p; p | q - 1 */
-            k = q_factors.exp[j];   /* set max k for which p^k | q - 1 */
-            r = n_pow(p, k);        /* set r = p^k */
-            pind = _p_ind(config, p);  /* find index of p in lambdas */
-
-            /* if lambdas_p == 0 set q_pow = q^{(n - 1) / 2} and p == 2 */
-            fmpz_set_ui(q_pow, q);
-            if (lambdas[pind] == 0 && p == 2)
-                fmpz_powm(q_pow, q_pow, ndecdiv, n);
-
-            /* compute u = n / r and v = n % r */
-            fmpz_tdiv_q_ui(u, n, r);
-            v = fmpz_tdiv_ui(n, r);
-
-            /* init unity_zp for jacobi sums */
-            unity_zp_init(jacobi_sum, p, k, n);
-            unity_zp_init(jacobi_sum2_1, p, k, n);
-            unity_zp_init(jacobi_sum2_2, p, k, n);
-
-            /* compute set jacobi_sum = J(p, q) */
-            unity_zp_jacobi_sum_pq(jacobi_sum, q, p);
-            /* if p == 2 and k >= 3 we also need to compute J_2(q) and J_3(q) */
-            if (p == 2 && k >= 3)
-            {
-                /* compute J_3(q) */
-                unity_zp_jacobi_sum_2q_one(jacobi_sum2_1, q);
-                /* compute J_2(q) */
-                unity_zp_jacobi_sum_2q_two(jacobi_sum2_2, q);
-            }
-
-            /* check (2.b) */
-            if (p == 2 && k == 1)
-            {
-                h = _is_prime_jacobi_check_21(q, n);
-
-                /* if h not found then n is composite */
-                if (h < 0)
-                    result = COMPOSITE;
-
-                /* 
-                    check (Lp); 
-                    if h == 1 (unity root = -1) 
-                    and n % 4 == 1 then lambdas_2 = 1 
-                */
-                if (lambdas[pind] == 0 && h == 1 && nmod4 == 1)
-                    lambdas[pind] = 1;
-            }
-
-            /* check (2.c) */
-            if (p == 2 && k == 2)
-            {
-                h = _is_prime_jacobi_check_22(jacobi_sum, u, v, q);
-
-                /* if h not found then n is composite */
-                if (h < 0)
-                    result = COMPOSITE;
-
-                /* 
-                    check (Lp); 
-                    if h == 1 or 3 (unity root = -i or i) 
-                    and q^{(n - 1) / 2} = -1 mod n then lambdas_2 = 1
-                */
-                if (h % 2 != 0 && lambdas[pind] == 0 && fmpz_equal(q_pow, ndec))
-                    lambdas[pind] = 1;
-            }
-
-            /* check (2.d) */
-            if (p == 2 && k >= 3)
-            {
-                h = _is_prime_jacobi_check_2k(jacobi_sum,
-                        jacobi_sum2_1, jacobi_sum2_2, u, v);
-
-                /* if h not found then n is composite */
-                if (h < 0)
-                    result = COMPOSITE;
-
-                /* 
-                    check (Lp); 
-                    if h % 2 != 0 (primitive unity root) 
-                    and q^{(n - 1) / 2} = -1 mod n then lambdas_2 = 1
-                */
-                if (h % 2 != 0 && lambdas[pind] == 0 && fmpz_equal(q_pow, ndec))
-                    lambdas[pind] = 1;
-            }
-
-            /* check (2.a) */
-            if (p != 2)
-            {
-                h = _is_prime_jacobi_check_pk(jacobi_sum, u, v);
-
-                /* if h not found then n is composite */
-                if (h < 0)
-                    result = COMPOSITE;
-
-                /* 
-                    check (Lp); 
-                    if h % p != 0 (primitive unity root) 
-                    then lambdas_p = 1
-                */
-                if (h % p != 0 && lambdas[pind] == 0)
-                    lambdas[pind] = 1;
-            }
-
-            /* clear unity_zp for jacobi sums */
-            unity_zp_clear(jacobi_sum);
-            unity_zp_clear(jacobi_sum2_1);
-            unity_zp_clear(jacobi_sum2_2);
-        }
-
     }
 
+    /* for every prime p | q - 1, the pairs being tested in parallel */
+    if (result == PROBABPRIME
+            && _is_prime_jacobi_pairs(lambdas, n, config, nmod4) == 1)
+        result = COMPOSITE;
+
     /* end of (2.) */
 
     /* (3.) begin of Additional tests step */
@@ -793,11 +943,7 @@ _is_prime_jacobi(const fmpz_t n, const aprcl_config config)
 
     /* clear */
     flint_free(lambdas);
-    fmpz_clear(u);
-    fmpz_clear(q_pow);
     fmpz_clear(p2);
-    fmpz_clear(ndec);
-    fmpz_clear(ndecdiv);
     fmpz_clear(temp);
 
     return result;
@@ -156,6 +156,9 @@ int main(void)
             fmpz_t n;
             fmpz_init(n);
 
+            /* the pairs (p, q) are shared out between the threads */
+            flint_set_num_threads(n_randint(state, 4) + 1);
+
             fmpz_randtest_unsigned(n, state, 1000);
             while (fmpz_cmp_ui(n, 100) <= 0)
                 fmpz_randtest_unsigned(n, state, 1000);
@@ -232,6 +235,8 @@ int main(void)
 
     }
 
+    flint_set_num_threads(1);
+
     FLINT_TEST_CLEANUP(state);
 
     flint_printf("PASS\n");
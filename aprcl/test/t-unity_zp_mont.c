@@ -0,0 +1,174 @@
+/*
+    Copyright (C) 2026 agent
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <gmp.h>
+#include "flint.h"
+#include "aprcl.h"
+
+int main(void)
+{
+    int i, j;
+    FLINT_TEST_INIT(state);
+
+    flint_printf("unity_zp_mont....");
+    fflush(stdout);
+
+    /* check REDC against x/R mod n */
+    for (i = 0; i < 1000 * flint_test_multiplier(); i++)
+    {
+        fmpz_t n, x, r, s;
+        unity_zp_mont m;
+
+        fmpz_init(n);
+        fmpz_init(x);
+        fmpz_init(r);
+        fmpz_init(s);
+
+        fmpz_randtest_unsigned(n, state, 400);
+        fmpz_setbit(n, 0);
+
+        fmpz_randtest(x, state, 1000);
+
+        unity_zp_mont_init(m, n);
+        _unity_zp_mont_redc(r, x, m);
+
+        fmpz_mul_2exp(s, r, FLINT_BITS*m->size);
+        fmpz_sub(s, s, x);
+
+        if (fmpz_sgn(r) < 0 || fmpz_cmp(r, n) >= 0 || !fmpz_divisible(s, n))
+        {
+            flint_printf("FAIL:\n");
+            flint_printf("n = "); fmpz_print(n); flint_printf("\n");
+            flint_printf("x = "); fmpz_print(x); flint_printf("\n");
+            flint_printf("r = "); fmpz_print(r); flint_printf("\n");
+            abort();
+        }
+
+        /* aliasing */
+        _unity_zp_mont_redc(x, x, m);
+
+        if (!fmpz_equal(x, r))
+        {
+            flint_printf("FAIL (aliasing):\n");
+            abort();
+        }
+
+        unity_zp_mont_clear(m);
+
+        fmpz_clear(n);
+        fmpz_clear(x);
+        fmpz_clear(r);
+        fmpz_clear(s);
+    }
+
+    /* check products in Montgomery form, including the special cases */
+    for (i = 0; i < 100 * flint_test_multiplier(); i++)
+    {
+        ulong p, exp;
+        fmpz_t n;
+        fmpz_t * t;
+        unity_zp f, g, h, f2, g2, h2;
+        unity_zp_mont m;
+
+        p = n_randprime(state, 2 + n_randint(state, 3), 0);
+        exp = (p == 2) ? n_randint(state, 4) + 1 : n_randint(state, 2) + 1;
+
+        t = (fmpz_t *) flint_malloc(sizeof(fmpz_t) * SQUARING_SPACE);
+        for (j = 0; j < SQUARING_SPACE; j++)
+            fmpz_init(t[j]);
+
+        fmpz_init(n);
+        fmpz_randtest_unsigned(n, state, 400);
+        fmpz_setbit(n, 0);
+
+        unity_zp_init(f, p, exp, n);
+        unity_zp_init(g, p, exp, n);
+        unity_zp_init(h, p, exp, n);
+        unity_zp_init(f2, p, exp, n);
+        unity_zp_init(g2, p, exp, n);
+        unity_zp_init(h2, p, exp, n);
+
+        for (j = 0; j < 100; j++)
+        {
+            ulong ind;
+            fmpz_t val;
+
+            fmpz_init(val);
+
+            ind = n_randint(state, n_pow(p, exp));
+            fmpz_randtest_unsigned(val, state, 400);
+            unity_zp_coeff_set_fmpz(g, ind, val);
+
+            ind = n_randint(state, n_pow(p, exp));
+            fmpz_randtest_unsigned(val, state, 400);
+            unity_zp_coeff_set_fmpz(h, ind, val);
+
+            fmpz_clear(val);
+        }
+
+        _unity_zp_reduce_cyclotomic(g);
+        _unity_zp_reduce_cyclotomic(h);
+
+        unity_zp_mont_init(m, n);
+        unity_zp_to_mont(g2, g, m);
+        unity_zp_to_mont(h2, h, m);
+
+        /* the round trip gives back g */
+        unity_zp_from_mont(f2, g2);
+
+        if (unity_zp_equal(f2, g) == 0)
+        {
+            flint_printf("FAIL (round trip):\n");
+            flint_printf("p = %wu, exp = %wu\n", p, exp);
+            abort();
+        }
+
+        if (n_randint(state, 2))
+        {
+            unity_zp_mul_inplace(f2, g2, h2, t);
+            unity_zp_mul_inplace(f, g, h, t);
+        } else
+        {
+            unity_zp_sqr_inplace(f2, g2, t);
+            unity_zp_sqr_inplace(f, g, t);
+        }
+
+        unity_zp_from_mont(f2, f2);
+
+        if (unity_zp_equal(f2, f) == 0)
+        {
+            flint_printf("FAIL (product):\n");
+            flint_printf("p = %wu, exp = %wu\n", p, exp);
+            abort();
+        }
+
+        unity_zp_mont_clear(m);
+
+        for (j = 0; j < SQUARING_SPACE; j++)
+            fmpz_clear(t[j]);
+        flint_free(t);
+
+        fmpz_clear(n);
+        unity_zp_clear(f);
+        unity_zp_clear(g);
+        unity_zp_clear(h);
+        unity_zp_clear(f2);
+        unity_zp_clear(g2);
+        unity_zp_clear(h2);
+    }
+
+    FLINT_TEST_CLEANUP(state);
+
+    flint_printf("PASS\n");
+    return 0;
+}
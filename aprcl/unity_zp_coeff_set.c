@@ -17,6 +17,35 @@ unity_zp_coeff_set_fmpz(unity_zp f, ulong ind, const fmpz_t x)
     fmpz_mod_poly_set_coeff_fmpz(f->poly, ind, x);
 }
 
+/*
+    Sets the coefficient ind of f to x, which must be a sum of products of
+    coefficients in the form of f, reduced by REDC if f is in Montgomery
+    form and modulo n otherwise.
+*/
+void
+_unity_zp_coeff_set_product(unity_zp f, ulong ind, const fmpz_t x)
+{
+    if (f->mont == NULL)
+    {
+        fmpz_mod_poly_set_coeff_fmpz(f->poly, ind, x);
+        return;
+    }
+
+    fmpz_mod_poly_fit_length(f->poly, ind + 1);
+
+    if (ind + 1 > f->poly->length)
+    {
+        flint_mpn_zero((mp_ptr) (f->poly->coeffs + f->poly->length),
+                                                   ind + 1 - f->poly->length);
+        f->poly->length = ind + 1;
+    }
+
+    _unity_zp_mont_redc(f->poly->coeffs + ind, x, f->mont);
+
+    if (ind == f->poly->length - 1)
+        _fmpz_mod_poly_normalise(f->poly);
+}
+
 void
 unity_zp_coeff_set_ui(unity_zp f, ulong ind, ulong x)
 {
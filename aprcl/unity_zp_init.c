@@ -18,6 +18,7 @@ unity_zp_init(unity_zp f, ulong p, ulong exp, const fmpz_t n)
     f->exp = exp;
     fmpz_init_set(f->n, n);
     fmpz_mod_poly_init(f->poly, n);
+    f->mont = NULL;
 }
 
 void
@@ -0,0 +1,166 @@
+/*
+    Copyright (C) 2026 agent
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include "mpn_extras.h"
+#include "aprcl.h"
+
+void
+unity_zp_mont_init(unity_zp_mont m, const fmpz_t n)
+{
+    mp_limb_t inv;
+    slong i;
+
+    if (!fmpz_is_odd(n))
+    {
+        flint_printf("Exception (unity_zp_mont_init). Even modulus.\n");
+        flint_abort();
+    }
+
+    m->size = fmpz_size(n);
+    m->d = flint_malloc(m->size*sizeof(mp_limb_t));
+
+    if (COEFF_IS_MPZ(*n))
+        mpn_copyi(m->d, COEFF_TO_PTR(*n)->_mp_d, m->size);
+    else
+        m->d[0] = *n;
+
+    /* 1/d0 = d0 mod 8, each Newton step doubles the number of correct bits */
+    inv = m->d[0];
+    for (i = 0; i < 5; i++)
+        inv *= 2 - m->d[0]*inv;
+
+    m->ninv = -inv;
+
+    fmpz_init(m->r2);
+    fmpz_one(m->r2);
+    fmpz_mul_2exp(m->r2, m->r2, 2*FLINT_BITS*m->size);
+    fmpz_mod(m->r2, m->r2, n);
+}
+
+void
+unity_zp_mont_clear(unity_zp_mont m)
+{
+    flint_free(m->d);
+    fmpz_clear(m->r2);
+}
+
+/*
+    Sets r to x/R mod n, reduced into [0, n). Any x is allowed, but the
+    reduction is cheapest when |x| < nR, e.g. x is a sum of a few products
+    of residues, which is then reduced with n word steps and no division.
+*/
+void
+_unity_zp_mont_redc(fmpz_t r, const fmpz_t x, const unity_zp_mont m)
+{
+    mp_size_t i, xn, tn, n = m->size;
+    mp_srcptr xp;
+    mp_ptr t, rp, qp;
+    mp_limb_t xl, cy;
+    __mpz_struct * rm;
+    int neg;
+    TMP_INIT;
+
+    if (fmpz_is_zero(x))
+    {
+        fmpz_zero(r);
+        return;
+    }
+
+    if (!COEFF_IS_MPZ(*x))
+    {
+        xl = FLINT_ABS(*x);
+        xp = &xl;
+        xn = 1;
+        neg = (*x < 0);
+    } else
+    {
+        __mpz_struct * xm = COEFF_TO_PTR(*x);
+
+        xp = xm->_mp_d;
+        xn = FLINT_ABS(xm->_mp_size);
+        neg = (xm->_mp_size < 0);
+    }
+
+    TMP_START;
+
+    tn = FLINT_MAX(xn, 2*n) + 1;
+    t = TMP_ALLOC(2*tn*sizeof(mp_limb_t));
+    mpn_copyi(t, xp, xn);
+    flint_mpn_zero(t + xn, tn - xn);
+
+    /* the carry out of step i is kept in t[i], which is zero after it */
+    for (i = 0; i < n; i++)
+        t[i] = mpn_addmul_1(t + i, m->d, n, t[i]*m->ninv);
+
+    cy = mpn_add_n(t + n, t + n, t, n);
+    mpn_add_1(t + 2*n, t + 2*n, tn - 2*n, cy);
+
+    rp = t + n;
+    tn -= n;
+    MPN_NORM(rp, tn);
+
+    if (tn > n || (tn == n && mpn_cmp(rp, m->d, n) >= 0))
+    {
+        qp = rp + tn;
+        mpn_tdiv_qr(qp, rp, 0, rp, tn, m->d, n);
+        tn = n;
+        MPN_NORM(rp, tn);
+    }
+
+    if (neg && tn != 0)
+    {
+        mpn_sub(rp, m->d, n, rp, tn);
+        tn = n;
+        MPN_NORM(rp, tn);
+    }
+
+    rm = _fmpz_promote(r);
+
+    if (rm->_mp_alloc < tn)
+        mpz_realloc2(rm, tn*FLINT_BITS);
+
+    mpn_copyi(rm->_mp_d, rp, tn);
+    rm->_mp_size = tn;
+
+    _fmpz_demote_val(r);
+
+    TMP_END;
+}
+
+void
+unity_zp_to_mont(unity_zp f, const unity_zp g, const unity_zp_mont m)
+{
+    slong i;
+
+    fmpz_mod_poly_set(f->poly, g->poly);
+
+    /* c*R is c*R^2 reduced by REDC; nonzero coefficients stay nonzero */
+    for (i = 0; i < f->poly->length; i++)
+    {
+        fmpz_mul(f->poly->coeffs + i, f->poly->coeffs + i, m->r2);
+        _unity_zp_mont_redc(f->poly->coeffs + i, f->poly->coeffs + i, m);
+    }
+
+    f->mont = m;
+}
+
+void
+unity_zp_from_mont(unity_zp f, const unity_zp g)
+{
+    slong i;
+
+    fmpz_mod_poly_set(f->poly, g->poly);
+
+    for (i = 0; i < f->poly->length; i++)
+        _unity_zp_mont_redc(f->poly->coeffs + i, f->poly->coeffs + i, g->mont);
+
+    f->mont = NULL;
+}
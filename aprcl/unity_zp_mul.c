@@ -16,6 +16,8 @@ unity_zp_mul(unity_zp f, const unity_zp g, const unity_zp h)
 {
     slong glen, hlen;
 
+    f->mont = g->mont;
+
     glen = g->poly->length;
     hlen = h->poly->length;
 
@@ -40,6 +42,8 @@ unity_zp_mul(unity_zp f, const unity_zp g, const unity_zp h)
 void
 unity_zp_mul_inplace(unity_zp f, const unity_zp g, const unity_zp h, fmpz_t * t)
 {
+    f->mont = g->mont;
+
     /* multiplication for p^k = 4 */
     if (f->p == 2 && f->exp == 2)
     {
@@ -127,10 +127,10 @@ unity_zp_mul11(unity_zp f, const unity_zp g, const unity_zp h, fmpz_t * t)
     for (i = 0; i < 9; i++)
     {
         fmpz_sub(t[0], t[50 + i], t[1]);
-        unity_zp_coeff_set_fmpz(f, i, t[0]);
+        _unity_zp_coeff_set_product(f, i, t[0]);
     }
     /* a0 = d_{3, 4} - a1 */
     fmpz_sub(t[0], t[44], t[1]);
-    unity_zp_coeff_set_fmpz(f, 9, t[0]);    /*  y9 = a0 mod n   */
+    _unity_zp_coeff_set_product(f, 9, t[0]);    /*  y9 = a0 mod n   */
 }
 
@@ -48,9 +48,9 @@ unity_zp_mul4(unity_zp f, const unity_zp g, const unity_zp h, fmpz_t * t)
     fmpz_mul(t[9], t[6], t[0]);             /*  d3 = m3 * x0    */
     fmpz_sub(t[0], t[7], t[8]);             /*  t[0] = d1 - d2  */
 
-    unity_zp_coeff_set_fmpz(f, 0, t[0]);    /*  z0 = t[0] mod n */
+    _unity_zp_coeff_set_product(f, 0, t[0]);    /*  z0 = t[0] mod n */
     fmpz_add(t[0], t[7], t[9]);             /*  t[0] = d1 + d3  */
-    unity_zp_coeff_set_fmpz(f, 1, t[0]);    /*  z1 = t[0] mod n */
+    _unity_zp_coeff_set_product(f, 1, t[0]);    /*  z1 = t[0] mod n */
 }
 
 /*
@@ -113,17 +113,17 @@ unity_zp_mul8(unity_zp f, const unity_zp g, const unity_zp h, fmpz_t * t)
     fmpz_add(t[28], t[26], t[19]);          /*  d12 = d10 + d3  */
     fmpz_add(t[21], t[24], t[18]);          /*  d5 = d8 + d2    */
     fmpz_sub(t[0], t[28], t[21]);           /*  t[0] = d12 - d5 */
-    unity_zp_coeff_set_fmpz(f, 0, t[0]);    /*  z0 = t[0] mod n */
+    _unity_zp_coeff_set_product(f, 0, t[0]);    /*  z0 = t[0] mod n */
 
     fmpz_add(t[28], t[22], t[27]);          /*  d12 = d6 + d11  */
     fmpz_add(t[21], t[26], t[25]);          /*  d5 = d10 + d9   */
     fmpz_sub(t[0], t[28], t[21]);           /*  t[0] = d12 - d5 */
-    unity_zp_coeff_set_fmpz(f, 1, t[0]);    /*  z1 = t[0] mod n */
+    _unity_zp_coeff_set_product(f, 1, t[0]);    /*  z1 = t[0] mod n */
     fmpz_add(t[28], t[17], t[23]);          /*  d12 = d1 + d7   */
     fmpz_add(t[21], t[16], t[27]);          /*  d5 = d0 + d11   */
 
     fmpz_sub(t[0], t[28], t[21]);           /*  t[0] = d12 - d5 */
-    unity_zp_coeff_set_fmpz(f, 2, t[0]);    /*  z2 = t[0] mod n */
+    _unity_zp_coeff_set_product(f, 2, t[0]);    /*  z2 = t[0] mod n */
     fmpz_add(t[28], t[23], t[22]);          /*  d12 = d7 + d6   */
     fmpz_add(t[21], t[28], t[24]);          /*  d5 = d12 + d8   */
     fmpz_add(t[28], t[21], t[25]);          /*  d12 = d5 + d8   */
@@ -131,7 +131,7 @@ unity_zp_mul8(unity_zp f, const unity_zp g, const unity_zp h, fmpz_t * t)
 
     fmpz_add(t[21], t[19], t[20]);          /*  d5 = d3 + d4    */
     fmpz_sub(t[0], t[21], t[28]);           /*  t[0] = d5 - d12 */
-    unity_zp_coeff_set_fmpz(f, 3, t[0]);    /*  z3 = t[0] mod n */
+    _unity_zp_coeff_set_product(f, 3, t[0]);    /*  z3 = t[0] mod n */
 }
 
 /*
@@ -227,37 +227,37 @@ unity_zp_mul16(unity_zp f, const unity_zp g, const unity_zp h, fmpz_t * t)
     fmpz_add(t[1], t[54], t[57]);           /*  a1 = d4 + d7    */
     fmpz_add(t[2], t[1], t[12]);            /*  a2 = a1 + c3    */
     fmpz_sub(t[0], t[50], t[2]);            /*  a0 = d0 - a2    */
-    unity_zp_coeff_set_fmpz(f, 0, t[0]);    /*  z0 = a0 mod n   */
+    _unity_zp_coeff_set_product(f, 0, t[0]);    /*  z0 = a0 mod n   */
 
     fmpz_add(t[1], t[55], t[58]);           /*  a1 = d5 + d8    */
     fmpz_add(t[2], t[1], t[13]);            /*  a2 = a1 + c4    */
     fmpz_sub(t[0], t[51], t[2]);            /*  a0 = d1 - a2    */
-    unity_zp_coeff_set_fmpz(f, 1, t[0]);    /*  z1 = a0 mod n   */
+    _unity_zp_coeff_set_product(f, 1, t[0]);    /*  z1 = a0 mod n   */
 
     fmpz_add(t[1], t[56], t[59]);           /*  a1 = d6 + d9    */
     fmpz_add(t[2], t[1], t[14]);            /*  a2 = a1 + c5    */
     fmpz_sub(t[0], t[52], t[2]);            /*  a0 = d2 - a2    */
-    unity_zp_coeff_set_fmpz(f, 2, t[0]);    /*  z2 = a0 mod n   */
+    _unity_zp_coeff_set_product(f, 2, t[0]);    /*  z2 = a0 mod n   */
 
     fmpz_sub(t[0], t[53], t[60]);           /*  a0 = d3 - d10   */
-    unity_zp_coeff_set_fmpz(f, 3, t[0]);    /*  z3 = a0 mod n   */
+    _unity_zp_coeff_set_product(f, 3, t[0]);    /*  z3 = a0 mod n   */
 
     fmpz_add(t[1], t[54], t[50]);           /*  a1 = d4 + d0    */
     fmpz_add(t[2], t[1], t[8]);             /*  a2 = a1 + c0    */
     fmpz_sub(t[0], t[2], t[61]);            /*  a0 = a2 - d11   */
-    unity_zp_coeff_set_fmpz(f, 4, t[0]);    /*  z4 = a0 mod n   */
+    _unity_zp_coeff_set_product(f, 4, t[0]);    /*  z4 = a0 mod n   */
 
     fmpz_add(t[1], t[55], t[51]);           /*  a1 = d5 + d1    */
     fmpz_add(t[2], t[1], t[9]);             /*  a2 = a1 + c0    */
     fmpz_sub(t[0], t[2], t[62]);            /*  a0 = a2 - d12   */
-    unity_zp_coeff_set_fmpz(f, 5, t[0]);    /*  z5 = a0 mod n   */
+    _unity_zp_coeff_set_product(f, 5, t[0]);    /*  z5 = a0 mod n   */
 
     fmpz_add(t[1], t[56], t[52]);           /*  a1 = d6 + d2    */
     fmpz_add(t[2], t[1], t[10]);            /*  a2 = a1 + c1    */
     fmpz_sub(t[0], t[2], t[63]);            /*  a0 = a2 - a13   */
-    unity_zp_coeff_set_fmpz(f, 6, t[0]);    /*  z6 = a0 mod n   */
+    _unity_zp_coeff_set_product(f, 6, t[0]);    /*  z6 = a0 mod n   */
 
     fmpz_add(t[1], t[53], t[11]);           /*  a1 = d3 + c2    */
-    unity_zp_coeff_set_fmpz(f, 7, t[1]);    /*  z7 = a1 mod n   */
+    _unity_zp_coeff_set_product(f, 7, t[1]);    /*  z7 = a1 mod n   */
 }
 
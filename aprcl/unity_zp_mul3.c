@@ -46,9 +46,9 @@ unity_zp_mul3(unity_zp f, const unity_zp g, const unity_zp h, fmpz_t * t)
     fmpz_mul(t[8], t[4], t[5]);             /*  d3 = m1 * m2    */
     fmpz_add(t[8], t[8], t[6]);             /*  d3 = d3 + d1    */
     
-    unity_zp_coeff_set_fmpz(f, 1, t[8]);    /*  z1 = d3 mod n   */
+    _unity_zp_coeff_set_product(f, 1, t[8]);    /*  z1 = d3 mod n   */
     fmpz_sub(t[0], t[6], t[7]);             /*  x0 = d1 - d2    */
-    unity_zp_coeff_set_fmpz(f, 0, t[0]);    /*  z0 = x0 mod n   */
+    _unity_zp_coeff_set_product(f, 0, t[0]);    /*  z0 = x0 mod n   */
 }
 
 /*
@@ -159,24 +159,24 @@ unity_zp_mul9(unity_zp f, const unity_zp g, const unity_zp h, fmpz_t * t)
     fmpz_add(t[36], t[50], t[33]);          /*  d4 = d18 + d1   */
     fmpz_add(t[37], t[34], t[45]);          /*  d5 = d2 + d13   */
     fmpz_sub(t[0], t[32], t[48]);           /*  a0 = d0 - d16   */
-    unity_zp_coeff_set_fmpz(f, 0, t[0]);    /*  z0 = a0 mod n   */
+    _unity_zp_coeff_set_product(f, 0, t[0]);    /*  z0 = a0 mod n   */
 
     fmpz_sub(t[0], t[33], t[49]);           /*  a0 = d1 - d17   */
-    unity_zp_coeff_set_fmpz(f, 1, t[0]);    /*  z1 = a0 mod n   */
+    _unity_zp_coeff_set_product(f, 1, t[0]);    /*  z1 = a0 mod n   */
 
     fmpz_sub(t[0], t[34], t[40]);           /*  a0 = d2 - d8    */
-    unity_zp_coeff_set_fmpz(f, 2, t[0]);    /*  z2 = a0 mod n   */
+    _unity_zp_coeff_set_product(f, 2, t[0]);    /*  z2 = a0 mod n   */
 
-    unity_zp_coeff_set_fmpz(f, 5, t[37]);   /*  z5 = d5 mod n   */
+    _unity_zp_coeff_set_product(f, 5, t[37]);   /*  z5 = d5 mod n   */
 
     fmpz_add(t[50], t[35], t[38]);          /*  d18 = d3 + d6   */
     fmpz_add(t[51], t[48], t[41]);          /*  d19 = d16 + d9  */
     fmpz_sub(t[0], t[50], t[51]);           /*  a0 = d18 - d19  */
-    unity_zp_coeff_set_fmpz(f, 3, t[0]);    /*  z3 = a0 mod n   */
+    _unity_zp_coeff_set_product(f, 3, t[0]);    /*  z3 = a0 mod n   */
 
     fmpz_add(t[50], t[36], t[39]);          /*  d18 = d4 + d7   */
     fmpz_add(t[51], t[42], t[49]);          /*  d19 = d10 + d17 */
     fmpz_sub(t[0], t[50], t[51]);           /*  a0 = d18 - d19  */
-    unity_zp_coeff_set_fmpz(f, 4, t[0]);    /*  z4 = a0 mod n   */
+    _unity_zp_coeff_set_product(f, 4, t[0]);    /*  z4 = a0 mod n   */
 }
 
@@ -70,15 +70,15 @@ unity_zp_mul5(unity_zp f, const unity_zp g, const unity_zp h, fmpz_t * t)
     fmpz_add(t[24], t[17], t[18]);          /* d8 = d1 + d2  */
 
     fmpz_sub(t[0], t[24], t[21]);           /* x0 = d8 - d5  */
-    unity_zp_coeff_set_fmpz(f, 0, t[0]);    /* z0 = x0 mod n */
+    _unity_zp_coeff_set_product(f, 0, t[0]);    /* z0 = x0 mod n */
 
     fmpz_add(t[24], t[17], t[19]);          /* d8 = d1 + d3  */
     fmpz_sub(t[0], t[24], t[22]);           /* x0 = d8 - d6  */
-    unity_zp_coeff_set_fmpz(f, 1, t[0]);    /* z1 = x0 mod n */
+    _unity_zp_coeff_set_product(f, 1, t[0]);    /* z1 = x0 mod n */
 
     fmpz_add(t[24], t[17], t[20]);          /* d8 = d1 + d4  */
     fmpz_sub(t[0], t[24], t[23]);           /* x0 = d8 - d7  */
-    unity_zp_coeff_set_fmpz(f, 2, t[0]);    /* z2 = x0 mod n */
+    _unity_zp_coeff_set_product(f, 2, t[0]);    /* z2 = x0 mod n */
 
     fmpz_sub(t[10], t[8], t[14]);           /* m3 = m1 - m7  */
     fmpz_add(t[11], t[9], t[15]);           /* m4 = m2 + m8  */
@@ -87,6 +87,6 @@ unity_zp_mul5(unity_zp f, const unity_zp g, const unity_zp h, fmpz_t * t)
     fmpz_add(t[23], t[24], t[18]);          /* d7 = d8 + d2  */
     fmpz_add(t[24], t[23], t[19]);          /* d8 = d7 + d3  */
     fmpz_add(t[0], t[24], t[20]);           /* d7 = d8 + d4  */
-    unity_zp_coeff_set_fmpz(f, 3, t[0]);    /* z3 = d7 mod n */
+    _unity_zp_coeff_set_product(f, 3, t[0]);    /* z3 = d7 mod n */
 }
 
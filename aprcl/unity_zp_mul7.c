@@ -129,24 +129,24 @@ unity_zp_mul7(unity_zp f, const unity_zp g, const unity_zp h, fmpz_t * t)
 
     fmpz_add(t[68], t[50], t[57]);          /*  d18 = d10 + d7  */
     fmpz_sub(t[0], t[68], t[56]);           /*  a0 = d18 - d6   */
-    unity_zp_coeff_set_fmpz(f, 0, t[0]);    /*  z0 = a0 mod n   */
+    _unity_zp_coeff_set_product(f, 0, t[0]);    /*  z0 = a0 mod n   */
 
     fmpz_add(t[68], t[51], t[58]);          /*  d18 = d1 + d8   */
     fmpz_sub(t[0], t[68], t[56]);           /*  a0 = d18 - d6   */
-    unity_zp_coeff_set_fmpz(f, 1, t[0]);    /*  z1 = a0 mod n   */
+    _unity_zp_coeff_set_product(f, 1, t[0]);    /*  z1 = a0 mod n   */
 
     fmpz_add(t[68], t[52], t[59]);          /*  d18 = d2 + d9   */
     fmpz_sub(t[0], t[68], t[56]);           /*  a0 = d18 - d6   */
-    unity_zp_coeff_set_fmpz(f, 2, t[0]);    /*  z2 = a0 mod n   */
+    _unity_zp_coeff_set_product(f, 2, t[0]);    /*  z2 = a0 mod n   */
 
     fmpz_add(t[68], t[63], t[60]);          /*  d18 = d13 + d10 */
     fmpz_sub(t[0], t[68], t[56]);           /*  a0 = d18 - d6   */
-    unity_zp_coeff_set_fmpz(f, 3, t[0]);    /*  z3 = a0 mod n   */
+    _unity_zp_coeff_set_product(f, 3, t[0]);    /*  z3 = a0 mod n   */
 
     fmpz_sub(t[0], t[64], t[56]);           /*  a0 = d14 - d6   */
-    unity_zp_coeff_set_fmpz(f, 4, t[0]);    /*  z4 = a0 mod n   */
+    _unity_zp_coeff_set_product(f, 4, t[0]);    /*  z4 = a0 mod n   */
 
     fmpz_sub(t[0], t[65], t[56]);           /*  a0 = d15 - d6   */
-    unity_zp_coeff_set_fmpz(f, 5, t[0]);    /*  z5 = a0 mod n   */
+    _unity_zp_coeff_set_product(f, 5, t[0]);    /*  z5 = a0 mod n   */
 }
 
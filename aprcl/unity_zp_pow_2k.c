@@ -19,12 +19,15 @@ unity_zp_pow_2k_fmpz(unity_zp f, const unity_zp g, const fmpz_t pow)
     fmpz_t digit;
     unity_zp temp;
     unity_zp *g_powers;
+    unity_zp_mont m;
+    int mont = fmpz_is_odd(f->n);
 
     fmpz_init(digit);
     unity_zp_init(temp, f->p, f->exp, f->n);
 
-    /* g_sqr = g * g */
-    unity_zp_sqr(temp, g);
+    /* for odd n all products are reduced in Montgomery form */
+    if (mont)
+        unity_zp_mont_init(m, f->n);
 
     /* selects optimal k value for n */
     k = _unity_zp_pow_select_k(pow);
@@ -46,6 +49,15 @@ unity_zp_pow_2k_fmpz(unity_zp f, const unity_zp g, const fmpz_t pow)
     unity_zp_init(g_powers[1], f->p, f->exp, f->n);
     unity_zp_copy(g_powers[1], g);
 
+    if (mont)
+    {
+        unity_zp_to_mont(g_powers[0], g_powers[0], m);
+        unity_zp_to_mont(g_powers[1], g_powers[1], m);
+    }
+
+    /* g_sqr = g * g */
+    unity_zp_sqr(temp, g_powers[1]);
+
     /* sets g_powers[i] = g^2 * g_powers[i - 1] */
     for (i = 2; i <= pow2k; i++)
     {
@@ -109,6 +121,12 @@ unity_zp_pow_2k_fmpz(unity_zp f, const unity_zp g, const fmpz_t pow)
 
     }
 
+    if (mont)
+    {
+        unity_zp_from_mont(f, f);
+        unity_zp_mont_clear(m);
+    }
+
     for (i = 0; i <= pow2k; i++)
         unity_zp_clear(g_powers[i]);
     flint_free(g_powers);
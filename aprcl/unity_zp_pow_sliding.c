@@ -18,6 +18,8 @@ unity_zp_pow_sliding_fmpz(unity_zp f, unity_zp g, const fmpz_t pow)
     slong i, j;
     unity_zp temp;
     unity_zp *g_powers;
+    unity_zp_mont m;
+    int mont = fmpz_is_odd(f->n);
 
     fmpz_t * t;
     t = (fmpz_t*) flint_malloc(sizeof(fmpz_t) * SQUARING_SPACE);
@@ -29,8 +31,9 @@ unity_zp_pow_sliding_fmpz(unity_zp f, unity_zp g, const fmpz_t pow)
     /* reduce g by cyclopoly */
     _unity_zp_reduce_cyclotomic(g);
 
-    /* temp = g * g */
-    unity_zp_sqr_inplace(temp, g, t);
+    /* for odd n all products are reduced in Montgomery form */
+    if (mont)
+        unity_zp_mont_init(m, f->n);
 
     /* selects optimal k value for n */
     k = _unity_zp_pow_select_k(pow);
@@ -49,6 +52,15 @@ unity_zp_pow_sliding_fmpz(unity_zp f, unity_zp g, const fmpz_t pow)
     unity_zp_init(g_powers[1], f->p, f->exp, f->n);
     unity_zp_copy(g_powers[1], g);
 
+    if (mont)
+    {
+        unity_zp_to_mont(g_powers[0], g_powers[0], m);
+        unity_zp_to_mont(g_powers[1], g_powers[1], m);
+    }
+
+    /* temp = g * g */
+    unity_zp_sqr_inplace(temp, g_powers[1], t);
+
     /* sets g_powers[i] = g^2 * g_powers[i - 1] */
     for (i = 2; i <= n_pow(2, k - 1); i++)
     {
@@ -56,8 +68,7 @@ unity_zp_pow_sliding_fmpz(unity_zp f, unity_zp g, const fmpz_t pow)
         unity_zp_mul_inplace(g_powers[i], g_powers[i - 1], temp, t);
     }
 
-    unity_zp_set_zero(f);
-    unity_zp_coeff_set_ui(f, 0, 1);
+    unity_zp_copy(f, g_powers[0]);
     i = fmpz_bits(pow) - 1;
 
     /* working with pow = (e_l, e_{l-1}, ... , e_0) in 2 base */
@@ -102,6 +113,12 @@ unity_zp_pow_sliding_fmpz(unity_zp f, unity_zp g, const fmpz_t pow)
         }
     }
 
+    if (mont)
+    {
+        unity_zp_from_mont(f, f);
+        unity_zp_mont_clear(m);
+    }
+
     for (i = 0; i < SQUARING_SPACE; i++)
         fmpz_clear(t[i]);
     flint_free(t);
@@ -44,8 +44,17 @@ _unity_zp_reduce_cyclotomic_divmod(unity_zp f)
     }
 
     _fmpz_mod_poly_normalise(f->poly);
-    _fmpz_vec_scalar_mod_fmpz(f->poly->coeffs,
-            f->poly->coeffs, f->poly->length, f->n);
+
+    if (f->mont == NULL)
+        _fmpz_vec_scalar_mod_fmpz(f->poly->coeffs,
+                f->poly->coeffs, f->poly->length, f->n);
+    else
+    {
+        for (i = 0; i < f->poly->length; i++)
+            _unity_zp_mont_redc(f->poly->coeffs + i,
+                    f->poly->coeffs + i, f->mont);
+    }
+
     _fmpz_mod_poly_normalise(f->poly);
 }
 
@@ -14,6 +14,8 @@
 void
 unity_zp_sqr(unity_zp f, const unity_zp g)
 {
+    f->mont = g->mont;
+
     if (g->poly->length == 0)
     {
         fmpz_mod_poly_zero(f->poly);
@@ -31,6 +33,8 @@ unity_zp_sqr(unity_zp f, const unity_zp g)
 void
 unity_zp_sqr_inplace(unity_zp f, const unity_zp g, fmpz_t * t)
 {
+    f->mont = g->mont;
+
     /* squaring for p^k = 4 */
     if (f->p == 2 && f->exp == 2)
     {
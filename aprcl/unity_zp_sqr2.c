@@ -37,9 +37,9 @@ unity_zp_sqr4(unity_zp f, const unity_zp g, fmpz_t * t)
     fmpz_add(t[3], t[0], t[1]);             /*  m2 = x0 + x1    */
     fmpz_mul(t[4], t[2], t[3]);             /*  d1 = m1 * m2    */
     fmpz_add(t[2], t[0], t[0]);             /*  m1 = x0 + x0    */
-    unity_zp_coeff_set_fmpz(f, 0, t[4]);    /*  y0 = d1 mod n   */
+    _unity_zp_coeff_set_product(f, 0, t[4]);    /*  y0 = d1 mod n   */
     fmpz_mul(t[4], t[2], t[1]);             /*  d1 = m1 * x1    */
-    unity_zp_coeff_set_fmpz(f, 1, t[4]);    /*  y1 = d1 mod n   */
+    _unity_zp_coeff_set_product(f, 1, t[4]);    /*  y1 = d1 mod n   */
 }
 
 /*
@@ -84,20 +84,20 @@ unity_zp_sqr8(unity_zp f, const unity_zp g, fmpz_t * t)
 
     fmpz_add(t[5], t[2], t[3]);             /*  m2 = x2 + x3    */
     fmpz_sub(t[16], t[12], t[14]);          /*  d5 = d1 - d3    */
-    unity_zp_coeff_set_fmpz(f, 0, t[16]);   /*  y0 = d5 mod n   */
+    _unity_zp_coeff_set_product(f, 0, t[16]);   /*  y0 = d5 mod n   */
     fmpz_add(t[17], t[13], t[15]);          /*  d6 = d2 + d4    */
-    unity_zp_coeff_set_fmpz(f, 2, t[17]);   /*  y2 = d6 mod n   */
+    _unity_zp_coeff_set_product(f, 2, t[17]);   /*  y2 = d6 mod n   */
     fmpz_mul(t[16], t[10], t[11]);          /*  d5 = m7 * m8    */
 
     fmpz_add(t[17], t[12], t[13]);          /*  d6 = d1 + d2    */
     fmpz_sub(t[13], t[16], t[17]);          /*  d2 = d5 - d6    */
-    unity_zp_coeff_set_fmpz(f, 1, t[13]);   /*  y1 = d2 mod n   */
+    _unity_zp_coeff_set_product(f, 1, t[13]);   /*  y1 = d2 mod n   */
     fmpz_add(t[4], t[8], t[9]);             /*  m1 = m5 + m6    */
     fmpz_mul(t[12], t[4], t[5]);            /*  d1 = m1 * m2    */
     fmpz_add(t[17], t[14], t[15]);          /*  d6 = d3 + d4    */
 
     fmpz_sub(t[13], t[12], t[17]);          /*  d2 = d1 - d6    */
-    unity_zp_coeff_set_fmpz(f, 3, t[13]);   /*  y3 = d2 mod n   */
+    _unity_zp_coeff_set_product(f, 3, t[13]);   /*  y3 = d2 mod n   */
 }
 
 /*
@@ -166,18 +166,18 @@ unity_zp_sqr16(unity_zp f, const unity_zp g, fmpz_t * t)
     unity_zp_ar2(t);
 
     fmpz_sub(t[16], t[38], t[12]);          /*  d7 = d0 - c4    */
-    unity_zp_coeff_set_fmpz(f, 0, t[16]);   /*  y0 = d7 mod n   */
+    _unity_zp_coeff_set_product(f, 0, t[16]);   /*  y0 = d7 mod n   */
     fmpz_sub(t[16], t[39], t[13]);          /*  d7 = d1 - c5    */
-    unity_zp_coeff_set_fmpz(f, 1, t[16]);   /*  y1 = d7 mod n   */
+    _unity_zp_coeff_set_product(f, 1, t[16]);   /*  y1 = d7 mod n   */
     fmpz_sub(t[16], t[40], t[14]);          /*  d7 = d2 - c6    */
-    unity_zp_coeff_set_fmpz(f, 2, t[16]);   /*  y2 = d7 mod n   */
-    unity_zp_coeff_set_fmpz(f, 3, t[41]);   /*  y3 = d3 mod n   */
+    _unity_zp_coeff_set_product(f, 2, t[16]);   /*  y2 = d7 mod n   */
+    _unity_zp_coeff_set_product(f, 3, t[41]);   /*  y3 = d3 mod n   */
     fmpz_add(t[16], t[42], t[8]);           /*  d7 = d4 + c0    */
-    unity_zp_coeff_set_fmpz(f, 4, t[16]);   /*  y4 = d7 mod n   */
+    _unity_zp_coeff_set_product(f, 4, t[16]);   /*  y4 = d7 mod n   */
     fmpz_add(t[16], t[43], t[9]);           /*  d7 = d5 + c1    */
-    unity_zp_coeff_set_fmpz(f, 5, t[16]);   /*  y5 = d7 mod n   */
+    _unity_zp_coeff_set_product(f, 5, t[16]);   /*  y5 = d7 mod n   */
     fmpz_add(t[16], t[44], t[10]);          /*  d7 = d6 + c2    */
-    unity_zp_coeff_set_fmpz(f, 6, t[16]);   /*  y6 = d7 mod n   */
-    unity_zp_coeff_set_fmpz(f, 7, t[11]);   /*  y7 = c3 mod n   */
+    _unity_zp_coeff_set_product(f, 6, t[16]);   /*  y6 = d7 mod n   */
+    _unity_zp_coeff_set_product(f, 7, t[11]);   /*  y7 = c3 mod n   */
 }
 
@@ -35,9 +35,9 @@ unity_zp_sqr3(unity_zp f, const unity_zp g, fmpz_t * t)
     fmpz_add(t[3], t[0], t[1]);             /*  m2 = x0 + x1    */
     fmpz_mul(t[4], t[2], t[3]);             /*  d1 = m1 * m2    */
     fmpz_add(t[3], t[2], t[0]);             /*  m2 = m1 + m0    */
-    unity_zp_coeff_set_fmpz(f, 0, t[4]);    /*  y0 = d1 mod n   */
+    _unity_zp_coeff_set_product(f, 0, t[4]);    /*  y0 = d1 mod n   */
     fmpz_mul(t[4], t[1], t[3]);             /*  d1 = x1 * m2    */
-    unity_zp_coeff_set_fmpz(f, 1, t[4]);    /*  y1 = d1 mod n   */
+    _unity_zp_coeff_set_product(f, 1, t[4]);    /*  y1 = d1 mod n   */
 }
 
 /*
@@ -104,16 +104,16 @@ unity_zp_sqr9(unity_zp f, const unity_zp g, fmpz_t * t)
     unity_zp_ar1(t);
 
     fmpz_sub(t[0], t[26], t[9]);            /*  a0 = d0 - c3    */
-    unity_zp_coeff_set_fmpz(f, 0, t[0]);    /*  y0 = a0 mod n   */
+    _unity_zp_coeff_set_product(f, 0, t[0]);    /*  y0 = a0 mod n   */
     fmpz_sub(t[0], t[27], t[10]);           /*  a0 = d1 - c4    */
-    unity_zp_coeff_set_fmpz(f, 1, t[0]);    /*  y1 = a0 mod n   */
-    unity_zp_coeff_set_fmpz(f, 2, t[28]);   /*  y2 = d2 mod n   */
+    _unity_zp_coeff_set_product(f, 1, t[0]);    /*  y1 = a0 mod n   */
+    _unity_zp_coeff_set_product(f, 2, t[28]);   /*  y2 = d2 mod n   */
     fmpz_add(t[0], t[29], t[6]);            /*  a0 = d3 + c0    */
     fmpz_sub(t[1], t[0], t[9]);             /*  a1 = a0 - c3    */
-    unity_zp_coeff_set_fmpz(f, 3, t[1]);    /*  y3 = a1 mod n   */
+    _unity_zp_coeff_set_product(f, 3, t[1]);    /*  y3 = a1 mod n   */
     fmpz_add(t[0], t[30], t[7]);            /*  a0 = d4 + c1    */
     fmpz_sub(t[1], t[0], t[10]);            /*  a1 = a0 - c4    */
-    unity_zp_coeff_set_fmpz(f, 4, t[1]);    /*  y4 = a1 mod n   */
-    unity_zp_coeff_set_fmpz(f, 5, t[8]);    /*  y5 = c2 mod n   */
+    _unity_zp_coeff_set_product(f, 4, t[1]);    /*  y4 = a1 mod n   */
+    _unity_zp_coeff_set_product(f, 5, t[8]);    /*  y5 = c2 mod n   */
 }
 
@@ -48,22 +48,22 @@ unity_zp_sqr5(unity_zp f, const unity_zp g, fmpz_t * t)
     fmpz_mul(t[12], t[4], t[5]);            /*  d1 = m1 * m2    */
     fmpz_mul(t[13], t[6], t[11]);           /*  d2 = m3 * m8    */
     fmpz_add(t[14], t[12], t[13]);          /*  d3 = d1 + d2    */
-    unity_zp_coeff_set_fmpz(f, 0, t[14]);   /*  y0 = d3 mod n   */
+    _unity_zp_coeff_set_product(f, 0, t[14]);   /*  y0 = d3 mod n   */
     fmpz_add(t[11], t[8], t[10]);           /*  m8 = m5 + m7    */
 
     fmpz_mul(t[13], t[7], t[11]);           /*  d2 = m4 * m8    */
     fmpz_add(t[15], t[12], t[13]);          /*  d4 = d1 + d2    */
-    unity_zp_coeff_set_fmpz(f, 1, t[15]);   /*  y1 = d4 mod n   */
+    _unity_zp_coeff_set_product(f, 1, t[15]);   /*  y1 = d4 mod n   */
     fmpz_add(t[6], t[4], t[0]);             /*  m3 = m1 + x0    */
     fmpz_mul(t[12], t[2], t[6]);            /*  d1 = x2 * m3    */
     fmpz_sub(t[5], t[10], t[3]);            /*  m2 = m7 - x3    */
     fmpz_mul(t[13], t[5], t[1]);            /*  d2 = m2 * x1    */
 
     fmpz_add(t[14], t[12], t[13]);          /*  d3 = d1 + d2    */
-    unity_zp_coeff_set_fmpz(f, 2, t[14]);   /*  y2 = d3 mod n   */
+    _unity_zp_coeff_set_product(f, 2, t[14]);   /*  y2 = d3 mod n   */
     fmpz_add(t[10], t[9], t[9]);            /*  m7 = m6 + m6    */
     fmpz_mul(t[13], t[10], t[8]);           /*  d2 = m7 * m5    */
     fmpz_add(t[14], t[12], t[13]);          /*  d3 = d1 + d2    */
-    unity_zp_coeff_set_fmpz(f, 3, t[14]);   /*  y3 = d3 mod n   */
+    _unity_zp_coeff_set_product(f, 3, t[14]);   /*  y3 = d3 mod n   */
 }
 
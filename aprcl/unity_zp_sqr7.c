@@ -75,14 +75,14 @@ unity_zp_sqr7(unity_zp f, const unity_zp g, fmpz_t * t)
     fmpz_mul(t[30], t[22], t[10]);          /*  d7 = m17 * m5   */
     fmpz_add(t[31], t[24], t[25]);          /*  d8 = d1 + d2    */
     fmpz_add(t[24], t[31], t[26]);          /*  d1 = d8 + d5    */ 
-    unity_zp_coeff_set_fmpz(f, 3, t[24]);   /*  y3 = d1 mod n   */
+    _unity_zp_coeff_set_product(f, 3, t[24]);   /*  y3 = d1 mod n   */
     fmpz_add(t[31], t[26], t[27]);          /*  d8 = d3 + d4    */
 
     fmpz_add(t[24], t[31], t[28]);          /*  d1 = d8 + d5    */
-    unity_zp_coeff_set_fmpz(f, 1, t[24]);   /*  y1 = d1 mod n   */
+    _unity_zp_coeff_set_product(f, 1, t[24]);   /*  y1 = d1 mod n   */
     fmpz_add(t[31], t[27], t[29]);          /*  d8 = d4 + d6    */
     fmpz_add(t[24], t[31], t[30]);          /*  d1 = d8 + d7    */
-    unity_zp_coeff_set_fmpz(f, 0, t[24]);   /*  y0 = d1 mod n   */
+    _unity_zp_coeff_set_product(f, 0, t[24]);   /*  y0 = d1 mod n   */
     fmpz_add(t[22], t[12], t[19]);          /*  m17 = m7 + m14  */
 
     fmpz_mul(t[24], t[14], t[22]);          /*  d1 = m9 * m17   */
@@ -102,13 +102,13 @@ unity_zp_sqr7(unity_zp f, const unity_zp g, fmpz_t * t)
     fmpz_mul(t[30], t[22], t[15]);          /*  d7 = m17 * m10  */
     fmpz_add(t[31], t[24], t[25]);          /*  d8 = d1 + d2    */
     fmpz_add(t[24], t[31], t[26]);          /*  d1 = d8 + d3    */
-    unity_zp_coeff_set_fmpz(f, 4, t[24]);   /*  y4 = d1 mod n   */
+    _unity_zp_coeff_set_product(f, 4, t[24]);   /*  y4 = d1 mod n   */
     fmpz_add(t[31], t[26], t[27]);          /*  d8 = d3 + d4    */
 
     fmpz_add(t[24], t[31], t[28]);          /*  d1 = d8 + d5    */
-    unity_zp_coeff_set_fmpz(f, 5, t[24]);   /*  y5 = d1 mod n   */
+    _unity_zp_coeff_set_product(f, 5, t[24]);   /*  y5 = d1 mod n   */
     fmpz_add(t[31], t[27], t[29]);          /*  d8 = d4 + d6    */
     fmpz_add(t[24], t[31], t[30]);          /*  d1 = d8 + d7    */ 
-    unity_zp_coeff_set_fmpz(f, 2, t[24]);   /*  y2 = d1 mod n   */
+    _unity_zp_coeff_set_product(f, 2, t[24]);   /*  y2 = d1 mod n   */
 }
 
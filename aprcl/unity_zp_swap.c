@@ -14,6 +14,12 @@
 void
 unity_zp_swap(unity_zp f, unity_zp g)
 {
+    const _unity_zp_mont * t;
+
     fmpz_mod_poly_swap(f->poly, g->poly);
+
+    t = f->mont;
+    f->mont = g->mont;
+    g->mont = t;
 }
 
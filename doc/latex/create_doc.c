@@ -28,6 +28,7 @@ static char * docsin[] = {
     "../../fmpz_poly_q/doc/fmpz_poly_q.txt", 
     "../../fmpz_poly_mat/doc/fmpz_poly_mat.txt", 
     "../../nmod_vec/doc/nmod_vec.txt",
+    "../../nmod_fft/doc/nmod_fft.txt",
     "../../nmod_mat/doc/nmod_mat.txt",
     "../../nmod_poly/doc/nmod_poly.txt",
     "../../nmod_poly_factor/doc/nmod_poly_factor.txt",
@@ -82,6 +83,7 @@ static char * docsout[] = {
     "input/fmpz_poly_q.tex", 
     "input/fmpz_poly_mat.tex", 
     "input/nmod_vec.tex",
+    "input/nmod_fft.tex",
     "input/nmod_mat.tex",
     "input/nmod_poly.tex",
     "input/nmod_poly_factor.tex",
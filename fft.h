@@ -230,6 +230,36 @@ FLINT_DLL void ifft_mfa_truncate_sqrt2(mp_limb_t ** ii, mp_size_t n,
 FLINT_DLL void mul_mfa_truncate_sqrt2(mp_ptr r1, mp_srcptr i1, mp_size_t n1,
                         mp_srcptr i2, mp_size_t n2, mp_bitcnt_t depth, mp_bitcnt_t w);
 
+/* shared state of one parallel loop of the matrix fourier algorithm */
+typedef struct fft_mfa_arg_struct
+{
+   mp_limb_t ** ii;
+   mp_limb_t ** jj;
+   mp_limb_t ** t1;        /* one temporary of each kind per thread */
+   mp_limb_t ** t2;
+   mp_limb_t ** temp;
+   mp_limb_t ** tt;
+   mp_size_t n;
+   mp_bitcnt_t w;
+   mp_size_t n1;           /* number of columns */
+   mp_size_t n2;           /* number of rows */
+   mp_size_t trunc;
+   mp_size_t trunc2;
+   mp_size_t limbs;
+   mp_bitcnt_t depth;      /* log2 n2 */
+   mp_bitcnt_t depth2;     /* log2 n1 */
+   void (* fn)(const struct fft_mfa_arg_struct * arg, mp_size_t i, slong k);
+} fft_mfa_arg_struct;
+
+FLINT_DLL void _fft_mfa_arg_init(fft_mfa_arg_struct * arg, mp_limb_t ** ii,
+          mp_limb_t ** jj, mp_size_t n, mp_bitcnt_t w, mp_limb_t ** t1,
+          mp_limb_t ** t2, mp_limb_t ** temp, mp_limb_t ** tt, mp_size_t n1,
+                                                             mp_size_t trunc);
+
+FLINT_DLL void _fft_mfa_run(const fft_mfa_arg_struct * arg, mp_size_t len);
+
+FLINT_DLL slong fft_mfa_num_threads(void);
+
 FLINT_DLL void fft_mfa_truncate_sqrt2_outer(mp_limb_t ** ii, mp_size_t n, 
                       mp_bitcnt_t w, mp_limb_t ** t1, mp_limb_t ** t2, 
                                 mp_limb_t ** temp, mp_size_t n1, mp_size_t trunc);
@@ -251,6 +281,43 @@ FLINT_DLL void ifft_negacyclic(mp_limb_t ** ii, mp_size_t n, mp_bitcnt_t w,
 FLINT_DLL void fft_naive_convolution_1(mp_limb_t * r, mp_limb_t * ii, 
                                                      mp_limb_t * jj, mp_size_t m);
 
+/* version of the tuning file format written by fft_tuning_write */
+#define FFT_TUNING_VERSION 1
+
+/* maximum number of entries of the mulmod table */
+#define FFT_TUNING_MULMOD_MAX 32
+
+/* largest depth benchmarked by fft_tuning_tune for the mulmod table */
+#define FFT_TUNING_MULMOD_DEPTH 20
+
+typedef struct
+{
+   int fft_tab[5][2];       /* depth reduction for mul_truncate_sqrt2 */
+   mp_size_t mulmod_tab[FFT_TUNING_MULMOD_MAX]; /* for _fft_mulmod_2expp1 */
+   slong mulmod_num;        /* number of entries of mulmod_tab in use */
+   mp_size_t mulmod_cutoff; /* largest basecase fft_mulmod_2expp1 in limbs */
+} fft_tuning_struct;
+
+typedef fft_tuning_struct fft_tuning_t[1];
+
+FLINT_DLL const fft_tuning_struct * _fft_tuning_active(void);
+
+FLINT_DLL void fft_tuning_init_default(fft_tuning_t tab);
+
+FLINT_DLL void fft_tuning_get(fft_tuning_t tab);
+
+FLINT_DLL int fft_tuning_set(const fft_tuning_t tab);
+
+FLINT_DLL void fft_tuning_reset(void);
+
+FLINT_DLL int fft_tuning_is_valid(const fft_tuning_t tab);
+
+FLINT_DLL void fft_tuning_tune(fft_tuning_t tab);
+
+FLINT_DLL int fft_tuning_write(const char * filename, const fft_tuning_t tab);
+
+FLINT_DLL int fft_tuning_read(fft_tuning_t tab, const char * filename);
+
 FLINT_DLL void _fft_mulmod_2expp1(mp_limb_t * r1, mp_limb_t * i1, mp_limb_t * i2, 
                              mp_size_t r_limbs, mp_bitcnt_t depth, mp_bitcnt_t w);
 
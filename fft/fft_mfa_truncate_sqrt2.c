@@ -218,100 +218,101 @@ void fft_mfa_truncate_sqrt2(mp_limb_t ** ii, mp_size_t n,
    }
 }
 
-void fft_mfa_truncate_sqrt2_outer(mp_limb_t ** ii, mp_size_t n, 
-                   mp_bitcnt_t w, mp_limb_t ** t1, mp_limb_t ** t2, 
-                             mp_limb_t ** temp, mp_size_t n1, mp_size_t trunc)
+/* first half columns: sqrt2 layer then twiddled FFT on column i */
+static void _fft_mfa_outer_column1(const fft_mfa_arg_struct * arg,
+                                                     mp_size_t i, slong k)
 {
-   mp_size_t i, j;
-   mp_size_t n2 = (2*n)/n1;
-   mp_size_t trunc2 = (trunc - 2*n)/n1;
-   mp_size_t limbs = (n*w)/FLINT_BITS;
-   mp_bitcnt_t depth = 0;
-   mp_bitcnt_t depth2 = 0;
-   int k = 0;
+   mp_limb_t ** ii = arg->ii;
+   mp_size_t j, n = arg->n, n1 = arg->n1, n2 = arg->n2;
+   mp_size_t trunc = arg->trunc, limbs = arg->limbs;
+   mp_bitcnt_t w = arg->w;
 
-   while ((UWORD(1)<<depth) < n2) depth++;
-   while ((UWORD(1)<<depth2) < n1) depth2++;
+   /* relevant part of first layer of full sqrt2 FFT */
+   if (w & 1)
+   {
+      for (j = i; j < trunc - 2*n; j+=n1) 
+      {   
+         if (j & 1)
+            fft_butterfly_sqrt2(arg->t1[k], arg->t2[k], ii[j], ii[2*n+j], j, limbs, w, arg->temp[k]);
+         else
+            fft_butterfly(arg->t1[k], arg->t2[k], ii[j], ii[2*n+j], j/2, limbs, w);     
 
-   /* first half matrix fourier FFT : n2 rows, n1 cols */
-   
-   /* FFTs on columns */
+         SWAP_PTRS(ii[j],     arg->t1[k]);
+         SWAP_PTRS(ii[2*n+j], arg->t2[k]);
+      }
 
-#pragma omp parallel for private(i, j, k)
-   for (i = 0; i < n1; i++)
-   {   
-#if HAVE_OPENMP
-      k = omp_get_thread_num();
-#endif
-      /* relevant part of first layer of full sqrt2 FFT */
-      if (w & 1)
+      for ( ; j < 2*n; j+=n1)
       {
-         for (j = i; j < trunc - 2*n; j+=n1) 
-         {   
-            if (j & 1)
-               fft_butterfly_sqrt2(t1[k], t2[k], ii[j], ii[2*n+j], j, limbs, w, temp[k]);
-            else
-               fft_butterfly(t1[k], t2[k], ii[j], ii[2*n+j], j/2, limbs, w);     
+          if (i & 1)
+             fft_adjust_sqrt2(ii[j + 2*n], ii[j], j, limbs, w, arg->temp[k]); 
+          else
+             fft_adjust(ii[j + 2*n], ii[j], j/2, limbs, w); 
+      }
+   } else
+   {
+      for (j = i; j < trunc - 2*n; j+=n1) 
+      {   
+         fft_butterfly(arg->t1[k], arg->t2[k], ii[j], ii[2*n+j], j, limbs, w/2);
 
-            SWAP_PTRS(ii[j],     t1[k]);
-            SWAP_PTRS(ii[2*n+j], t2[k]);
-         }
+         SWAP_PTRS(ii[j],     arg->t1[k]);
+         SWAP_PTRS(ii[2*n+j], arg->t2[k]);
+      }
 
-         for ( ; j < 2*n; j+=n1)
-         {
-             if (i & 1)
-                fft_adjust_sqrt2(ii[j + 2*n], ii[j], j, limbs, w, temp[k]); 
-             else
-                fft_adjust(ii[j + 2*n], ii[j], j/2, limbs, w); 
-         }
-      } else
-      {
-         for (j = i; j < trunc - 2*n; j+=n1) 
-         {   
-            fft_butterfly(t1[k], t2[k], ii[j], ii[2*n+j], j, limbs, w/2);
+      for ( ; j < 2*n; j+=n1)
+         fft_adjust(ii[j + 2*n], ii[j], j, limbs, w/2);
+   }
+
+   /* 
+      FFT of length n2 on column i, applying z^{r*i} for rows going up in steps 
+      of 1 starting at row 0, where z => w bits
+   */
    
-            SWAP_PTRS(ii[j],     t1[k]);
-            SWAP_PTRS(ii[2*n+j], t2[k]);
-         }
+   fft_radix2_twiddle(ii + i, n1, n2/2, w*n1, arg->t1 + k, arg->t2 + k, w, 0, i, 1);
+   for (j = 0; j < n2; j++)
+   {
+      mp_size_t s = n_revbin(j, arg->depth);
+      if (j < s) SWAP_PTRS(ii[i+j*n1], ii[i+s*n1]);
+   }
+}
 
-         for ( ; j < 2*n; j+=n1)
-            fft_adjust(ii[j + 2*n], ii[j], j, limbs, w/2);
-      }
+/* second half columns: truncated twiddled FFT on column i */
+static void _fft_mfa_outer_column2(const fft_mfa_arg_struct * arg,
+                                                     mp_size_t i, slong k)
+{
+   mp_limb_t ** ii = arg->ii + 2*arg->n;
+   mp_size_t j, n1 = arg->n1, n2 = arg->n2;
+
+   /*
+      FFT of length n2 on column i, applying z^{r*i} for rows going up in steps 
+      of 1 starting at row 0, where z => w bits
+   */
    
-      /* 
-         FFT of length n2 on column i, applying z^{r*i} for rows going up in steps 
-         of 1 starting at row 0, where z => w bits
-      */
-      
-      fft_radix2_twiddle(ii + i, n1, n2/2, w*n1, t1 + k, t2 + k, w, 0, i, 1);
-      for (j = 0; j < n2; j++)
-      {
-         mp_size_t s = n_revbin(j, depth);
-         if (j < s) SWAP_PTRS(ii[i+j*n1], ii[i+s*n1]);
-      }
+   fft_truncate1_twiddle(ii + i, n1, n2/2, arg->w*n1, arg->t1 + k, arg->t2 + k,
+                                                 arg->w, 0, i, 1, arg->trunc2);
+   for (j = 0; j < n2; j++)
+   {
+      mp_size_t s = n_revbin(j, arg->depth);
+      if (j < s) SWAP_PTRS(ii[i+j*n1], ii[i+s*n1]);
    }
+}
+
+void fft_mfa_truncate_sqrt2_outer(mp_limb_t ** ii, mp_size_t n, 
+                   mp_bitcnt_t w, mp_limb_t ** t1, mp_limb_t ** t2, 
+                             mp_limb_t ** temp, mp_size_t n1, mp_size_t trunc)
+{
+   fft_mfa_arg_struct arg;
+
+   _fft_mfa_arg_init(&arg, ii, ii, n, w, t1, t2, temp, NULL, n1, trunc);
+
+   /* first half matrix fourier FFT : n2 rows, n1 cols */
+   
+   /* FFTs on columns */
+   arg.fn = _fft_mfa_outer_column1;
+   _fft_mfa_run(&arg, n1);
       
    /* second half matrix fourier FFT : n2 rows, n1 cols */
-   ii += 2*n;
 
    /* FFTs on columns */
-
-#pragma omp parallel for private(i, j, k)
-   for (i = 0; i < n1; i++)
-   {   
-#if HAVE_OPENMP
-      k = omp_get_thread_num();
-#endif
-      /*
-         FFT of length n2 on column i, applying z^{r*i} for rows going up in steps 
-         of 1 starting at row 0, where z => w bits
-      */
-      
-      fft_truncate1_twiddle(ii + i, n1, n2/2, w*n1, t1 + k, t2 + k, w, 0, i, 1, trunc2);
-      for (j = 0; j < n2; j++)
-      {
-         mp_size_t s = n_revbin(j, depth);
-         if (j < s) SWAP_PTRS(ii[i+j*n1], ii[i+s*n1]);
-      }
-   }
+   arg.fn = _fft_mfa_outer_column2;
+   _fft_mfa_run(&arg, n1);
 }
@@ -14,72 +14,55 @@
 #include "ulong_extras.h"
 #include "fft.h"
 
-void fft_mfa_truncate_sqrt2_inner(mp_limb_t ** ii, mp_limb_t ** jj, mp_size_t n, 
-                   mp_bitcnt_t w, mp_limb_t ** t1, mp_limb_t ** t2, 
-                  mp_limb_t ** temp, mp_size_t n1, mp_size_t trunc, mp_limb_t ** tt)
+/* forward FFTs, pointwise products and inverse FFT on row i */
+static void _fft_mfa_inner_row(mp_limb_t ** ii, mp_limb_t ** jj,
+                      const fft_mfa_arg_struct * arg, mp_size_t i, slong k)
 {
-   mp_size_t i, j, s;
-   mp_size_t n2 = (2*n)/n1;
-   mp_size_t trunc2 = (trunc - 2*n)/n1;
-   mp_size_t limbs = (n*w)/FLINT_BITS;
-   mp_bitcnt_t depth = 0;
-   mp_bitcnt_t depth2 = 0;
-   int k = 0;
-
-   while ((UWORD(1)<<depth) < n2) depth++;
-   while ((UWORD(1)<<depth2) < n1) depth2++;
-
-   ii += 2*n;
-   jj += 2*n;
+   mp_size_t j, n1 = arg->n1, limbs = arg->limbs;
+   mp_bitcnt_t w2 = arg->w*arg->n2;
 
-   /* convolutions on relevant rows */
+   fft_radix2(ii + i*n1, n1/2, w2, arg->t1 + k, arg->t2 + k);
+   if (ii != jj) fft_radix2(jj + i*n1, n1/2, w2, arg->t1 + k, arg->t2 + k);
 
-#pragma omp parallel for private(s, i, j, k)
-   for (s = 0; s < trunc2; s++)
+   for (j = 0; j < n1; j++)
    {
-#if HAVE_OPENMP
-      k = omp_get_thread_num();
-#endif
+      mp_size_t t = i*n1 + j;
+      mpn_normmod_2expp1(ii[t], limbs);
+      if (ii != jj) mpn_normmod_2expp1(jj[t], limbs);
+      fft_mulmod_2expp1(ii[t], ii[t], jj[t], arg->n, arg->w, arg->tt[k]);
+   }      
+   
+   ifft_radix2(ii + i*n1, n1/2, w2, arg->t1 + k, arg->t2 + k);
+}
 
-      i = n_revbin(s, depth);
-      fft_radix2(ii + i*n1, n1/2, w*n2, t1 + k, t2 + k);
-      if (ii != jj) fft_radix2(jj + i*n1, n1/2, w*n2, t1 + k, t2 + k);
-      
-      for (j = 0; j < n1; j++)
-      {
-         mp_size_t t = i*n1 + j;
-         mpn_normmod_2expp1(ii[t], limbs);
-         if (ii != jj) mpn_normmod_2expp1(jj[t], limbs);
-         fft_mulmod_2expp1(ii[t], ii[t], jj[t], n, w, tt[k]);
-      }      
-      
-      ifft_radix2(ii + i*n1, n1/2, w*n2, t1 + k, t2 + k);
-   }
+/* convolutions on relevant rows of the second half */
+static void _fft_mfa_inner_row2(const fft_mfa_arg_struct * arg,
+                                                     mp_size_t s, slong k)
+{
+   _fft_mfa_inner_row(arg->ii + 2*arg->n, arg->jj + 2*arg->n, arg,
+                                           n_revbin(s, arg->depth), k);
+}
 
-   ii -= 2*n;
-   jj -= 2*n;
+/* convolutions on rows of the first half */
+static void _fft_mfa_inner_row1(const fft_mfa_arg_struct * arg,
+                                                     mp_size_t i, slong k)
+{
+   _fft_mfa_inner_row(arg->ii, arg->jj, arg, i, k);
+}
 
-   /* convolutions on rows */
+void fft_mfa_truncate_sqrt2_inner(mp_limb_t ** ii, mp_limb_t ** jj, mp_size_t n, 
+                   mp_bitcnt_t w, mp_limb_t ** t1, mp_limb_t ** t2, 
+                  mp_limb_t ** temp, mp_size_t n1, mp_size_t trunc, mp_limb_t ** tt)
+{
+   fft_mfa_arg_struct arg;
 
-#pragma omp parallel for private(i, j, k)
-   for (i = 0; i < n2; i++)
-   {
-#if HAVE_OPENMP
-      k = omp_get_thread_num();
-#endif
+   _fft_mfa_arg_init(&arg, ii, jj, n, w, t1, t2, temp, tt, n1, trunc);
 
-      fft_radix2(ii + i*n1, n1/2, w*n2, t1 + k, t2 + k);
-      if (ii != jj) fft_radix2(jj + i*n1, n1/2, w*n2, t1 + k, t2 + k);
+   /* convolutions on relevant rows */
+   arg.fn = _fft_mfa_inner_row2;
+   _fft_mfa_run(&arg, arg.trunc2);
 
-      for (j = 0; j < n1; j++)
-      {
-         mp_size_t t = i*n1 + j;
-         mpn_normmod_2expp1(ii[t], limbs);
-         if (ii != jj) mpn_normmod_2expp1(jj[t], limbs);
-         fft_mulmod_2expp1(ii[t], ii[t], jj[t], n, w, tt[k]);
-      }      
-      
-      ifft_radix2(ii + i*n1, n1/2, w*n2, t1 + k, t2 + k);
-   }
+   /* convolutions on rows */
+   arg.fn = _fft_mfa_inner_row1;
+   _fft_mfa_run(&arg, arg.n2);
 }
-
@@ -245,119 +245,123 @@ void ifft_mfa_truncate_sqrt2(mp_limb_t ** ii, mp_size_t n, mp_bitcnt_t w,
    }
 }
 
-void ifft_mfa_truncate_sqrt2_outer(mp_limb_t ** ii, mp_size_t n, mp_bitcnt_t w, 
-   mp_limb_t ** t1, mp_limb_t ** t2, mp_limb_t ** temp, mp_size_t n1, mp_size_t trunc)
+/* first half columns: twiddled IFFT on column i */
+static void _ifft_mfa_outer_column1(const fft_mfa_arg_struct * arg,
+                                                     mp_size_t i, slong k)
 {
-   mp_size_t i, j;
-   mp_size_t n2 = (2*n)/n1;
-   mp_size_t trunc2 = (trunc - 2*n)/n1;
-   mp_bitcnt_t depth = 0;
-   mp_bitcnt_t depth2 = 0;
-   mp_bitcnt_t limbs = (w*n)/FLINT_BITS;
-   int k = 0;
-  
-   while ((UWORD(1)<<depth) < n2) depth++;
-   while ((UWORD(1)<<depth2) < n1) depth2++;
-
-   /* first half mfa IFFT : n2 rows, n1 cols */
-   
-   /* column IFFTs */
-#pragma omp parallel for private(i, j, k)
-   for (i = 0; i < n1; i++)
-   {   
-#if HAVE_OPENMP
-      k = omp_get_thread_num();
-#endif
+   mp_limb_t ** ii = arg->ii;
+   mp_size_t j, n1 = arg->n1, n2 = arg->n2;
 
-      for (j = 0; j < n2; j++)
-      {
-         mp_size_t s = n_revbin(j, depth);
-         if (j < s) SWAP_PTRS(ii[i+j*n1], ii[i+s*n1]);
-      }
-      
-      /*
-         IFFT of length n2 on column i, applying z^{r*i} for rows going up in steps 
-         of 1 starting at row 0, where z => w bits
-      */
-      ifft_radix2_twiddle(ii + i, n1, n2/2, w*n1, t1 + k, t2 + k, w, 0, i, 1);
+   for (j = 0; j < n2; j++)
+   {
+      mp_size_t s = n_revbin(j, arg->depth);
+      if (j < s) SWAP_PTRS(ii[i+j*n1], ii[i+s*n1]);
    }
    
-   /* second half IFFT : n2 rows, n1 cols */
-   ii += 2*n;
-
-   /* column IFFTs with relevant sqrt2 layer butterflies combined */
-
-#pragma omp parallel for private(i, j, k)
-   for (i = 0; i < n1; i++)
-   {   
-#if HAVE_OPENMP
-      k = omp_get_thread_num();
-#endif
+   /*
+      IFFT of length n2 on column i, applying z^{r*i} for rows going up in steps 
+      of 1 starting at row 0, where z => w bits
+   */
+   ifft_radix2_twiddle(ii + i, n1, n2/2, arg->w*n1, arg->t1 + k, arg->t2 + k,
+                                                            arg->w, 0, i, 1);
+}
 
-      for (j = 0; j < trunc2; j++)
-      {
-         mp_size_t s = n_revbin(j, depth);
-         if (j < s) SWAP_PTRS(ii[i+j*n1], ii[i+s*n1]);
-      }
+/*
+   second half columns: truncated IFFT on column i, the final sqrt2 layer
+   and normalisation of column i in both halves
+*/
+static void _ifft_mfa_outer_column2(const fft_mfa_arg_struct * arg,
+                                                     mp_size_t i, slong k)
+{
+   mp_limb_t ** ii = arg->ii + 2*arg->n;
+   mp_size_t j, n = arg->n, n1 = arg->n1, n2 = arg->n2;
+   mp_size_t trunc = arg->trunc, trunc2 = arg->trunc2, limbs = arg->limbs;
+   mp_bitcnt_t w = arg->w, depth = arg->depth, depth2 = arg->depth2;
+   mp_limb_t ** t1 = arg->t1, ** t2 = arg->t2, ** temp = arg->temp;
 
-      for ( ; j < n2; j++)
-      {
-         mp_size_t u = i + j*n1;
-         if (w & 1)
-         {
-            if (i & 1)
-               fft_adjust_sqrt2(ii[i + j*n1], ii[u - 2*n], u, limbs, w, temp[k]); 
-            else
-               fft_adjust(ii[i + j*n1], ii[u - 2*n], u/2, limbs, w); 
-         } else
-            fft_adjust(ii[i + j*n1], ii[u - 2*n], u, limbs, w/2);
-      }
+   for (j = 0; j < trunc2; j++)
+   {
+      mp_size_t s = n_revbin(j, depth);
+      if (j < s) SWAP_PTRS(ii[i+j*n1], ii[i+s*n1]);
+   }
 
-      /* 
-         IFFT of length n2 on column i, applying z^{r*i} for rows going up in steps 
-         of 1 starting at row 0, where z => w bits
-      */
-      ifft_truncate1_twiddle(ii + i, n1, n2/2, w*n1, t1 + k, t2 + k, w, 0, i, 1, trunc2);
-      
-      /* relevant components of final sqrt2 layer of IFFT */
+   for ( ; j < n2; j++)
+   {
+      mp_size_t u = i + j*n1;
       if (w & 1)
       {
-         for (j = i; j < trunc - 2*n; j+=n1) 
-         {   
-            if (j & 1)
-               ifft_butterfly_sqrt2(t1[k], t2[k], ii[j - 2*n], ii[j], j, limbs, w, temp[k]); 
-            else
-               ifft_butterfly(t1[k], t2[k], ii[j - 2*n], ii[j], j/2, limbs, w);
-
-            SWAP_PTRS(ii[j-2*n], t1[k]);
-            SWAP_PTRS(ii[j],     t2[k]);
-         }
+         if (i & 1)
+            fft_adjust_sqrt2(ii[i + j*n1], ii[u - 2*n], u, limbs, w, temp[k]); 
+         else
+            fft_adjust(ii[i + j*n1], ii[u - 2*n], u/2, limbs, w); 
       } else
-      {
-         for (j = i; j < trunc - 2*n; j+=n1) 
-         {   
-            ifft_butterfly(t1[k], t2[k], ii[j - 2*n], ii[j], j, limbs, w/2);
-   
-            SWAP_PTRS(ii[j-2*n], t1[k]);
-            SWAP_PTRS(ii[j],     t2[k]);
-         }
-      }
+         fft_adjust(ii[i + j*n1], ii[u - 2*n], u, limbs, w/2);
+   }
 
-      for (j = trunc + i - 2*n; j < 2*n; j+=n1)
-           mpn_add_n(ii[j - 2*n], ii[j - 2*n], ii[j - 2*n], limbs + 1);
+   /* 
+      IFFT of length n2 on column i, applying z^{r*i} for rows going up in steps 
+      of 1 starting at row 0, where z => w bits
+   */
+   ifft_truncate1_twiddle(ii + i, n1, n2/2, w*n1, t1 + k, t2 + k, w, 0, i, 1, trunc2);
+   
+   /* relevant components of final sqrt2 layer of IFFT */
+   if (w & 1)
+   {
+      for (j = i; j < trunc - 2*n; j+=n1) 
+      {   
+         if (j & 1)
+            ifft_butterfly_sqrt2(t1[k], t2[k], ii[j - 2*n], ii[j], j, limbs, w, temp[k]); 
+         else
+            ifft_butterfly(t1[k], t2[k], ii[j - 2*n], ii[j], j/2, limbs, w);
 
-      for (j = 0; j < trunc2; j++)
-      {
-         mp_size_t t = j*n1 + i;
-         mpn_div_2expmod_2expp1(ii[t], ii[t], limbs, depth + depth2 + 1);
-         mpn_normmod_2expp1(ii[t], limbs);
+         SWAP_PTRS(ii[j-2*n], t1[k]);
+         SWAP_PTRS(ii[j],     t2[k]);
       }
+   } else
+   {
+      for (j = i; j < trunc - 2*n; j+=n1) 
+      {   
+         ifft_butterfly(t1[k], t2[k], ii[j - 2*n], ii[j], j, limbs, w/2);
 
-      for (j = 0; j < n2; j++)
-      {
-         mp_size_t t = j*n1 + i - 2*n;
-         mpn_div_2expmod_2expp1(ii[t], ii[t], limbs, depth + depth2 + 1);
-         mpn_normmod_2expp1(ii[t], limbs);
+         SWAP_PTRS(ii[j-2*n], t1[k]);
+         SWAP_PTRS(ii[j],     t2[k]);
       }
    }
+
+   for (j = trunc + i - 2*n; j < 2*n; j+=n1)
+        mpn_add_n(ii[j - 2*n], ii[j - 2*n], ii[j - 2*n], limbs + 1);
+
+   for (j = 0; j < trunc2; j++)
+   {
+      mp_size_t t = j*n1 + i;
+      mpn_div_2expmod_2expp1(ii[t], ii[t], limbs, depth + depth2 + 1);
+      mpn_normmod_2expp1(ii[t], limbs);
+   }
+
+   for (j = 0; j < n2; j++)
+   {
+      mp_size_t t = j*n1 + i - 2*n;
+      mpn_div_2expmod_2expp1(ii[t], ii[t], limbs, depth + depth2 + 1);
+      mpn_normmod_2expp1(ii[t], limbs);
+   }
+}
+
+void ifft_mfa_truncate_sqrt2_outer(mp_limb_t ** ii, mp_size_t n, mp_bitcnt_t w, 
+   mp_limb_t ** t1, mp_limb_t ** t2, mp_limb_t ** temp, mp_size_t n1, mp_size_t trunc)
+{
+   fft_mfa_arg_struct arg;
+
+   _fft_mfa_arg_init(&arg, ii, ii, n, w, t1, t2, temp, NULL, n1, trunc);
+
+   /* first half mfa IFFT : n2 rows, n1 cols */
+   
+   /* column IFFTs */
+   arg.fn = _ifft_mfa_outer_column1;
+   _fft_mfa_run(&arg, n1);
+   
+   /* second half IFFT : n2 rows, n1 cols */
+
+   /* column IFFTs with relevant sqrt2 layer butterflies combined */
+   arg.fn = _ifft_mfa_outer_column2;
+   _fft_mfa_run(&arg, n1);
 }
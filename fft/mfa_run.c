@@ -0,0 +1,135 @@
+/*
+    Copyright (C) 2026 agent
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include <pthread.h>
+#include "gmp.h"
+#include "flint.h"
+#include "fft.h"
+
+slong fft_mfa_num_threads(void)
+{
+#if HAVE_OPENMP
+   return omp_get_max_threads();
+#else
+   return flint_get_num_threads();
+#endif
+}
+
+void _fft_mfa_arg_init(fft_mfa_arg_struct * arg, mp_limb_t ** ii,
+          mp_limb_t ** jj, mp_size_t n, mp_bitcnt_t w, mp_limb_t ** t1,
+          mp_limb_t ** t2, mp_limb_t ** temp, mp_limb_t ** tt, mp_size_t n1,
+                                                              mp_size_t trunc)
+{
+   arg->ii = ii;
+   arg->jj = jj;
+   arg->t1 = t1;
+   arg->t2 = t2;
+   arg->temp = temp;
+   arg->tt = tt;
+   arg->n = n;
+   arg->w = w;
+   arg->n1 = n1;
+   arg->n2 = (2*n)/n1;
+   arg->trunc = trunc;
+   arg->trunc2 = (trunc - 2*n)/n1;
+   arg->limbs = (n*w)/FLINT_BITS;
+
+   arg->depth = 0;
+   arg->depth2 = 0;
+   while ((UWORD(1)<<arg->depth) < arg->n2) arg->depth++;
+   while ((UWORD(1)<<arg->depth2) < n1) arg->depth2++;
+
+   arg->fn = NULL;
+}
+
+#if !HAVE_OPENMP
+
+typedef struct
+{
+   const fft_mfa_arg_struct * arg;
+   mp_size_t len;
+   mp_size_t * next;    /* next unclaimed row or column */
+   slong k;             /* index of the temporaries of this thread */
+   pthread_mutex_t * mutex;
+}
+fft_mfa_worker_arg_t;
+
+void * _fft_mfa_worker(void * arg_ptr)
+{
+   fft_mfa_worker_arg_t warg = *((fft_mfa_worker_arg_t *) arg_ptr);
+   mp_size_t i;
+
+   while (1)
+   {
+      pthread_mutex_lock(warg.mutex);
+      i = *warg.next;
+      *warg.next = i + 1;
+      pthread_mutex_unlock(warg.mutex);
+
+      if (i >= warg.len)
+         break;
+
+      warg.arg->fn(warg.arg, i, warg.k);
+   }
+
+   return NULL;
+}
+
+#endif
+
+/*
+   Applies arg->fn to every row or column 0 <= i < len. Each call only
+   touches its own row or column and the temporaries of its thread, so the
+   result does not depend on the number of threads or the order in which
+   rows and columns are claimed.
+*/
+void _fft_mfa_run(const fft_mfa_arg_struct * arg, mp_size_t len)
+{
+   mp_size_t i;
+#if HAVE_OPENMP
+
+#pragma omp parallel for private(i)
+   for (i = 0; i < len; i++)
+      arg->fn(arg, i, omp_get_thread_num());
+#else
+   slong k, num_threads = FLINT_MIN(flint_get_num_threads(), len);
+   fft_mfa_worker_arg_t * args;
+   pthread_mutex_t mutex;
+   mp_size_t next = 0;
+
+   if (num_threads <= 1)
+   {
+      for (i = 0; i < len; i++)
+         arg->fn(arg, i, 0);
+
+      return;
+   }
+
+   args = flint_malloc(sizeof(fft_mfa_worker_arg_t)*num_threads);
+
+   pthread_mutex_init(&mutex, NULL);
+
+   for (k = 0; k < num_threads; k++)
+   {
+      args[k].arg = arg;
+      args[k].len = len;
+      args[k].next = &next;
+      args[k].k = k;
+      args[k].mutex = &mutex;
+   }
+
+   flint_parallel_do(_fft_mfa_worker,
+                            args, sizeof(fft_mfa_worker_arg_t), num_threads);
+
+   pthread_mutex_destroy(&mutex);
+   flint_free(args);
+#endif
+}
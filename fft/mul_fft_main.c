@@ -13,13 +13,11 @@
 #include "flint.h"
 #include "fft.h"
 #include "ulong_extras.h"
-#include "fft_tuning.h"
-
-static int fft_tuning_table[5][2] = FFT_TAB;
 
 void flint_mpn_mul_fft_main(mp_ptr r1, mp_srcptr i1, mp_size_t n1, 
                         mp_srcptr i2, mp_size_t n2)
 {
+   const fft_tuning_struct * tab = _fft_tuning_active();
    mp_size_t off, depth = 6;
    mp_size_t w = 1;
    mp_size_t n = ((mp_size_t) 1 << depth);
@@ -54,7 +52,7 @@ void flint_mpn_mul_fft_main(mp_ptr r1, mp_srcptr i1, mp_size_t n1,
    {
       mp_size_t wadj = 1;
       
-      off = fft_tuning_table[depth - 6][w - 1]; /* adjust n and w */
+      off = tab->fft_tab[depth - 6][w - 1]; /* adjust n and w */
       depth -= off;
       n = ((mp_size_t) 1 << depth);
       w *= ((mp_size_t) 1 << (2*off));
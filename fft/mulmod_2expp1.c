@@ -14,11 +14,8 @@
 #include "fft.h"
 #include "longlong.h"
 #include "ulong_extras.h"
-#include "fft_tuning.h"
 #include "mpn_extras.h"
 
-static mp_size_t mulmod_2expp1_table_n[FFT_N_NUM] = MULMOD_TAB;
-
 void fft_naive_convolution_1(mp_limb_t * r, mp_limb_t * ii, mp_limb_t * jj, mp_size_t m)
 {
    mp_size_t i, j;
@@ -169,6 +166,7 @@ void fft_mulmod_2expp1(mp_limb_t * r, mp_limb_t * i1, mp_limb_t * i2,
    mp_bitcnt_t depth1, depth = 1;
 
    mp_size_t w1, off;
+   const fft_tuning_struct * tab = _fft_tuning_active();
 
    mp_limb_t c = 2*i1[limbs] + i2[limbs];
       
@@ -184,7 +182,7 @@ void fft_mulmod_2expp1(mp_limb_t * r, mp_limb_t * i1, mp_limb_t * i2,
       return;
    }
 
-   if (limbs <= FFT_MULMOD_2EXPP1_CUTOFF) 
+   if (limbs <= tab->mulmod_cutoff)
    {
       r[limbs] = flint_mpn_mulmod_2expp1_basecase(r, i1, i2, c, bits, tt);
       return;
@@ -192,8 +190,8 @@ void fft_mulmod_2expp1(mp_limb_t * r, mp_limb_t * i1, mp_limb_t * i2,
    
    while ((UWORD(1)<<depth) < bits) depth++;
    
-   if (depth < 12) off = mulmod_2expp1_table_n[0];
-   else off = mulmod_2expp1_table_n[FLINT_MIN(depth, FFT_N_NUM + 11) - 12];
+   if (depth < 12) off = tab->mulmod_tab[0];
+   else off = tab->mulmod_tab[FLINT_MIN(depth, tab->mulmod_num + 11) - 12];
    depth1 = depth/2 - off;
    
    w1 = bits/(UWORD(1)<<(2*depth1));
@@ -206,21 +204,22 @@ slong fft_adjust_limbs(mp_size_t limbs)
    mp_size_t bits1 = limbs*FLINT_BITS, bits2;
    mp_size_t depth = 1, limbs2, depth1 = 1, depth2 = 1, adj;
    mp_size_t off1, off2;
+   const fft_tuning_struct * tab = _fft_tuning_active();
 
-   if (limbs <= FFT_MULMOD_2EXPP1_CUTOFF) return limbs;
+   if (limbs <= tab->mulmod_cutoff) return limbs;
          
    depth = FLINT_CLOG2(limbs);
    limbs2 = (WORD(1)<<depth); /* within a factor of 2 of limbs */
    bits2 = limbs2*FLINT_BITS;
 
    depth1 = FLINT_CLOG2(bits1);
-   if (depth1 < 12) off1 = mulmod_2expp1_table_n[0];
-   else off1 = mulmod_2expp1_table_n[FLINT_MIN(depth1, FFT_N_NUM + 11) - 12];
+   if (depth1 < 12) off1 = tab->mulmod_tab[0];
+   else off1 = tab->mulmod_tab[FLINT_MIN(depth1, tab->mulmod_num + 11) - 12];
    depth1 = depth1/2 - off1;
    
    depth2 = FLINT_CLOG2(bits2);
-   if (depth2 < 12) off2 = mulmod_2expp1_table_n[0];
-   else off2 = mulmod_2expp1_table_n[FLINT_MIN(depth2, FFT_N_NUM + 11) - 12];
+   if (depth2 < 12) off2 = tab->mulmod_tab[0];
+   else off2 = tab->mulmod_tab[FLINT_MIN(depth2, tab->mulmod_num + 11) - 12];
    depth2 = depth2/2 - off2;
    
    depth1 = FLINT_MAX(depth1, depth2);
@@ -50,7 +50,9 @@ main(void)
             random_fermat(i2, state, int_limbs);
             
             mpn_mul(r2, i1, int_limbs, i2, int_limbs);
+            flint_set_num_threads(1 + n_randint(state, 6));
             mul_mfa_truncate_sqrt2(r1, i1, int_limbs, i2, int_limbs, depth, w);
+            flint_set_num_threads(1);
             
             for (j = 0; j < 2*int_limbs; j++)
             {
@@ -85,7 +87,9 @@ main(void)
             random_fermat(i1, state, int_limbs);
             
             mpn_mul(r2, i1, int_limbs, i1, int_limbs);
+            flint_set_num_threads(1 + n_randint(state, 6));
             mul_mfa_truncate_sqrt2(r1, i1, int_limbs, i1, int_limbs, depth, w);
+            flint_set_num_threads(1);
             
             for (j = 0; j < 2*int_limbs; j++)
             {
@@ -0,0 +1,188 @@
+/*
+    Copyright (C) 2026 agent
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <gmp.h>
+#include "flint.h"
+#include "ulong_extras.h"
+#include "fft.h"
+
+#define TUNING_FILE "t-tuning.tmp"
+
+int tuning_equal(const fft_tuning_t a, const fft_tuning_t b)
+{
+   slong i;
+
+   for (i = 0; i < 5; i++)
+   {
+      if (a->fft_tab[i][0] != b->fft_tab[i][0] ||
+          a->fft_tab[i][1] != b->fft_tab[i][1])
+         return 0;
+   }
+
+   if (a->mulmod_num != b->mulmod_num || a->mulmod_cutoff != b->mulmod_cutoff)
+      return 0;
+
+   for (i = 0; i < a->mulmod_num; i++)
+   {
+      if (a->mulmod_tab[i] != b->mulmod_tab[i])
+         return 0;
+   }
+
+   return 1;
+}
+
+/* checks flint_mpn_mul_fft_main against mpn_mul with the active table */
+void check_mul(flint_rand_t state, const char * descr)
+{
+   mp_size_t n1, n2, j;
+   mp_limb_t * i1, * i2, * r1, * r2;
+
+   n2 = 100 + n_randint(state, 5000);
+   n1 = n2 + n_randint(state, 5000);
+
+   i1 = flint_malloc(3*(n1 + n2)*sizeof(mp_limb_t));
+   i2 = i1 + n1;
+   r1 = i2 + n2;
+   r2 = r1 + n1 + n2;
+
+   flint_mpn_urandomb(i1, state->gmp_state, n1*FLINT_BITS);
+   flint_mpn_urandomb(i2, state->gmp_state, n2*FLINT_BITS);
+
+   mpn_mul(r2, i1, n1, i2, n2);
+   flint_mpn_mul_fft_main(r1, i1, n1, i2, n2);
+
+   for (j = 0; j < n1 + n2; j++)
+   {
+      if (r1[j] != r2[j])
+      {
+         flint_printf("FAIL (%s):\n", descr);
+         flint_printf("n1 = %wd, n2 = %wd, j = %wd\n", n1, n2, j);
+         abort();
+      }
+   }
+
+   flint_free(i1);
+}
+
+int
+main(void)
+{
+   fft_tuning_t def, tab, tab2;
+   FILE * file;
+   slong i, iter;
+
+   FLINT_TEST_INIT(state);
+
+   flint_printf("tuning....");
+   fflush(stdout);
+
+   _flint_rand_init_gmp(state);
+
+   fft_tuning_init_default(def);
+   fft_tuning_get(tab);
+
+   if (!fft_tuning_is_valid(def) || !tuning_equal(def, tab))
+   {
+      flint_printf("FAIL (default table)\n");
+      abort();
+   }
+
+   /* random valid tables round trip through a file and give correct products */
+   for (iter = 0; iter < 10 * flint_test_multiplier(); iter++)
+   {
+      for (i = 0; i < 5; i++)
+      {
+         tab->fft_tab[i][0] = n_randint(state, 5);
+         tab->fft_tab[i][1] = n_randint(state, 5);
+      }
+
+      tab->mulmod_num = 1 + n_randint(state, FFT_TUNING_MULMOD_MAX);
+      for (i = 0; i < tab->mulmod_num; i++)
+         tab->mulmod_tab[i] = n_randint(state, 5);
+
+      tab->mulmod_cutoff = (WORD(1) << 11)/FLINT_BITS + n_randint(state, 300);
+
+      if (!fft_tuning_write(TUNING_FILE, tab) ||
+          !fft_tuning_read(tab2, TUNING_FILE) || !tuning_equal(tab, tab2))
+      {
+         flint_printf("FAIL (write/read)\n");
+         abort();
+      }
+
+      if (!fft_tuning_set(tab2))
+      {
+         flint_printf("FAIL (set)\n");
+         abort();
+      }
+
+      fft_tuning_get(tab);
+      if (!tuning_equal(tab, tab2))
+      {
+         flint_printf("FAIL (get)\n");
+         abort();
+      }
+
+      check_mul(state, "random table");
+   }
+
+   /* invalid tables and files are rejected */
+   tab->mulmod_cutoff = 0;
+   if (fft_tuning_is_valid(tab) || fft_tuning_set(tab))
+   {
+      flint_printf("FAIL (invalid table)\n");
+      abort();
+   }
+
+   file = fopen(TUNING_FILE, "w");
+   fputs("flint-fft-tuning 0 0\n", file);
+   fclose(file);
+
+   if (fft_tuning_read(tab, TUNING_FILE))
+   {
+      flint_printf("FAIL (bad version)\n");
+      abort();
+   }
+
+   remove(TUNING_FILE);
+
+   if (fft_tuning_read(tab, TUNING_FILE))
+   {
+      flint_printf("FAIL (missing file)\n");
+      abort();
+   }
+
+   /* a measured table is valid and gives correct products */
+   fft_tuning_tune(tab);
+
+   if (!fft_tuning_set(tab))
+   {
+      flint_printf("FAIL (tuned table)\n");
+      abort();
+   }
+
+   check_mul(state, "tuned table");
+
+   fft_tuning_reset();
+   fft_tuning_get(tab);
+
+   if (!tuning_equal(def, tab))
+   {
+      flint_printf("FAIL (reset)\n");
+      abort();
+   }
+
+   FLINT_TEST_CLEANUP(state);
+
+   flint_printf("PASS\n");
+   return 0;
+}
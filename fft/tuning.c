@@ -0,0 +1,244 @@
+/*
+    Copyright (C) 2026 agent
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#define ulong ulongxx /* interferes with system includes */
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#undef ulong
+#include <gmp.h>
+#define ulong mp_limb_t
+#include "flint.h"
+#include "fft.h"
+#include "fft_tuning.h"
+#if HAVE_PTHREAD
+#include <pthread.h>
+#endif
+
+/* the table used by flint_mpn_mul_fft_main and fft_mulmod_2expp1 */
+static fft_tuning_struct fft_tuning_active =
+   { FFT_TAB, MULMOD_TAB, FFT_N_NUM, FFT_MULMOD_2EXPP1_CUTOFF };
+
+/* set once the table named by FLINT_FFT_TUNING has been looked at */
+static volatile int fft_tuning_loaded = 0;
+
+/* set while this thread is benchmarking, which uses the built in table */
+static FLINT_TLS_PREFIX int fft_tuning_busy = 0;
+
+#if HAVE_PTHREAD
+static pthread_mutex_t fft_tuning_lock = PTHREAD_MUTEX_INITIALIZER;
+#endif
+
+void fft_tuning_init_default(fft_tuning_t tab)
+{
+   static const int fft_tab[5][2] = FFT_TAB;
+   static const mp_size_t mulmod_tab[FFT_N_NUM] = MULMOD_TAB;
+   slong i;
+
+   for (i = 0; i < 5; i++)
+   {
+      tab->fft_tab[i][0] = fft_tab[i][0];
+      tab->fft_tab[i][1] = fft_tab[i][1];
+   }
+
+   for (i = 0; i < FFT_TUNING_MULMOD_MAX; i++)
+      tab->mulmod_tab[i] = mulmod_tab[FLINT_MIN(i, FFT_N_NUM - 1)];
+
+   tab->mulmod_num = FFT_N_NUM;
+   tab->mulmod_cutoff = FFT_MULMOD_2EXPP1_CUTOFF;
+}
+
+int fft_tuning_is_valid(const fft_tuning_t tab)
+{
+   slong i;
+
+   for (i = 0; i < 5; i++)
+   {
+      if (tab->fft_tab[i][0] < 0 || tab->fft_tab[i][0] > 4 ||
+          tab->fft_tab[i][1] < 0 || tab->fft_tab[i][1] > 4)
+         return 0;
+   }
+
+   if (tab->mulmod_num < 1 || tab->mulmod_num > FFT_TUNING_MULMOD_MAX)
+      return 0;
+
+   for (i = 0; i < tab->mulmod_num; i++)
+   {
+      if (tab->mulmod_tab[i] < 0 || tab->mulmod_tab[i] > 4)
+         return 0;
+   }
+
+   /* the FFT is only set up for at least 2^12 bit coefficients */
+   return tab->mulmod_cutoff >= (WORD(1) << 11)/FLINT_BITS;
+}
+
+static void _fft_tuning_load(void)
+{
+   const char * filename;
+   fft_tuning_t tab;
+
+#if HAVE_PTHREAD
+   pthread_mutex_lock(&fft_tuning_lock);
+#endif
+
+   if (!fft_tuning_loaded)
+   {
+      filename = getenv("FLINT_FFT_TUNING");
+
+      if (filename != NULL && filename[0] != '\0')
+      {
+         fft_tuning_busy = 1;
+
+         if (!fft_tuning_read(tab, filename))
+         {
+            fft_tuning_tune(tab);
+            fft_tuning_write(filename, tab);
+         }
+
+         fft_tuning_active = *tab;
+         fft_tuning_busy = 0;
+      }
+
+      fft_tuning_loaded = 1;
+   }
+
+#if HAVE_PTHREAD
+   pthread_mutex_unlock(&fft_tuning_lock);
+#endif
+}
+
+const fft_tuning_struct * _fft_tuning_active(void)
+{
+   if (!fft_tuning_loaded && !fft_tuning_busy)
+      _fft_tuning_load();
+
+   return &fft_tuning_active;
+}
+
+void fft_tuning_get(fft_tuning_t tab)
+{
+   *tab = *_fft_tuning_active();
+}
+
+int fft_tuning_set(const fft_tuning_t tab)
+{
+   if (!fft_tuning_is_valid(tab))
+      return 0;
+
+#if HAVE_PTHREAD
+   pthread_mutex_lock(&fft_tuning_lock);
+#endif
+
+   fft_tuning_active = *tab;
+   fft_tuning_loaded = 1;
+
+#if HAVE_PTHREAD
+   pthread_mutex_unlock(&fft_tuning_lock);
+#endif
+
+   return 1;
+}
+
+void fft_tuning_reset(void)
+{
+   fft_tuning_t tab;
+
+   fft_tuning_init_default(tab);
+   fft_tuning_set(tab);
+}
+
+int fft_tuning_write(const char * filename, const fft_tuning_t tab)
+{
+   FILE * file;
+   slong i;
+   int ok;
+
+   file = fopen(filename, "w");
+   if (file == NULL)
+      return 0;
+
+   ok = (flint_fprintf(file, "flint-fft-tuning %d %d\n",
+                                FFT_TUNING_VERSION, FLINT_BITS) > 0);
+
+   ok = ok && (fputs("fft_tab", file) >= 0);
+   for (i = 0; i < 5 && ok; i++)
+      ok = (flint_fprintf(file, " %d %d",
+                                tab->fft_tab[i][0], tab->fft_tab[i][1]) > 0);
+
+   ok = ok && (flint_fprintf(file, "\nmulmod_tab %wd", tab->mulmod_num) > 0);
+   for (i = 0; i < tab->mulmod_num && ok; i++)
+      ok = (flint_fprintf(file, " %wd", tab->mulmod_tab[i]) > 0);
+
+   ok = ok && (flint_fprintf(file, "\nmulmod_cutoff %wd\n",
+                                                tab->mulmod_cutoff) > 0);
+
+   if (fclose(file) != 0)
+      ok = 0;
+
+   return ok;
+}
+
+/* reads the next word of the file and checks that it is the given one */
+static int _fft_tuning_expect(FILE * file, const char * word)
+{
+   char buf[32];
+
+   return fscanf(file, "%31s", buf) == 1 && strcmp(buf, word) == 0;
+}
+
+int fft_tuning_read(fft_tuning_t tab, const char * filename)
+{
+   FILE * file;
+   fft_tuning_t t;
+   int version, bits, ok;
+   slong i, v;
+
+   file = fopen(filename, "r");
+   if (file == NULL)
+      return 0;
+
+   fft_tuning_init_default(t);
+
+   ok = _fft_tuning_expect(file, "flint-fft-tuning")
+      && (fscanf(file, "%d %d", &version, &bits) == 2)
+      && version == FFT_TUNING_VERSION && bits == FLINT_BITS
+      && _fft_tuning_expect(file, "fft_tab");
+
+   for (i = 0; i < 5 && ok; i++)
+      ok = (fscanf(file, "%d %d", &t->fft_tab[i][0], &t->fft_tab[i][1]) == 2);
+
+   ok = ok && _fft_tuning_expect(file, "mulmod_tab")
+           && (flint_fscanf(file, "%wd", &v) == 1)
+           && v >= 1 && v <= FFT_TUNING_MULMOD_MAX;
+
+   if (ok)
+      t->mulmod_num = v;
+
+   for (i = 0; i < t->mulmod_num && ok; i++)
+   {
+      ok = (flint_fscanf(file, "%wd", &v) == 1);
+      t->mulmod_tab[i] = v;
+   }
+
+   ok = ok && _fft_tuning_expect(file, "mulmod_cutoff")
+           && (flint_fscanf(file, "%wd", &v) == 1);
+
+   if (ok)
+      t->mulmod_cutoff = v;
+
+   fclose(file);
+
+   if (!ok || !fft_tuning_is_valid(t))
+      return 0;
+
+   *tab = *t;
+   return 1;
+}
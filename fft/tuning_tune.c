@@ -0,0 +1,162 @@
+/*
+    Copyright (C) 2026 agent
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#define ulong ulongxx /* interferes with system includes */
+#include <stdlib.h>
+#include <time.h>
+#undef ulong
+#include <gmp.h>
+#define ulong mp_limb_t
+#include "flint.h"
+#include "ulong_extras.h"
+#include "fft.h"
+
+/*
+   The same measurements as fft/tune/tune-fft.c, with fewer iterations so
+   that tuning at runtime takes a second or two. Only mulmod depths up to
+   FFT_TUNING_MULMOD_DEPTH are timed; beyond that the built in table is
+   kept, capped by the last measured offset.
+*/
+void fft_tuning_tune(fft_tuning_t tab)
+{
+   mp_bitcnt_t depth, w, depth1, w1;
+   mp_size_t off, best_off, best_d, best_w, last;
+   clock_t start, end;
+   double elapsed, best = 0.0;
+   slong i, iters;
+   flint_rand_t state;
+
+   flint_randinit(state);
+   _flint_rand_init_gmp(state);
+
+   fft_tuning_init_default(tab);
+
+   for (depth = 6; depth <= 10; depth++)
+   {
+      for (w = 1; w <= 2; w++)
+      {
+         mp_size_t n = (UWORD(1) << depth);
+         mp_bitcnt_t bits1 = (n*w - (depth + 1))/2;
+         mp_bitcnt_t b1 = 2*n*bits1;
+         mp_size_t n1 = (b1 - 1)/FLINT_BITS + 1;
+         mp_limb_t * i1, * i2, * r1;
+
+         iters = 10*((mp_size_t) 1 << (3*(10 - depth)/2));
+
+         i1 = flint_malloc(4*n1*sizeof(mp_limb_t));
+         i2 = i1 + n1;
+         r1 = i2 + n1;
+
+         flint_mpn_urandomb(i1, state->gmp_state, b1);
+         flint_mpn_urandomb(i2, state->gmp_state, b1);
+
+         best_off = -1;
+
+         for (off = 0; off <= 4; off++)
+         {
+            start = clock();
+            for (i = 0; i < iters; i++)
+               mul_truncate_sqrt2(r1, i1, n1, i2, n1, depth - off,
+                                             w*((mp_size_t) 1 << (off*2)));
+            end = clock();
+
+            elapsed = ((double) (end - start)) / CLOCKS_PER_SEC;
+
+            if (best_off == -1 || elapsed < best)
+            {
+               best_off = off;
+               best = elapsed;
+            }
+         }
+
+         tab->fft_tab[depth - 6][w - 1] = best_off;
+
+         flint_free(i1);
+      }
+   }
+
+   best_d = 12;
+   best_w = 1;
+   last = 4;
+
+   for (depth = 12; depth <= FFT_TUNING_MULMOD_DEPTH; depth++)
+   {
+      for (w = 1; w <= 2; w++)
+      {
+         mp_size_t n = (UWORD(1) << depth);
+         mp_bitcnt_t bits = n*w;
+         mp_size_t int_limbs = (bits - 1)/FLINT_BITS + 1;
+         mp_limb_t * i1, * i2, * r1, * tt;
+
+         iters = 4*((mp_size_t) 1 << (FFT_TUNING_MULMOD_DEPTH - depth));
+
+         i1 = flint_malloc(6*(int_limbs + 1)*sizeof(mp_limb_t));
+         i2 = i1 + int_limbs + 1;
+         r1 = i2 + int_limbs + 1;
+         tt = r1 + 2*(int_limbs + 1);
+
+         flint_mpn_urandomb(i1, state->gmp_state, int_limbs*FLINT_BITS);
+         flint_mpn_urandomb(i2, state->gmp_state, int_limbs*FLINT_BITS);
+         i1[int_limbs] = 0;
+         i2[int_limbs] = 0;
+
+         depth1 = FLINT_CLOG2(bits)/2;
+         w1 = bits/(UWORD(1) << (2*depth1));
+
+         best_off = -1;
+
+         for (off = 0; off <= 4; off++)
+         {
+            start = clock();
+            for (i = 0; i < iters; i++)
+               _fft_mulmod_2expp1(r1, i1, i2, int_limbs, depth1 - off,
+                                             w1*((mp_size_t) 1 << (off*2)));
+            end = clock();
+
+            elapsed = ((double) (end - start)) / CLOCKS_PER_SEC;
+
+            if (best_off == -1 || elapsed < best)
+            {
+               best_off = off;
+               best = elapsed;
+            }
+         }
+
+         start = clock();
+         for (i = 0; i < iters; i++)
+            flint_mpn_mulmod_2expp1_basecase(r1, i1, i2, 0, bits, tt);
+         end = clock();
+
+         elapsed = ((double) (end - start)) / CLOCKS_PER_SEC;
+         if (elapsed < best)
+         {
+            best_d = depth + (w == 2);
+            best_w = w + 1 - 2*(w == 2);
+         }
+
+         /* the table has one entry per bit size 2^depth, 2^(depth + 1) */
+         if (2*(depth - 12) + w - 1 < FFT_TUNING_MULMOD_MAX)
+            tab->mulmod_tab[2*(depth - 12) + w - 1] = best_off;
+         last = best_off;
+
+         flint_free(i1);
+      }
+   }
+
+   for (i = 2*(FFT_TUNING_MULMOD_DEPTH - 11); i < tab->mulmod_num; i++)
+      tab->mulmod_tab[i] = FLINT_MIN(tab->mulmod_tab[i], last);
+
+   tab->mulmod_num = FLINT_MAX(tab->mulmod_num,
+                                          2*(FFT_TUNING_MULMOD_DEPTH - 11));
+   tab->mulmod_cutoff = ((mp_limb_t) 1 << best_d)*best_w/(2*FLINT_BITS);
+
+   flint_randclear(state);
+}
@@ -167,6 +167,16 @@ FLINT_DLL int flint_get_num_threads(void);
 FLINT_DLL void flint_set_num_threads(int num_threads);
 FLINT_DLL void flint_parallel_cleanup(void);
 
+typedef void (* flint_parallel_fn_t)(void * arg, slong i);
+typedef void * (* flint_thread_fn_t)(void * arg);
+
+FLINT_DLL void flint_parallel_for(slong start, slong stop, slong chunk,
+                                         flint_parallel_fn_t fn, void * arg);
+FLINT_DLL void flint_parallel_do(flint_thread_fn_t fn, void * args,
+                                                      size_t size, slong num);
+FLINT_DLL void flint_thread_pool_clear(void);
+FLINT_DLL int _flint_parallel_in_task(void);
+
 FLINT_DLL int flint_test_multiplier(void);
 
 typedef struct
@@ -58,13 +58,25 @@ typedef fmpz_preinvn_struct fmpz_preinvn_t[1];
 
 typedef struct
 {
-   int count;
+   slong count;              /* slots released after the owner cleaned up */
+   slong live;               /* slots in use, maintained by the owner */
+   __mpz_struct * volatile remote; /* slots freed by other threads */
 #if HAVE_PTHREAD
    pthread_t thread;
 #endif
-   void * address;
 } fmpz_block_header_s;
 
+typedef struct
+{
+   slong live;               /* mpz's in use by fmpz's */
+   slong blocks;             /* blocks of mpz's held */
+   slong bytes;              /* bytes held in blocks, excluding limbs */
+   slong remote_frees;       /* mpz's freed by a thread other than the owner */
+   slong trimmed;            /* empty blocks returned to the OS */
+} fmpz_alloc_stats_struct;
+
+typedef fmpz_alloc_stats_struct fmpz_alloc_stats_t[1];
+
 /* maximum positive value a small coefficient can have */
 #define COEFF_MAX ((WORD(1) << (FLINT_BITS - 2)) - WORD(1))
 
@@ -73,6 +85,9 @@ typedef struct
 
 #define COEFF_IS_MPZ(x) (((x) >> (FLINT_BITS - 2)) == WORD(1))  /* is x a pointer not an integer */
 
+/* large values of at most this many limbs are handled without GMP */
+#define FMPZ_SMALL_LIMBS 3
+
 FLINT_DLL __mpz_struct * _fmpz_new_mpz(void);
 
 FLINT_DLL void _fmpz_clear_mpz(fmpz f);
@@ -81,6 +96,8 @@ FLINT_DLL void _fmpz_cleanup_mpz_content(void);
 
 FLINT_DLL void _fmpz_cleanup(void);
 
+FLINT_DLL void fmpz_get_alloc_stats(fmpz_alloc_stats_t stats);
+
 FLINT_DLL __mpz_struct * _fmpz_promote(fmpz_t f);
 
 FLINT_DLL __mpz_struct * _fmpz_promote_val(fmpz_t f);
@@ -101,6 +118,14 @@ void _fmpz_demote(fmpz_t f)
 
 FLINT_DLL void _fmpz_demote_val(fmpz_t f);
 
+FLINT_DLL slong _fmpz_mpn_add_small(mp_ptr r, mp_srcptr x, slong xs,
+                                                  mp_srcptr y, slong ys);
+
+FLINT_DLL slong _fmpz_mpn_mul_small(mp_ptr r, mp_srcptr x, slong xs,
+                                                  mp_srcptr y, slong ys);
+
+FLINT_DLL void _fmpz_set_mpn_small(fmpz_t f, mp_srcptr r, slong rs);
+
 FLINT_DLL void _fmpz_init_readonly_mpz(fmpz_t f, const mpz_t z);
 
 FLINT_DLL void _fmpz_clear_readonly_mpz(mpz_t);
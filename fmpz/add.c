@@ -26,30 +26,60 @@ void fmpz_add(fmpz_t f, const fmpz_t g, const fmpz_t h)
             fmpz_set_si(f, c1 + c2);
         } else  /* g is small, h is large */
         {
-            __mpz_struct * mpz3 = _fmpz_promote(f);  /* g is saved and h is large */
             __mpz_struct * mpz2 = COEFF_TO_PTR(c2);
-            if (c1 < WORD(0)) flint_mpz_sub_ui(mpz3, mpz2, -c1);
-            else flint_mpz_add_ui(mpz3, mpz2, c1);
-            _fmpz_demote_val(f);  /* may have cancelled */
+
+            if (FLINT_ABS(mpz2->_mp_size) <= FMPZ_SMALL_LIMBS)
+            {
+                mp_limb_t d = FLINT_ABS(c1), r[FMPZ_SMALL_LIMBS + 1];
+                slong ds = (c1 > 0) - (c1 < 0);
+                _fmpz_set_mpn_small(f, r, _fmpz_mpn_add_small(r,
+                                      mpz2->_mp_d, mpz2->_mp_size, &d, ds));
+            } else
+            {
+                __mpz_struct * mpz3 = _fmpz_promote(f);  /* g is saved and h is large */
+                if (c1 < WORD(0)) flint_mpz_sub_ui(mpz3, mpz2, -c1);
+                else flint_mpz_add_ui(mpz3, mpz2, c1);
+                _fmpz_demote_val(f);  /* may have cancelled */
+            }
         }
     }
     else
     {
         if (!COEFF_IS_MPZ(c2))  /* g is large, h is small */
         {
-            __mpz_struct * mpz3 = _fmpz_promote(f);  /* h is saved and g is large */
             __mpz_struct * mpz1 = COEFF_TO_PTR(c1);
-            if (c2 < WORD(0)) flint_mpz_sub_ui(mpz3, mpz1, -c2);   
-            else flint_mpz_add_ui(mpz3, mpz1, c2);
-            _fmpz_demote_val(f);  /* may have cancelled */
+
+            if (FLINT_ABS(mpz1->_mp_size) <= FMPZ_SMALL_LIMBS)
+            {
+                mp_limb_t d = FLINT_ABS(c2), r[FMPZ_SMALL_LIMBS + 1];
+                slong ds = (c2 > 0) - (c2 < 0);
+                _fmpz_set_mpn_small(f, r, _fmpz_mpn_add_small(r,
+                                      mpz1->_mp_d, mpz1->_mp_size, &d, ds));
+            } else
+            {
+                __mpz_struct * mpz3 = _fmpz_promote(f);  /* h is saved and g is large */
+                if (c2 < WORD(0)) flint_mpz_sub_ui(mpz3, mpz1, -c2);
+                else flint_mpz_add_ui(mpz3, mpz1, c2);
+                _fmpz_demote_val(f);  /* may have cancelled */
+            }
         }
         else  /* g and h are large */
         {
-            __mpz_struct * mpz3 = _fmpz_promote(f);  /* aliasing means f is already large */
             __mpz_struct * mpz1 = COEFF_TO_PTR(c1);
             __mpz_struct * mpz2 = COEFF_TO_PTR(c2);
-            mpz_add(mpz3, mpz1, mpz2);
-            _fmpz_demote_val(f);  /* may have cancelled */
+
+            if (FLINT_ABS(mpz1->_mp_size) <= FMPZ_SMALL_LIMBS &&
+                FLINT_ABS(mpz2->_mp_size) <= FMPZ_SMALL_LIMBS)
+            {
+                mp_limb_t r[FMPZ_SMALL_LIMBS + 1];
+                _fmpz_set_mpn_small(f, r, _fmpz_mpn_add_small(r,
+                     mpz1->_mp_d, mpz1->_mp_size, mpz2->_mp_d, mpz2->_mp_size));
+            } else
+            {
+                __mpz_struct * mpz3 = _fmpz_promote(f);  /* aliasing means f is already large */
+                mpz_add(mpz3, mpz1, mpz2);
+                _fmpz_demote_val(f);  /* may have cancelled */
+            }
         }
     }
 }
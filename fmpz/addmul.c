@@ -38,6 +38,36 @@ void fmpz_addmul(fmpz_t f, const fmpz_t g, const fmpz_t h)
 	} 
 
 	/* both g and h are large */
+    if (FLINT_ABS(COEFF_TO_PTR(c1)->_mp_size) <= FMPZ_SMALL_LIMBS &&
+        FLINT_ABS(COEFF_TO_PTR(c2)->_mp_size) <= FMPZ_SMALL_LIMBS)
+    {
+        mp_limb_t p[2 * FMPZ_SMALL_LIMBS], r[2 * FMPZ_SMALL_LIMBS + 1], d;
+        slong ps, fs;
+        mp_srcptr fd;
+        fmpz c3 = *f;
+
+        ps = _fmpz_mpn_mul_small(p, COEFF_TO_PTR(c1)->_mp_d,
+               COEFF_TO_PTR(c1)->_mp_size, COEFF_TO_PTR(c2)->_mp_d,
+               COEFF_TO_PTR(c2)->_mp_size);
+
+        if (!COEFF_IS_MPZ(c3))
+        {
+            d = FLINT_ABS(c3);
+            fd = &d;
+            fs = (c3 > 0) - (c3 < 0);
+        } else
+        {
+            fd = COEFF_TO_PTR(c3)->_mp_d;
+            fs = COEFF_TO_PTR(c3)->_mp_size;
+        }
+
+        if (FLINT_ABS(fs) <= 2 * FMPZ_SMALL_LIMBS)
+        {
+            _fmpz_set_mpn_small(f, r, _fmpz_mpn_add_small(r, p, ps, fd, fs));
+            return;
+        }
+    }
+
     mpz_ptr = _fmpz_promote_val(f);
     mpz_addmul(mpz_ptr, COEFF_TO_PTR(c1), COEFF_TO_PTR(c2));
     _fmpz_demote_val(f);  /* cancellation may have occurred	*/
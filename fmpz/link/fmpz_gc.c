@@ -127,6 +127,15 @@ void _fmpz_cleanup(void)
 #endif
 }
 
+void fmpz_get_alloc_stats(fmpz_alloc_stats_t stats)
+{
+    stats->live = 0;
+    stats->blocks = 0;
+    stats->bytes = 0;
+    stats->remote_frees = 0;
+    stats->trimmed = 0;
+}
+
 __mpz_struct * _fmpz_promote(fmpz_t f)
 {
     if (!COEFF_IS_MPZ(*f)) /* f is small so promote it first */
@@ -28,18 +28,52 @@
 
 #define PAGES_PER_BLOCK 16
 
-/* The number of new mpz's allocated at a time */
-#define MPZ_BLOCK 64 
+/* Release an empty block once a thread caches more than this many blocks
+   worth of free mpz's */
+#define FLINT_MPZ_TRIM_BLOCKS 2
 
+/* Fold per-thread live counts into the global statistics this often */
+#define FLINT_MPZ_STATS_FLUSH 256
+
+/* Marks the remote free list of a block whose owner has cleaned up */
+#define FMPZ_BLOCK_ORPHANED ((__mpz_struct *) WORD(1))
+
+#if defined(_MSC_VER)
+#define fmpz_atomic_add(p, v) \
+    (InterlockedExchangeAdd64((volatile LONG64 *) (p), (v)) + (v))
+#define fmpz_atomic_cas_ptr(p, old, new) \
+    InterlockedCompareExchangePointer((PVOID volatile *) (p), (new), (old))
+#else
+#define fmpz_atomic_add(p, v) __sync_add_and_fetch((p), (v))
+#define fmpz_atomic_cas_ptr(p, old, new) \
+    __sync_val_compare_and_swap((p), (old), (new))
+#endif
+
+/* the thread's cache ("magazine") of free mpz's */
 FLINT_TLS_PREFIX __mpz_struct ** mpz_free_arr = NULL;
 FLINT_TLS_PREFIX ulong mpz_free_num = 0;
 FLINT_TLS_PREFIX ulong mpz_free_alloc = 0;
+
+/* the blocks owned by the thread */
+FLINT_TLS_PREFIX fmpz_block_header_s ** mpz_block_arr = NULL;
+FLINT_TLS_PREFIX ulong mpz_block_num = 0;
+FLINT_TLS_PREFIX ulong mpz_block_alloc = 0;
+
+/* change in number of live mpz's not yet added to the statistics */
+FLINT_TLS_PREFIX slong mpz_live_delta = 0;
 #pragma omp threadprivate(mpz_free_arr, mpz_free_num, mpz_free_alloc)
+#pragma omp threadprivate(mpz_block_arr, mpz_block_num, mpz_block_alloc)
+#pragma omp threadprivate(mpz_live_delta)
 
 static slong flint_page_size;
 static slong flint_mpz_structs_per_block;
 static slong flint_page_mask;
 
+static volatile slong fmpz_stats_live = 0;
+static volatile slong fmpz_stats_blocks = 0;
+static volatile slong fmpz_stats_remote_frees = 0;
+static volatile slong fmpz_stats_trimmed = 0;
+
 slong flint_get_page_size()
 {
 #if defined(__unix__)
@@ -60,94 +94,239 @@ void * flint_align_ptr(void * ptr, slong size)
     return (void *)((mask & (slong) ptr) + size);
 }
 
-__mpz_struct * _fmpz_new_mpz(void)
+static __inline__ slong _fmpz_block_bytes(void)
 {
-    if (mpz_free_num == 0) /* allocate more mpz's */
+    return sizeof(fmpz_block_header_s) + (PAGES_PER_BLOCK + 1)*flint_page_size;
+}
+
+/* the first word of each page of a block points to the block header */
+static __inline__ fmpz_block_header_s * _fmpz_mpz_block(__mpz_struct * ptr)
+{
+    return *((fmpz_block_header_s **) ((slong) ptr & flint_page_mask));
+}
+
+static __inline__ int _fmpz_block_is_owned(fmpz_block_header_s * header)
+{
+    /* only the owner sets the orphaned mark, so it can read it safely */
+#if HAVE_PTHREAD
+    return header->remote != FMPZ_BLOCK_ORPHANED
+        && pthread_equal(header->thread, pthread_self());
+#else
+    return header->remote != FMPZ_BLOCK_ORPHANED;
+#endif
+}
+
+static __inline__ void _fmpz_live_add(slong n)
+{
+    mpz_live_delta += n;
+
+    if (mpz_live_delta >= FLINT_MPZ_STATS_FLUSH
+        || mpz_live_delta <= -FLINT_MPZ_STATS_FLUSH)
+    {
+        fmpz_atomic_add(&fmpz_stats_live, mpz_live_delta);
+        mpz_live_delta = 0;
+    }
+}
+
+static void _fmpz_free_block(fmpz_block_header_s * header)
+{
+    fmpz_atomic_add(&fmpz_stats_blocks, -1);
+    flint_free(header);
+}
+
+/* account for n slots of the block being cleared for good */
+static void _fmpz_block_release(fmpz_block_header_s * header, slong n)
+{
+    if (fmpz_atomic_add(&header->count, n) == flint_mpz_structs_per_block)
+        _fmpz_free_block(header);
+}
+
+static void _fmpz_free_arr_push(__mpz_struct * ptr)
+{
+    if (mpz_free_num == mpz_free_alloc)
     {
-        void * aligned_ptr, * ptr;
+        mpz_free_alloc = FLINT_MAX(64, mpz_free_alloc * 2);
+        mpz_free_arr = flint_realloc(mpz_free_arr, mpz_free_alloc * sizeof(__mpz_struct *));
+    }
 
-        slong i, j, num, block_size, skip;
+    mpz_free_arr[mpz_free_num++] = ptr;
+}
 
-        flint_page_size = flint_get_page_size();
-        block_size = PAGES_PER_BLOCK*flint_page_size;
-        flint_page_mask = ~(flint_page_size - 1);
+static void _fmpz_new_block(void)
+{
+    void * aligned_ptr;
+    fmpz_block_header_s * header;
+    slong i, j, num, skip;
 
-        /* get new block */
-        ptr = flint_malloc(block_size + flint_page_size);
+    flint_page_size = flint_get_page_size();
+    flint_page_mask = ~(flint_page_size - 1);
 
-        /* align to page boundary */
-        aligned_ptr = flint_align_ptr(ptr, flint_page_size);
+    /* get new block, with the header in front of the first aligned page */
+    header = flint_malloc(_fmpz_block_bytes());
+    aligned_ptr = flint_align_ptr(header + 1, flint_page_size);
 
-        /* set free count to zero and determine if this is the main thread */
-        ((fmpz_block_header_s *) ptr)->count = 0;
+    header->count = 0;
+    header->live = 0;
+    header->remote = NULL;
 #if HAVE_PTHREAD
-        ((fmpz_block_header_s *) ptr)->thread = pthread_self();
+    header->thread = pthread_self();
 #endif
-        /* how many __mpz_structs worth are dedicated to header, per page */
-        skip = (sizeof(fmpz_block_header_s) - 1)/sizeof(__mpz_struct) + 1;
 
-        /* total number of number of __mpz_structs worth per page */
-        num = flint_page_size/sizeof(__mpz_struct);
+    /* how many __mpz_structs worth are dedicated to header, per page */
+    skip = (sizeof(fmpz_block_header_s *) - 1)/sizeof(__mpz_struct) + 1;
+
+    /* total number of number of __mpz_structs worth per page */
+    num = flint_page_size/sizeof(__mpz_struct);
 
-        flint_mpz_structs_per_block = PAGES_PER_BLOCK*(num - skip);
+    flint_mpz_structs_per_block = PAGES_PER_BLOCK*(num - skip);
+
+    if (mpz_free_num + flint_mpz_structs_per_block >= mpz_free_alloc)
+    {
+        mpz_free_alloc = FLINT_MAX(mpz_free_num + flint_mpz_structs_per_block, mpz_free_alloc * 2);
+        mpz_free_arr = flint_realloc(mpz_free_arr, mpz_free_alloc * sizeof(__mpz_struct *));
+    }
 
-        if (mpz_free_num  + flint_mpz_structs_per_block >= mpz_free_alloc)
+    for (i = 0; i < PAGES_PER_BLOCK; i++)
+    {
+        __mpz_struct * page_ptr = (__mpz_struct *)((slong) aligned_ptr + i*flint_page_size);
+
+        /* set pointer in each page to the block header */
+        *((fmpz_block_header_s **) page_ptr) = header;
+
+        for (j = skip; j < num; j++)
         {
-            mpz_free_alloc = FLINT_MAX(mpz_free_num + flint_mpz_structs_per_block, mpz_free_alloc * 2);
-            mpz_free_arr = flint_realloc(mpz_free_arr, mpz_free_alloc * sizeof(__mpz_struct *));
+            mpz_init2(page_ptr + j, 2*FLINT_BITS);
+
+            mpz_free_arr[mpz_free_num++] = page_ptr + j;
         }
+    }
 
-        for (i = 0; i < PAGES_PER_BLOCK; i++)
+    if (mpz_block_num == mpz_block_alloc)
+    {
+        mpz_block_alloc = FLINT_MAX(16, mpz_block_alloc * 2);
+        mpz_block_arr = flint_realloc(mpz_block_arr, mpz_block_alloc * sizeof(fmpz_block_header_s *));
+    }
+
+    mpz_block_arr[mpz_block_num++] = header;
+
+    fmpz_atomic_add(&fmpz_stats_blocks, 1);
+}
+
+/* take back the mpz's which other threads freed into our blocks */
+static void _fmpz_reclaim_remote(void)
+{
+    ulong i;
+
+    for (i = 0; i < mpz_block_num; i++)
+    {
+        fmpz_block_header_s * header = mpz_block_arr[i];
+        __mpz_struct * ptr, * next;
+
+        if (header->remote == NULL)
+            continue;
+
+        /* detach the whole list */
+        do {
+            ptr = header->remote;
+        } while (fmpz_atomic_cas_ptr(&header->remote, ptr,
+                                     (__mpz_struct *) NULL) != ptr);
+
+        for ( ; ptr != NULL; ptr = next)
         {
-            __mpz_struct * page_ptr = (__mpz_struct *)((slong) aligned_ptr + i*flint_page_size);
+            next = (__mpz_struct *) ptr->_mp_d;
+            mpz_init2(ptr, 2*FLINT_BITS);
+            header->live--;
+            _fmpz_free_arr_push(ptr);
+        }
+    }
+}
 
-            /* set pointer in each page to start of entire block */
-            ((fmpz_block_header_s *) page_ptr)->address = ptr;
+/* give an empty block back to the OS */
+static void _fmpz_trim_block(fmpz_block_header_s * header)
+{
+    ulong i, j;
 
-            for (j = skip; j < num; j++) 
-            {
-                mpz_init2(page_ptr + j, 2*FLINT_BITS);
+    for (i = j = 0; i < mpz_free_num; i++)
+    {
+        if (_fmpz_mpz_block(mpz_free_arr[i]) == header)
+            mpz_clear(mpz_free_arr[i]);
+        else
+            mpz_free_arr[j++] = mpz_free_arr[i];
+    }
 
-                mpz_free_arr[mpz_free_num++] = page_ptr + j;
-            }
+    mpz_free_num = j;
+
+    for (i = 0; i < mpz_block_num; i++)
+    {
+        if (mpz_block_arr[i] == header)
+        {
+            mpz_block_arr[i] = mpz_block_arr[--mpz_block_num];
+            break;
         }
     }
 
-    return mpz_free_arr[--mpz_free_num];
+    fmpz_atomic_add(&fmpz_stats_trimmed, 1);
+    _fmpz_free_block(header);
 }
 
-void _fmpz_clear_mpz(fmpz f)
+__mpz_struct * _fmpz_new_mpz(void)
 {
-    __mpz_struct * ptr = COEFF_TO_PTR(f);
+    __mpz_struct * ptr;
 
-    /* check free count for block is zero, else this mpz came from a thread */
-    fmpz_block_header_s * header_ptr = (fmpz_block_header_s *)((slong) ptr & flint_page_mask);
+    if (mpz_free_num == 0)
+        _fmpz_reclaim_remote();
 
-    header_ptr = (fmpz_block_header_s *) header_ptr->address;
+    if (mpz_free_num == 0) /* allocate more mpz's */
+        _fmpz_new_block();
 
-    /* clean up if this is left over from another thread */
-#if HAVE_PTHREAD
-    if (header_ptr->count != 0 || header_ptr->thread != pthread_self()) 
-#else
-    if (header_ptr->count != 0)
-#endif
-    {
-        mpz_clear(ptr);
+    ptr = mpz_free_arr[--mpz_free_num];
+    _fmpz_mpz_block(ptr)->live++;
+    _fmpz_live_add(1);
+
+    return ptr;
+}
 
-        if (++header_ptr->count == flint_mpz_structs_per_block)
-            flint_free(header_ptr);    
-    } else
+void _fmpz_clear_mpz(fmpz f)
+{
+    __mpz_struct * ptr = COEFF_TO_PTR(f);
+    fmpz_block_header_s * header = _fmpz_mpz_block(ptr);
+
+    _fmpz_live_add(-1);
+
+    if (_fmpz_block_is_owned(header))
     {
         if (ptr->_mp_alloc > FLINT_MPZ_MAX_CACHE_LIMBS)
             mpz_realloc2(ptr, 2*FLINT_BITS);
 
-        if (mpz_free_num == mpz_free_alloc)
+        _fmpz_free_arr_push(ptr);
+
+        if (--header->live == 0 && mpz_free_num >
+                      FLINT_MPZ_TRIM_BLOCKS * flint_mpz_structs_per_block)
+            _fmpz_trim_block(header);
+    }
+    else
+    {
+        /* this mpz came from another thread, or its owner has cleaned up */
+        __mpz_struct * head;
+
+        fmpz_atomic_add(&fmpz_stats_remote_frees, 1);
+        mpz_clear(ptr);
+
+        while (1)
         {
-            mpz_free_alloc = FLINT_MAX(64, mpz_free_alloc * 2);
-            mpz_free_arr = flint_realloc(mpz_free_arr, mpz_free_alloc * sizeof(__mpz_struct *));
-        }
+            head = header->remote;
+
+            if (head == FMPZ_BLOCK_ORPHANED)
+            {
+                _fmpz_block_release(header, 1);
+                break;
+            }
 
-        mpz_free_arr[mpz_free_num++] = ptr;
+            /* push onto the owner's remote free list */
+            ptr->_mp_d = (mp_ptr) head;
+            if (fmpz_atomic_cas_ptr(&header->remote, head, ptr) == head)
+                break;
+        }
     }
 }
 
@@ -155,22 +334,46 @@ void _fmpz_cleanup_mpz_content(void)
 {
     ulong i;
 
+    /* tally the slots of each block which are released for good */
+    for (i = 0; i < mpz_block_num; i++)
+        mpz_block_arr[i]->live = 0;
+
     for (i = 0; i < mpz_free_num; i++)
     {
-       fmpz_block_header_s * ptr;
+        mpz_clear(mpz_free_arr[i]);
+        _fmpz_mpz_block(mpz_free_arr[i])->live++;
+    }
+
+    mpz_free_num = 0;
 
-       mpz_clear(mpz_free_arr[i]);
+    /*
+       Orphan our blocks. The slots on the remote list have already been
+       cleared; slots still in use will be released by whoever frees them.
+    */
+    for (i = 0; i < mpz_block_num; i++)
+    {
+        fmpz_block_header_s * header = mpz_block_arr[i];
+        __mpz_struct * ptr;
+        slong n;
 
-       /* update count of cleared mpz's for block */
-       ptr = (fmpz_block_header_s *)((slong) mpz_free_arr[i] & ~(flint_page_size - 1));
+        do {
+            ptr = header->remote;
+        } while (fmpz_atomic_cas_ptr(&header->remote, ptr,
+                                     FMPZ_BLOCK_ORPHANED) != ptr);
 
-       ptr = (fmpz_block_header_s *) ptr->address;
-       
-       if (++ptr->count == flint_mpz_structs_per_block)
-          flint_free(ptr);
+        n = header->live;
+
+        for ( ; ptr != NULL; ptr = (__mpz_struct *) ptr->_mp_d)
+            n++;
+
+        if (n != 0)
+            _fmpz_block_release(header, n);
     }
 
-    mpz_free_num = mpz_free_alloc = 0;
+    mpz_block_num = 0;
+
+    fmpz_atomic_add(&fmpz_stats_live, mpz_live_delta);
+    mpz_live_delta = 0;
 }
 
 void _fmpz_cleanup(void)
@@ -178,6 +381,22 @@ void _fmpz_cleanup(void)
     _fmpz_cleanup_mpz_content();
     flint_free(mpz_free_arr);
     mpz_free_arr = NULL;
+    mpz_free_alloc = 0;
+    flint_free(mpz_block_arr);
+    mpz_block_arr = NULL;
+    mpz_block_alloc = 0;
+}
+
+void fmpz_get_alloc_stats(fmpz_alloc_stats_t stats)
+{
+    fmpz_atomic_add(&fmpz_stats_live, mpz_live_delta);
+    mpz_live_delta = 0;
+
+    stats->live = fmpz_atomic_add(&fmpz_stats_live, 0);
+    stats->blocks = fmpz_atomic_add(&fmpz_stats_blocks, 0);
+    stats->bytes = stats->blocks * _fmpz_block_bytes();
+    stats->remote_frees = fmpz_atomic_add(&fmpz_stats_remote_frees, 0);
+    stats->trimmed = fmpz_atomic_add(&fmpz_stats_trimmed, 0);
 }
 
 __mpz_struct * _fmpz_promote(fmpz_t f)
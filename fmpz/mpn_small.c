@@ -0,0 +1,150 @@
+/*
+    Copyright (C) 2026 agent
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include <gmp.h>
+#include "flint.h"
+#include "ulong_extras.h"
+#include "fmpz.h"
+
+slong _fmpz_mpn_add_small(mp_ptr r, mp_srcptr x, slong xs,
+                                                  mp_srcptr y, slong ys)
+{
+    slong xn = FLINT_ABS(xs), yn = FLINT_ABS(ys), i, n;
+    mp_limb_t cy, t;
+
+    if (xn < yn)
+    {
+        mp_srcptr p = x; x = y; y = p;
+        n = xs; xs = ys; ys = n;
+        n = xn; xn = yn; yn = n;
+    }
+
+    if ((xs ^ ys) >= WORD(0))  /* same sign, add magnitudes */
+    {
+        cy = 0;
+        for (i = 0; i < yn; i++)
+        {
+            t = x[i] + cy;
+            cy = (t < cy);
+            r[i] = t + y[i];
+            cy += (r[i] < t);
+        }
+
+        for ( ; i < xn; i++)
+        {
+            r[i] = x[i] + cy;
+            cy = (r[i] < cy);
+        }
+
+        r[xn] = cy;
+        n = xn + cy;
+    }
+    else  /* opposite signs, subtract the smaller magnitude */
+    {
+        if (xn == yn)
+        {
+            i = xn - 1;
+            while (i >= 0 && x[i] == y[i])
+                i--;
+
+            if (i < 0)
+                return 0;
+
+            if (x[i] < y[i])
+            {
+                mp_srcptr p = x; x = y; y = p;
+                xs = ys;
+            }
+
+            xn = yn = i + 1;  /* higher limbs cancel */
+        }
+
+        cy = 0;
+        for (i = 0; i < yn; i++)
+        {
+            t = x[i] - y[i];
+            r[i] = t - cy;
+            cy = (x[i] < y[i]) + (t < cy);
+        }
+
+        for ( ; i < xn; i++)
+        {
+            r[i] = x[i] - cy;
+            cy = (x[i] < cy);
+        }
+
+        n = xn;
+        while (n > 0 && r[n - 1] == 0)
+            n--;
+    }
+
+    return xs >= WORD(0) ? n : -n;
+}
+
+slong _fmpz_mpn_mul_small(mp_ptr r, mp_srcptr x, slong xs,
+                                                  mp_srcptr y, slong ys)
+{
+    slong xn = FLINT_ABS(xs), yn = FLINT_ABS(ys), i, j, n;
+    mp_limb_t cy, hi, lo;
+
+    if (xn == 0 || yn == 0)
+        return 0;
+
+    for (j = 0; j < yn; j++)
+        r[j] = 0;
+
+    for (i = 0; i < xn; i++)
+    {
+        cy = 0;
+        for (j = 0; j < yn; j++)
+        {
+            umul_ppmm(hi, lo, x[i], y[j]);
+            add_ssaaaa(hi, lo, hi, lo, UWORD(0), r[i + j]);
+            add_ssaaaa(hi, lo, hi, lo, UWORD(0), cy);
+            r[i + j] = lo;
+            cy = hi;
+        }
+        r[i + yn] = cy;
+    }
+
+    n = xn + yn;
+    if (r[n - 1] == 0)
+        n--;
+
+    return (xs ^ ys) >= WORD(0) ? n : -n;
+}
+
+void _fmpz_set_mpn_small(fmpz_t f, mp_srcptr r, slong rs)
+{
+    slong i, n = FLINT_ABS(rs);
+    __mpz_struct * z;
+
+    if (n <= 1)
+    {
+        if (n == 0)
+            fmpz_zero(f);
+        else if (rs > 0)
+            fmpz_set_ui(f, r[0]);
+        else
+            fmpz_neg_ui(f, r[0]);
+        return;
+    }
+
+    z = _fmpz_promote(f);
+
+    if (z->_mp_alloc < n)
+        mpz_realloc2(z, n * FLINT_BITS);
+
+    for (i = 0; i < n; i++)
+        z->_mp_d[i] = r[i];
+
+    z->_mp_size = rs;
+}
@@ -36,6 +36,21 @@ fmpz_mul(fmpz_t f, const fmpz_t g, const fmpz_t h)
         return;
     }
 
+    if (COEFF_IS_MPZ(c2))
+    {
+        __mpz_struct * mpz1 = COEFF_TO_PTR(c1);
+        __mpz_struct * mpz2 = COEFF_TO_PTR(c2);
+
+        if (FLINT_ABS(mpz1->_mp_size) <= FMPZ_SMALL_LIMBS &&
+            FLINT_ABS(mpz2->_mp_size) <= FMPZ_SMALL_LIMBS)
+        {
+            mp_limb_t r[2 * FMPZ_SMALL_LIMBS];
+            _fmpz_set_mpn_small(f, r, _fmpz_mpn_mul_small(r,
+                     mpz1->_mp_d, mpz1->_mp_size, mpz2->_mp_d, mpz2->_mp_size));
+            return;
+        }
+    }
+
     mpz_ptr = _fmpz_promote(f); /* h is saved, g is already large */
 
     if (!COEFF_IS_MPZ(c2))      /* g is large, h is small */
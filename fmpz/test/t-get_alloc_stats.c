@@ -0,0 +1,172 @@
+/*
+    Copyright (C) 2026 agent
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <gmp.h>
+#include "flint.h"
+#include "ulong_extras.h"
+#include "fmpz.h"
+#include "fmpz_vec.h"
+
+#if HAVE_PTHREAD
+
+typedef struct
+{
+    fmpz * vec;
+    slong start;
+    slong stop;
+    ulong bits;
+}
+alloc_stats_arg_t;
+
+/* frees the given range, allocated by another thread, then refills it */
+void *
+alloc_stats_worker(void * arg_ptr)
+{
+    alloc_stats_arg_t arg = *((alloc_stats_arg_t *) arg_ptr);
+    slong i;
+
+    for (i = arg.start; i < arg.stop; i++)
+        fmpz_zero(arg.vec + i);
+
+    for (i = arg.start; i < arg.stop; i++)
+    {
+        fmpz_one(arg.vec + i);
+        fmpz_mul_2exp(arg.vec + i, arg.vec + i, arg.bits);
+        fmpz_add_ui(arg.vec + i, arg.vec + i, i);
+    }
+
+    flint_cleanup();
+    return NULL;
+}
+
+#endif
+
+int
+main(void)
+{
+    slong iter;
+    FLINT_TEST_INIT(state);
+
+    flint_printf("get_alloc_stats....");
+    fflush(stdout);
+
+    for (iter = 0; iter < 20 * flint_test_multiplier(); iter++)
+    {
+        fmpz_alloc_stats_t s0, s1;
+        fmpz * vec;
+        fmpz_t t;
+        slong i, len;
+        ulong bits;
+
+        len = 1 + n_randint(state, 5000);
+        bits = FLINT_BITS + n_randint(state, 300);
+
+        fmpz_get_alloc_stats(s0);
+
+        vec = _fmpz_vec_init(len);
+        fmpz_init(t);
+
+        for (i = 0; i < len; i++)
+            fmpz_randbits(vec + i, state, bits);
+
+#if HAVE_PTHREAD
+        {
+            pthread_t threads[4];
+            alloc_stats_arg_t args[4];
+            slong num_threads = 1 + n_randint(state, 4);
+
+            for (i = 0; i < num_threads; i++)
+            {
+                args[i].vec = vec;
+                args[i].start = (len * i) / num_threads;
+                args[i].stop = (len * (i + 1)) / num_threads;
+                args[i].bits = bits;
+                pthread_create(&threads[i], NULL,
+                                            alloc_stats_worker, &args[i]);
+            }
+
+            for (i = 0; i < num_threads; i++)
+                pthread_join(threads[i], NULL);
+
+            for (i = 0; i < len; i++)
+            {
+                fmpz_one(t);
+                fmpz_mul_2exp(t, t, bits);
+                fmpz_add_ui(t, t, i);
+
+                if (!fmpz_equal(t, vec + i))
+                {
+                    flint_printf("FAIL (value from thread)\n");
+                    flint_printf("i = %wd\n", i);
+                    abort();
+                }
+            }
+        }
+#endif
+
+        /* everything allocated by the workers is freed here */
+        _fmpz_vec_clear(vec, len);
+        fmpz_clear(t);
+
+        fmpz_get_alloc_stats(s1);
+
+        if (s1->blocks != 0 || s0->blocks != 0)
+        {
+            if (s1->live != s0->live || s1->remote_frees < s0->remote_frees
+                || s1->bytes < 0 || s1->trimmed < s0->trimmed)
+            {
+                flint_printf("FAIL (statistics)\n");
+                flint_printf("live %wd -> %wd, remote frees %wd -> %wd\n",
+                   s0->live, s1->live, s0->remote_frees, s1->remote_frees);
+                abort();
+            }
+
+#if HAVE_PTHREAD
+            if (s1->remote_frees < s0->remote_frees + 2 * len)
+            {
+                flint_printf("FAIL (remote frees)\n");
+                flint_printf("len = %wd, remote frees %wd -> %wd\n",
+                   len, s0->remote_frees, s1->remote_frees);
+                abort();
+            }
+#endif
+        }
+    }
+
+    /* empty blocks are given back once enough are cached */
+    {
+        fmpz_alloc_stats_t s0, s1;
+        fmpz * vec;
+        slong i, len = 100000;
+
+        fmpz_get_alloc_stats(s0);
+
+        vec = _fmpz_vec_init(len);
+        for (i = 0; i < len; i++)
+            fmpz_randbits(vec + i, state, 2 * FLINT_BITS);
+        _fmpz_vec_clear(vec, len);
+
+        fmpz_get_alloc_stats(s1);
+
+        if (s0->blocks != 0 && s1->trimmed == s0->trimmed)
+        {
+            flint_printf("FAIL (trimming)\n");
+            abort();
+        }
+    }
+
+    FLINT_TEST_CLEANUP(state);
+
+    flint_printf("PASS\n");
+    return 0;
+}
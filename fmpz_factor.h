@@ -36,6 +36,21 @@ typedef struct
 
 typedef fmpz_factor_struct fmpz_factor_t[1];
 
+/* stages of the factoring pipeline, as passed to a progress callback */
+#define FMPZ_FACTOR_STAGE_TRIAL 0 /* trial division */
+#define FMPZ_FACTOR_STAGE_PROVE 1 /* primality proving of a cofactor */
+#define FMPZ_FACTOR_STAGE_RHO   2 /* Pollard-Brent rho */
+#define FMPZ_FACTOR_STAGE_PP1   3 /* Williams' p + 1 */
+#define FMPZ_FACTOR_STAGE_ECM   4 /* elliptic curve method */
+#define FMPZ_FACTOR_STAGE_QS    5 /* self initialising quadratic sieve */
+
+/*
+   Called with the stage and the cofactor n being worked on, and the amount
+   of work done out of total for that stage. Return nonzero to cancel.
+*/
+typedef int (* fmpz_factor_progress_t)(void * arg, int stage,
+                                  const fmpz_t n, slong done, slong total);
+
 /* Utility functions *********************************************************/
 
 FLINT_DLL void fmpz_factor_init(fmpz_factor_t factor);
@@ -66,8 +81,14 @@ FLINT_DLL int fmpz_factor_trial_range(fmpz_factor_t factor, const fmpz_t n,
 
 FLINT_DLL void fmpz_factor(fmpz_factor_t factor, const fmpz_t n);
 
+FLINT_DLL int fmpz_factor_progress(fmpz_factor_t factor, const fmpz_t n,
+                              fmpz_factor_progress_t progress, void * arg);
+
 FLINT_DLL void fmpz_factor_no_trial(fmpz_factor_t factor, const fmpz_t n);
 
+FLINT_DLL int fmpz_factor_no_trial_progress(fmpz_factor_t factor,
+          const fmpz_t n, fmpz_factor_progress_t progress, void * arg);
+
 FLINT_DLL void fmpz_factor_si(fmpz_factor_t factor, slong n);
 
 FLINT_DLL int fmpz_factor_pp1(fmpz_t factor, const fmpz_t n, 
@@ -107,6 +128,9 @@ FLINT_DLL void fmpz_factor_divisor_sigma(fmpz_t res, const fmpz_factor_t fac, ul
 
 /* ECM Factoring functions ***************************************************/
 
+/* ratio B2/B1 from which stage II of ECM evaluates a polynomial */
+#define FMPZ_FACTOR_ECM_FFT_CUTOFF 300
+
 typedef struct ecm_s {
 
     mp_ptr t, u, v, w;  /* temp variables */
@@ -123,6 +147,8 @@ typedef struct ecm_s {
     mp_limb_t n_size;
     mp_limb_t normbits;
 
+    volatile int * stop; /* if not NULL, the stages give up once it is set */
+
 } ecm_s;
 
 typedef ecm_s ecm_t[1];
@@ -159,9 +185,16 @@ FLINT_DLL int fmpz_factor_ecm_stage_I(mp_ptr f, const mp_limb_t *prime_array,
 FLINT_DLL int fmpz_factor_ecm_stage_II(mp_ptr f, mp_limb_t B1, mp_limb_t B2,
                                        mp_limb_t P, mp_ptr n, ecm_t ecm_inf);
 
+FLINT_DLL int fmpz_factor_ecm_stage_II_fft(mp_ptr f, mp_limb_t B1,
+                    mp_limb_t B2, mp_limb_t P, mp_ptr n, ecm_t ecm_inf);
+
 FLINT_DLL int fmpz_factor_ecm(fmpz_t f, mp_limb_t curves, mp_limb_t B1,
                         mp_limb_t B2, flint_rand_t state, const fmpz_t n_in);
 
+FLINT_DLL int fmpz_factor_ecm_threaded(fmpz_t f, mp_limb_t curves,
+                  mp_limb_t B1, mp_limb_t B2, slong max_time,
+                  flint_rand_t state, const fmpz_t n_in);
+
 #ifdef __cplusplus
 }
 #endif
@@ -12,10 +12,12 @@
 /* Outer wrapper for ECM 
    makes calls to stage I and stage II (one) */
 
+#include <pthread.h>
 #include <gmp.h>
 #include "flint.h"
 #include "fmpz.h"
 #include "mpn_extras.h"
+#include "profiler.h"
 
 static
 ulong n_ecm_primorial[] =
@@ -43,28 +45,212 @@ ulong n_ecm_primorial[] =
 #define num_n_ecm_primorials 9
 #endif
 
-int
-fmpz_factor_ecm(fmpz_t f, mp_limb_t curves, mp_limb_t B1, mp_limb_t B2,
-                flint_rand_t state, const fmpz_t n_in)
+/* data shared by the threads trying curves */
+typedef struct
 {
-    fmpz_t sig, nm8;
-    mp_limb_t P, num, maxD, mmin, mmax, mdiff, prod, maxj, n_size, cy;
-    int i, j, ret;
-    ecm_t ecm_inf;
-    __mpz_struct *fac, *mpz_ptr;
-    mp_ptr n, mpsig;
+    mp_srcptr n;                    /* normalised n */
+    mp_srcptr ninv;
+    mp_limb_t n_size;
+    mp_limb_t normbits;
+    const mp_limb_t * prime_array;  /* primes up to B1 */
+    mp_limb_t num;
+    mp_limb_t B1, B2, P;
+    unsigned char * GCD_table;
+    unsigned char ** prime_table;
+    int fft;                        /* use fmpz_factor_ecm_stage_II_fft */
+    flint_rand_s * state;           /* source of the curve parameters */
+    const fmpz * nm8;               /* n - 8 */
+    mp_limb_t curves;               /* curves left to try */
+    slong max_time;                 /* milliseconds, or 0 for no limit */
+    timeit_t timer;
+    volatile int stop;              /* set once a factor is found */
+    int ret;                        /* return value of the first success */
+    mp_ptr fac;                     /* factor, normalised, and its size */
+    mp_size_t fac_size;
+    pthread_mutex_t mutex;
+}
+_fmpz_factor_ecm_shared_t;
 
-    TMP_INIT;
+/* claim the next curve and its parameter sigma, return 0 if none is left */
+static int
+_fmpz_factor_ecm_next_curve(fmpz_t sig, _fmpz_factor_ecm_shared_t * sh)
+{
+    int res = 0;
 
-    const mp_limb_t *prime_array;
-    n_size = fmpz_size(n_in);
+    pthread_mutex_lock(&sh->mutex);
+
+    if (!sh->stop && sh->curves != 0)
+    {
+        if (sh->max_time != 0)
+        {
+            timeit_t t;
+
+            t->wall = sh->timer->wall;
+            t->cpu = sh->timer->cpu;
+            timeit_stop(t);
+
+            if (t->wall >= sh->max_time)
+                sh->curves = 0;
+        }
+
+        if (sh->curves != 0)
+        {
+            sh->curves--;
+
+            fmpz_randm(sig, sh->state, sh->nm8);
+            fmpz_add_ui(sig, sig, 7);
+
+            res = 1;
+        }
+    }
+
+    pthread_mutex_unlock(&sh->mutex);
+
+    return res;
+}
+
+/*
+   Try curves until they run out or another thread finds a factor. The
+   ecm_t of the thread is set up once and shares the stage II tables.
+*/
+static void *
+_fmpz_factor_ecm_worker(void * arg_ptr)
+{
+    _fmpz_factor_ecm_shared_t * sh = *((_fmpz_factor_ecm_shared_t **) arg_ptr);
+    mp_limb_t n_size = sh->n_size, cy;
+    mp_ptr mpsig, fac;
+    mp_srcptr n = sh->n;
+    __mpz_struct * mpz_ptr;
+    ecm_t ecm_inf;
+    fmpz_t sig;
+    int ret;
 
     fmpz_factor_ecm_init(ecm_inf, n_size);
 
-    TMP_START;
+    mpn_copyi(ecm_inf->ninv, sh->ninv, n_size);
+    ecm_inf->normbits = sh->normbits;
+    ecm_inf->one[0] = UWORD(1) << sh->normbits;
+    ecm_inf->GCD_table = sh->GCD_table;
+    ecm_inf->prime_table = sh->prime_table;
+    ecm_inf->stop = &sh->stop;
+
+    mpsig = flint_malloc(n_size * sizeof(mp_limb_t));
+    fac = flint_malloc(n_size * sizeof(mp_limb_t));
 
-    n     = TMP_ALLOC(n_size * sizeof(mp_limb_t));
-    mpsig = TMP_ALLOC(n_size * sizeof(mp_limb_t));
+    fmpz_init(sig);
+
+    while (_fmpz_factor_ecm_next_curve(sig, sh))
+    {
+        /* sig < n, so it fits in n_size limbs after normalisation */
+        mpn_zero(mpsig, n_size);
+
+        if ((!COEFF_IS_MPZ(*sig)))
+        {
+            mpsig[0] = fmpz_get_ui(sig);
+            cy = ecm_inf->normbits == 0 ? 0 :
+                 mpn_lshift(mpsig, mpsig, 1, ecm_inf->normbits);
+            if (cy)
+                mpsig[1] = cy;
+        }
+        else
+        {
+            mpz_ptr = COEFF_TO_PTR(*sig);
+
+            if (ecm_inf->normbits == 0) /* GMP does not allow shifts by 0 */
+            {
+                mpn_copyi(mpsig, mpz_ptr->_mp_d, mpz_ptr->_mp_size);
+                cy = 0;
+            }
+            else
+                cy = mpn_lshift(mpsig, mpz_ptr->_mp_d, mpz_ptr->_mp_size, ecm_inf->normbits);
+            if (cy)
+                mpsig[mpz_ptr->_mp_size] = cy;
+        }
+
+        /************************ SELECT CURVE ************************/
+
+        ret = fmpz_factor_ecm_select_curve(fac, mpsig, (mp_ptr) n, ecm_inf);
+
+        if (ret > 0)
+        {
+            /* Found factor while selecting curve,
+               very very lucky :) */
+
+            cy = ret;
+            ret = -1;
+        }
+        else if (ret == 0)
+        {
+            /************************** STAGE I ***************************/
+
+            cy = fmpz_factor_ecm_stage_I(fac, sh->prime_array, sh->num,
+                                                sh->B1, (mp_ptr) n, ecm_inf);
+            ret = 1;
+
+            /************************** STAGE II **************************/
+
+            if (cy == 0 && sh->fft)
+            {
+                cy = fmpz_factor_ecm_stage_II_fft(fac, sh->B1, sh->B2, sh->P,
+                                                         (mp_ptr) n, ecm_inf);
+                ret = 2;
+            }
+            else if (cy == 0)
+            {
+                cy = fmpz_factor_ecm_stage_II(fac, sh->B1, sh->B2, sh->P,
+                                                         (mp_ptr) n, ecm_inf);
+                ret = 2;
+            }
+        }
+        else
+            cy = 0; /* unsuitable curve */
+
+        if (cy != 0)
+        {
+            pthread_mutex_lock(&sh->mutex);
+
+            if (!sh->stop) /* first factor found, tell the others */
+            {
+                mpn_copyi(sh->fac, fac, cy);
+                sh->fac_size = cy;
+                sh->ret = ret;
+                sh->stop = 1;
+            }
+
+            pthread_mutex_unlock(&sh->mutex);
+
+            break;
+        }
+    }
+
+    fmpz_clear(sig);
+    flint_free(mpsig);
+    flint_free(fac);
+
+    /* the tables belong to the caller */
+    ecm_inf->GCD_table = NULL;
+    ecm_inf->prime_table = NULL;
+    fmpz_factor_ecm_clear(ecm_inf);
+
+    return NULL;
+}
+
+int
+fmpz_factor_ecm_threaded(fmpz_t f, mp_limb_t curves, mp_limb_t B1,
+                mp_limb_t B2, slong max_time, flint_rand_t state,
+                const fmpz_t n_in)
+{
+    fmpz_t nm8;
+    mp_limb_t P, num, maxD, mmin, mmax, mdiff, prod, maxj, n_size, normbits;
+    slong i, j, num_threads;
+    int ret;
+    __mpz_struct *fac, *mpz_ptr;
+    mp_ptr n, ninv;
+    _fmpz_factor_ecm_shared_t sh;
+    _fmpz_factor_ecm_shared_t ** args;
+
+    const mp_limb_t *prime_array;
+    n_size = fmpz_size(n_in);
 
     if (n_size == 1)
     {
@@ -73,29 +259,23 @@ fmpz_factor_ecm(fmpz_t f, mp_limb_t curves, mp_limb_t B1, mp_limb_t B2,
         return ret;
     }
 
-    if ((!COEFF_IS_MPZ(* n_in)))
-    {
-        count_leading_zeros(ecm_inf->normbits, fmpz_get_ui(n_in));
-        n[0] = fmpz_get_ui(n_in);
-        n[0] <<= ecm_inf->normbits;
-    }
+    timeit_start(sh.timer);
+
+    n    = flint_malloc(n_size * sizeof(mp_limb_t));
+    ninv = flint_malloc(n_size * sizeof(mp_limb_t));
+
+    mpz_ptr = COEFF_TO_PTR(* n_in);
+    count_leading_zeros(normbits, mpz_ptr->_mp_d[n_size - 1]);
+    if (normbits == 0)
+        mpn_copyi(n, mpz_ptr->_mp_d, n_size);
     else
-    {
-        mpz_ptr = COEFF_TO_PTR(* n_in);
-        count_leading_zeros(ecm_inf->normbits, mpz_ptr->_mp_d[n_size - 1]);
-        mpn_lshift(n, mpz_ptr->_mp_d, n_size, ecm_inf->normbits);
-    }
+        mpn_lshift(n, mpz_ptr->_mp_d, n_size, normbits);
 
-    flint_mpn_preinvn(ecm_inf->ninv, n, n_size);
-    ecm_inf->one[0] = UWORD(1) << ecm_inf->normbits;
+    flint_mpn_preinvn(ninv, n, n_size);
 
-    fmpz_init(sig);
     fmpz_init(nm8);
     fmpz_sub_ui(nm8, n_in, 8);
 
-    ret = 0;
-    fac = _fmpz_promote(f);
-
     /************************ STAGE I PRECOMPUTATIONS ************************/
 
     num = n_prime_pi(B1);   /* number of primes under B1 */
@@ -105,155 +285,148 @@ fmpz_factor_ecm(fmpz_t f, mp_limb_t curves, mp_limb_t B1, mp_limb_t B2,
 
     /************************ STAGE II PRECOMPUTATIONS ***********************/
 
-    maxD = n_sqrt(B2);
+    sh.fft = (B2 / B1 >= FMPZ_FACTOR_ECM_FFT_CUTOFF);
+
+    if (sh.fft)
+    {
+        /*
+           phi(P)/2 baby steps and B2/P giant steps, which are evaluated in
+           batches of phi(P)/2, so take P*phi(P)/2 about B2
+        */
+        j = 4;
+        while (j < 7 &&
+               n_ecm_primorial[j]/2 <= B2/n_euler_phi(n_ecm_primorial[j]))
+            j += 1;
+
+        P = n_ecm_primorial[j - 1];
+    }
+    else
+    {
+        maxD = n_sqrt(B2);
 
-    /* Selecting primorial */
+        /* Selecting primorial */
 
-    j = 1;
-    while ((j < num_n_ecm_primorials) && (n_ecm_primorial[j] < maxD))
-        j += 1;
+        j = 1;
+        while ((j < num_n_ecm_primorials) && (n_ecm_primorial[j] < maxD))
+            j += 1;
 
-    P = n_ecm_primorial[j - 1]; 
+        P = n_ecm_primorial[j - 1]; 
+    }
     
     mmin = (B1 + (P/2)) / P;
     mmax = ((B2 - P/2) + P - 1)/P;      /* ceil */
     maxj = (P + 1)/2; 
-    mdiff = mmax - mmin + 1;
+    mdiff = sh.fft ? 0 : mmax - mmin + 1; /* only needed for the tables */
 
     /* compute GCD_table */
 
-    ecm_inf->GCD_table = flint_malloc(maxj + 1);
+    sh.GCD_table = flint_malloc(maxj + 1);
 
     for (j = 1; j <= maxj; j += 2)
     {
         if ((j%2) && n_gcd(j, P) == 1)
-            ecm_inf->GCD_table[j] = 1;  
+            sh.GCD_table[j] = 1;  
         else
-            ecm_inf->GCD_table[j] = 0;
+            sh.GCD_table[j] = 0;
     }  
 
     /* compute prime table */
 
-    ecm_inf->prime_table = flint_malloc(mdiff * sizeof(unsigned char*));
+    sh.prime_table = (mdiff == 0) ? NULL :
+                              flint_malloc(mdiff * sizeof(unsigned char*));
 
     for (i = 0; i < mdiff; i++)
-        ecm_inf->prime_table[i] = flint_malloc((maxj + 1) * sizeof(unsigned char));
+        sh.prime_table[i] = flint_malloc((maxj + 1) * sizeof(unsigned char));
 
     for (i = 0; i < mdiff; i++)
     {
         for (j = 1; j <= maxj; j += 2)
         {
-            ecm_inf->prime_table[i][j] = 0;
+            sh.prime_table[i][j] = 0;
 
             /* if (i + mmin)*D + j
                is prime, mark 1. Can be possibly prime
                only if gcd(j, D) = 1 */
 
-            if (ecm_inf->GCD_table[j] == 1)
+            if (sh.GCD_table[j] == 1)
             {
                 prod = (i + mmin)*P + j;
                 if (n_is_prime(prod))
-                    ecm_inf->prime_table[i][j] = 1;
+                    sh.prime_table[i][j] = 1;
 
                 prod = (i + mmin)*P - j;
                 if (n_is_prime(prod))
-                    ecm_inf->prime_table[i][j] = 1;
+                    sh.prime_table[i][j] = 1;
             }
         }
     }
 
-
     /****************************** TRY "CURVES" *****************************/
 
-    for (j = 0; j < curves; j++)
+    sh.n = n;
+    sh.ninv = ninv;
+    sh.n_size = n_size;
+    sh.normbits = normbits;
+    sh.prime_array = prime_array;
+    sh.num = num;
+    sh.B1 = B1;
+    sh.B2 = B2;
+    sh.P = P;
+    sh.state = state;
+    sh.nm8 = nm8;
+    sh.curves = curves;
+    sh.max_time = max_time;
+    sh.stop = 0;
+    sh.ret = 0;
+    sh.fac = flint_malloc(n_size * sizeof(mp_limb_t));
+    sh.fac_size = 0;
+    pthread_mutex_init(&sh.mutex, NULL);
+
+    num_threads = FLINT_MAX(1, FLINT_MIN(flint_get_num_threads(), curves));
+
+    args = flint_malloc(num_threads * sizeof(_fmpz_factor_ecm_shared_t *));
+    for (i = 0; i < num_threads; i++)
+        args[i] = &sh;
+
+    flint_parallel_do(_fmpz_factor_ecm_worker, args,
+                      sizeof(_fmpz_factor_ecm_shared_t *), num_threads);
+
+    ret = sh.ret;
+
+    if (ret != 0)
     {
-        fmpz_randm(sig, state, nm8);
-        fmpz_add_ui(sig, sig, 7);
+        fac = _fmpz_promote(f);
+        mpz_realloc2(fac, n_size * FLINT_BITS);
 
-        if ((!COEFF_IS_MPZ(*sig)))
-        {
-            mpsig[0] = fmpz_get_ui(sig);
-            cy = mpn_lshift(mpsig, mpsig, 1, ecm_inf->normbits);
-            if (cy)
-                mpsig[1] = cy;
-        }
+        if (normbits == 0)
+            mpn_copyi(fac->_mp_d, sh.fac, sh.fac_size);
         else
-        {
-            mpz_ptr = COEFF_TO_PTR(*sig);
-
-            cy = mpn_lshift(mpsig, mpz_ptr->_mp_d, mpz_ptr->_mp_size, ecm_inf->normbits);
-            if (cy)
-                mpsig[mpz_ptr->_mp_size] = cy;
-
-        }
-
-        /************************ SELECT CURVE ************************/
-
-        ret = fmpz_factor_ecm_select_curve(fac->_mp_d, mpsig, n, ecm_inf);
-
-        if (ret)
-        {
-            /* Found factor while selecting curve,
-               very very lucky :) */
-
-            mpn_rshift(fac->_mp_d, fac->_mp_d, ret, ecm_inf->normbits);
-            MPN_NORM(fac->_mp_d, ret);
-
-            fac->_mp_size = ret;
-            _fmpz_demote_val(f);    
-
-            ret = -1;
-            goto cleanup;
-        }
-
-        if (ret != -1)
-        {
-
-            /************************** STAGE I ***************************/
-
-            ret = fmpz_factor_ecm_stage_I(fac->_mp_d, prime_array, num, B1, n, ecm_inf);
+            mpn_rshift(fac->_mp_d, sh.fac, sh.fac_size, normbits);
+        MPN_NORM(fac->_mp_d, sh.fac_size);
 
-            if (ret)
-            {
-                /* Found factor after stage I */
-                mpn_rshift(fac->_mp_d, fac->_mp_d, ret, ecm_inf->normbits);
-                MPN_NORM(fac->_mp_d, ret);
-
-                fac->_mp_size = ret;
-                _fmpz_demote_val(f);    
-
-                ret = 1;
-                goto cleanup;
-            }  
-            /************************** STAGE II ***************************/
-
-            ret = fmpz_factor_ecm_stage_II(fac->_mp_d, B1, B2, P, n, ecm_inf);
-
-            if (ret)
-            {
-                /* Found factor after stage I */
-                mpn_rshift(fac->_mp_d, fac->_mp_d, ret, ecm_inf->normbits);
-                MPN_NORM(fac->_mp_d, ret);
-                fac->_mp_size = ret;
-                _fmpz_demote_val(f);  
-
-                ret = 2;
-                goto cleanup;
-            }
-        }
+        fac->_mp_size = sh.fac_size;
+        _fmpz_demote_val(f);
     }
 
-    cleanup:
+    pthread_mutex_destroy(&sh.mutex);
+    flint_free(args);
+    flint_free(sh.fac);
 
-
-    flint_free(ecm_inf->GCD_table);
+    flint_free(sh.GCD_table);
     for (i = 0; i < mdiff; i++)
-        flint_free(ecm_inf->prime_table[i]);
-    flint_free(ecm_inf->prime_table);
+        flint_free(sh.prime_table[i]);
+    flint_free(sh.prime_table);
 
-    fmpz_factor_ecm_clear(ecm_inf);
-    
-    TMP_END;
+    fmpz_clear(nm8);
+    flint_free(n);
+    flint_free(ninv);
 
     return ret;
 }
+
+int
+fmpz_factor_ecm(fmpz_t f, mp_limb_t curves, mp_limb_t B1, mp_limb_t B2,
+                flint_rand_t state, const fmpz_t n_in)
+{
+    return fmpz_factor_ecm_threaded(f, curves, B1, B2, 0, state, n_in);
+}
@@ -46,7 +46,8 @@ fmpz_factor_ecm_select_curve(mp_ptr f, mp_ptr sig, mp_ptr n, ecm_t ecm_inf)
     temp[0] = UWORD(4);
     ret = 0;
 
-    mpn_lshift(temp, temp, ecm_inf->n_size, ecm_inf->normbits);   /* temp = (4 << norm) */
+    if (ecm_inf->normbits != 0)
+        mpn_lshift(temp, temp, ecm_inf->n_size, ecm_inf->normbits);   /* temp = (4 << norm) */
 
     flint_mpn_mulmod_preinvn(ecm_inf->v, ecm_inf->u, temp, ecm_inf->n_size,
                              n, ecm_inf->ninv, ecm_inf->normbits);
@@ -125,7 +126,8 @@ fmpz_factor_ecm_select_curve(mp_ptr f, mp_ptr sig, mp_ptr n, ecm_t ecm_inf)
     {
         invlimbs *= -1;
 
-        cy = mpn_lshift(tempi, tempi, invlimbs, ecm_inf->normbits);
+        cy = ecm_inf->normbits == 0 ? 0 :
+             mpn_lshift(tempi, tempi, invlimbs, ecm_inf->normbits);
         if (cy)
             tempi[invlimbs] = cy;
 
@@ -133,7 +135,8 @@ fmpz_factor_ecm_select_curve(mp_ptr f, mp_ptr sig, mp_ptr n, ecm_t ecm_inf)
     }
     else
     {
-        cy = mpn_lshift(tempi, tempi, invlimbs, ecm_inf->normbits);
+        cy = ecm_inf->normbits == 0 ? 0 :
+             mpn_lshift(tempi, tempi, invlimbs, ecm_inf->normbits);
         if (cy)
             tempi[invlimbs] = cy;
     }
@@ -156,11 +159,13 @@ fmpz_factor_ecm_select_curve(mp_ptr f, mp_ptr sig, mp_ptr n, ecm_t ecm_inf)
 
     mpn_zero(temp, sz);
     temp[0] = UWORD(2);
-    mpn_lshift(temp, temp, ecm_inf->n_size, ecm_inf->normbits);
+    if (ecm_inf->normbits != 0)
+        mpn_lshift(temp, temp, ecm_inf->n_size, ecm_inf->normbits);
 
     fmpz_factor_ecm_addmod(ecm_inf->a24, ecm_inf->w, temp, n, ecm_inf->n_size);
     mpn_rshift(ecm_inf->a24, ecm_inf->a24, ecm_inf->n_size, 2 + ecm_inf->normbits);
-    mpn_lshift(ecm_inf->a24, ecm_inf->a24, ecm_inf->n_size, ecm_inf->normbits);
+    if (ecm_inf->normbits != 0)
+        mpn_lshift(ecm_inf->a24, ecm_inf->a24, ecm_inf->n_size, ecm_inf->normbits);
 
     mpn_copyi(ecm_inf->z, ecm_inf->one, ecm_inf->n_size);
 
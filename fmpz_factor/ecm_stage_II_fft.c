@@ -0,0 +1,294 @@
+/*
+    Copyright (C) 2026 agent
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include <gmp.h>
+#include "flint.h"
+#include "fmpz.h"
+#include "fmpz_vec.h"
+#include "fmpz_mod_poly.h"
+#include "mpn_extras.h"
+
+/* Implementation of the stage II of ECM by polynomial evaluation */
+
+/* set r to the residue a, stored shifted left by normbits */
+static void
+_fmpz_factor_ecm_get_fmpz(fmpz_t r, mp_srcptr a, ecm_t ecm_inf)
+{
+    __mpz_struct * z = _fmpz_promote(r);
+    mp_size_t sz = ecm_inf->n_size;
+
+    mpz_realloc2(z, sz * FLINT_BITS);
+    if (ecm_inf->normbits == 0)
+        mpn_copyi(z->_mp_d, a, sz);
+    else
+        mpn_rshift(z->_mp_d, a, sz, ecm_inf->normbits);
+    MPN_NORM(z->_mp_d, sz);
+    z->_mp_size = sz;
+
+    _fmpz_demote_val(r);
+}
+
+/* set f to g shifted left by normbits, return its size in limbs */
+static mp_size_t
+_fmpz_factor_ecm_set_factor(mp_ptr f, const fmpz_t g, ecm_t ecm_inf)
+{
+    __mpz_struct * z;
+    mp_size_t sz;
+    fmpz_t t;
+
+    fmpz_init(t);
+    fmpz_mul_2exp(t, g, ecm_inf->normbits);
+
+    if (!COEFF_IS_MPZ(*t))
+    {
+        f[0] = *t;
+        sz = 1;
+    }
+    else
+    {
+        z = COEFF_TO_PTR(*t);
+        sz = z->_mp_size;
+        mpn_copyi(f, z->_mp_d, sz);
+    }
+
+    fmpz_clear(t);
+
+    return sz;
+}
+
+/*
+   Set xs[i] to X[i]/Z[i] modulo n, for 0 <= i < len, with one inversion.
+   Return 0 on success. Otherwise some Z[i] is not invertible and g is set
+   to a proper factor of n if one of them gives it, or to n.
+*/
+static int
+_fmpz_factor_ecm_normalise(fmpz * xs, const fmpz * X, const fmpz * Z,
+                                         slong len, fmpz * t, const fmpz_t n,
+                                         fmpz_t g)
+{
+    slong i;
+    fmpz_t inv;
+
+    fmpz_set(t + 0, Z + 0);
+    for (i = 1; i < len; i++)
+    {
+        fmpz_mul(t + i, t + i - 1, Z + i);
+        fmpz_mod(t + i, t + i, n);
+    }
+
+    fmpz_init(inv);
+    fmpz_gcdinv(g, inv, t + len - 1, n);
+    fmpz_swap(t + len - 1, inv);
+    fmpz_clear(inv);
+
+    if (!fmpz_is_one(g))
+    {
+        for (i = 0; i < len; i++)
+        {
+            fmpz_gcd(g, Z + i, n);
+
+            if (!fmpz_is_one(g) && !fmpz_equal(g, n))
+                return 1;
+        }
+
+        fmpz_set(g, n);
+        return 1;
+    }
+
+    /* now t[len - 1] = 1/(Z[0]...Z[len - 1]) */
+    for (i = len - 1; i > 0; i--)
+    {
+        fmpz_mul(xs + i, t + i, t + i - 1);
+        fmpz_mul(t + i - 1, t + i, Z + i);
+        fmpz_mod(t + i - 1, t + i - 1, n);
+        fmpz_mod(xs + i, xs + i, n);
+        fmpz_mul(xs + i, xs + i, X + i);
+        fmpz_mod(xs + i, xs + i, n);
+    }
+
+    fmpz_mul(xs + 0, t + 0, X + 0);
+    fmpz_mod(xs + 0, xs + 0, n);
+
+    return 0;
+}
+
+int
+fmpz_factor_ecm_stage_II_fft(mp_ptr f, mp_limb_t B1, mp_limb_t B2,
+                                      mp_limb_t P, mp_ptr n, ecm_t ecm_inf)
+{
+    mp_ptr Qx, Qz, Rx, Rz, Qdx, Qdz, a, b;
+    mp_limb_t mmin, mmax, maxj, m;
+    slong j, d, len, sz;
+    int ret;
+    mp_ptr arrx, arrz, Q0x2, Q0z2;
+    fmpz * X, * Z, * xs, * t, * F;
+    fmpz_t N, g, h;
+
+    TMP_INIT;
+
+    mmin = (B1 + (P/2)) / P;
+    mmax = ((B2 - P/2) + P - 1)/P;      /* ceil */
+    maxj = (P + 1)/2;
+
+    /* P may exceed 2*B1, the primes below P/2 are then skipped */
+    mmin = FLINT_MAX(mmin, 1);
+
+    sz = ecm_inf->n_size;
+
+    TMP_START;
+    Qx   = TMP_ALLOC(sz * sizeof(mp_limb_t));
+    Qz   = TMP_ALLOC(sz * sizeof(mp_limb_t));
+    Rx   = TMP_ALLOC(sz * sizeof(mp_limb_t));
+    Rz   = TMP_ALLOC(sz * sizeof(mp_limb_t));
+    Qdx  = TMP_ALLOC(sz * sizeof(mp_limb_t));
+    Qdz  = TMP_ALLOC(sz * sizeof(mp_limb_t));
+    Q0x2 = TMP_ALLOC(sz * sizeof(mp_limb_t));
+    Q0z2 = TMP_ALLOC(sz * sizeof(mp_limb_t));
+    a    = TMP_ALLOC(sz * sizeof(mp_limb_t));
+    b    = TMP_ALLOC(sz * sizeof(mp_limb_t));
+    arrx = flint_malloc(((maxj >> 1) + 1) * sz * sizeof(mp_limb_t));
+    arrz = flint_malloc(((maxj >> 1) + 1) * sz * sizeof(mp_limb_t));
+
+    mpn_zero(arrx, ((maxj >> 1) + 1) * sz);
+    mpn_zero(arrz, ((maxj >> 1) + 1) * sz);
+
+    ret = 0;
+
+    fmpz_init(N);
+    fmpz_init(g);
+    fmpz_init(h);
+    _fmpz_factor_ecm_get_fmpz(N, n, ecm_inf);
+
+    /* number of baby steps, the j in [1, P/2] coprime to P */
+    for (j = 1, d = 0; j <= maxj; j += 2)
+    {
+        if (n_gcd(j, P) == 1)
+            d++;
+    }
+
+    X  = _fmpz_vec_init(d);
+    Z  = _fmpz_vec_init(d);
+    xs = _fmpz_vec_init(d);
+    t  = _fmpz_vec_init(d);
+    F  = _fmpz_vec_init(d + 1);
+
+    /* jQ0 for odd j as in stage II, arr[j/2] = jQ0 */
+    mpn_copyi(arrx, ecm_inf->x, sz);
+    mpn_copyi(arrz, ecm_inf->z, sz);
+
+    fmpz_factor_ecm_double(Q0x2, Q0z2, arrx, arrz, n, ecm_inf);
+
+    fmpz_factor_ecm_add(arrx + 1 * sz, arrz + 1 * sz,
+                         Q0x2, Q0z2, arrx, arrz, arrx, arrz, n, ecm_inf);
+
+    for (j = 2; j <= (maxj >> 1); j += 1)
+    {
+        fmpz_factor_ecm_add(arrx + j * sz, arrz + j * sz,
+                             arrx + (j - 1) * sz, arrz + (j - 1) * sz,
+                             Q0x2, Q0z2,
+                             arrx + (j - 2) * sz, arrz + (j - 2) * sz,
+                             n, ecm_inf);
+    }
+
+    /* F = prod (X - x(jQ0)) over the baby steps */
+    for (j = 1, len = 0; j <= maxj; j += 2)
+    {
+        if (n_gcd(j, P) == 1)
+        {
+            _fmpz_factor_ecm_get_fmpz(X + len, arrx + (j >> 1) * sz, ecm_inf);
+            _fmpz_factor_ecm_get_fmpz(Z + len, arrz + (j >> 1) * sz, ecm_inf);
+            len++;
+        }
+    }
+
+    flint_free(arrx);
+    flint_free(arrz);
+
+    if (_fmpz_factor_ecm_normalise(xs, X, Z, d, t, N, g))
+        goto found;
+
+    _fmpz_mod_poly_product_roots_fmpz_vec(F, xs, d, N);
+
+    /* Q = P * Q_0, R = mmin * Q, Qd = (mmin - 1) * Q */
+    fmpz_factor_ecm_mul_montgomery_ladder(Qx, Qz, ecm_inf->x, ecm_inf->z,
+                                           P, n, ecm_inf);
+    fmpz_factor_ecm_mul_montgomery_ladder(Rx, Rz, Qx, Qz, mmin, n, ecm_inf);
+    fmpz_factor_ecm_mul_montgomery_ladder(Qdx, Qdz, Qx, Qz, mmin - 1, n, ecm_inf);
+
+    /*
+       x(mQ) = x(jQ0) modulo p, i.e. F(x(mQ)) = 0, if the order of Q0 modulo
+       p divides mP + j or mP - j, so every prime in (B1, B2] is covered.
+       The giant steps are evaluated in batches of d points.
+    */
+    fmpz_one(g);
+
+    for (m = mmin; m <= mmax; )
+    {
+        if (ecm_inf->stop != NULL && *ecm_inf->stop)
+            goto cleanup;
+
+        for (len = 0; len < d && m <= mmax; len++, m++)
+        {
+            _fmpz_factor_ecm_get_fmpz(X + len, Rx, ecm_inf);
+            _fmpz_factor_ecm_get_fmpz(Z + len, Rz, ecm_inf);
+
+            /* R = R + Q, difference is stored in Qd */
+            mpn_copyi(a, Rx, sz);
+            mpn_copyi(b, Rz, sz);
+
+            fmpz_factor_ecm_add(Rx, Rz, Rx, Rz, Qx, Qz, Qdx, Qdz, n, ecm_inf);
+
+            mpn_copyi(Qdx, a, sz);
+            mpn_copyi(Qdz, b, sz);
+        }
+
+        if (_fmpz_factor_ecm_normalise(xs, X, Z, len, t, N, h))
+        {
+            fmpz_swap(g, h);
+            goto found;
+        }
+
+        _fmpz_mod_poly_evaluate_fmpz_vec_fast(t, F, d + 1, xs, len, N);
+
+        for (j = 0; j < len; j++)
+        {
+            fmpz_mul(g, g, t + j);
+            fmpz_mod(g, g, N);
+        }
+    }
+
+    fmpz_gcd(g, g, N);
+
+found:
+
+    /* condition one -> gcd = 1
+       condition two -> gcd = n
+       if neither is true, factor found */
+
+    if (!fmpz_is_one(g) && !fmpz_equal(g, N))
+        ret = _fmpz_factor_ecm_set_factor(f, g, ecm_inf);
+
+cleanup:
+
+    _fmpz_vec_clear(X, d);
+    _fmpz_vec_clear(Z, d);
+    _fmpz_vec_clear(xs, d);
+    _fmpz_vec_clear(t, d);
+    _fmpz_vec_clear(F, d + 1);
+
+    fmpz_clear(N);
+    fmpz_clear(g);
+    fmpz_clear(h);
+
+    TMP_END;
+
+    return ret;
+}
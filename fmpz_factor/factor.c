@@ -1,5 +1,6 @@
 /*
     Copyright (C) 2010 Fredrik Johansson
+    Copyright (C) 2026 agent
 
     This file is part of FLINT.
 
@@ -16,8 +17,9 @@
 #include "mpn_extras.h"
 #include "ulong_extras.h"
 
-void
-fmpz_factor(fmpz_factor_t factor, const fmpz_t n)
+int
+fmpz_factor_progress(fmpz_factor_t factor, const fmpz_t n,
+                                 fmpz_factor_progress_t progress, void * arg)
 {
     ulong exp;
     mp_limb_t p;
@@ -26,12 +28,13 @@ fmpz_factor(fmpz_factor_t factor, const fmpz_t n)
     mp_size_t xsize;
     slong found;
     slong trial_start, trial_stop;
+    int ret = 1;
     TMP_INIT;
 
     if (!COEFF_IS_MPZ(*n))
     {
         fmpz_factor_si(factor, *n);
-        return;
+        return 1;
     }
 
     _fmpz_factor_set_length(factor, 0);
@@ -53,7 +56,19 @@ fmpz_factor(fmpz_factor_t factor, const fmpz_t n)
     if (xsize == 1)
     {
         _fmpz_factor_extend_factor_ui(factor, xsrc->_mp_d[0]);
-        return;
+        return 1;
+    }
+
+    if (progress != NULL && progress(arg, FMPZ_FACTOR_STAGE_TRIAL, n, 0, 0))
+    {
+        fmpz_t n2;
+
+        fmpz_init(n2);
+        fmpz_abs(n2, n);
+        _fmpz_factor_append(factor, n2, 1);
+        fmpz_clear(n2);
+
+        return 0;
     }
 
     /* Create a temporary copy to be mutated */
@@ -117,7 +132,9 @@ fmpz_factor(fmpz_factor_t factor, const fmpz_t n)
             mpn_copyi(data->_mp_d, xd, xsize);
             data->_mp_size = xsize;
             
-            fmpz_factor_no_trial(factor, n2);
+            ret = fmpz_factor_no_trial_progress(factor, n2, progress, arg);
+
+            fmpz_clear(n2);
 
             goto cleanup;
         }
@@ -130,6 +147,12 @@ fmpz_factor(fmpz_factor_t factor, const fmpz_t n)
 cleanup:
 
     TMP_END;
-    return;
+    return ret;
+}
+
+void
+fmpz_factor(fmpz_factor_t factor, const fmpz_t n)
+{
+    fmpz_factor_progress(factor, n, NULL, NULL);
 }
 
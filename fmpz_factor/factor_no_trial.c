@@ -15,56 +15,280 @@
 #include "fmpz_vec.h"
 #include "mpn_extras.h"
 #include "ulong_extras.h"
+#include "aprcl.h"
 #include "qsieve.h"
 
-void
-fmpz_factor_no_trial(fmpz_factor_t factor, const fmpz_t n)
+/*
+   Tuning parameters { bits, rho_iters, pp1_B1, ecm_levels } for the effort
+   spent on a composite cofactor before the quadratic sieve is run, where:
+     * bits is the maximum number of bits of the cofactor for the row
+     * rho_iters is the number of iterations of each of two Pollard-Brent
+       attempts, 0 to skip them
+     * pp1_B1 is the stage I bound of each of two p + 1 attempts, 0 to skip
+     * ecm_levels is the number of rows of fmpz_factor_ecm_levels to run
+   The last row is used for all larger cofactors.
+*/
+
+static const mp_limb_t fmpz_factor_effort_tune[][4] =
+{
+   {100,   4000,     0, 0},
+   {130,   8000,  2000, 0},
+   {175,   8000,  5000, 0},
+   {200,  32000, 10000, 1},
+   {230,  32000, 20000, 2},
+   {260,  32000, 50000, 2},
+   {290,  32000, 50000, 3},
+   {320,  32000, 50000, 4},
+   {0,    32000, 50000, 8}
+};
+
+/*
+   ECM bounds { B1, curves } in order of increasing effort, each level
+   finding most prime factors of 15, 20, 25, ... decimal digits.
+   Stage II is run up to B2 = 100*B1.
+*/
+
+static const mp_limb_t fmpz_factor_ecm_levels[][2] =
+{
+   {    2000,   25},
+   {   11000,   90},
+   {   50000,  300},
+   {  250000,  700},
+   { 1000000, 1800},
+   { 3000000, 5100},
+   {11000000, 10600},
+   {43000000, 19300}
+};
+
+/* ECM curves are run in batches of about this many stage I steps */
+#define FMPZ_FACTOR_ECM_BATCH 100000
+
+static int
+_fmpz_factor_cancel(fmpz_factor_progress_t progress, void * arg, int stage,
+                                       const fmpz_t n, slong done, slong total)
+{
+    return progress != NULL && progress(arg, stage, n, done, total);
+}
+
+/* append p^exp to factor, adding to the exponent of p if it is present */
+static void
+_fmpz_factor_append_merge(fmpz_factor_t factor, const fmpz_t p, ulong exp)
+{
+    slong i;
+
+    for (i = 0; i < factor->num; i++)
+    {
+        if (fmpz_equal(factor->p + i, p))
+        {
+            factor->exp[i] += exp;
+            return;
+        }
+    }
+
+    _fmpz_factor_append(factor, p, exp);
+}
+
+/*
+   Either set f to a proper factor of n, which must be composite and not a
+   perfect power, and return 1, or set fac to the factorisation of n given
+   by the quadratic sieve and return 1, or return 0 if cancelled.
+*/
+static int
+_fmpz_factor_split(fmpz_t f, fmpz_factor_t fac, const fmpz_t n,
+              fmpz_factor_progress_t progress, void * arg, flint_rand_t state)
+{
+    slong row, rows, i, done, curves, batch;
+    mp_limb_t bits, B1;
+    fmpz_t m;
+    int found = 0;
+
+    bits = fmpz_bits(n);
+
+    rows = sizeof(fmpz_factor_effort_tune)/(4*sizeof(mp_limb_t));
+
+    for (row = 0; row < rows - 1; row++)
+    {
+        if (bits <= fmpz_factor_effort_tune[row][0])
+            break;
+    }
+
+    /* pollard_brent takes a mutable n */
+    fmpz_init_set(m, n);
+
+    if (fmpz_factor_effort_tune[row][1] != 0)
+    {
+        if (_fmpz_factor_cancel(progress, arg, FMPZ_FACTOR_STAGE_RHO, n, 0, 1))
+            goto cleanup;
+
+        found = fmpz_factor_pollard_brent(f, state, m, 2,
+                                               fmpz_factor_effort_tune[row][1]);
+    }
+
+    B1 = fmpz_factor_effort_tune[row][2];
+
+    for (i = 0; i < 2 && B1 != 0 && !found; i++)
+    {
+        if (_fmpz_factor_cancel(progress, arg, FMPZ_FACTOR_STAGE_PP1, n, i, 2))
+            goto cleanup;
+
+        found = fmpz_factor_pp1(f, n, B1, n_sqrt(100*B1),
+                                                     n_randint(state, 100) + 3);
+    }
+
+    for (i = 0; i < fmpz_factor_effort_tune[row][3] && !found; i++)
+    {
+        B1 = fmpz_factor_ecm_levels[i][0];
+        curves = fmpz_factor_ecm_levels[i][1];
+
+        batch = flint_get_num_threads()*(FMPZ_FACTOR_ECM_BATCH/B1);
+        batch = FLINT_MAX(batch, flint_get_num_threads());
+
+        for (done = 0; done < curves && !found; done += batch)
+        {
+            if (_fmpz_factor_cancel(progress, arg, FMPZ_FACTOR_STAGE_ECM,
+                                                            n, done, curves))
+                goto cleanup;
+
+            found = fmpz_factor_ecm_threaded(f, FLINT_MIN(batch, curves - done),
+                                                   B1, 100*B1, 0, state, n);
+        }
+    }
+
+    /* the methods above may return a trivial factor */
+    if (found && (fmpz_is_one(f) || fmpz_equal(f, n)))
+        found = 0;
+
+    if (!found)
+        found = qsieve_factor_progress(fac, n, progress, arg);
+
+cleanup:
+
+    fmpz_clear(m);
+
+    return found;
+}
+
+/*
+   Append the factorisation of n^exp to factor, returning 0 if cancelled,
+   in which case the cofactors not fully factored are appended instead.
+*/
+static int
+_fmpz_factor_no_trial(fmpz_factor_t factor, const fmpz_t n, ulong exp,
+              fmpz_factor_progress_t progress, void * arg, flint_rand_t state)
 {
-   int exp, i;
+    fmpz_factor_t fac;
+    fmpz_t f, root;
+    slong i;
+    int ret, k;
+
+    if (fmpz_abs_fits_ui(n))
+    {
+        n_factor_t nfac;
+
+        n_factor_init(&nfac);
+        n_factor(&nfac, fmpz_get_ui(n), 0);
+
+        fmpz_init(f);
+
+        for (i = 0; i < nfac.num; i++)
+        {
+            fmpz_set_ui(f, nfac.p[i]);
+            _fmpz_factor_append_merge(factor, f, exp*nfac.exp[i]);
+        }
 
-   if (fmpz_is_prime(n))
-      _fmpz_factor_append(factor, n, 1);
-   else
-   {
-      fmpz_t root;
+        fmpz_clear(f);
 
-      fmpz_init(root);
+        return 1;
+    }
 
-      exp = fmpz_is_perfect_power(root, n);
+    if (_fmpz_factor_cancel(progress, arg, FMPZ_FACTOR_STAGE_PROVE, n, 0, 1))
+    {
+        _fmpz_factor_append_merge(factor, n, exp);
 
-      if (exp != 0)
-      {
-         fmpz_factor_t fac;
+        return 0;
+    }
 
-         fmpz_factor_init(fac);
+    /* a probable prime is certified with a primality proof */
+    if (fmpz_is_probabprime(n))
+    {
+        k = fmpz_is_prime(n);
 
-         fmpz_factor_no_trial(fac, root);
+        if (k == -1)
+            k = is_prime_aprcl(n);
 
-         _fmpz_factor_concat(factor, fac, exp);
+        if (k)
+        {
+            _fmpz_factor_append_merge(factor, n, exp);
 
-         fmpz_factor_clear(fac);
-      } else
-      {
-         fmpz_factor_t fac, fac2;
+            return 1;
+        }
+    }
 
-         fmpz_factor_init(fac);
+    fmpz_init(root);
 
-         /* insert call to ecm here */
+    k = fmpz_is_perfect_power(root, n);
 
-         qsieve_factor(fac, n);
+    if (k != 0)
+    {
+        ret = _fmpz_factor_no_trial(factor, root, exp*k, progress, arg, state);
 
-         for (i = 0; i < fac->num; i++)
-         {
-            fmpz_factor_init(fac2);
+        fmpz_clear(root);
 
-            fmpz_factor_no_trial(fac2, fac->p + i);
+        return ret;
+    }
 
-            _fmpz_factor_concat(factor, fac2, fac->exp[i]);
- 
-            fmpz_factor_clear(fac2);
-         }
+    fmpz_init(f);
+    fmpz_factor_init(fac);
 
-         fmpz_factor_clear(fac);
-      }
-   }
+    ret = _fmpz_factor_split(f, fac, n, progress, arg, state);
+
+    if (!ret)
+        _fmpz_factor_append_merge(factor, n, exp);
+    else
+    {
+        if (fac->num == 0) /* n = f*(n/f) */
+        {
+            _fmpz_factor_append(fac, f, 1);
+            fmpz_divexact(f, n, f);
+            _fmpz_factor_append(fac, f, 1);
+        }
+
+        /* once cancelled, the remaining cofactors are appended as they are */
+        for (i = 0; i < fac->num; i++)
+        {
+            if (ret)
+                ret = _fmpz_factor_no_trial(factor, fac->p + i,
+                                    exp*fac->exp[i], progress, arg, state);
+            else
+                _fmpz_factor_append_merge(factor, fac->p + i, exp*fac->exp[i]);
+        }
+    }
+
+    fmpz_factor_clear(fac);
+    fmpz_clear(f);
+    fmpz_clear(root);
+
+    return ret;
+}
+
+int
+fmpz_factor_no_trial_progress(fmpz_factor_t factor, const fmpz_t n,
+                                 fmpz_factor_progress_t progress, void * arg)
+{
+    flint_rand_t state;
+    int ret;
+
+    flint_randinit(state);
+
+    ret = _fmpz_factor_no_trial(factor, n, 1, progress, arg, state);
+
+    flint_randclear(state);
+
+    return ret;
+}
+
+void
+fmpz_factor_no_trial(fmpz_factor_t factor, const fmpz_t n)
+{
+    fmpz_factor_no_trial_progress(factor, n, NULL, NULL);
 }
@@ -0,0 +1,82 @@
+/*
+    Copyright (C) 2026 agent
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "profiler.h"
+#include "flint.h"
+#include "fmpz.h"
+#include "fmpz_factor.h"
+
+/*
+   Factors found per second by fmpz_factor_ecm for products of a prime
+   of the given size and one of 150 bits, comparing stage II bounds B2 on
+   either side of FMPZ_FACTOR_ECM_FFT_CUTOFF, i.e. the prime table stage II
+   against the polynomial evaluation one.
+*/
+
+#define NUMS 20
+#define CURVES 20
+
+int main(void)
+{
+   slong i, j, k, found;
+   fmpz_t p, q, n, f;
+   timeit_t t;
+   mp_bitcnt_t bits[2] = { 45, 55 };
+   mp_limb_t B1[2] = { 2000, 11000 };
+   mp_limb_t ratio[3] = { 100, 1000, 10000 };
+
+   FLINT_TEST_INIT(state);
+
+   fmpz_init(p);
+   fmpz_init(q);
+   fmpz_init(n);
+   fmpz_init(f);
+
+   for (i = 0; i < 2; i++)
+   {
+      for (j = 0; j < 3; j++)
+      {
+         mp_limb_t B2 = B1[i]*ratio[j];
+
+         flint_randseed(state, 1, 2); /* the same numbers and curves */
+
+         found = 0;
+         timeit_start(t);
+
+         for (k = 0; k < NUMS; k++)
+         {
+            fmpz_randprime(p, state, bits[i], 0);
+            fmpz_randprime(q, state, 150, 0);
+            fmpz_mul(n, p, q);
+
+            found += (fmpz_factor_ecm(f, CURVES, B1[i], B2, state, n) != 0);
+         }
+
+         timeit_stop(t);
+
+         flint_printf("%wu bits, B1 = %wu, B2 = %wu (%s): %wd/%d found, "
+                      "%.3f per second\n", bits[i], B1[i], B2,
+                      ratio[j] >= FMPZ_FACTOR_ECM_FFT_CUTOFF ? "fft" : "table",
+                      found, NUMS, (double) found*1000/FLINT_MAX(t->wall, 1));
+      }
+   }
+
+   fmpz_clear(p);
+   fmpz_clear(q);
+   fmpz_clear(n);
+   fmpz_clear(f);
+
+   FLINT_TEST_CLEANUP(state);
+
+   return 0;
+}
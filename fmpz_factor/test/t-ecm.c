@@ -12,6 +12,7 @@
 #include <gmp.h>
 #include "flint.h"
 #include "fmpz.h"
+#include "fmpz_factor.h"
 #include "ulong_extras.h"
 
 int main(void)
@@ -68,6 +69,44 @@ int main(void)
         abort();
     }
 
+    /* stage II by polynomial evaluation, n with top bit set or not */
+    fails = 0;
+
+    for (j = 0; j < flint_test_multiplier(); j++)
+    {
+        fmpz_set_ui(prime1, n_randprime(state, 40, 1));
+        fmpz_set_ui(prime2, n_randprime(state, 88 + n_randint(state, 2), 1));
+
+        fmpz_mul(primeprod, prime1, prime2);
+
+        k = fmpz_factor_ecm(fac, 40, 1000, 1000*FMPZ_FACTOR_ECM_FFT_CUTOFF,
+                                                             state, primeprod);
+
+        if (k == 0)
+            fails += 1;
+        else
+        {
+            fmpz_mod(modval, primeprod, fac);
+
+            if (!fmpz_is_zero(modval) || fmpz_is_one(fac)
+                                      || fmpz_equal(fac, primeprod))
+            {
+                printf("FAIL : Wrong factor calculated (stage II fft)\n");
+                printf("n : ");
+                fmpz_print(primeprod);
+                printf(" factor calculated : ");
+                fmpz_print(fac);
+                abort();
+            }
+        }
+    }
+
+    if (fails > flint_test_multiplier()/2 + 1)
+    {
+        printf("FAIL : ECM failed too many times (%d times, stage II fft)\n", fails);
+        abort();
+    }
+
     fmpz_clear(prime1);
     fmpz_clear(prime2);
     fmpz_clear(primeprod);
@@ -0,0 +1,109 @@
+/*
+    Copyright (C) 2026 agent
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include <gmp.h>
+#include "flint.h"
+#include "fmpz.h"
+#include "ulong_extras.h"
+
+int main(void)
+{
+    fmpz_t prime1, prime2, primeprod, fac, modval;
+    int i, j, k, fails;
+
+    FLINT_TEST_INIT(state);
+
+    fmpz_init(prime1);
+    fmpz_init(prime2);
+    fmpz_init(primeprod);
+    fmpz_init(fac);
+    fmpz_init(modval);
+
+    fails = 0;
+
+    flint_printf("ecm_threaded....");
+    fflush(stdout);
+
+    /* factors are found with any number of threads */
+    for (i = 35; i <= 50; i += 5)
+    {
+        for (j = 0; j < flint_test_multiplier(); j++)
+        {
+            flint_set_num_threads(1 + n_randint(state, 4));
+
+            fmpz_set_ui(prime1, n_randprime(state, i, 1));
+            fmpz_set_ui(prime2, n_randprime(state, i, 1));
+
+            fmpz_mul(primeprod, prime1, prime2);
+
+            k = fmpz_factor_ecm_threaded(fac, i << 2, 2000, 50000, 0,
+                                                             state, primeprod);
+
+            if (k == 0)
+                fails += 1;
+            else
+            {
+                fmpz_mod(modval, primeprod, fac);
+
+                if (!fmpz_is_zero(modval) || fmpz_is_one(fac)
+                                          || fmpz_equal(fac, primeprod))
+                {
+                    printf("FAIL : Wrong factor calculated\n");
+                    printf("n : ");
+                    fmpz_print(primeprod);
+                    printf(" factor calculated : ");
+                    fmpz_print(fac);
+                    abort();
+                }
+            }
+        }
+    }
+
+    if (fails > flint_test_multiplier())
+    {
+        printf("FAIL : ECM failed too many times (%d times)\n", fails);
+        abort();
+    }
+
+    /* the time limit is honoured for a number without small factors */
+    for (i = 0; i < 2; i++)
+    {
+        flint_set_num_threads(1 + n_randint(state, 4));
+
+        fmpz_set_ui(prime1, n_randprime(state, 60, 1));
+        fmpz_set_ui(prime2, n_randprime(state, 60, 1));
+        fmpz_mul(primeprod, prime1, prime2);
+        fmpz_mul(primeprod, primeprod, primeprod);
+        fmpz_add_ui(primeprod, primeprod, 2);
+        fmpz_nextprime(primeprod, primeprod, 0);
+
+        k = fmpz_factor_ecm_threaded(fac, UWORD_MAX, 2000, 50000, 50,
+                                                             state, primeprod);
+
+        if (k != 0)
+        {
+            printf("FAIL : factor of a prime found\n");
+            fmpz_print(primeprod);
+            abort();
+        }
+    }
+
+    flint_set_num_threads(1);
+
+    fmpz_clear(prime1);
+    fmpz_clear(prime2);
+    fmpz_clear(primeprod);
+    fmpz_clear(fac);
+    fmpz_clear(modval);
+    FLINT_TEST_CLEANUP(state);
+    flint_printf("PASS\n");
+    return 0;
+}
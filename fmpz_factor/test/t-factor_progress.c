@@ -0,0 +1,153 @@
+/*
+    Copyright (C) 2026 agent
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <gmp.h>
+#include "flint.h"
+#include "fmpz.h"
+#include "fmpz_factor.h"
+#include "ulong_extras.h"
+
+typedef struct
+{
+    slong calls;   /* number of calls so far */
+    slong limit;   /* cancel on this call */
+} progress_t;
+
+int progress(void * arg, int stage, const fmpz_t n, slong done, slong total)
+{
+    progress_t * p = (progress_t *) arg;
+
+    if (stage < FMPZ_FACTOR_STAGE_TRIAL || stage > FMPZ_FACTOR_STAGE_QS
+          || done < 0 || (total != 0 && done > total && stage != FMPZ_FACTOR_STAGE_QS))
+    {
+        flint_printf("FAIL:\n");
+        flint_printf("stage = %d, done = %wd, total = %wd\n", stage, done, total);
+        abort();
+    }
+
+    return ++p->calls == p->limit;
+}
+
+int main(void)
+{
+    int i, j, k, ret;
+    fmpz_t n, m, p;
+    fmpz_factor_t factor;
+    progress_t prog;
+
+    FLINT_TEST_INIT(state);
+
+    flint_printf("factor_progress....");
+    fflush(stdout);
+
+    fmpz_init(n);
+    fmpz_init(m);
+    fmpz_init(p);
+
+    /* complete factorisations into distinct proven primes */
+    for (i = 0; i < 10 * flint_test_multiplier(); i++)
+    {
+        fmpz_one(n);
+
+        k = n_randint(state, 4) + 1;
+        for (j = 0; j < k; j++)
+        {
+            fmpz_randprime(p, state, n_randint(state, 50) + 2, 0);
+            fmpz_pow_ui(p, p, n_randint(state, 3) + 1);
+            fmpz_mul(n, n, p);
+        }
+
+        if (n_randint(state, 2))
+            fmpz_neg(n, n);
+
+        prog.calls = 0;
+        prog.limit = -1;
+
+        fmpz_factor_init(factor);
+
+        ret = fmpz_factor_progress(factor, n, progress, &prog);
+        fmpz_factor_expand(m, factor);
+
+        if (!ret || !fmpz_equal(m, n))
+        {
+            flint_printf("FAIL:\n");
+            flint_printf("ret = %d\n", ret);
+            fmpz_print(n); flint_printf("\n");
+            fmpz_factor_print(factor); flint_printf("\n");
+            abort();
+        }
+
+        for (j = 0; j < factor->num; j++)
+        {
+            for (k = 0; k < j; k++)
+            {
+                if (fmpz_equal(factor->p + j, factor->p + k))
+                {
+                    flint_printf("FAIL:\n");
+                    flint_printf("repeated prime factor\n");
+                    fmpz_factor_print(factor); flint_printf("\n");
+                    abort();
+                }
+            }
+
+            if (fmpz_is_prime(factor->p + j) != 1)
+            {
+                flint_printf("FAIL:\n");
+                flint_printf("factor is not prime\n");
+                fmpz_factor_print(factor); flint_printf("\n");
+                abort();
+            }
+        }
+
+        fmpz_factor_clear(factor);
+    }
+
+    /* a cancelled factorisation still multiplies out to n */
+    for (i = 0; i < 10 * flint_test_multiplier(); i++)
+    {
+        fmpz_randprime(n, state, n_randint(state, 30) + 40, 0);
+        fmpz_randprime(p, state, n_randint(state, 30) + 40, 0);
+        fmpz_mul(n, n, p);
+        fmpz_mul_ui(n, n, n_randint(state, 1000) + 1);
+
+        prog.calls = 0;
+        prog.limit = n_randint(state, 5) + 1;
+
+        fmpz_factor_init(factor);
+
+        ret = fmpz_factor_progress(factor, n, progress, &prog);
+        fmpz_factor_expand(m, factor);
+
+        if (!fmpz_equal(m, n) || (ret == 0 && prog.calls != prog.limit)
+                              || (ret == 1 && prog.calls >= prog.limit))
+        {
+            flint_printf("FAIL:\n");
+            flint_printf("ret = %d, calls = %wd, limit = %wd\n",
+                                                 ret, prog.calls, prog.limit);
+            fmpz_print(n); flint_printf("\n");
+            fmpz_factor_print(factor); flint_printf("\n");
+            abort();
+        }
+
+        fmpz_factor_clear(factor);
+    }
+
+    fmpz_clear(n);
+    fmpz_clear(m);
+    fmpz_clear(p);
+
+    FLINT_TEST_CLEANUP(state);
+
+    flint_printf("PASS\n");
+    return 0;
+}
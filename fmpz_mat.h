@@ -240,6 +240,13 @@ FLINT_DLL void fmpz_mat_mul_strassen(fmpz_mat_t C, const fmpz_mat_t A, const fmp
 FLINT_DLL void fmpz_mat_mul_classical_inline(fmpz_mat_t C, const fmpz_mat_t A,
     const fmpz_mat_t B);
 
+/* Maximum number of limbs taken by residue matrices in multimodular
+   multiplication, unless more primes are needed to occupy all threads */
+#define FMPZ_MAT_MUL_MULTI_MOD_BATCH_LIMBS (WORD(1) << 24)
+
+FLINT_DLL void _fmpz_mat_mul_multi_mod_batch(fmpz_mat_t C,
+    const fmpz_mat_t A, const fmpz_mat_t B, mp_bitcnt_t bits, slong batch);
+
 FLINT_DLL void _fmpz_mat_mul_multi_mod(fmpz_mat_t C, const fmpz_mat_t A,
     const fmpz_mat_t B, mp_bitcnt_t bits);
 
@@ -9,25 +9,211 @@
     (at your option) any later version.  See <http://www.gnu.org/licenses/>.
 */
 
+#include <pthread.h>
 #include "fmpz_mat.h"
 
-void
-_fmpz_mat_mul_multi_mod(fmpz_mat_t C, const fmpz_mat_t A, const fmpz_mat_t B,
-    mp_bitcnt_t bits)
+typedef struct mul_multi_mod_arg_struct
+{
+    void (* fn)(struct mul_multi_mod_arg_struct *);
+    fmpz_mat_struct * C;
+    const fmpz_mat_struct * A;
+    const fmpz_mat_struct * B;
+    nmod_mat_struct * mod_A;
+    nmod_mat_struct * mod_B;
+    nmod_mat_struct * mod_C;
+    slong num_primes;
+    const fmpz_comb_struct * comb;
+    const fmpz * M1;          /* product of the primes of earlier batches */
+    const fmpz * M2;          /* product of the primes of this batch */
+    const fmpz * c;           /* inverse of M1 modulo M2 */
+    int sign;
+    slong r0;
+    slong r1;
+    slong * next;
+    slong num_threads;
+    pthread_mutex_t * mutex;
+}
+mul_multi_mod_arg_t;
+
+/* reduce rows [r0, r1) of A and B modulo all primes of the batch */
+static void
+_fmpz_mat_mul_multi_mod_reduce(mul_multi_mod_arg_t * arg_ptr)
 {
+    mul_multi_mod_arg_t arg = *arg_ptr;
+    fmpz_comb_temp_t comb_temp;
+    mp_ptr residues;
     slong i, j, k;
 
-    fmpz_comb_t comb;
+    residues = flint_malloc(sizeof(mp_limb_t) * arg.num_primes);
+    fmpz_comb_temp_init(comb_temp, arg.comb);
+
+    for (i = arg.r0; i < arg.r1; i++)
+    {
+        const fmpz_mat_struct * M;
+        nmod_mat_struct * mod_M;
+        slong r;
+
+        if (i < arg.A->r)
+        {
+            M = arg.A;
+            mod_M = arg.mod_A;
+            r = i;
+        }
+        else
+        {
+            M = arg.B;
+            mod_M = arg.mod_B;
+            r = i - arg.A->r;
+        }
+
+        for (j = 0; j < M->c; j++)
+        {
+            fmpz_multi_mod_ui(residues, M->rows[r] + j, arg.comb, comb_temp);
+            for (k = 0; k < arg.num_primes; k++)
+                mod_M[k].rows[r][j] = residues[k];
+        }
+    }
+
+    fmpz_comb_temp_clear(comb_temp);
+    flint_free(residues);
+}
+
+/* multiply modulo the primes of the batch, claiming one prime at a time */
+static void
+_fmpz_mat_mul_multi_mod_mul(mul_multi_mod_arg_t * arg_ptr)
+{
+    mul_multi_mod_arg_t arg = *arg_ptr;
+    slong i;
+
+    while (1)
+    {
+        if (arg.mutex != NULL)
+            pthread_mutex_lock(arg.mutex);
+        i = *arg.next;
+        *arg.next = i + 1;
+        if (arg.mutex != NULL)
+            pthread_mutex_unlock(arg.mutex);
+
+        if (i >= arg.num_primes)
+            break;
+
+        nmod_mat_mul(arg.mod_C + i, arg.mod_A + i, arg.mod_B + i);
+    }
+}
+
+/*
+    reconstruct rows [r0, r1) of C from the residues of the batch; for
+    all but the first batch the result is combined with the value of C
+    modulo the primes of the earlier batches
+*/
+static void
+_fmpz_mat_mul_multi_mod_crt(mul_multi_mod_arg_t * arg_ptr)
+{
+    mul_multi_mod_arg_t arg = *arg_ptr;
     fmpz_comb_temp_t comb_temp;
+    mp_ptr residues;
+    fmpz_t r, t, M, Mhalf;
+    slong i, j, k;
 
-    slong num_primes;
+    residues = flint_malloc(sizeof(mp_limb_t) * arg.num_primes);
+    fmpz_comb_temp_init(comb_temp, arg.comb);
+    fmpz_init(r);
+    fmpz_init(t);
+    fmpz_init(M);
+    fmpz_init(Mhalf);
+
+    if (arg.M1 != NULL)
+    {
+        fmpz_mul(M, arg.M1, arg.M2);
+        fmpz_fdiv_q_2exp(Mhalf, M, 1);
+    }
+
+    for (i = arg.r0; i < arg.r1; i++)
+    {
+        for (j = 0; j < arg.C->c; j++)
+        {
+            fmpz * e = arg.C->rows[i] + j;
+
+            for (k = 0; k < arg.num_primes; k++)
+                residues[k] = arg.mod_C[k].rows[i][j];
+
+            if (arg.M1 == NULL)
+            {
+                fmpz_multi_CRT_ui(e, residues, arg.comb, comb_temp, arg.sign);
+            }
+            else
+            {
+                /* e = e + M1 * ((r - e) / M1 mod M2), with 0 <= e < M1 */
+                fmpz_multi_CRT_ui(r, residues, arg.comb, comb_temp, 0);
+                fmpz_sub(t, r, e);
+                fmpz_mul(t, t, arg.c);
+                fmpz_mod(t, t, arg.M2);
+                fmpz_addmul(e, t, arg.M1);
+
+                if (arg.sign && fmpz_cmp(e, Mhalf) > 0)
+                    fmpz_sub(e, e, M);
+            }
+        }
+    }
+
+    fmpz_clear(r);
+    fmpz_clear(t);
+    fmpz_clear(M);
+    fmpz_clear(Mhalf);
+    fmpz_comb_temp_clear(comb_temp);
+    flint_free(residues);
+}
+
+void *
+_fmpz_mat_mul_multi_mod_worker(void * arg_ptr)
+{
+    mul_multi_mod_arg_t * arg = (mul_multi_mod_arg_t *) arg_ptr;
+
+    /* spare threads are handed down, e.g. to nmod_mat_mul */
+    flint_set_num_threads(arg->num_threads);
+    arg->fn(arg);
+
+    return NULL;
+}
+
+/* run fn on args[0], ..., args[num_workers - 1] concurrently */
+static void
+_fmpz_mat_mul_multi_mod_run(void (* fn)(mul_multi_mod_arg_t *),
+                         mul_multi_mod_arg_t * args, slong num_workers)
+{
+    slong i;
+
+    for (i = 0; i < num_workers; i++)
+        args[i].fn = fn;
+
+    if (num_workers == 1)
+    {
+        fn(args);
+        return;
+    }
+
+    flint_parallel_do(_fmpz_mat_mul_multi_mod_worker,
+                              args, sizeof(mul_multi_mod_arg_t), num_workers);
+}
+
+void
+_fmpz_mat_mul_multi_mod_batch(fmpz_mat_t C, const fmpz_mat_t A,
+    const fmpz_mat_t B, mp_bitcnt_t bits, slong batch)
+{
+    slong i, k, next;
+    slong num_primes, nb, num_threads, num_workers, rows;
     mp_bitcnt_t primes_bits;
     mp_limb_t * primes;
-    mp_limb_t * residues;
 
-    nmod_mat_t * mod_C;
-    nmod_mat_t * mod_A;
-    nmod_mat_t * mod_B;
+    fmpz_comb_t comb;
+    fmpz_t M1, M2, c;
+
+    nmod_mat_struct * mod_C;
+    nmod_mat_struct * mod_A;
+    nmod_mat_struct * mod_B;
+
+    mul_multi_mod_arg_t * args;
+    pthread_mutex_t mutex;
 
     primes_bits = NMOD_MAT_OPTIMAL_MODULUS_BITS;
 
@@ -42,79 +228,159 @@ _fmpz_mat_mul_multi_mod(fmpz_mat_t C, const fmpz_mat_t A, const fmpz_mat_t B,
         num_primes = (bits + primes_bits - 1) / primes_bits;
     }
 
+    num_threads = FLINT_MAX(flint_get_num_threads(), 1);
+    batch = FLINT_MAX(batch, 1);
+    batch = FLINT_MIN(batch, num_primes);
+
     /* Initialize */
     primes = flint_malloc(sizeof(mp_limb_t) * num_primes);
     primes[0] = n_nextprime(UWORD(1) << primes_bits, 0);
     for (i = 1; i < num_primes; i++)
         primes[i] = n_nextprime(primes[i-1], 0);
 
-    residues = flint_malloc(sizeof(mp_limb_t) * num_primes);
-
-    mod_A = flint_malloc(sizeof(nmod_mat_t) * num_primes);
-    mod_B = flint_malloc(sizeof(nmod_mat_t) * num_primes);
-    mod_C = flint_malloc(sizeof(nmod_mat_t) * num_primes);
-    for (i = 0; i < num_primes; i++)
+    mod_A = flint_malloc(sizeof(nmod_mat_struct) * batch);
+    mod_B = flint_malloc(sizeof(nmod_mat_struct) * batch);
+    mod_C = flint_malloc(sizeof(nmod_mat_struct) * batch);
+    for (i = 0; i < batch; i++)
     {
-        nmod_mat_init(mod_A[i], A->r, A->c, primes[i]);
-        nmod_mat_init(mod_B[i], B->r, B->c, primes[i]);
-        nmod_mat_init(mod_C[i], C->r, C->c, primes[i]);
+        nmod_mat_init(mod_A + i, A->r, A->c, primes[i]);
+        nmod_mat_init(mod_B + i, B->r, B->c, primes[i]);
+        nmod_mat_init(mod_C + i, C->r, C->c, primes[i]);
     }
 
-    fmpz_comb_init(comb, primes, num_primes);
-    fmpz_comb_temp_init(comb_temp, comb);
+    args = flint_malloc(sizeof(mul_multi_mod_arg_t) * num_threads);
+    pthread_mutex_init(&mutex, NULL);
+
+    fmpz_init(M1);
+    fmpz_init(M2);
+    fmpz_init(c);
+
+    for (k = 0; k < num_primes; k += nb)
+    {
+        nb = FLINT_MIN(batch, num_primes - k);
+
+        for (i = 0; i < nb; i++)
+        {
+            nmod_t mod;
+            nmod_init(&mod, primes[k + i]);
 
-    /* Calculate residues of A */
-    for (i = 0; i < A->r; i++)
-    {   for (j = 0; j < A->c; j++)
-        {   fmpz_multi_mod_ui(residues, &(A->rows[i][j]), comb, comb_temp);
-            for (k = 0; k < num_primes; k++)
-                mod_A[k]->rows[i][j] = residues[k];
+            mod_A[i].mod = mod;
+            mod_B[i].mod = mod;
+            mod_C[i].mod = mod;
         }
-    }
 
-    /* Calculate residues of B */
-    for (i = 0; i < B->r; i++)
-    {   for (j = 0; j < B->c; j++)
-        {   fmpz_multi_mod_ui(residues, &B->rows[i][j], comb, comb_temp);
-            for (k = 0; k < num_primes; k++)
-                mod_B[k]->rows[i][j] = residues[k];
+        fmpz_comb_init(comb, primes + k, nb);
+
+        fmpz_set_ui(M2, primes[k]);
+        for (i = 1; i < nb; i++)
+            fmpz_mul_ui(M2, M2, primes[k + i]);
+
+        if (k != 0)
+        {
+            fmpz_mod(c, M1, M2);
+            fmpz_invmod(c, c, M2);
         }
-    }
 
-    /* Multiply */
-    for (i = 0; i < num_primes; i++)
-    {
-        nmod_mat_mul(mod_C[i], mod_A[i], mod_B[i]);
-    }
+        for (i = 0; i < num_threads; i++)
+        {
+            args[i].C = C;
+            args[i].A = A;
+            args[i].B = B;
+            args[i].mod_A = mod_A;
+            args[i].mod_B = mod_B;
+            args[i].mod_C = mod_C;
+            args[i].num_primes = nb;
+            args[i].comb = comb;
+            args[i].M1 = (k == 0) ? NULL : M1;
+            args[i].M2 = M2;
+            args[i].c = c;
+            args[i].sign = (k + nb == num_primes);
+            args[i].next = &next;
+            args[i].mutex = (num_threads > 1) ? &mutex : NULL;
+        }
 
-    /* Chinese remaindering */
-    for (i = 0; i < C->r; i++)
-    {   for (j = 0; j < C->c; j++)
-        {   for (k = 0; k < num_primes; k++)
-                residues[k] = mod_C[k]->rows[i][j];
-            fmpz_multi_CRT_ui(&C->rows[i][j], residues, comb, comb_temp, 1);
+        /* Calculate residues of A and B */
+        rows = A->r + B->r;
+        num_workers = FLINT_MAX(FLINT_MIN(num_threads, rows), 1);
+        for (i = 0; i < num_workers; i++)
+        {
+            args[i].r0 = (rows * i) / num_workers;
+            args[i].r1 = (rows * (i + 1)) / num_workers;
+            args[i].num_threads = 1;
         }
+        _fmpz_mat_mul_multi_mod_run(_fmpz_mat_mul_multi_mod_reduce,
+                                                        args, num_workers);
+
+        /* Multiply, sharing spare threads among the products */
+        next = 0;
+        num_workers = FLINT_MIN(num_threads, nb);
+        for (i = 0; i < num_workers; i++)
+        {
+            args[i].num_threads = (num_threads * (i + 1)) / num_workers
+                                - (num_threads * i) / num_workers;
+        }
+        _fmpz_mat_mul_multi_mod_run(_fmpz_mat_mul_multi_mod_mul,
+                                                        args, num_workers);
+
+        /* Chinese remaindering */
+        rows = C->r;
+        num_workers = FLINT_MAX(FLINT_MIN(num_threads, rows), 1);
+        for (i = 0; i < num_workers; i++)
+        {
+            args[i].r0 = (rows * i) / num_workers;
+            args[i].r1 = (rows * (i + 1)) / num_workers;
+            args[i].num_threads = 1;
+        }
+        _fmpz_mat_mul_multi_mod_run(_fmpz_mat_mul_multi_mod_crt,
+                                                        args, num_workers);
+
+        if (k == 0)
+            fmpz_swap(M1, M2);
+        else
+            fmpz_mul(M1, M1, M2);
+
+        fmpz_comb_clear(comb);
     }
 
     /* Cleanup */
-    for (i = 0; i < num_primes; i++)
+    for (i = 0; i < batch; i++)
     {
-        nmod_mat_clear(mod_A[i]);
-        nmod_mat_clear(mod_B[i]);
-        nmod_mat_clear(mod_C[i]);
+        nmod_mat_clear(mod_A + i);
+        nmod_mat_clear(mod_B + i);
+        nmod_mat_clear(mod_C + i);
     }
 
+    fmpz_clear(M1);
+    fmpz_clear(M2);
+    fmpz_clear(c);
+
+    pthread_mutex_destroy(&mutex);
+    flint_free(args);
+
     flint_free(mod_A);
     flint_free(mod_B);
     flint_free(mod_C);
 
-    fmpz_comb_temp_clear(comb_temp);
-    fmpz_comb_clear(comb);
-
-    flint_free(residues);
     flint_free(primes);
 }
 
+void
+_fmpz_mat_mul_multi_mod(fmpz_mat_t C, const fmpz_mat_t A, const fmpz_mat_t B,
+    mp_bitcnt_t bits)
+{
+    slong batch;
+
+    /*
+        Bound the memory taken by the residue matrices by streaming the
+        primes in batches, but keep every thread busy within a batch.
+    */
+    batch = FMPZ_MAT_MUL_MULTI_MOD_BATCH_LIMBS /
+                    FLINT_MAX(A->r * A->c + B->r * B->c + C->r * C->c, 1);
+    batch = FLINT_MAX(batch, flint_get_num_threads());
+
+    _fmpz_mat_mul_multi_mod_batch(C, A, B, bits, batch);
+}
+
 void
 fmpz_mat_mul_multi_mod(fmpz_mat_t C, const fmpz_mat_t A, const fmpz_mat_t B)
 {
@@ -49,7 +49,26 @@ int main(void)
         fmpz_mat_randtest(C, state, n_randint(state, 200) + 1);
 
         fmpz_mat_mul_classical_inline(C, A, B);
-        fmpz_mat_mul_multi_mod(D, A, B);
+
+        flint_set_num_threads(1 + n_randint(state, 4));
+
+        if (n_randint(state, 2))
+        {
+            fmpz_mat_mul_multi_mod(D, A, B);
+        }
+        else
+        {
+            /* stream the primes in small batches */
+            slong bits = FLINT_ABS(fmpz_mat_max_bits(A))
+                       + FLINT_ABS(fmpz_mat_max_bits(B))
+                       + FLINT_BIT_COUNT(n) + 1;
+
+            fmpz_mat_randtest(D, state, n_randint(state, 200) + 1);
+            _fmpz_mat_mul_multi_mod_batch(D, A, B, bits,
+                                                1 + n_randint(state, 4));
+        }
+
+        flint_set_num_threads(1);
 
         if (!fmpz_mat_equal(C, D))
         {
@@ -483,7 +483,20 @@ FLINT_DLL slong _fmpz_mpoly_mul_array(fmpz ** poly1, ulong ** exp1,
                          const fmpz * poly3, const ulong * exp3, slong len3, 
                                          slong * mults, slong num, slong bits);
 
-FLINT_DLL int fmpz_mpoly_mul_array(fmpz_mpoly_t poly1, 
+FLINT_DLL int fmpz_mpoly_mul_array(fmpz_mpoly_t poly1,
+                 const fmpz_mpoly_t poly2, const fmpz_mpoly_t poly3,
+                                                   const fmpz_mpoly_ctx_t ctx);
+
+FLINT_DLL slong _fmpz_mpoly_mul_array_chunked_threaded(fmpz ** poly1,
+      ulong ** exp1, slong * alloc, const fmpz * poly2, const ulong * exp2,
+               slong len2, const fmpz * poly3, const ulong * exp3, slong len3,
+            const slong * mults, slong num, slong nmain, slong bits,
+                                                              slong nthreads);
+
+FLINT_DLL slong _fmpz_mpoly_mul_array_main_vars(const slong * mults, slong n,
+                                                      slong len2, slong len3);
+
+FLINT_DLL int fmpz_mpoly_mul_array_threaded(fmpz_mpoly_t poly1,
                  const fmpz_mpoly_t poly2, const fmpz_mpoly_t poly3,
                                                    const fmpz_mpoly_ctx_t ctx);
 
@@ -525,6 +538,16 @@ FLINT_DLL int fmpz_mpoly_divides_monagan_pearce(fmpz_mpoly_t poly1,
                   const fmpz_mpoly_t poly2, const fmpz_mpoly_t poly3,
                                                    const fmpz_mpoly_ctx_t ctx);
 
+FLINT_DLL slong _fmpz_mpoly_divides_heap_threaded(fmpz ** poly1,
+                      ulong ** exp1, slong * alloc, const fmpz * poly2,
+                    const ulong * exp2, slong len2, const fmpz * poly3,
+                          const ulong * exp3, slong len3, slong bits, slong N,
+                                   ulong maskhi, ulong masklo, slong nthreads);
+
+FLINT_DLL int fmpz_mpoly_divides_heap_threaded(fmpz_mpoly_t poly1,
+                  const fmpz_mpoly_t poly2, const fmpz_mpoly_t poly3,
+                                                   const fmpz_mpoly_ctx_t ctx);
+
 /* Division ******************************************************************/
 
 FLINT_DLL slong _fmpz_mpoly_div_monagan_pearce(fmpz ** polyq,
@@ -557,6 +580,18 @@ FLINT_DLL int fmpz_mpoly_divrem_array(fmpz_mpoly_t q, fmpz_mpoly_t r,
                     const fmpz_mpoly_t poly2, const fmpz_mpoly_t poly3, 
                                                    const fmpz_mpoly_ctx_t ctx);
 
+FLINT_DLL slong _fmpz_mpoly_divrem_heap_threaded(slong * lenr,
+                fmpz ** polyq, ulong ** expq, slong * allocq,
+                fmpz ** polyr, ulong ** expr, slong * allocr,
+                const fmpz * poly2, const ulong * exp2, slong len2,
+                const fmpz * poly3, const ulong * exp3, slong len3,
+                   slong bits, slong N, ulong maskhi, ulong masklo,
+                                                               slong nthreads);
+
+FLINT_DLL void fmpz_mpoly_divrem_heap_threaded(fmpz_mpoly_t q, fmpz_mpoly_t r,
+                  const fmpz_mpoly_t poly2, const fmpz_mpoly_t poly3,
+                                                   const fmpz_mpoly_ctx_t ctx);
+
 FLINT_DLL void fmpz_mpoly_quasidivrem_heap(fmpz_t scale,
                         fmpz_mpoly_t q, fmpz_mpoly_t r,
                   const fmpz_mpoly_t poly2, const fmpz_mpoly_t poly3,
@@ -637,6 +672,15 @@ FLINT_DLL void fmpz_mpoly_term_content(fmpz_mpoly_t poly1,
 FLINT_DLL void fmpz_mpoly_gcd_prs(fmpz_mpoly_t poly1, fmpz_mpoly_t poly2,
                                fmpz_mpoly_t poly3, const fmpz_mpoly_ctx_t ctx);
 
+FLINT_DLL void fmpz_mpoly_gcd_brown(fmpz_mpoly_t G, const fmpz_mpoly_t A,
+                            const fmpz_mpoly_t B, const fmpz_mpoly_ctx_t ctx);
+
+FLINT_DLL void fmpz_mpoly_gcd_zippel(fmpz_mpoly_t G, const fmpz_mpoly_t A,
+                            const fmpz_mpoly_t B, const fmpz_mpoly_ctx_t ctx);
+
+FLINT_DLL void fmpz_mpoly_gcd(fmpz_mpoly_t G, const fmpz_mpoly_t A,
+                            const fmpz_mpoly_t B, const fmpz_mpoly_ctx_t ctx);
+
 FLINT_DLL int fmpz_mpoly_gcd_is_unit(const fmpz_mpoly_t a, const fmpz_mpoly_t b,
                                                    const fmpz_mpoly_ctx_t ctx);
 
@@ -709,6 +753,10 @@ void fmpz_mpoly_randtest(fmpz_mpoly_t poly, flint_rand_t state,
 
 /* Internal packing and conversion */
 
+FLINT_DLL void _fmpz_mpoly_convert_ord(fmpz_mpoly_t poly1, slong bits,
+                              const fmpz_mpoly_ctx_t ctx1,
+                       const fmpz_mpoly_t poly2, const fmpz_mpoly_ctx_t ctx2);
+
 FLINT_DLL slong _fmpz_mpoly_from_ulong_array(fmpz ** poly1,
                          ulong ** exp1, slong * alloc, ulong * poly2,
                           const slong * mults, slong num, slong bits, slong k);
@@ -725,7 +773,23 @@ FLINT_DLL slong _fmpz_mpoly_from_fmpz_array(fmpz ** poly1,
                          ulong ** exp1, slong * alloc, fmpz * poly2,
                           const slong * mults, slong num, slong bits, slong k);
 
-FLINT_DLL void _fmpz_mpoly_submul_array1_slong(ulong * poly1, 
+FLINT_DLL void _fmpz_mpoly_addmul_array1_slong1(ulong * poly1,
+                  const slong * poly2, const ulong * exp2, slong len2,
+                          const slong * poly3, const ulong * exp3, slong len3);
+
+FLINT_DLL void _fmpz_mpoly_addmul_array1_slong2(ulong * poly1,
+                  const slong * poly2, const ulong * exp2, slong len2,
+                          const slong * poly3, const ulong * exp3, slong len3);
+
+FLINT_DLL void _fmpz_mpoly_addmul_array1_slong(ulong * poly1,
+                  const slong * poly2, const ulong * exp2, slong len2,
+                          const slong * poly3, const ulong * exp3, slong len3);
+
+FLINT_DLL void _fmpz_mpoly_addmul_array1_fmpz(fmpz * poly1,
+                  const fmpz * poly2, const ulong * exp2, slong len2,
+                           const fmpz * poly3, const ulong * exp3, slong len3);
+
+FLINT_DLL void _fmpz_mpoly_submul_array1_slong(ulong * poly1,
                   const slong * poly2, const ulong * exp2, slong len2,
                           const slong * poly3, const ulong * exp3, slong len3);
 
@@ -832,6 +896,11 @@ void _fmpz_mpoly_addmul_uiuiui_fmpz(ulong * c, slong d1, slong d2)
 
 
 
+/* Internal GCD */
+
+FLINT_DLL void _fmpz_mpoly_gcd_modular(fmpz_mpoly_t G, const fmpz_mpoly_t A,
+                const fmpz_mpoly_t B, int zippel, const fmpz_mpoly_ctx_t ctx);
+
 /******************************************************************************
 
    Internal consistency checks
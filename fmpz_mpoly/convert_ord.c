@@ -0,0 +1,76 @@
+/*
+    Copyright (C) 2026 agent
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include <gmp.h>
+#include <stdlib.h>
+#include "flint.h"
+#include "fmpz.h"
+#include "fmpz_mpoly.h"
+
+/*
+   Set poly1 to poly2 with its exponents repacked into the given number of
+   bits with respect to the ordering of ctx1. The contexts must have the
+   same number of variables and the bits must be sufficient to hold the
+   exponents (and total degree if any) of poly2 in the new ordering.
+*/
+void _fmpz_mpoly_convert_ord(fmpz_mpoly_t poly1, slong bits,
+                              const fmpz_mpoly_ctx_t ctx1,
+                     const fmpz_mpoly_t poly2, const fmpz_mpoly_ctx_t ctx2)
+{
+   slong i, N1, N2, len = poly2->length;
+   int deg1, rev1, deg2, rev2;
+   ulong maskhi, masklo;
+   ulong * exps, * user;
+   slong * perm;
+   fmpz_mpoly_t t;
+   TMP_INIT;
+
+   degrev_from_ord(deg1, rev1, ctx1->ord);
+   degrev_from_ord(deg2, rev2, ctx2->ord);
+
+   N1 = words_per_exp(ctx1->n, bits);
+   N2 = words_per_exp(ctx2->n, poly2->bits);
+   masks_from_bits_ord(maskhi, masklo, bits, ctx1->ord);
+
+   TMP_START;
+
+   exps = (ulong *) flint_malloc(len*N1*sizeof(ulong));
+   perm = (slong *) TMP_ALLOC(len*sizeof(slong));
+   user = (ulong *) TMP_ALLOC(ctx2->n*sizeof(ulong));
+
+   for (i = 0; i < len; i++)
+   {
+      mpoly_get_monomial(user, poly2->exps + i*N2,
+                                          poly2->bits, ctx2->n, deg2, rev2);
+      mpoly_set_monomial(exps + i*N1, user, bits, ctx1->n, deg1, rev1);
+   }
+
+   mpoly_monomials_sort(perm, exps, len, N1, maskhi, masklo);
+
+   fmpz_mpoly_init2(t, len, ctx1);
+   fmpz_mpoly_fit_bits(t, bits, ctx1);
+   t->bits = bits;
+
+   for (i = 0; i < len; i++)
+   {
+      fmpz_set(t->coeffs + i, poly2->coeffs + perm[i]);
+      mpoly_monomial_set(t->exps + i*N1, exps + perm[i]*N1, N1);
+   }
+
+   _fmpz_mpoly_set_length(t, len, ctx1);
+
+   fmpz_mpoly_swap(poly1, t, ctx1);
+   fmpz_mpoly_clear(t, ctx1);
+
+   flint_free(exps);
+
+   TMP_END;
+}
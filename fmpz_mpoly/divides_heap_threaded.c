@@ -0,0 +1,175 @@
+/*
+    Copyright (C) 2026 agent
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include <gmp.h>
+#include <stdlib.h>
+#include "flint.h"
+#include "fmpz.h"
+#include "fmpz_mpoly.h"
+
+slong _fmpz_mpoly_divides_heap_threaded(fmpz ** poly1, ulong ** exp1,
+         slong * alloc, const fmpz * poly2, const ulong * exp2, slong len2,
+       const fmpz * poly3, const ulong * exp3, slong len3, slong bits, slong N,
+                                    ulong maskhi, ulong masklo, slong nthreads)
+{
+   slong lenr;
+
+   return _fmpz_mpoly_divrem_heap_threaded(&lenr, poly1, exp1, alloc,
+                      NULL, NULL, NULL, poly2, exp2, len2, poly3, exp3, len3,
+                                          bits, N, maskhi, masklo, nthreads);
+}
+
+/* return 1 if quotient is exact */
+int fmpz_mpoly_divides_heap_threaded(fmpz_mpoly_t poly1,
+                  const fmpz_mpoly_t poly2, const fmpz_mpoly_t poly3,
+                                                    const fmpz_mpoly_ctx_t ctx)
+{
+   slong i, bits, exp_bits, N, len = 0;
+   ulong * max_degs2, * max_degs3;
+   ulong max = 0;
+   ulong maskhi, masklo;
+   ulong * exp2 = poly2->exps, * exp3 = poly3->exps, * expq;
+   int free2 = 0, free3 = 0;
+   ulong mask = 0;
+   TMP_INIT;
+
+   /* check divisor is nonzero */
+   if (poly3->length == 0)
+      flint_throw(FLINT_DIVZERO, "Divide by zero in fmpz_mpoly_divides_heap_threaded");
+
+   /* dividend zero, write out quotient */
+   if (poly2->length == 0)
+   {
+      fmpz_mpoly_zero(poly1, ctx);
+
+      return 1;
+   }
+
+   TMP_START;
+
+   max_degs2 = (ulong *) TMP_ALLOC(ctx->n*sizeof(ulong));
+   max_degs3 = (ulong *) TMP_ALLOC(ctx->n*sizeof(ulong));
+
+   /* compute maximum degree appearing in inputs and outputs */
+   fmpz_mpoly_max_degrees(max_degs2, poly2, ctx);
+   fmpz_mpoly_max_degrees(max_degs3, poly3, ctx);
+
+   for (i = 0; i < ctx->n; i++)
+   {
+      if (max_degs2[i] > max)
+         max = max_degs2[i];
+
+      /* cannot be exact division if poly2 degrees less than those of poly3 */
+      if (max_degs2[i] < max_degs3[i])
+      {
+         len = 0;
+
+         goto cleanup;
+      }
+   }
+
+   /* compute number of bits required for exponent fields */
+   bits = FLINT_BIT_COUNT(max);
+
+   exp_bits = 8;
+   while (bits >= exp_bits)
+      exp_bits += 1;
+
+   exp_bits = FLINT_MAX(exp_bits, poly2->bits);
+   exp_bits = FLINT_MAX(exp_bits, poly3->bits);
+   exp_bits = mpoly_optimize_bits(exp_bits, ctx->n);
+
+   masks_from_bits_ord(maskhi, masklo, exp_bits, ctx->ord);
+   N = words_per_exp(ctx->n, exp_bits);
+
+   /* temporary space to check leading monomials divide */
+   expq = (ulong *) TMP_ALLOC(N*sizeof(ulong));
+
+   /* quick check for easy case of inexact division of leading monomials */
+   if (poly2->bits == poly3->bits && N == 1 &&
+       poly2->exps[0] < poly3->exps[0])
+   {
+      goto cleanup;
+   }
+
+   /* ensure input exponents packed to same size as output exponents */
+   if (exp_bits > poly2->bits)
+   {
+      free2 = 1;
+      exp2 = (ulong *) flint_malloc(N*poly2->length*sizeof(ulong));
+      mpoly_unpack_monomials(exp2, exp_bits, poly2->exps, poly2->bits,
+                                                        poly2->length, ctx->n);
+   }
+
+   if (exp_bits > poly3->bits)
+   {
+      free3 = 1;
+      exp3 = (ulong *) flint_malloc(N*poly3->length*sizeof(ulong));
+      mpoly_unpack_monomials(exp3, exp_bits, poly3->exps, poly3->bits,
+                                                        poly3->length, ctx->n);
+   }
+
+   /* mask with high bit of each exponent vector field set */
+   for (i = 0; i < FLINT_BITS/exp_bits; i++)
+      mask = (mask << exp_bits) + (UWORD(1) << (exp_bits - 1));
+
+   /* check leading monomial divides exactly */
+   if (!mpoly_monomial_divides(expq, exp2, exp3, N, mask))
+   {
+      len = 0;
+
+      goto cleanup;
+   }
+
+   /* deal with aliasing and divide polynomials */
+   if (poly1 == poly2 || poly1 == poly3)
+   {
+      fmpz_mpoly_t temp;
+
+      fmpz_mpoly_init2(temp, poly2->length/poly3->length + 1, ctx);
+      fmpz_mpoly_fit_bits(temp, exp_bits, ctx);
+      temp->bits = exp_bits;
+
+      len = _fmpz_mpoly_divides_heap_threaded(&temp->coeffs, &temp->exps,
+                            &temp->alloc, poly2->coeffs, exp2, poly2->length,
+                              poly3->coeffs, exp3, poly3->length, exp_bits, N,
+                                      maskhi, masklo, flint_get_num_threads());
+
+      fmpz_mpoly_swap(temp, poly1, ctx);
+
+      fmpz_mpoly_clear(temp, ctx);
+   } else
+   {
+      fmpz_mpoly_fit_length(poly1, poly2->length/poly3->length + 1, ctx);
+      fmpz_mpoly_fit_bits(poly1, exp_bits, ctx);
+      poly1->bits = exp_bits;
+
+      len = _fmpz_mpoly_divides_heap_threaded(&poly1->coeffs, &poly1->exps,
+                            &poly1->alloc, poly2->coeffs, exp2, poly2->length,
+                              poly3->coeffs, exp3, poly3->length, exp_bits, N,
+                                      maskhi, masklo, flint_get_num_threads());
+   }
+
+cleanup:
+
+   _fmpz_mpoly_set_length(poly1, len, ctx);
+
+   if (free2)
+      flint_free(exp2);
+
+   if (free3)
+      flint_free(exp3);
+
+   TMP_END;
+
+   /* division is exact if len is nonzero */
+   return (len != 0);
+}
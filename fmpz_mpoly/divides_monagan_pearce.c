@@ -296,6 +296,21 @@ not_exact_division:
     goto cleanup;
 }
 
+/* versions for exponent vectors of exactly two, three and four words */
+#define W 2
+#include "fmpz_mpoly_templates.h"
+#include "fmpz_mpoly_templates/divides_monagan_pearce.c"
+#undef W
+
+#define W 3
+#include "fmpz_mpoly_templates.h"
+#include "fmpz_mpoly_templates/divides_monagan_pearce.c"
+#undef W
+
+#define W 4
+#include "fmpz_mpoly_templates.h"
+#include "fmpz_mpoly_templates/divides_monagan_pearce.c"
+#undef W
 
 slong _fmpz_mpoly_divides_monagan_pearce(fmpz ** poly1, ulong ** exp1,
          slong * alloc, const fmpz * poly2, const ulong * exp2, slong len2,
@@ -328,6 +343,19 @@ slong _fmpz_mpoly_divides_monagan_pearce(fmpz ** poly1, ulong ** exp1,
         return _fmpz_mpoly_divides_monagan_pearce1(poly1, exp1, alloc,
                            poly2, exp2, len2, poly3, exp3, len3, bits, maskhi);
 
+    /* if exponent vectors take two to four words, call special versions */
+    if (N == 2)
+        return _fmpz_mpoly_divides_monagan_pearce2(poly1, exp1, alloc,
+                   poly2, exp2, len2, poly3, exp3, len3, bits, maskhi, masklo);
+
+    if (N == 3)
+        return _fmpz_mpoly_divides_monagan_pearce3(poly1, exp1, alloc,
+                   poly2, exp2, len2, poly3, exp3, len3, bits, maskhi, masklo);
+
+    if (N == 4)
+        return _fmpz_mpoly_divides_monagan_pearce4(poly1, exp1, alloc,
+                   poly2, exp2, len2, poly3, exp3, len3, bits, maskhi, masklo);
+
     TMP_START;
 
     fmpz_init(acc_lg);
@@ -0,0 +1,941 @@
+/*
+    Copyright (C) 2026 agent
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include <gmp.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include "flint.h"
+#include "fmpz.h"
+#include "fmpz_vec.h"
+#include "fmpz_mpoly.h"
+
+/*
+   The dividend is split into chunks of consecutive terms and the chunks are
+   divided in order by whichever thread is free when the previous one is
+   finished (the leader). Quotient terms are appended to a quotient shared by
+   all threads and published in batches. Meanwhile the other threads multiply
+   published quotient terms by the divisor, keeping only the products that
+   fall into a chunk which has not been divided yet, and accumulate these for
+   the chunk. So when the leader reaches a chunk, most of the products it has
+   to subtract are already summed, and it only has to deal with products of
+   the quotient terms it generates itself.
+*/
+
+/* number of quotient terms published or multiplied at once */
+#define DIVREM_HEAP_BATCH 32
+
+typedef struct
+{
+   const fmpz * coeffs;       /* terms of the dividend in the chunk */
+   const ulong * exps;
+   slong length;
+   const ulong * upper;       /* monomials in chunk come after upper */
+   const ulong * lower;       /* and do not come after lower */
+   fmpz_mpoly_struct levels[FLINT_BITS]; /* partial sums of products */
+   slong nlevels;
+   slong applied;             /* number of quotient terms in the sums */
+   int busy;
+} _divrem_heap_chunk_struct;
+
+typedef struct
+{
+   pthread_mutex_t mutex;
+   pthread_cond_t cond;
+   const fmpz * poly3;
+   const ulong * exp3;
+   slong len3;
+   const ulong * min2;        /* last monomial of the dividend */
+   slong N;
+   ulong maskhi, masklo, mask;
+   _divrem_heap_chunk_struct * chunks;
+   slong nchunks;
+   slong lead;                /* chunk being divided */
+   fmpz * qcoeffs;            /* the shared quotient */
+   ulong * qexps;
+   slong qalloc;
+   slong qlen;                /* number of quotient terms published */
+   void * old[2*FLINT_BITS];  /* quotient arrays which have been replaced */
+   slong nold;
+   fmpz ** polyr;             /* remainder, NULL for exact division */
+   ulong ** expr;
+   slong * allocr;
+   slong lenr;
+   int failed;
+} _divrem_heap_base_t;
+
+typedef struct
+{
+   _divrem_heap_base_t * base;
+} _divrem_heap_arg_t;
+
+static void _divrem_heap_poly_init(fmpz_mpoly_struct * A)
+{
+   A->coeffs = NULL;
+   A->exps = NULL;
+   A->alloc = 0;
+   A->length = 0;
+}
+
+static void _divrem_heap_poly_clear(fmpz_mpoly_struct * A)
+{
+   _fmpz_vec_clear(A->coeffs, A->alloc);
+   flint_free(A->exps);
+}
+
+/* set A to A + B and clear B */
+static void _divrem_heap_poly_add(fmpz_mpoly_struct * A, fmpz_mpoly_struct * B,
+                                          slong N, ulong maskhi, ulong masklo)
+{
+   fmpz_mpoly_struct T;
+
+   if (B->length == 0)
+   {
+      _divrem_heap_poly_clear(B);
+      return;
+   }
+
+   if (A->length == 0)
+   {
+      _divrem_heap_poly_clear(A);
+      *A = *B;
+      return;
+   }
+
+   _divrem_heap_poly_init(&T);
+   _fmpz_mpoly_fit_length(&T.coeffs, &T.exps, &T.alloc,
+                                                  A->length + B->length, N);
+   T.length = _fmpz_mpoly_add(T.coeffs, T.exps, A->coeffs, A->exps,
+         A->length, B->coeffs, B->exps, B->length, N, maskhi, masklo);
+
+   _divrem_heap_poly_clear(A);
+   _divrem_heap_poly_clear(B);
+   *A = T;
+}
+
+/*
+   Return the first index i >= start such that expq + exp3[i] comes after
+   exp, assuming the exp3[i] are sorted. The array t is used as temporary
+   space for N words.
+*/
+static slong _divrem_heap_search(const ulong * expq, const ulong * exp3,
+           slong start, slong len3, const ulong * exp, ulong * t, slong N,
+                                                    ulong maskhi, ulong masklo)
+{
+   slong mid, stop = len3;
+
+   while (start < stop)
+   {
+      mid = start + (stop - start)/2;
+
+      mpoly_monomial_add(t, expq, exp3 + mid*N, N);
+
+      if (mpoly_monomial_gt(t, exp, N, maskhi, masklo))
+         stop = mid;
+      else
+         start = mid + 1;
+   }
+
+   return start;
+}
+
+/*
+   Set (poly1, exp1, alloc) to minus the sum of the products of
+   (polyq, expq, lenq) and (poly3, exp3, len3) whose monomials come after
+   upper and not after lower (either of which may be NULL for no bound) and
+   return its length. For each quotient term the products in range are found
+   by binary search and the rows are merged with a heap.
+*/
+static slong _fmpz_mpoly_mul_chunk(fmpz ** poly1, ulong ** exp1,
+         slong * alloc, const fmpz * polyq, const ulong * expq, slong lenq,
+                         const fmpz * poly3, const ulong * exp3, slong len3,
+              const ulong * upper, const ulong * lower, slong N, ulong maskhi,
+                                                                 ulong masklo)
+{
+   slong i, j, k;
+   slong next_loc = lenq + 4; /* something bigger than heap can ever be */
+   slong heap_len = 1; /* heap zero index unused */
+   mpoly_heap_s * heap;
+   mpoly_heap_t * chain, * x, * y;
+   ulong * exps, * t;
+   slong * ends;
+   fmpz * p1 = *poly1;
+   ulong * e1 = *exp1;
+
+   heap = (mpoly_heap_s *) flint_malloc((lenq + 1)*sizeof(mpoly_heap_s));
+   chain = (mpoly_heap_t *) flint_malloc(lenq*sizeof(mpoly_heap_t));
+   exps = (ulong *) flint_malloc((lenq + 1)*N*sizeof(ulong));
+   ends = (slong *) flint_malloc(lenq*sizeof(slong));
+   t = exps + lenq*N;
+
+   /* put the first product in range of each row into the heap */
+   for (j = 0; j < lenq; j++)
+   {
+      i = upper == NULL ? 0 : _divrem_heap_search(expq + j*N, exp3,
+                                0, len3, upper, t, N, maskhi, masklo);
+
+      ends[j] = lower == NULL ? len3 : _divrem_heap_search(expq + j*N, exp3,
+                                i, len3, lower, t, N, maskhi, masklo);
+
+      if (i < ends[j])
+      {
+         x = chain + j;
+         x->i = i;
+         x->j = j;
+         x->next = NULL;
+         mpoly_monomial_add(exps + j*N, expq + j*N, exp3 + i*N, N);
+         _mpoly_heap_insert(heap, exps + j*N, x,
+                                      &next_loc, &heap_len, N, maskhi, masklo);
+      }
+   }
+
+   k = -WORD(1);
+
+   while (heap_len > 1)
+   {
+      k++;
+      _fmpz_mpoly_fit_length(&p1, &e1, alloc, k + 1, N);
+
+      mpoly_monomial_set(e1 + k*N, heap[1].exp, N);
+      fmpz_zero(p1 + k);
+
+      while (heap_len > 1 && mpoly_monomial_equal(heap[1].exp, e1 + k*N, N))
+      {
+         x = _mpoly_heap_pop(heap, &heap_len, N, maskhi, masklo);
+
+         do
+         {
+            y = x->next;
+
+            fmpz_submul(p1 + k, polyq + x->j, poly3 + x->i);
+
+            /* move along the row */
+            if ((slong) x->i + 1 < ends[x->j])
+            {
+               x->i++;
+               x->next = NULL;
+               mpoly_monomial_add(exps + x->j*N, expq + x->j*N,
+                                                        exp3 + x->i*N, N);
+               _mpoly_heap_insert(heap, exps + x->j*N, x,
+                                      &next_loc, &heap_len, N, maskhi, masklo);
+            }
+         } while ((x = y) != NULL);
+      }
+
+      if (fmpz_is_zero(p1 + k))
+         k--;
+   }
+
+   k++;
+
+   flint_free(heap);
+   flint_free(chain);
+   flint_free(exps);
+   flint_free(ends);
+
+   (*poly1) = p1;
+   (*exp1) = e1;
+
+   return k;
+}
+
+/* add a product sum to a chunk, keeping sums of 2^i batches in level i */
+static void _divrem_heap_chunk_add(_divrem_heap_chunk_struct * C,
+                   fmpz_mpoly_struct * T, slong N, ulong maskhi, ulong masklo)
+{
+   slong i;
+
+   if (T->length == 0)
+   {
+      _divrem_heap_poly_clear(T);
+      return;
+   }
+
+   for (i = 0; i < C->nlevels && C->levels[i].length != 0; i++)
+   {
+      _divrem_heap_poly_add(T, C->levels + i, N, maskhi, masklo);
+      _divrem_heap_poly_init(C->levels + i);
+   }
+
+   if (i == C->nlevels)
+      C->nlevels++;
+   else
+      _divrem_heap_poly_clear(C->levels + i);
+
+   C->levels[i] = *T;
+}
+
+/*
+   Make space for len quotient terms, of which the first k are set. Other
+   threads may be reading the current arrays, so they are not freed until
+   the division is finished.
+*/
+static void _divrem_heap_fit_quotient(_divrem_heap_base_t * base, slong k,
+                                                                     slong len)
+{
+   slong i, N = base->N, alloc;
+   fmpz * qc;
+   ulong * qe;
+
+   if (len <= base->qalloc)
+      return;
+
+   alloc = FLINT_MAX(len, 2*base->qalloc);
+
+   qc = (fmpz *) flint_malloc(alloc*sizeof(fmpz));
+   qe = (ulong *) flint_malloc(alloc*N*sizeof(ulong));
+
+   memcpy(qc, base->qcoeffs, k*sizeof(fmpz));
+   memcpy(qe, base->qexps, k*N*sizeof(ulong));
+   flint_mpn_zero((mp_ptr) (qc + k), alloc - k);
+
+   for (i = k; i < base->qalloc; i++)
+      fmpz_clear(base->qcoeffs + i);
+
+   base->old[base->nold++] = base->qcoeffs;
+   base->old[base->nold++] = base->qexps;
+
+   pthread_mutex_lock(&base->mutex);
+   base->qcoeffs = qc;
+   base->qexps = qe;
+   pthread_mutex_unlock(&base->mutex);
+
+   base->qalloc = alloc;
+}
+
+/* append a remainder term, only done by the leader */
+static void _divrem_heap_remainder(_divrem_heap_base_t * base,
+                                              fmpz_t c, const ulong * exp)
+{
+   slong N = base->N;
+
+   _fmpz_mpoly_fit_length(base->polyr, base->expr, base->allocr,
+                                                          base->lenr + 1, N);
+   fmpz_swap(*base->polyr + base->lenr, c);
+   mpoly_monomial_set(*base->expr + base->lenr*N, exp, N);
+   base->lenr++;
+}
+
+/*
+   Divide chunk c by the divisor, appending the new quotient terms to the
+   shared quotient and setting *qlen to its new length. Return 0 if the
+   division was found to be inexact (or the remainder is required and an
+   exponent overflowed), otherwise 1.
+*/
+static int _fmpz_mpoly_divrem_heap_chunk(slong * qlen,
+                                     _divrem_heap_base_t * base, slong c)
+{
+   _divrem_heap_chunk_struct * C = base->chunks + c;
+   const fmpz * poly3 = base->poly3;
+   const ulong * exp3 = base->exp3, * lower = C->lower;
+   const fmpz * scoeffs;
+   const ulong * sexps;
+   slong i, j, k, s, pos, slen, len3 = base->len3, N = base->N;
+   slong next_loc = len3 + 4; /* something bigger than heap can ever be */
+   slong heap_len = 1; /* heap zero index unused */
+   slong nwait, nstore;
+   ulong maskhi = base->maskhi, masklo = base->masklo, mask = base->mask;
+   int exact = (base->polyr == NULL), newq, ok = 1;
+   fmpz_mpoly_struct S, T;
+   mpoly_heap_s * heap;
+   mpoly_heap_t * chain, * x;
+   mpoly_heap_t ** store;
+   ulong * exps, * exp;
+   slong * wait;
+   fmpz_t acc, r;
+
+   k = base->qlen;
+
+   /* sum the products of the quotient terms with the divisor so far */
+   _divrem_heap_poly_init(&S);
+
+   for (i = 0; i < C->nlevels; i++)
+      _divrem_heap_poly_add(&S, C->levels + i, N, maskhi, masklo);
+
+   C->nlevels = 0;
+
+   if (C->applied < k)
+   {
+      _divrem_heap_poly_init(&T);
+      T.length = _fmpz_mpoly_mul_chunk(&T.coeffs, &T.exps, &T.alloc,
+                  base->qcoeffs + C->applied, base->qexps + C->applied*N,
+                  k - C->applied, poly3, exp3, len3, C->upper, lower,
+                                                       N, maskhi, masklo);
+      _divrem_heap_poly_add(&S, &T, N, maskhi, masklo);
+      C->applied = k;
+   }
+
+   /* and subtract them from the dividend */
+   if (S.length == 0)
+   {
+      scoeffs = C->coeffs;
+      sexps = C->exps;
+      slen = C->length;
+   } else
+   {
+      _divrem_heap_poly_init(&T);
+      _fmpz_mpoly_fit_length(&T.coeffs, &T.exps, &T.alloc,
+                                                   C->length + S.length, N);
+      T.length = _fmpz_mpoly_add(T.coeffs, T.exps, C->coeffs, C->exps,
+                  C->length, S.coeffs, S.exps, S.length, N, maskhi, masklo);
+      _divrem_heap_poly_clear(&S);
+      S = T;
+
+      scoeffs = S.coeffs;
+      sexps = S.exps;
+      slen = S.length;
+   }
+
+   fmpz_init(acc);
+   fmpz_init(r);
+
+   /*
+      the heap contains one node for each divisor term after the first,
+      for the product with the next quotient term from this chunk; rows
+      which have used all quotient terms so far wait for the next one
+   */
+   heap = (mpoly_heap_s *) flint_malloc(len3*sizeof(mpoly_heap_s));
+   chain = (mpoly_heap_t *) flint_malloc(len3*sizeof(mpoly_heap_t));
+   store = (mpoly_heap_t **) flint_malloc(len3*sizeof(mpoly_heap_t *));
+   exps = (ulong *) flint_malloc((len3 + 1)*N*sizeof(ulong));
+   wait = (slong *) flint_malloc(len3*sizeof(slong));
+   exp = exps + len3*N;
+
+   nwait = 0;
+   for (i = len3 - 1; i >= 1; i--)
+      wait[nwait++] = i;
+
+   pos = 0;
+
+   while (pos < slen || heap_len > 1)
+   {
+      /* find the next monomial */
+      if (heap_len > 1 && (pos == slen ||
+            !mpoly_monomial_gt(heap[1].exp, sexps + pos*N, N, maskhi, masklo)))
+         mpoly_monomial_set(exp, heap[1].exp, N);
+      else
+         mpoly_monomial_set(exp, sexps + pos*N, N);
+
+      if (mpoly_monomial_overflows(exp, N, mask))
+      {
+         ok = 0;
+         goto cleanup;
+      }
+
+      /* accumulate its coefficient */
+      fmpz_zero(acc);
+
+      if (pos < slen && mpoly_monomial_equal(sexps + pos*N, exp, N))
+      {
+         fmpz_set(acc, scoeffs + pos);
+         pos++;
+      }
+
+      nstore = 0;
+
+      while (heap_len > 1 && mpoly_monomial_equal(heap[1].exp, exp, N))
+      {
+         x = _mpoly_heap_pop(heap, &heap_len, N, maskhi, masklo);
+
+         do
+         {
+            fmpz_submul(acc, base->qcoeffs + x->j, poly3 + x->i);
+            store[nstore++] = x;
+         } while ((x = x->next) != NULL);
+      }
+
+      /* try to divide it by the leading term */
+      newq = 0;
+
+      if (!fmpz_is_zero(acc))
+      {
+         _divrem_heap_fit_quotient(base, k, k + 1);
+
+         if (!mpoly_monomial_divides(base->qexps + k*N, exp, exp3, N, mask))
+         {
+            if (exact)
+            {
+               ok = 0;
+               goto cleanup;
+            }
+
+            _divrem_heap_remainder(base, acc, exp);
+         } else
+         {
+            fmpz_tdiv_qr(base->qcoeffs + k, r, acc, poly3 + 0);
+
+            if (!fmpz_is_zero(r))
+            {
+               if (exact)
+               {
+                  ok = 0;
+                  goto cleanup;
+               }
+
+               _divrem_heap_remainder(base, r, exp);
+            }
+
+            if (!fmpz_is_zero(base->qcoeffs + k))
+            {
+               /* exact quotient terms must not go past the dividend */
+               if (exact && mpoly_monomial_gt(exp, base->min2,
+                                                        N, maskhi, masklo))
+               {
+                  ok = 0;
+                  goto cleanup;
+               }
+
+               newq = 1;
+               k++;
+            }
+         }
+      }
+
+      /* move along the rows taken from the heap */
+      for (s = 0; s < nstore; s++)
+      {
+         x = store[s];
+
+         if ((slong) x->j + 1 < k)
+         {
+            x->j++;
+            x->next = NULL;
+            mpoly_monomial_add(exps + x->i*N, base->qexps + x->j*N,
+                                                        exp3 + x->i*N, N);
+
+            /* rows leaving the chunk are finished */
+            if (lower == NULL ||
+                  !mpoly_monomial_gt(exps + x->i*N, lower, N, maskhi, masklo))
+               _mpoly_heap_insert(heap, exps + x->i*N, x,
+                                      &next_loc, &heap_len, N, maskhi, masklo);
+         } else
+            wait[nwait++] = x->i;
+      }
+
+      /* start the waiting rows on the new quotient term */
+      if (newq)
+      {
+         j = k - 1;
+
+         while (nwait > 0)
+         {
+            i = wait[--nwait];
+
+            mpoly_monomial_add(exps + i*N, base->qexps + j*N, exp3 + i*N, N);
+
+            if (lower == NULL ||
+                  !mpoly_monomial_gt(exps + i*N, lower, N, maskhi, masklo))
+            {
+               x = chain + i;
+               x->i = i;
+               x->j = j;
+               x->next = NULL;
+               _mpoly_heap_insert(heap, exps + i*N, x,
+                                      &next_loc, &heap_len, N, maskhi, masklo);
+            }
+         }
+
+         /* publish a batch of quotient terms */
+         if (k - base->qlen >= DIVREM_HEAP_BATCH)
+         {
+            pthread_mutex_lock(&base->mutex);
+            base->qlen = k;
+            pthread_cond_broadcast(&base->cond);
+            pthread_mutex_unlock(&base->mutex);
+         }
+      }
+   }
+
+cleanup:
+
+   flint_free(heap);
+   flint_free(chain);
+   flint_free(store);
+   flint_free(exps);
+   flint_free(wait);
+
+   fmpz_clear(acc);
+   fmpz_clear(r);
+
+   _divrem_heap_poly_clear(&S);
+
+   *qlen = k;
+
+   return ok;
+}
+
+static void * _fmpz_mpoly_divrem_heap_threaded_worker(void * arg_ptr)
+{
+   _divrem_heap_arg_t * arg = (_divrem_heap_arg_t *) arg_ptr;
+   _divrem_heap_base_t * base = arg->base;
+   _divrem_heap_chunk_struct * C;
+   fmpz_mpoly_struct T;
+   const fmpz * qc;
+   const ulong * qe;
+   slong c, d, a, n, N = base->N;
+   int ok;
+
+   pthread_mutex_lock(&base->mutex);
+
+   while (!base->failed && base->lead < base->nchunks)
+   {
+      c = base->lead;
+      C = base->chunks + c;
+
+      /* divide the leading chunk if nobody is working on it */
+      if (!C->busy)
+      {
+         C->busy = 1;
+         pthread_mutex_unlock(&base->mutex);
+
+         ok = _fmpz_mpoly_divrem_heap_chunk(&n, base, c);
+
+         pthread_mutex_lock(&base->mutex);
+
+         if (ok)
+         {
+            base->qlen = n;
+            base->lead = c + 1;
+         } else
+            base->failed = 1;
+
+         C->busy = 0;
+         pthread_cond_broadcast(&base->cond);
+
+         continue;
+      }
+
+      /* otherwise add products to the nearest chunk with enough new terms */
+      for (d = c + 1; d < base->nchunks; d++)
+      {
+         C = base->chunks + d;
+
+         if (!C->busy && base->qlen - C->applied >= DIVREM_HEAP_BATCH)
+            break;
+      }
+
+      if (d == base->nchunks)
+      {
+         pthread_cond_wait(&base->cond, &base->mutex);
+
+         continue;
+      }
+
+      C->busy = 1;
+      a = C->applied;
+      n = base->qlen;
+      qc = base->qcoeffs;
+      qe = base->qexps;
+
+      pthread_mutex_unlock(&base->mutex);
+
+      _divrem_heap_poly_init(&T);
+      T.length = _fmpz_mpoly_mul_chunk(&T.coeffs, &T.exps, &T.alloc,
+                        qc + a, qe + a*N, n - a, base->poly3, base->exp3,
+                        base->len3, C->upper, C->lower,
+                                              N, base->maskhi, base->masklo);
+      _divrem_heap_chunk_add(C, &T, N, base->maskhi, base->masklo);
+
+      pthread_mutex_lock(&base->mutex);
+
+      C->applied = n;
+      C->busy = 0;
+      pthread_cond_broadcast(&base->cond);
+   }
+
+   pthread_mutex_unlock(&base->mutex);
+
+   return NULL;
+}
+
+/*
+   Set (polyq, expq, allocq) and (polyr, expr, allocr) to the quotient and
+   remainder of (poly2, exp2, len2) by (poly3, exp3, len3) using the given
+   number of threads and return the length of the quotient. If polyr is NULL
+   only an exact quotient is computed, and zero is returned if the division
+   is not exact. Otherwise lenr is set to the length of the remainder and
+   zero is returned for both if an exponent overflows.
+*/
+slong _fmpz_mpoly_divrem_heap_threaded(slong * lenr,
+                fmpz ** polyq, ulong ** expq, slong * allocq,
+                fmpz ** polyr, ulong ** expr, slong * allocr,
+                const fmpz * poly2, const ulong * exp2, slong len2,
+                const fmpz * poly3, const ulong * exp3, slong len3,
+                   slong bits, slong N, ulong maskhi, ulong masklo,
+                                                                slong nthreads)
+{
+   _divrem_heap_base_t base[1];
+   _divrem_heap_chunk_struct * C;
+   _divrem_heap_arg_t * args;
+   slong i, c, start, stop, lenq;
+
+   base->poly3 = poly3;
+   base->exp3 = exp3;
+   base->len3 = len3;
+   base->min2 = exp2 + (len2 - 1)*N;
+   base->N = N;
+   base->maskhi = maskhi;
+   base->masklo = masklo;
+
+   /* mask with high bit set in each field of exponent vector */
+   base->mask = 0;
+   for (i = 0; i < FLINT_BITS/bits; i++)
+      base->mask = (base->mask << bits) + (UWORD(1) << (bits - 1));
+
+   base->qcoeffs = *polyq;
+   base->qexps = *expq;
+   base->qalloc = *allocq;
+   base->qlen = 0;
+   base->nold = 0;
+
+   base->polyr = polyr;
+   base->expr = expr;
+   base->allocr = allocr;
+   base->lenr = 0;
+
+   base->failed = 0;
+   base->lead = 0;
+
+   /* split the dividend into chunks of consecutive terms */
+   nthreads = FLINT_MAX(nthreads, 1);
+   base->nchunks = nthreads == 1 ? 1 : FLINT_MIN(len2, 16*nthreads);
+   base->chunks = (_divrem_heap_chunk_struct *) flint_malloc(
+                           base->nchunks*sizeof(_divrem_heap_chunk_struct));
+
+   for (c = 0; c < base->nchunks; c++)
+   {
+      C = base->chunks + c;
+
+      start = c*len2/base->nchunks;
+      stop = (c + 1)*len2/base->nchunks;
+
+      C->coeffs = poly2 + start;
+      C->exps = exp2 + start*N;
+      C->length = stop - start;
+      C->upper = c == 0 ? NULL : exp2 + (start - 1)*N;
+      C->lower = c + 1 == base->nchunks ? NULL : exp2 + (stop - 1)*N;
+      C->nlevels = 0;
+      C->applied = 0;
+      C->busy = 0;
+   }
+
+   args = (_divrem_heap_arg_t *) flint_malloc(
+                                           nthreads*sizeof(_divrem_heap_arg_t));
+   for (i = 0; i < nthreads; i++)
+      args[i].base = base;
+
+   pthread_mutex_init(&base->mutex, NULL);
+   pthread_cond_init(&base->cond, NULL);
+
+   flint_parallel_do(_fmpz_mpoly_divrem_heap_threaded_worker,
+                                 args, sizeof(_divrem_heap_arg_t), nthreads);
+
+   pthread_cond_destroy(&base->cond);
+   pthread_mutex_destroy(&base->mutex);
+
+   /* clean up */
+   for (c = 0; c < base->nchunks; c++)
+   {
+      C = base->chunks + c;
+
+      for (i = 0; i < C->nlevels; i++)
+         _divrem_heap_poly_clear(C->levels + i);
+   }
+
+   for (i = 0; i < base->nold; i++)
+      flint_free(base->old[i]);
+
+   lenq = base->qlen;
+   *lenr = base->lenr;
+
+   if (base->failed)
+   {
+      for (i = 0; i < base->qalloc; i++)
+         _fmpz_demote(base->qcoeffs + i);
+
+      for (i = 0; i < base->lenr; i++)
+         _fmpz_demote(*polyr + i);
+
+      lenq = 0;
+      *lenr = 0;
+   }
+
+   *polyq = base->qcoeffs;
+   *expq = base->qexps;
+   *allocq = base->qalloc;
+
+   flint_free(args);
+   flint_free(base->chunks);
+
+   return lenq;
+}
+
+void fmpz_mpoly_divrem_heap_threaded(fmpz_mpoly_t q, fmpz_mpoly_t r,
+                  const fmpz_mpoly_t poly2, const fmpz_mpoly_t poly3,
+                                                    const fmpz_mpoly_ctx_t ctx)
+{
+   slong exp_bits, N, lenq = 0, lenr = 0;
+   ulong * exp2 = poly2->exps, * exp3 = poly3->exps;
+   ulong maskhi, masklo;
+   int free2 = 0, free3 = 0;
+   fmpz_mpoly_t temp1, temp2;
+   fmpz_mpoly_struct * tq, * tr;
+
+   /* check divisor is nonzero */
+   if (poly3->length == 0)
+      flint_throw(FLINT_DIVZERO, "Divide by zero in fmpz_mpoly_divrem_heap_threaded");
+
+   /* dividend zero, write out quotient and remainder */
+   if (poly2->length == 0)
+   {
+      fmpz_mpoly_zero(q, ctx);
+      fmpz_mpoly_zero(r, ctx);
+
+      return;
+   }
+
+   /* maximum bits in quotient and remainder exps is max for poly2 and poly3 */
+   exp_bits = FLINT_MAX(poly2->bits, poly3->bits);
+
+   masks_from_bits_ord(maskhi, masklo, exp_bits, ctx->ord);
+   /* number of words required for exponent vectors */
+   N = words_per_exp(ctx->n, exp_bits);
+
+   /* ensure input exponents packed to same size as output exponents */
+   if (exp_bits > poly2->bits)
+   {
+      free2 = 1;
+      exp2 = (ulong *) flint_malloc(N*poly2->length*sizeof(ulong));
+      mpoly_unpack_monomials(exp2, exp_bits, poly2->exps, poly2->bits,
+                                                        poly2->length, ctx->n);
+   }
+
+   if (exp_bits > poly3->bits)
+   {
+      free3 = 1;
+      exp3 = (ulong *) flint_malloc(N*poly3->length*sizeof(ulong));
+      mpoly_unpack_monomials(exp3, exp_bits, poly3->exps, poly3->bits,
+                                                        poly3->length, ctx->n);
+   }
+
+   /* check divisor leading monomial is at most that of the dividend */
+   if (mpoly_monomial_lt(exp3, exp2, N, maskhi, masklo))
+   {
+      fmpz_mpoly_set(r, poly2, ctx);
+      fmpz_mpoly_zero(q, ctx);
+
+      goto cleanup;
+   }
+
+   /* take care of aliasing */
+   if (q == poly2 || q == poly3)
+   {
+      fmpz_mpoly_init2(temp1, FLINT_MAX(poly2->length/poly3->length + 1, 1),
+                                                                          ctx);
+      fmpz_mpoly_fit_bits(temp1, exp_bits, ctx);
+      temp1->bits = exp_bits;
+
+      tq = temp1;
+   } else
+   {
+      fmpz_mpoly_fit_length(q, FLINT_MAX(poly2->length/poly3->length + 1, 1),
+                                                                          ctx);
+      fmpz_mpoly_fit_bits(q, exp_bits, ctx);
+      q->bits = exp_bits;
+
+      tq = q;
+   }
+
+   if (r == poly2 || r == poly3)
+   {
+      fmpz_mpoly_init2(temp2, poly3->length, ctx);
+      fmpz_mpoly_fit_bits(temp2, exp_bits, ctx);
+      temp2->bits = exp_bits;
+
+      tr = temp2;
+   } else
+   {
+      fmpz_mpoly_fit_length(r, poly3->length, ctx);
+      fmpz_mpoly_fit_bits(r, exp_bits, ctx);
+      r->bits = exp_bits;
+
+      tr = r;
+   }
+
+   /* do division with remainder, with more bits if an exponent overflows */
+   while ((lenq = _fmpz_mpoly_divrem_heap_threaded(&lenr, &tq->coeffs,
+         &tq->exps, &tq->alloc, &tr->coeffs, &tr->exps, &tr->alloc,
+         poly2->coeffs, exp2, poly2->length, poly3->coeffs, exp3,
+         poly3->length, exp_bits, N, maskhi, masklo,
+                                          flint_get_num_threads())) == 0
+         && lenr == 0 && exp_bits < FLINT_BITS)
+   {
+      ulong * old_exp2 = exp2, * old_exp3 = exp3;
+      slong old_exp_bits = exp_bits;
+
+      exp_bits = mpoly_optimize_bits(exp_bits + 1, ctx->n);
+
+      masks_from_bits_ord(maskhi, masklo, exp_bits, ctx->ord);
+      N = words_per_exp(ctx->n, exp_bits);
+
+      exp2 = (ulong *) flint_malloc(N*poly2->length*sizeof(ulong));
+      mpoly_unpack_monomials(exp2, exp_bits, old_exp2, old_exp_bits,
+                                                        poly2->length, ctx->n);
+
+      exp3 = (ulong *) flint_malloc(N*poly3->length*sizeof(ulong));
+      mpoly_unpack_monomials(exp3, exp_bits, old_exp3, old_exp_bits,
+                                                        poly3->length, ctx->n);
+
+      if (free2)
+         flint_free(old_exp2);
+
+      if (free3)
+         flint_free(old_exp3);
+
+      free2 = free3 = 1;
+
+      fmpz_mpoly_fit_bits(tq, exp_bits, ctx);
+      tq->bits = exp_bits;
+
+      fmpz_mpoly_fit_bits(tr, exp_bits, ctx);
+      tr->bits = exp_bits;
+   }
+
+   if (lenq == 0 && lenr == 0)
+      flint_throw(FLINT_EXPOF,
+                      "Exponent overflow in fmpz_mpoly_divrem_heap_threaded");
+
+   /* deal with aliasing */
+   if (q == poly2 || q == poly3)
+   {
+      fmpz_mpoly_swap(temp1, q, ctx);
+
+      fmpz_mpoly_clear(temp1, ctx);
+   }
+
+   if (r == poly2 || r == poly3)
+   {
+      fmpz_mpoly_swap(temp2, r, ctx);
+
+      fmpz_mpoly_clear(temp2, ctx);
+   }
+
+   _fmpz_mpoly_set_length(q, lenq, ctx);
+   _fmpz_mpoly_set_length(r, lenr, ctx);
+
+cleanup:
+
+   if (free2)
+      flint_free(exp2);
+
+   if (free3)
+      flint_free(exp3);
+}
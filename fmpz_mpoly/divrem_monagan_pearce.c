@@ -349,8 +349,21 @@ exp_overflow:
     goto cleanup;
 }
 
-
-
+/* versions for exponent vectors of exactly two, three and four words */
+#define W 2
+#include "fmpz_mpoly_templates.h"
+#include "fmpz_mpoly_templates/divrem_monagan_pearce.c"
+#undef W
+
+#define W 3
+#include "fmpz_mpoly_templates.h"
+#include "fmpz_mpoly_templates/divrem_monagan_pearce.c"
+#undef W
+
+#define W 4
+#include "fmpz_mpoly_templates.h"
+#include "fmpz_mpoly_templates/divrem_monagan_pearce.c"
+#undef W
 
 slong _fmpz_mpoly_divrem_monagan_pearce(slong * lenr,
   fmpz ** polyq, ulong ** expq, slong * allocq, fmpz ** polyr,
@@ -387,6 +400,22 @@ slong _fmpz_mpoly_divrem_monagan_pearce(slong * lenr,
                                      polyr, expr, allocr, poly2, exp2, len2,
                                               poly3, exp3, len3, bits, maskhi);
 
+    /* if exponent vectors take two to four words, call special versions */
+    if (N == 2)
+        return _fmpz_mpoly_divrem_monagan_pearce2(lenr, polyq, expq, allocq,
+                                     polyr, expr, allocr, poly2, exp2, len2,
+                                      poly3, exp3, len3, bits, maskhi, masklo);
+
+    if (N == 3)
+        return _fmpz_mpoly_divrem_monagan_pearce3(lenr, polyq, expq, allocq,
+                                     polyr, expr, allocr, poly2, exp2, len2,
+                                      poly3, exp3, len3, bits, maskhi, masklo);
+
+    if (N == 4)
+        return _fmpz_mpoly_divrem_monagan_pearce4(lenr, polyq, expq, allocq,
+                                     polyr, expr, allocr, poly2, exp2, len2,
+                                      poly3, exp3, len3, bits, maskhi, masklo);
+
     TMP_START;
 
     fmpz_init(acc_lg);
@@ -0,0 +1,67 @@
+/*
+    Copyright (C) 2026 agent
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include <gmp.h>
+#include <stdlib.h>
+#include "flint.h"
+#include "fmpz.h"
+#include "fmpz_mpoly.h"
+
+/*
+   Choose between the dense and sparse modular algorithms by comparing the
+   number of terms of the inputs with the size of the dense representation
+   in the variables that actually occur. Brown's algorithm needs a number
+   of univariate images that is roughly the product of the degrees, which
+   only pays off if the inputs fill a reasonable part of that box.
+*/
+void fmpz_mpoly_gcd(fmpz_mpoly_t G, const fmpz_mpoly_t A,
+                             const fmpz_mpoly_t B, const fmpz_mpoly_ctx_t ctx)
+{
+   slong i, nvars, occur;
+   int deg, rev;
+   slong * degA, * degB;
+   double dense;
+   TMP_INIT;
+
+   if (A->length == 0 || B->length == 0)
+   {
+      _fmpz_mpoly_gcd_modular(G, A, B, 0, ctx);
+      return;
+   }
+
+   TMP_START;
+
+   degrev_from_ord(deg, rev, ctx->ord);
+   nvars = ctx->n - deg;
+
+   degA = (slong *) TMP_ALLOC(nvars*sizeof(slong));
+   degB = (slong *) TMP_ALLOC(nvars*sizeof(slong));
+   fmpz_mpoly_degrees(degA, A, ctx);
+   fmpz_mpoly_degrees(degB, B, ctx);
+
+   dense = 1.0;
+   occur = 0;
+   for (i = 0; i < nvars; i++)
+   {
+      slong d = FLINT_MAX(degA[i], degB[i]);
+
+      if (d > 0)
+      {
+         dense *= d + 1;
+         occur++;
+      }
+   }
+
+   TMP_END;
+
+   _fmpz_mpoly_gcd_modular(G, A, B,
+              occur > 2 && 16.0*(A->length + B->length) < dense, ctx);
+}
@@ -0,0 +1,306 @@
+/*
+    Copyright (C) 2026 agent
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include <gmp.h>
+#include <stdlib.h>
+#include "flint.h"
+#include "fmpz.h"
+#include "fmpz_vec.h"
+#include "fmpz_mpoly.h"
+#include "nmod_mpoly.h"
+
+/*
+   Set H to the polynomial congruent to H modulo m and to g modulo p, with
+   coefficients in the symmetric range. Return 1 if H was changed.
+*/
+static int _fmpz_mpoly_crt_nmod(fmpz_mpoly_t H, const fmpz_t m,
+                   const nmod_mpoly_t g, const fmpz_mpoly_ctx_t ctx,
+                                                  const nmod_mpoly_ctx_t pctx)
+{
+   slong i, j, k, N = words_per_exp(ctx->n, g->bits);
+   mp_limb_t p = pctx->mod.n, pinv, c;
+   int cmp, changed = 0;
+   fmpz_t mp, zero;
+   fmpz_mpoly_t T;
+
+   fmpz_init(mp);
+   fmpz_init(zero);
+   fmpz_mul_ui(mp, m, p);
+   c = n_invmod(fmpz_fdiv_ui(m, p), p);
+   pinv = n_preinvert_limb(p);
+
+   fmpz_mpoly_init2(T, H->length + g->length, ctx);
+   fmpz_mpoly_fit_bits(T, g->bits, ctx);
+   T->bits = g->bits;
+
+   i = j = k = 0;
+   while (i < H->length || j < g->length)
+   {
+      if (i >= H->length)
+         cmp = -1;
+      else if (j >= g->length)
+         cmp = 1;
+      else
+         cmp = mpoly_monomial_cmp(H->exps + i*N, g->exps + j*N, N, 0, 0);
+
+      if (cmp > 0)
+      {
+         _fmpz_CRT_ui_precomp(T->coeffs + k, H->coeffs + i, m, 0, p, pinv,
+                                                                    mp, c, 1);
+         mpoly_monomial_set(T->exps + k*N, H->exps + i*N, N);
+         changed |= !fmpz_equal(T->coeffs + k, H->coeffs + i);
+         i++;
+      } else if (cmp < 0)
+      {
+         _fmpz_CRT_ui_precomp(T->coeffs + k, zero, m, g->coeffs[j], p, pinv,
+                                                                    mp, c, 1);
+         mpoly_monomial_set(T->exps + k*N, g->exps + j*N, N);
+         changed |= !fmpz_is_zero(T->coeffs + k);
+         j++;
+      } else
+      {
+         _fmpz_CRT_ui_precomp(T->coeffs + k, H->coeffs + i, m, g->coeffs[j],
+                                                           p, pinv, mp, c, 1);
+         mpoly_monomial_set(T->exps + k*N, H->exps + i*N, N);
+         changed |= !fmpz_equal(T->coeffs + k, H->coeffs + i);
+         i++;
+         j++;
+      }
+
+      k += !fmpz_is_zero(T->coeffs + k);
+   }
+
+   _fmpz_mpoly_set_length(T, k, ctx);
+   fmpz_mpoly_swap(H, T, ctx);
+
+   fmpz_mpoly_clear(T, ctx);
+   fmpz_clear(mp);
+   fmpz_clear(zero);
+
+   return changed;
+}
+
+/*
+   Compute the gcd of A and B with positive leading coefficient from images
+   modulo word size primes. The images are computed by Brown's dense
+   algorithm or, if zippel is set, by sparse interpolation from the support
+   of the first image wherever possible. The primitive part of the
+   reconstruction is accepted once it is stable and divides both inputs.
+*/
+void _fmpz_mpoly_gcd_modular(fmpz_mpoly_t G, const fmpz_mpoly_t A,
+                const fmpz_mpoly_t B, int zippel, const fmpz_mpoly_ctx_t ctx)
+{
+   slong i, N, nvars, bits, max;
+   int deg, rev, changed, have_skel = 0;
+   slong * degs;
+   ulong * mab;
+   mp_limb_t p;
+   fmpz_t ca, cb, gc, gamma, m;
+   fmpz_mpoly_ctx_t lctx;
+   fmpz_mpoly_t Al, Bl, H, P, Q;
+   nmod_mpoly_ctx_t pctx;
+   nmod_mpoly_t Ap, Bp, g, S;
+   flint_rand_t state;
+   TMP_INIT;
+
+   if (A->length == 0 || B->length == 0)
+   {
+      fmpz_mpoly_set(G, A->length == 0 ? B : A, ctx);
+      if (G->length != 0 && fmpz_sgn(G->coeffs + 0) < 0)
+         fmpz_mpoly_neg(G, G, ctx);
+      return;
+   }
+
+   TMP_START;
+
+   degrev_from_ord(deg, rev, ctx->ord);
+   nvars = ctx->n - deg;
+
+   /* leave room for the degree of the interpolation modulus */
+   degs = (slong *) TMP_ALLOC(nvars*sizeof(slong));
+   max = 0;
+   fmpz_mpoly_degrees(degs, A, ctx);
+   for (i = 0; i < nvars; i++)
+      max = FLINT_MAX(max, degs[i]);
+   fmpz_mpoly_degrees(degs, B, ctx);
+   for (i = 0; i < nvars; i++)
+      max = FLINT_MAX(max, degs[i]);
+
+   bits = FLINT_MAX(A->bits, B->bits);
+   bits = FLINT_MAX(bits, FLINT_BIT_COUNT(max + 1) + 1);
+   bits = mpoly_optimize_bits(bits, nvars);
+   N = words_per_exp(nvars, bits);
+
+   fmpz_init(ca);
+   fmpz_init(cb);
+   fmpz_init(gc);
+   fmpz_init(gamma);
+   fmpz_init(m);
+
+   fmpz_mpoly_ctx_init(lctx, nvars, ORD_LEX);
+   fmpz_mpoly_init(Al, lctx);
+   fmpz_mpoly_init(Bl, lctx);
+   fmpz_mpoly_init(H, lctx);
+   fmpz_mpoly_init(P, lctx);
+   fmpz_mpoly_init(Q, lctx);
+
+   p = UWORD(1) << (FLINT_BITS - 2);
+   nmod_mpoly_ctx_init(pctx, nvars, ORD_LEX, 2);
+   nmod_mpoly_init(Ap, pctx);
+   nmod_mpoly_init(Bp, pctx);
+   nmod_mpoly_init(g, pctx);
+   nmod_mpoly_init(S, pctx);
+
+   flint_randinit(state);
+
+   /* primitive parts in lex order */
+   _fmpz_mpoly_convert_ord(Al, bits, lctx, A, ctx);
+   _fmpz_mpoly_convert_ord(Bl, bits, lctx, B, ctx);
+
+   _fmpz_vec_content(ca, Al->coeffs, Al->length);
+   _fmpz_vec_content(cb, Bl->coeffs, Bl->length);
+   fmpz_gcd(gc, ca, cb);
+   fmpz_mpoly_scalar_divexact_fmpz(Al, Al, ca, lctx);
+   fmpz_mpoly_scalar_divexact_fmpz(Bl, Bl, cb, lctx);
+
+   /* remove the monomial contents */
+   mab = (ulong *) TMP_ALLOC(2*N*sizeof(ulong));
+   mpoly_monomials_min(mab, Al->exps, Al->length, bits, N);
+   mpoly_monomials_min(mab + N, Bl->exps, Bl->length, bits, N);
+   for (i = 0; i < Al->length; i++)
+      mpoly_monomial_sub(Al->exps + i*N, Al->exps + i*N, mab, N);
+   for (i = 0; i < Bl->length; i++)
+      mpoly_monomial_sub(Bl->exps + i*N, Bl->exps + i*N, mab + N, N);
+   mpoly_monomials_min(mab, mab, 2, bits, N);
+
+   /* the leading coefficient of the gcd divides gamma */
+   fmpz_gcd(gamma, Al->coeffs + 0, Bl->coeffs + 0);
+
+   fmpz_one(m);
+
+   for (;;)
+   {
+      p = n_nextprime(p, 1);
+
+      if (fmpz_fdiv_ui(Al->coeffs + 0, p) == 0
+       || fmpz_fdiv_ui(Bl->coeffs + 0, p) == 0)
+         continue;
+
+      /* the context only depends on p through its modulus */
+      nmod_init(&pctx->mod, p);
+      nmod_mpoly_set_fmpz_mpoly(Ap, Al, pctx);
+      nmod_mpoly_set_fmpz_mpoly(Bp, Bl, pctx);
+
+      if (!(zippel && have_skel && nvars > 1
+         && _nmod_mpoly_gcd_zippel_skel(g, Ap, Bp, S, nvars, state, pctx)))
+      {
+         if (!_nmod_mpoly_gcd_brown_rec(g, Ap, Bp, nvars - 1,
+                                                       zippel, state, pctx))
+            continue;
+      }
+
+      /* a constant image means the primitive parts are coprime */
+      if (g->length == 1 && mpoly_monomial_is_zero(g->exps, N))
+      {
+         fmpz_mpoly_one(P, lctx);
+         break;
+      }
+
+      if (H->length != 0)
+      {
+         int cmp = mpoly_monomial_cmp(g->exps, H->exps, N, 0, 0);
+
+         /* unlucky prime */
+         if (cmp > 0)
+            continue;
+
+         /* all previous primes were unlucky */
+         if (cmp < 0)
+         {
+            fmpz_mpoly_zero(H, lctx);
+            fmpz_one(m);
+            have_skel = 0;
+         }
+      }
+
+      nmod_mpoly_scalar_mul_ui(g, g, fmpz_fdiv_ui(gamma, p), pctx);
+
+      if (H->length == 0)
+      {
+         nmod_mpoly_set(S, g, pctx);
+         have_skel = 1;
+
+         fmpz_mpoly_fit_length(H, g->length, lctx);
+         fmpz_mpoly_fit_bits(H, bits, lctx);
+         H->bits = bits;
+         for (i = 0; i < g->length; i++)
+         {
+            fmpz_set_ui(H->coeffs + i, g->coeffs[i]);
+            if (g->coeffs[i] > p/2)
+               fmpz_sub_ui(H->coeffs + i, H->coeffs + i, p);
+            mpoly_monomial_set(H->exps + i*N, g->exps + i*N, N);
+         }
+         _fmpz_mpoly_set_length(H, g->length, lctx);
+
+         changed = 1;
+      } else
+         changed = _fmpz_mpoly_crt_nmod(H, m, g, lctx, pctx);
+
+      fmpz_mul_ui(m, m, p);
+
+      if (changed)
+         continue;
+
+      /* trial division by the primitive part of H */
+      _fmpz_vec_content(ca, H->coeffs, H->length);
+      if (fmpz_sgn(H->coeffs + 0) < 0)
+         fmpz_neg(ca, ca);
+      fmpz_mpoly_scalar_divexact_fmpz(P, H, ca, lctx);
+
+      if (fmpz_mpoly_divides_monagan_pearce(Q, Al, P, lctx)
+       && fmpz_mpoly_divides_monagan_pearce(Q, Bl, P, lctx))
+         break;
+   }
+
+   /* put back the integer and monomial contents */
+   fmpz_mpoly_scalar_mul_fmpz(P, P, gc, lctx);
+   fmpz_mpoly_fit_bits(P, bits, lctx);
+   P->bits = bits;
+   for (i = 0; i < P->length; i++)
+      mpoly_monomial_add(P->exps + i*N, P->exps + i*N, mab, N);
+
+   _fmpz_mpoly_convert_ord(G, FLINT_MAX(A->bits, B->bits), ctx, P, lctx);
+   if (fmpz_sgn(G->coeffs + 0) < 0)
+      fmpz_mpoly_neg(G, G, ctx);
+
+   flint_randclear(state);
+
+   nmod_mpoly_clear(Ap, pctx);
+   nmod_mpoly_clear(Bp, pctx);
+   nmod_mpoly_clear(g, pctx);
+   nmod_mpoly_clear(S, pctx);
+   nmod_mpoly_ctx_clear(pctx);
+
+   fmpz_mpoly_clear(Al, lctx);
+   fmpz_mpoly_clear(Bl, lctx);
+   fmpz_mpoly_clear(H, lctx);
+   fmpz_mpoly_clear(P, lctx);
+   fmpz_mpoly_clear(Q, lctx);
+   fmpz_mpoly_ctx_clear(lctx);
+
+   fmpz_clear(ca);
+   fmpz_clear(cb);
+   fmpz_clear(gc);
+   fmpz_clear(gamma);
+   fmpz_clear(m);
+
+   TMP_END;
+}
@@ -913,10 +913,28 @@ slong _fmpz_mpoly_mul_array(fmpz ** poly1, ulong ** exp1, slong * alloc,
    return len;
 }
 
+/*
+   As for _fmpz_mpoly_mul_array, but if nmain is greater than one, compute
+   the output in chunks with respect to the top nmain variables.
+*/
+static slong _fmpz_mpoly_mul_array_main(fmpz ** poly1, ulong ** exp1,
+        slong * alloc, const fmpz * poly2, const ulong * exp2, slong len2,
+                       const fmpz * poly3, const ulong * exp3, slong len3,
+                              slong * mults, slong num, slong nmain, slong bits)
+{
+   if (nmain > 1)
+      return _fmpz_mpoly_mul_array_chunked_threaded(poly1, exp1, alloc,
+                           poly2, exp2, len2, poly3, exp3, len3,
+                                      mults, num - nmain, nmain, bits, 1);
+
+   return _fmpz_mpoly_mul_array(poly1, exp1, alloc, poly2, exp2, len2,
+                                         poly3, exp3, len3, mults, num, bits);
+}
+
 int fmpz_mpoly_mul_array(fmpz_mpoly_t poly1, const fmpz_mpoly_t poly2,
                           const fmpz_mpoly_t poly3, const fmpz_mpoly_ctx_t ctx)
 {
-   slong i, bits, exp_bits, N, len = 0, array_size;
+   slong i, bits, exp_bits, N, len = 0, nmain;
    ulong * max_degs2;
    ulong * max_degs3;
    ulong max2 = 0, max3 = 0, max;
@@ -979,16 +997,17 @@ int fmpz_mpoly_mul_array(fmpz_mpoly_t poly1, const fmpz_mpoly_t poly2,
    }
 
    /* compute bounds on output exps, used as mixed bases for packing exps */
-   array_size = 1;
-   for (i = 0; i < ctx->n - 1; i++)
-   {
+   for (i = 0; i < ctx->n; i++)
       max_degs2[i] += max_degs3[i] + 1;
-      array_size *= max_degs2[i];  
-   }
-   max_degs2[ctx->n - 1] += max_degs3[ctx->n - 1] + 1;
 
-   /* if exponents too large for array multiplication, exit silently */
-   if (array_size > MAX_ARRAY_SIZE)
+   /*
+      if the array for all but the main variable would be too large, the
+      output is computed in chunks with respect to more main variables,
+      but if the product is then too sparse, exit silently
+   */
+   nmain = _fmpz_mpoly_mul_array_main_vars((slong *) max_degs2, ctx->n,
+                                               poly2->length, poly3->length);
+   if (nmain == 0)
    {
       res = 0;
       goto cleanup;
@@ -1021,15 +1040,15 @@ int fmpz_mpoly_mul_array(fmpz_mpoly_t poly1, const fmpz_mpoly_t poly2,
       temp->bits = exp_bits;
 
       if (poly2->length >= poly3->length)
-         len = _fmpz_mpoly_mul_array(&temp->coeffs, &temp->exps, &temp->alloc, 
+         len = _fmpz_mpoly_mul_array_main(&temp->coeffs, &temp->exps, &temp->alloc, 
                                            poly3->coeffs, exp3, poly3->length,
                                            poly2->coeffs, exp2, poly2->length,
-                                        (slong *) max_degs2, ctx->n, exp_bits);
+                                        (slong *) max_degs2, ctx->n, nmain, exp_bits);
       else
-         len = _fmpz_mpoly_mul_array(&temp->coeffs, &temp->exps, &temp->alloc, 
+         len = _fmpz_mpoly_mul_array_main(&temp->coeffs, &temp->exps, &temp->alloc, 
                                            poly2->coeffs, exp2, poly2->length,
                                            poly3->coeffs, exp3, poly3->length,
-                                        (slong *) max_degs2, ctx->n, exp_bits);
+                                        (slong *) max_degs2, ctx->n, nmain, exp_bits);
 
       fmpz_mpoly_swap(temp, poly1, ctx);
 
@@ -1041,15 +1060,15 @@ int fmpz_mpoly_mul_array(fmpz_mpoly_t poly1, const fmpz_mpoly_t poly2,
       poly1->bits = exp_bits;
 
       if (poly2->length >= poly3->length)
-         len = _fmpz_mpoly_mul_array(&poly1->coeffs, &poly1->exps, &poly1->alloc,
+         len = _fmpz_mpoly_mul_array_main(&poly1->coeffs, &poly1->exps, &poly1->alloc,
                                             poly3->coeffs, exp3, poly3->length,
                                             poly2->coeffs, exp2, poly2->length,
-                                        (slong *) max_degs2, ctx->n, exp_bits);
+                                        (slong *) max_degs2, ctx->n, nmain, exp_bits);
       else
-         len = _fmpz_mpoly_mul_array(&poly1->coeffs, &poly1->exps, &poly1->alloc,
+         len = _fmpz_mpoly_mul_array_main(&poly1->coeffs, &poly1->exps, &poly1->alloc,
                                             poly2->coeffs, exp2, poly2->length, 
                                             poly3->coeffs, exp3, poly3->length,
-                                        (slong *) max_degs2, ctx->n, exp_bits);
+                                        (slong *) max_degs2, ctx->n, nmain, exp_bits);
    }
 
    _fmpz_mpoly_set_length(poly1, len, ctx);
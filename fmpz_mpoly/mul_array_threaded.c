@@ -0,0 +1,568 @@
+/*
+    Copyright (C) 2026 agent
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include <gmp.h>
+#include <stdlib.h>
+#include "flint.h"
+#include "fmpz.h"
+#include "fmpz_mpoly.h"
+
+#define MAX_ARRAY_SIZE (WORD(300000))
+
+/*
+   The top nmain fields of the exponents are the main variables. Their
+   values, tightly packed with the mixed bases in mults, form the key of
+   the chunk of terms sharing them. The remaining num fields index a dense
+   array of prod entries. A key is stored by its distance from the largest
+   key, so that chunk i of the output is the sum of the products of chunk
+   j of poly2 and chunk i - j of poly3.
+*/
+typedef struct
+{
+   const fmpz * poly2;
+   const ulong * e2;
+   const slong * i2, * n2, * b2, * maxb2;
+   slong l2;
+   const fmpz * poly3;
+   const ulong * e3;
+   const slong * i3, * n3, * b3, * maxb3;
+   slong l3;
+   const slong * mults;
+   slong num;
+   slong nmain;
+   slong bits;
+   slong prod;
+   int small;
+   /* slab s consists of the output chunks [slab[s], slab[s + 1]) */
+   const slong * slab;
+   fmpz ** coeffs;
+   ulong ** exps;
+   slong * allocs;
+   slong * lens;
+}
+_fmpz_mpoly_mul_array_chunked_arg_t;
+
+/*
+   Set i1 and n1 to the starts and lengths of the l1 chunks of a
+   polynomial of length len1 whose terms have the given keys.
+*/
+static void _fmpz_mpoly_chunks_from_keys(slong * i1, slong * n1,
+                                const ulong * keys, slong l1, slong len1)
+{
+   slong i;
+
+   for (i = 0; i < l1; i++)
+      n1[i] = 0;
+
+   for (i = 0; i < len1; i++)
+      n1[l1 - 1 - (slong) keys[i]]++;
+
+   i1[0] = 0;
+   for (i = 1; i < l1; i++)
+      i1[i] = i1[i - 1] + n1[i - 1];
+}
+
+/*
+   Append output chunk i to (poly1, exp1, alloc), starting at index k, and
+   return the new length. The array p1 must have room for prod entries of
+   three words, or of one fmpz in the multiprecision case, and be zero.
+   It is left zero.
+*/
+static slong _fmpz_mpoly_mul_array_chunk(fmpz ** poly1, ulong ** exp1,
+                  slong * alloc, slong k, void * p1, slong i,
+                                  const _fmpz_mpoly_mul_array_chunked_arg_t * a)
+{
+   slong j, len, num1 = 0, bits1 = 0, key;
+   slong l1 = a->l2 + a->l3 - 1;
+   slong shift = a->bits*(FLINT_BITS/a->bits - a->nmain);
+   ulong top;
+
+   /* compute bound on coeffs of output chunk */
+   for (j = FLINT_MAX(0, i - a->l3 + 1); j < a->l2 && j <= i; j++)
+   {
+      if (a->n2[j] != 0 && a->n3[i - j] != 0)
+      {
+         bits1 = FLINT_MAX(bits1, FLINT_MIN(a->b2[j] + a->maxb3[i - j],
+                                            a->maxb2[j] + a->b3[i - j]));
+         num1++;
+      }
+   }
+
+   /* no cross products contribute to this chunk */
+   if (num1 == 0)
+      return k;
+
+   bits1 += FLINT_BIT_COUNT(num1) + 1; /* includes one bit for sign */
+
+   /* addmuls for each cross product of chunks */
+   for (j = FLINT_MAX(0, i - a->l3 + 1); j < a->l2 && j <= i; j++)
+   {
+      const slong * c2, * c3;
+      const ulong * f2, * f3;
+
+      if (a->n2[j] == 0 || a->n3[i - j] == 0)
+         continue;
+
+      c2 = (const slong *) a->poly2 + a->i2[j];
+      c3 = (const slong *) a->poly3 + a->i3[i - j];
+      f2 = a->e2 + a->i2[j];
+      f3 = a->e3 + a->i3[i - j];
+
+      if (!a->small)
+         _fmpz_mpoly_addmul_array1_fmpz((fmpz *) p1,
+                   a->poly2 + a->i2[j], f2, a->n2[j],
+                   a->poly3 + a->i3[i - j], f3, a->n3[i - j]);
+      else if (bits1 <= FLINT_BITS)
+         _fmpz_mpoly_addmul_array1_slong1((ulong *) p1,
+                                    c2, f2, a->n2[j], c3, f3, a->n3[i - j]);
+      else if (bits1 <= 2*FLINT_BITS)
+         _fmpz_mpoly_addmul_array1_slong2((ulong *) p1,
+                                    c2, f2, a->n2[j], c3, f3, a->n3[i - j]);
+      else
+         _fmpz_mpoly_addmul_array1_slong((ulong *) p1,
+                                    c2, f2, a->n2[j], c3, f3, a->n3[i - j]);
+   }
+
+   /* convert array to fmpz_mpoly and clear the array again */
+   if (!a->small)
+   {
+      len = _fmpz_mpoly_from_fmpz_array(poly1, exp1, alloc, (fmpz *) p1,
+                                         a->mults, a->num, a->bits, k) - k;
+
+      for (j = 0; j < a->prod; j++)
+         fmpz_zero((fmpz *) p1 + j);
+   } else if (bits1 <= FLINT_BITS)
+      len = _fmpz_mpoly_from_ulong_array1(poly1, exp1, alloc, (ulong *) p1,
+                                         a->mults, a->num, a->bits, k) - k;
+   else if (bits1 <= 2*FLINT_BITS)
+      len = _fmpz_mpoly_from_ulong_array2(poly1, exp1, alloc, (ulong *) p1,
+                                         a->mults, a->num, a->bits, k) - k;
+   else
+      len = _fmpz_mpoly_from_ulong_array(poly1, exp1, alloc, (ulong *) p1,
+                                         a->mults, a->num, a->bits, k) - k;
+
+   if (a->small)
+   {
+      ulong * p = (ulong *) p1;
+      slong words = bits1 <= FLINT_BITS ? 1 : bits1 <= 2*FLINT_BITS ? 2 : 3;
+
+      for (j = 0; j < words*a->prod; j++)
+         p[j] = 0;
+   }
+
+   /* unpack the key into the main variables */
+   key = l1 - i - 1;
+   top = 0;
+   for (j = 0; j < a->nmain; j++)
+   {
+      top += ((ulong) (key % a->mults[a->num + j])) << (a->bits*j);
+      key /= a->mults[a->num + j];
+   }
+   top <<= shift;
+
+   /* insert main variables into exponents */
+   for (j = 0; j < len; j++)
+      (*exp1)[k + j] = ((*exp1)[k + j] >> (a->bits*a->nmain)) + top;
+
+   return k + len;
+}
+
+/* compute the output chunks of slab s */
+static void _fmpz_mpoly_mul_array_chunked_worker(void * arg_ptr, slong s)
+{
+   _fmpz_mpoly_mul_array_chunked_arg_t * a =
+                             (_fmpz_mpoly_mul_array_chunked_arg_t *) arg_ptr;
+   slong i, k = 0;
+   void * p1;
+
+   if (a->small)
+      p1 = flint_calloc(3*a->prod, sizeof(ulong));
+   else
+      p1 = flint_calloc(a->prod, sizeof(fmpz));
+
+   for (i = a->slab[s]; i < a->slab[s + 1]; i++)
+      k = _fmpz_mpoly_mul_array_chunk(a->coeffs + s, a->exps + s,
+                                                  a->allocs + s, k, p1, i, a);
+
+   a->lens[s] = k;
+
+   flint_free(p1);
+}
+
+/*
+   Use dense array multiplication to set poly1 to poly2*poly3 in
+   num + nmain variables, given a list of multipliers to tightly pack
+   exponents and a number of bits for the fields of the exponents of the
+   result, assuming no aliasing. The products are computed one chunk of
+   the output at a time, where a chunk consists of the terms with given
+   exponents in the top nmain variables, so that only an array for the
+   remaining num variables is needed. The output chunks are divided into
+   slabs of roughly equal work, which are computed by up to nthreads
+   threads. The function reallocates its output.
+*/
+slong _fmpz_mpoly_mul_array_chunked_threaded(fmpz ** poly1, ulong ** exp1,
+        slong * alloc, const fmpz * poly2, const ulong * exp2, slong len2,
+                       const fmpz * poly3, const ulong * exp3, slong len3,
+            const slong * mults, slong num, slong nmain, slong bits,
+                                                               slong nthreads)
+{
+   slong i, j, k, l1, l2, l3, prod, bits2 = 0, bits3 = 0, nslabs;
+   slong * i2, * n2, * b2, * maxb2, * i3, * n3, * b3, * maxb3, * slab;
+   ulong * e2, * e3, * k2, * k3;
+   double * cost, total, part;
+   fmpz * p1 = *poly1;
+   ulong * ex1 = *exp1;
+   _fmpz_mpoly_mul_array_chunked_arg_t arg;
+   TMP_INIT;
+
+   prod = 1;
+   for (i = 0; i < num; i++)
+      prod *= mults[i];
+
+   TMP_START;
+
+   /* compute the key of each term and the chunks of the inputs */
+   k2 = (ulong *) TMP_ALLOC(len2*sizeof(ulong));
+   k3 = (ulong *) TMP_ALLOC(len3*sizeof(ulong));
+   mpoly_pack_monomials_tight(k2, exp2, len2, mults + num, nmain, 0, bits);
+   mpoly_pack_monomials_tight(k3, exp3, len3, mults + num, nmain, 0, bits);
+
+   l2 = 1 + (slong) k2[0];
+   l3 = 1 + (slong) k3[0];
+   l1 = l2 + l3 - 1;
+
+   i2 = (slong *) TMP_ALLOC(4*l2*sizeof(slong));
+   n2 = i2 + l2;
+   b2 = n2 + l2;
+   maxb2 = b2 + l2;
+   i3 = (slong *) TMP_ALLOC(4*l3*sizeof(slong));
+   n3 = i3 + l3;
+   b3 = n3 + l3;
+   maxb3 = b3 + l3;
+
+   _fmpz_mpoly_chunks_from_keys(i2, n2, k2, l2, len2);
+   _fmpz_mpoly_chunks_from_keys(i3, n3, k3, l3, len3);
+
+   /* pack remaining exponents tightly with mixed bases given by mults */
+   e2 = k2;
+   e3 = k3;
+   mpoly_pack_monomials_tight(e2, exp2, len2, mults, num, nmain, bits);
+   mpoly_pack_monomials_tight(e3, exp3, len3, mults, num, nmain, bits);
+
+   /* work out max bits for each chunk */
+   for (i = 0; i < l2; i++)
+   {
+      _fmpz_mpoly_chunk_max_bits(b2, maxb2, poly2, i2, n2, i);
+      bits2 = FLINT_MAX(bits2, maxb2[i]);
+   }
+
+   for (i = 0; i < l3; i++)
+   {
+      _fmpz_mpoly_chunk_max_bits(b3, maxb3, poly3, i3, n3, i);
+      bits3 = FLINT_MAX(bits3, maxb3[i]);
+   }
+
+   /*
+      estimate the work for each output chunk, including clearing and
+      scanning the array, and divide the chunks into slabs of equal work
+   */
+   cost = (double *) TMP_ALLOC(l1*sizeof(double));
+   total = 0;
+   for (i = 0; i < l1; i++)
+   {
+      cost[i] = 0;
+      for (j = FLINT_MAX(0, i - l3 + 1); j < l2 && j <= i; j++)
+         cost[i] += (double) n2[j]*(double) n3[i - j];
+
+      if (cost[i] != 0)
+         cost[i] += prod;
+
+      total += cost[i];
+   }
+
+   nthreads = FLINT_MAX(nthreads, 1);
+   nslabs = nthreads == 1 ? 1 : FLINT_MIN(l1, 4*nthreads);
+
+   slab = (slong *) TMP_ALLOC((nslabs + 1)*sizeof(slong));
+   slab[0] = 0;
+   for (i = 0, j = 1, part = 0; j < nslabs; j++)
+   {
+      while (i < l1 && part < total*j/nslabs)
+         part += cost[i++];
+
+      slab[j] = i;
+   }
+   slab[nslabs] = l1;
+
+   arg.poly2 = poly2;
+   arg.e2 = e2;
+   arg.i2 = i2;
+   arg.n2 = n2;
+   arg.b2 = b2;
+   arg.maxb2 = maxb2;
+   arg.l2 = l2;
+   arg.poly3 = poly3;
+   arg.e3 = e3;
+   arg.i3 = i3;
+   arg.n3 = n3;
+   arg.b3 = b3;
+   arg.maxb3 = maxb3;
+   arg.l3 = l3;
+   arg.mults = mults;
+   arg.num = num;
+   arg.nmain = nmain;
+   arg.bits = bits;
+   arg.prod = prod;
+   arg.small = bits2 <= (FLINT_BITS - 2) && bits3 <= (FLINT_BITS - 2);
+   arg.slab = slab;
+   arg.coeffs = (fmpz **) TMP_ALLOC(nslabs*sizeof(fmpz *));
+   arg.exps = (ulong **) TMP_ALLOC(nslabs*sizeof(ulong *));
+   arg.allocs = (slong *) TMP_ALLOC(nslabs*sizeof(slong));
+   arg.lens = (slong *) TMP_ALLOC(nslabs*sizeof(slong));
+
+   /* the first slab writes to the output, the others to their own */
+   arg.coeffs[0] = p1;
+   arg.exps[0] = ex1;
+   arg.allocs[0] = *alloc;
+   for (i = 1; i < nslabs; i++)
+   {
+      arg.coeffs[i] = NULL;
+      arg.exps[i] = NULL;
+      arg.allocs[i] = 0;
+   }
+
+   if (nslabs == 1)
+      _fmpz_mpoly_mul_array_chunked_worker(&arg, 0);
+   else
+      flint_parallel_for(0, nslabs, 1,
+                                  _fmpz_mpoly_mul_array_chunked_worker, &arg);
+
+   /* concatenate the slabs */
+   p1 = arg.coeffs[0];
+   ex1 = arg.exps[0];
+   *alloc = arg.allocs[0];
+   k = arg.lens[0];
+
+   for (i = 1; i < nslabs; i++)
+   {
+      _fmpz_mpoly_fit_length(&p1, &ex1, alloc, k + arg.lens[i], 1);
+
+      for (j = 0; j < arg.lens[i]; j++)
+      {
+         fmpz_swap(p1 + k + j, arg.coeffs[i] + j);
+         ex1[k + j] = arg.exps[i][j];
+      }
+
+      k += arg.lens[i];
+
+      for (j = 0; j < arg.allocs[i]; j++)
+         fmpz_clear(arg.coeffs[i] + j);
+
+      flint_free(arg.coeffs[i]);
+      flint_free(arg.exps[i]);
+   }
+
+   *poly1 = p1;
+   *exp1 = ex1;
+
+   TMP_END;
+
+   return k;
+}
+
+/*
+   Return the number of main variables needed for the array for the
+   remaining variables to have at most MAX_ARRAY_SIZE entries, or zero if
+   the product is too sparse for the array method to be worthwhile, i.e.
+   the dense product is larger than the number of coefficient products or
+   there are more chunks than terms in the longer input.
+*/
+slong _fmpz_mpoly_mul_array_main_vars(const slong * mults, slong n,
+                                                      slong len2, slong len3)
+{
+   slong i, nmain;
+   ulong prod, chunks, hi, lo;
+
+   prod = 1;
+   for (i = 0; i < n - 1; i++)
+      prod *= mults[i];
+
+   for (nmain = 1; nmain < n - 1 && prod > MAX_ARRAY_SIZE; nmain++)
+      prod /= mults[n - 1 - nmain];
+
+   if (nmain == 1)
+      return 1;
+
+   if (prod > MAX_ARRAY_SIZE)
+      return 0;
+
+   /* number of chunks of the output */
+   chunks = 1;
+   for (i = n - nmain; i < n; i++)
+   {
+      umul_ppmm(hi, chunks, chunks, mults[i]);
+      if (hi != 0 || chunks > (ulong) FLINT_MAX(len2, len3))
+         return 0;
+   }
+
+   /* size of the full array */
+   umul_ppmm(hi, prod, prod, chunks);
+   umul_ppmm(hi, lo, len2, len3);
+
+   return (hi == 0 && prod > lo) ? 0 : nmain;
+}
+
+int fmpz_mpoly_mul_array_threaded(fmpz_mpoly_t poly1,
+    const fmpz_mpoly_t poly2, const fmpz_mpoly_t poly3,
+                                                   const fmpz_mpoly_ctx_t ctx)
+{
+   slong i, bits, exp_bits, N, len = 0, nmain;
+   ulong * max_degs2;
+   ulong * max_degs3;
+   ulong max2 = 0, max3 = 0, max;
+   ulong * exp2 = poly2->exps, * exp3 = poly3->exps;
+   int free2 = 0, free3 = 0;
+   int res = 1;
+
+   TMP_INIT;
+
+   /* input poly is zero */
+   if (poly2->length == 0 || poly3->length == 0)
+   {
+      fmpz_mpoly_zero(poly1, ctx);
+
+      return 1;
+   }
+
+   TMP_START;
+
+   /* compute maximum exponents for each variable */
+   max_degs2 = (ulong *) TMP_ALLOC(ctx->n*sizeof(ulong));
+   max_degs3 = (ulong *) TMP_ALLOC(ctx->n*sizeof(ulong));
+
+   mpoly_max_degrees(max_degs2, poly2->exps, poly2->length, poly2->bits, ctx->n);
+   mpoly_max_degrees(max_degs3, poly3->exps, poly3->length, poly3->bits, ctx->n);
+
+   for (i = 0; i < ctx->n; i++)
+   {
+      if (max_degs2[i] > max2)
+         max2 = max_degs2[i];
+
+      if (max_degs3[i] > max3)
+         max3 = max_degs3[i];
+   }
+
+   /* check that exponents won't overflow a word */
+   max = max2 + max3;
+   if (max < max2 || 0 > (slong) max)
+      flint_throw(FLINT_EXPOF,
+                        "Exponent overflow in fmpz_mpoly_mul_array_threaded");
+
+   /* compute number of bits required for output exponents */
+   bits = FLINT_BIT_COUNT(max);
+
+   exp_bits = 8;
+   while (bits >= exp_bits)
+      exp_bits += 1;
+
+   exp_bits = FLINT_MAX(exp_bits, poly2->bits);
+   exp_bits = FLINT_MAX(exp_bits, poly3->bits);
+
+   /* number of words for exponents */
+   N = words_per_exp(ctx->n, exp_bits);
+
+   /* array multiplication expects each exponent vector in one word */
+   /* current code is wrong for reversed orderings */
+   /* there must be a main variable and a variable for the array */
+   if (N != 1 || mpoly_ordering_isrev(ctx->ord) || ctx->n < 2)
+   {
+      res = 0;
+      goto cleanup;
+   }
+
+   /* compute bounds on output exps, used as mixed bases for packing exps */
+   for (i = 0; i < ctx->n; i++)
+      max_degs2[i] += max_degs3[i] + 1;
+
+   nmain = _fmpz_mpoly_mul_array_main_vars((slong *) max_degs2, ctx->n,
+                                               poly2->length, poly3->length);
+
+   /* if the product is too sparse, exit silently */
+   if (nmain == 0)
+   {
+      res = 0;
+      goto cleanup;
+   }
+
+   /* expand input exponents to same number of bits as output */
+   if (exp_bits > poly2->bits)
+   {
+      free2 = 1;
+      exp2 = (ulong *) flint_malloc(N*poly2->length*sizeof(ulong));
+      mpoly_unpack_monomials(exp2, exp_bits, poly2->exps, poly2->bits,
+                                                        poly2->length, ctx->n);
+   }
+
+   if (exp_bits > poly3->bits)
+   {
+      free3 = 1;
+      exp3 = (ulong *) flint_malloc(N*poly3->length*sizeof(ulong));
+      mpoly_unpack_monomials(exp3, exp_bits, poly3->exps, poly3->bits,
+                                                        poly3->length, ctx->n);
+   }
+
+   /* handle aliasing and do array multiplication */
+   if (poly1 == poly2 || poly1 == poly3)
+   {
+      fmpz_mpoly_t temp;
+
+      fmpz_mpoly_init2(temp, poly2->length + poly3->length - 1, ctx);
+      fmpz_mpoly_fit_bits(temp, exp_bits, ctx);
+      temp->bits = exp_bits;
+
+      len = _fmpz_mpoly_mul_array_chunked_threaded(
+                                 &temp->coeffs, &temp->exps, &temp->alloc,
+                                 poly2->coeffs, exp2, poly2->length,
+                                 poly3->coeffs, exp3, poly3->length,
+                                 (slong *) max_degs2, ctx->n - nmain, nmain,
+                                          exp_bits, flint_get_num_threads());
+
+      fmpz_mpoly_swap(temp, poly1, ctx);
+
+      fmpz_mpoly_clear(temp, ctx);
+   } else
+   {
+      fmpz_mpoly_fit_length(poly1, poly2->length + poly3->length - 1, ctx);
+      fmpz_mpoly_fit_bits(poly1, exp_bits, ctx);
+      poly1->bits = exp_bits;
+
+      len = _fmpz_mpoly_mul_array_chunked_threaded(
+                              &poly1->coeffs, &poly1->exps, &poly1->alloc,
+                                 poly2->coeffs, exp2, poly2->length,
+                                 poly3->coeffs, exp3, poly3->length,
+                                 (slong *) max_degs2, ctx->n - nmain, nmain,
+                                          exp_bits, flint_get_num_threads());
+   }
+
+   _fmpz_mpoly_set_length(poly1, len, ctx);
+
+   if (free2)
+      flint_free(exp2);
+
+   if (free3)
+      flint_free(exp3);
+
+cleanup:
+
+   TMP_END;
+
+   return res;
+}
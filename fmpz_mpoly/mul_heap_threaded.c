@@ -239,6 +239,22 @@ slong _fmpz_mpoly_mul_heap_part1(fmpz ** poly1, ulong ** exp1, slong * alloc,
 }
 
 
+/* versions for exponent vectors of exactly two, three and four words */
+#define W 2
+#include "fmpz_mpoly_templates.h"
+#include "fmpz_mpoly_templates/mul_heap_part.c"
+#undef W
+
+#define W 3
+#include "fmpz_mpoly_templates.h"
+#include "fmpz_mpoly_templates/mul_heap_part.c"
+#undef W
+
+#define W 4
+#include "fmpz_mpoly_templates.h"
+#include "fmpz_mpoly_templates/mul_heap_part.c"
+#undef W
+
 /*
     Set poly1 to poly2*poly3 using Johnson's heap method. The function
     realocates its output and returns the length of the product. This
@@ -275,6 +291,25 @@ slong _fmpz_mpoly_mul_heap_part(fmpz ** poly1, ulong ** exp1, slong * alloc,
                                           poly3, exp3, len3,
                                                     start, end, hind, maskhi);
 
+    /* if exponent vectors take two to four words, call special versions */
+    if (N == 2)
+        return _fmpz_mpoly_mul_heap_part2(poly1, exp1, alloc,
+                                          poly2, exp2, len2,
+                                          poly3, exp3, len3,
+                                            start, end, hind, maskhi, masklo);
+
+    if (N == 3)
+        return _fmpz_mpoly_mul_heap_part3(poly1, exp1, alloc,
+                                          poly2, exp2, len2,
+                                          poly3, exp3, len3,
+                                            start, end, hind, maskhi, masklo);
+
+    if (N == 4)
+        return _fmpz_mpoly_mul_heap_part4(poly1, exp1, alloc,
+                                          poly2, exp2, len2,
+                                          poly3, exp3, len3,
+                                            start, end, hind, maskhi, masklo);
+
     TMP_START;
 
     /* whether input coeffs are small, thus output coeffs fit in three words */
@@ -644,10 +679,7 @@ void * _fmpz_mpoly_mul_heap_threaded_worker(void * arg_ptr)
     flint_free(t2);
     flint_free(t1);
     flint_free(exp);
-    if (arg->idx + 1 < base->nthreads)
-    {
-        flint_cleanup();
-    }
+
     return NULL;
 }
 
@@ -659,7 +691,6 @@ slong _fmpz_mpoly_mul_heap_threaded(fmpz ** poly1, ulong ** exp1, slong * alloc,
                                            slong N, ulong maskhi, ulong masklo)
 {
     slong i, j, k, ndivs2;
-    pthread_t * threads;
     mul_heap_threaded_arg_t * args;
     mul_heap_threaded_base_t * base;
     mul_heap_threaded_div_t * divs;
@@ -683,7 +714,6 @@ slong _fmpz_mpoly_mul_heap_threaded(fmpz ** poly1, ulong ** exp1, slong * alloc,
     ndivs2 = base->ndivs*base->ndivs;
 
     divs    = flint_malloc(sizeof(mul_heap_threaded_div_t) * base->ndivs);
-    threads = flint_malloc(sizeof(pthread_t) * base->nthreads);
     args    = flint_malloc(sizeof(mul_heap_threaded_arg_t) * base->nthreads);
 
     /* allocate space and set the boundary for each division */
@@ -724,21 +754,9 @@ slong _fmpz_mpoly_mul_heap_threaded(fmpz ** poly1, ulong ** exp1, slong * alloc,
         args[i].idx = i;
         args[i].basep = base;
         args[i].divp = divs;
-        if (i + 1 < base->nthreads)
-        {
-            pthread_create(&threads[i], NULL, _fmpz_mpoly_mul_heap_threaded_worker, &args[i]);
-        } else
-        {
-            _fmpz_mpoly_mul_heap_threaded_worker(&args[i]);
-        }
-    }
-    for (i = base->nthreads-1; i >= 0; i--)
-    {
-        if (i + 1 < base->nthreads)
-        {
-            pthread_join(threads[i], NULL);
-        }
     }
+    flint_parallel_do(_fmpz_mpoly_mul_heap_threaded_worker,
+                      args, sizeof(mul_heap_threaded_arg_t), base->nthreads);
     pthread_mutex_destroy(&base->mutex);
 
     /* concatenate the outputs */ 
@@ -772,7 +790,6 @@ slong _fmpz_mpoly_mul_heap_threaded(fmpz ** poly1, ulong ** exp1, slong * alloc,
     }
 
     flint_free(args);
-    flint_free(threads);
     flint_free(divs);
     flint_free(base);
 
@@ -216,6 +216,22 @@ slong _fmpz_mpoly_mul_johnson1(fmpz ** poly1, ulong ** exp1, slong * alloc,
    return k;
 }
 
+/* versions for exponent vectors of exactly two, three and four words */
+#define W 2
+#include "fmpz_mpoly_templates.h"
+#include "fmpz_mpoly_templates/mul_johnson.c"
+#undef W
+
+#define W 3
+#include "fmpz_mpoly_templates.h"
+#include "fmpz_mpoly_templates/mul_johnson.c"
+#undef W
+
+#define W 4
+#include "fmpz_mpoly_templates.h"
+#include "fmpz_mpoly_templates/mul_johnson.c"
+#undef W
+
 /*
    Set poly1 to poly2*poly3 using Johnson's heap method. The function
    realocates its output and returns the length of the product. This
@@ -249,6 +265,19 @@ slong _fmpz_mpoly_mul_johnson(fmpz ** poly1, ulong ** exp1, slong * alloc,
       return _fmpz_mpoly_mul_johnson1(poly1, exp1, alloc,
                                   poly2, exp2, len2, poly3, exp3, len3, maskhi);
 
+   /* if exponent vectors take two to four words, call special versions */
+   if (N == 2)
+      return _fmpz_mpoly_mul_johnson2(poly1, exp1, alloc,
+                          poly2, exp2, len2, poly3, exp3, len3, maskhi, masklo);
+
+   if (N == 3)
+      return _fmpz_mpoly_mul_johnson3(poly1, exp1, alloc,
+                          poly2, exp2, len2, poly3, exp3, len3, maskhi, masklo);
+
+   if (N == 4)
+      return _fmpz_mpoly_mul_johnson4(poly1, exp1, alloc,
+                          poly2, exp2, len2, poly3, exp3, len3, maskhi, masklo);
+
    TMP_START;
 
    /* whether input coeffs are small, thus output coeffs fit in three words */
@@ -17,6 +17,53 @@
 #include "fmpz_mpoly.h"
 #include "ulong_extras.h"
 
+/*
+   set P to p, in a context ctxP with the variables of ctx followed by
+   others which do not occur, so that the ordering of terms is unchanged
+*/
+void embed_mpoly(fmpz_mpoly_t P, const fmpz_mpoly_ctx_t ctxP,
+                          const fmpz_mpoly_t p, const fmpz_mpoly_ctx_t ctx)
+{
+    slong i;
+    ulong * exp = (ulong *) flint_calloc(ctxP->n, sizeof(ulong));
+
+    fmpz_mpoly_zero(P, ctxP);
+
+    for (i = 0; i < p->length; i++)
+    {
+        fmpz_mpoly_get_monomial(exp, p, i, ctx);
+        fmpz_mpoly_set_term_fmpz(P, exp, p->coeffs + i, ctxP);
+    }
+
+    flint_free(exp);
+}
+
+/* check that P is p embedded as by embed_mpoly */
+int embedded_equal(const fmpz_mpoly_t P, const fmpz_mpoly_ctx_t ctxP,
+                          const fmpz_mpoly_t p, const fmpz_mpoly_ctx_t ctx)
+{
+    slong i, j;
+    int result = (P->length == p->length);
+    ulong * exp = (ulong *) flint_calloc(ctxP->n, sizeof(ulong));
+    ulong * expP = (ulong *) flint_calloc(ctxP->n, sizeof(ulong));
+
+    for (i = 0; result && i < p->length; i++)
+    {
+        fmpz_mpoly_get_monomial(exp, p, i, ctx);
+        fmpz_mpoly_get_monomial(expP, P, i, ctxP);
+
+        for (j = 0; j < ctxP->n; j++)
+            result &= (exp[j] == expP[j]);
+
+        result &= fmpz_equal(p->coeffs + i, P->coeffs + i);
+    }
+
+    flint_free(exp);
+    flint_free(expP);
+
+    return result;
+}
+
 int
 main(void)
 {
@@ -341,6 +388,112 @@ main(void)
        fmpz_mpoly_clear(h, ctx);  
     }
 
+    /*
+       Check the kernels for three and four word exponents agree with
+       divides_heap_threaded, and with the generic code by repeating the
+       division with extra variables
+    */
+    for (i = 0; i < 10 * flint_test_multiplier(); i++)
+    {
+       fmpz_mpoly_ctx_t ctx, ctxP;
+       fmpz_mpoly_t f, g, h, k, q, G, H, Q;
+       ordering_t ord;
+       slong N, n, nvars, fields, exp_bits, exp_bound, len, len1, len2;
+       slong coeff_bits;
+
+       ord = mpoly_ordering_randtest(state);
+       N = n_randint(state, 2) + 3;
+       fields = WORD(1) << n_randint(state, 3);
+       exp_bits = FLINT_BITS/fields;
+       n = (N - 1)*fields + 1 + n_randint(state, fields);
+       nvars = n - mpoly_ordering_isdeg(ord);
+
+       fmpz_mpoly_ctx_init(ctx, nvars, ord);
+       fmpz_mpoly_ctx_init(ctxP, nvars + 8, ord);
+
+       fmpz_mpoly_init(f, ctx);
+       fmpz_mpoly_init(g, ctx);
+       fmpz_mpoly_init(h, ctx);
+       fmpz_mpoly_init(k, ctx);
+       fmpz_mpoly_init(q, ctx);
+       fmpz_mpoly_init(G, ctxP);
+       fmpz_mpoly_init(H, ctxP);
+       fmpz_mpoly_init(Q, ctxP);
+
+       len = n_randint(state, 50);
+       len1 = n_randint(state, 50);
+       len2 = n_randint(state, 50) + 1;
+       coeff_bits = n_randint(state, 200);
+
+       /* products, and their degrees, stay below the top bit of a field */
+       exp_bound = n_randint(state, (WORD(1) << (exp_bits - 2))/nvars) + 1;
+
+       for (j = 0; j < 4; j++)
+       {
+          fmpz_mpoly_randtest(f, state, len1, exp_bound, coeff_bits, ctx);
+          do {
+             fmpz_mpoly_randtest(g, state, len2, exp_bound,
+                                                       coeff_bits + 1, ctx);
+          } while (g->length == 0);
+          fmpz_mpoly_fit_bits(f, exp_bits, ctx);
+          fmpz_mpoly_fit_bits(g, exp_bits, ctx);
+
+          fmpz_mpoly_mul_johnson(h, f, g, ctx);
+
+          fmpz_mpoly_div_monagan_pearce(q, h, g, ctx);
+          fmpz_mpoly_test(q, ctx);
+
+          result = fmpz_mpoly_equal(q, f, ctx)
+                && fmpz_mpoly_divides_heap_threaded(k, h, g, ctx)
+                && fmpz_mpoly_equal(k, q, ctx);
+
+          /* and a division which is not exact */
+          fmpz_mpoly_randtest(k, state, len, exp_bound, coeff_bits, ctx);
+          fmpz_mpoly_add(h, h, k, ctx);
+
+          fmpz_mpoly_div_monagan_pearce(q, h, g, ctx);
+          fmpz_mpoly_test(q, ctx);
+
+          embed_mpoly(H, ctxP, h, ctx);
+          embed_mpoly(G, ctxP, g, ctx);
+          fmpz_mpoly_fit_bits(H, FLINT_BITS, ctxP);
+
+          fmpz_mpoly_div_monagan_pearce(Q, H, G, ctxP);
+          fmpz_mpoly_test(Q, ctxP);
+
+          result = result && embedded_equal(Q, ctxP, q, ctx)
+                && (q->length == 0 || (words_per_exp(n, q->bits) == N
+                                  && words_per_exp(ctxP->n, Q->bits) > 4));
+
+          if (!result)
+          {
+             printf("FAIL\n");
+             printf("Check %ld word exponents\n", N);
+
+             printf("ord = "); mpoly_ordering_print(ord);
+             printf(", nvars = %ld, exp_bits = %ld, exp_bound = %lx, "
+                    "len = %ld, len1 = %ld, len2 = %ld, coeff_bits = %ld\n\n",
+                      nvars, exp_bits, exp_bound, len, len1, len2, coeff_bits);
+
+             fmpz_mpoly_print_pretty(f, NULL, ctx); printf("\n\n");
+             fmpz_mpoly_print_pretty(g, NULL, ctx); printf("\n\n");
+             fmpz_mpoly_print_pretty(h, NULL, ctx); printf("\n\n");
+             fmpz_mpoly_print_pretty(q, NULL, ctx); printf("\n\n");
+
+             flint_abort();
+          }
+       }
+
+       fmpz_mpoly_clear(f, ctx);
+       fmpz_mpoly_clear(g, ctx);
+       fmpz_mpoly_clear(h, ctx);
+       fmpz_mpoly_clear(k, ctx);
+       fmpz_mpoly_clear(q, ctx);
+       fmpz_mpoly_clear(G, ctxP);
+       fmpz_mpoly_clear(H, ctxP);
+       fmpz_mpoly_clear(Q, ctxP);
+    }
+
     FLINT_TEST_CLEANUP(state);
     
     flint_printf("PASS\n");
@@ -0,0 +1,279 @@
+/*
+    Copyright (C) 2026 agent
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <gmp.h>
+#include "flint.h"
+#include "fmpz.h"
+#include "fmpz_mpoly.h"
+#include "ulong_extras.h"
+
+typedef void (* gcd_func)(fmpz_mpoly_t, const fmpz_mpoly_t,
+                                 const fmpz_mpoly_t, const fmpz_mpoly_ctx_t);
+
+/* each algorithm, with a bound on the variables it is tested with */
+static const gcd_func gcd_funcs[3] =
+    { fmpz_mpoly_gcd, fmpz_mpoly_gcd_brown, fmpz_mpoly_gcd_zippel };
+
+static const char * gcd_names[3] = { "gcd", "gcd_brown", "gcd_zippel" };
+
+static const slong gcd_max_vars[3] = { 10, 4, 8 };
+
+int
+main(void)
+{
+    int i, j, k;
+    FLINT_TEST_INIT(state);
+
+    flint_printf("gcd....");
+    fflush(stdout);
+
+    for (k = 0; k < 3; k++)
+    {
+        gcd_func gcd = gcd_funcs[k];
+
+        /* compare with gcd_prs */
+        for (i = 0; i < 50 * flint_test_multiplier(); i++)
+        {
+            fmpz_mpoly_ctx_t ctx;
+            fmpz_mpoly_t a, b, c, g, h;
+            ordering_t ord;
+            slong nvars, len1, len2, len3, exp_bound1, exp_bound2, exp_bound3;
+            slong coeff_bits;
+
+            ord = mpoly_ordering_randtest(state);
+            nvars = n_randint(state, 3) + 1;
+
+            fmpz_mpoly_ctx_init(ctx, nvars, ord);
+
+            fmpz_mpoly_init(a, ctx);
+            fmpz_mpoly_init(b, ctx);
+            fmpz_mpoly_init(c, ctx);
+            fmpz_mpoly_init(g, ctx);
+            fmpz_mpoly_init(h, ctx);
+
+            for (j = 0; j < 4; j++)
+            {
+                len1 = n_randint(state, 18);
+                len2 = n_randint(state, 18);
+                len3 = n_randint(state, 14);
+                exp_bound1 = n_randint(state, 4) + 2;
+                exp_bound2 = n_randint(state, 4) + 2;
+                exp_bound3 = n_randint(state, 3) + 2;
+                coeff_bits = n_randint(state, 3) + 1;
+                fmpz_mpoly_randtest(a, state, len1, exp_bound1,
+                                                            coeff_bits, ctx);
+                fmpz_mpoly_randtest(b, state, len2, exp_bound2,
+                                                            coeff_bits, ctx);
+                fmpz_mpoly_randtest(c, state, len3, exp_bound3,
+                                                            coeff_bits, ctx);
+
+                fmpz_mpoly_mul_johnson(a, a, c, ctx);
+                fmpz_mpoly_mul_johnson(b, b, c, ctx);
+
+                gcd(g, a, b, ctx);
+                fmpz_mpoly_test(g, ctx);
+                fmpz_mpoly_gcd_prs(h, a, b, ctx);
+
+                if (!fmpz_mpoly_equal(g, h, ctx))
+                {
+                    flint_printf("FAIL\n%s does not agree with gcd_prs\n"
+                                 "i: %wd  j: %wd\n", gcd_names[k], i, j);
+                    flint_abort();
+                }
+            }
+
+            fmpz_mpoly_clear(a, ctx);
+            fmpz_mpoly_clear(b, ctx);
+            fmpz_mpoly_clear(c, ctx);
+            fmpz_mpoly_clear(g, ctx);
+            fmpz_mpoly_clear(h, ctx);
+        }
+
+        /* check gcd(a*c, b*c) is divisible by c and has coprime cofactors */
+        for (i = 0; i < 50 * flint_test_multiplier(); i++)
+        {
+            fmpz_mpoly_ctx_t ctx;
+            fmpz_mpoly_t a, b, c, g, t;
+            ordering_t ord;
+            slong nvars, len1, len2, len3, exp_bound1, exp_bound2, exp_bound3;
+            slong coeff_bits;
+
+            ord = mpoly_ordering_randtest(state);
+            nvars = n_randint(state, gcd_max_vars[k]) + 1;
+
+            fmpz_mpoly_ctx_init(ctx, nvars, ord);
+
+            fmpz_mpoly_init(a, ctx);
+            fmpz_mpoly_init(b, ctx);
+            fmpz_mpoly_init(c, ctx);
+            fmpz_mpoly_init(g, ctx);
+            fmpz_mpoly_init(t, ctx);
+
+            for (j = 0; j < 4; j++)
+            {
+                len1 = n_randint(state, 30);
+                len2 = n_randint(state, 30);
+                len3 = n_randint(state, 20) + 1;
+                exp_bound1 = n_randint(state, 6) + 2;
+                exp_bound2 = n_randint(state, 6) + 2;
+                exp_bound3 = n_randint(state, 6) + 2;
+                coeff_bits = n_randint(state, 100) + 1;
+                fmpz_mpoly_randtest(a, state, len1, exp_bound1,
+                                                            coeff_bits, ctx);
+                fmpz_mpoly_randtest(b, state, len2, exp_bound2,
+                                                            coeff_bits, ctx);
+                do {
+                    fmpz_mpoly_randtest(c, state, len3, exp_bound3,
+                                                            coeff_bits, ctx);
+                } while (c->length == 0);
+
+                fmpz_mpoly_mul_johnson(a, a, c, ctx);
+                fmpz_mpoly_mul_johnson(b, b, c, ctx);
+
+                gcd(g, a, b, ctx);
+                fmpz_mpoly_test(g, ctx);
+
+                if (fmpz_mpoly_is_zero(g, ctx))
+                {
+                    if (!fmpz_mpoly_is_zero(a, ctx)
+                     || !fmpz_mpoly_is_zero(b, ctx))
+                    {
+                        flint_printf("FAIL\n%s: gcd is zero but both inputs "
+                         "are not\ni: %wd  j: %wd\n", gcd_names[k], i, j);
+                        flint_abort();
+                    }
+                    continue;
+                }
+
+                if (fmpz_sgn(g->coeffs + 0) <= 0)
+                {
+                    flint_printf("FAIL\n%s: gcd does not have positive leading "
+                       "coefficient\ni: %wd  j: %wd\n", gcd_names[k], i, j);
+                    flint_abort();
+                }
+
+                if (!fmpz_mpoly_divides_monagan_pearce(t, g, c, ctx))
+                {
+                    flint_printf("FAIL\n%s: gcd is not divisible by common "
+                        "factor\ni: %wd  j: %wd\n", gcd_names[k], i, j);
+                    flint_abort();
+                }
+
+                if (!fmpz_mpoly_divides_monagan_pearce(a, a, g, ctx)
+                 || !fmpz_mpoly_divides_monagan_pearce(b, b, g, ctx))
+                {
+                    flint_printf("FAIL\n%s: gcd doesn't divide both inputs\n"
+                                 "i: %wd  j: %wd\n", gcd_names[k], i, j);
+                    flint_abort();
+                }
+
+                gcd(t, a, b, ctx);
+
+                if (!fmpz_mpoly_is_one(t, ctx))
+                {
+                    flint_printf("FAIL\n%s: cofactors are not relatively "
+                         "prime\ni: %wd  j: %wd\n", gcd_names[k], i, j);
+                    flint_abort();
+                }
+            }
+
+            fmpz_mpoly_clear(a, ctx);
+            fmpz_mpoly_clear(b, ctx);
+            fmpz_mpoly_clear(c, ctx);
+            fmpz_mpoly_clear(g, ctx);
+            fmpz_mpoly_clear(t, ctx);
+        }
+    }
+
+    /*
+       many variables and cofactors with thousands of terms, which only the
+       sparse algorithm is expected to handle, checked by exact division
+    */
+    for (k = 0; k < 3; k++)
+    {
+        gcd_func gcd = gcd_funcs[k];
+
+        if (gcd == fmpz_mpoly_gcd_brown)
+            continue;
+
+        for (i = 0; i < 2; i++)
+        {
+            fmpz_mpoly_ctx_t ctx;
+            fmpz_mpoly_t a, b, c, g, t;
+            ordering_t ord;
+            slong nvars, len;
+
+            ord = mpoly_ordering_randtest(state);
+            nvars = n_randint(state, 9) + 12;
+
+            fmpz_mpoly_ctx_init(ctx, nvars, ord);
+
+            fmpz_mpoly_init(a, ctx);
+            fmpz_mpoly_init(b, ctx);
+            fmpz_mpoly_init(c, ctx);
+            fmpz_mpoly_init(g, ctx);
+            fmpz_mpoly_init(t, ctx);
+
+            do {
+                fmpz_mpoly_randtest(c, state, 20, 4, 10, ctx);
+            } while (c->length < 10);
+
+            do {
+                fmpz_mpoly_randtest(a, state, 150, 4, 10, ctx);
+                fmpz_mpoly_mul_johnson(a, a, c, ctx);
+            } while (a->length < 1000);
+
+            do {
+                fmpz_mpoly_randtest(b, state, 150, 4, 10, ctx);
+                fmpz_mpoly_mul_johnson(b, b, c, ctx);
+            } while (b->length < 1000);
+
+            len = FLINT_MIN(a->length, b->length);
+
+            gcd(g, a, b, ctx);
+            fmpz_mpoly_test(g, ctx);
+
+            if (fmpz_mpoly_is_zero(g, ctx)
+             || !fmpz_mpoly_divides_monagan_pearce(t, g, c, ctx)
+             || !fmpz_mpoly_divides_monagan_pearce(a, a, g, ctx)
+             || !fmpz_mpoly_divides_monagan_pearce(b, b, g, ctx))
+            {
+                flint_printf("FAIL\n%s of %wd variables and %wd terms "
+                                "does not divide the inputs\ni: %wd\n",
+                                                 gcd_names[k], nvars, len, i);
+                flint_abort();
+            }
+
+            gcd(t, a, b, ctx);
+
+            if (!fmpz_mpoly_is_one(t, ctx))
+            {
+                flint_printf("FAIL\n%s of %wd variables: cofactors are "
+                                    "not relatively prime\ni: %wd\n",
+                                                      gcd_names[k], nvars, i);
+                flint_abort();
+            }
+
+            fmpz_mpoly_clear(a, ctx);
+            fmpz_mpoly_clear(b, ctx);
+            fmpz_mpoly_clear(c, ctx);
+            fmpz_mpoly_clear(g, ctx);
+            fmpz_mpoly_clear(t, ctx);
+        }
+    }
+
+    FLINT_TEST_CLEANUP(state);
+
+    printf("PASS\n");
+    return 0;
+}
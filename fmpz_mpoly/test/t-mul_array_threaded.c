@@ -0,0 +1,305 @@
+/*
+    Copyright (C) 2026 agent
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <gmp.h>
+#include "flint.h"
+#include "fmpz.h"
+#include "fmpz_mpoly.h"
+#include "ulong_extras.h"
+
+int
+main(void)
+{
+    int i, j, result, ok1, max_threads = 5;
+    FLINT_TEST_INIT(state);
+
+    flint_printf("mul_array_threaded....");
+    fflush(stdout);
+
+    /* Check mul_array_threaded matches mul_johnson */
+    for (i = 0; i < 10 * flint_test_multiplier(); i++)
+    {
+        fmpz_mpoly_ctx_t ctx;
+        fmpz_mpoly_t f, g, h, k;
+        ordering_t ord;
+        slong nvars, len, len1, len2, exp_bound, exp_bound1, exp_bound2;
+        slong coeff_bits, exp_bits, exp_bits1, exp_bits2;
+
+        ord = mpoly_ordering_randtest(state);
+        nvars = n_randint(state, 10) + 1;
+
+        fmpz_mpoly_ctx_init(ctx, nvars, ord);
+
+        fmpz_mpoly_init(f, ctx);
+        fmpz_mpoly_init(g, ctx);
+        fmpz_mpoly_init(h, ctx);
+        fmpz_mpoly_init(k, ctx);
+
+        len = n_randint(state, 100);
+        len1 = n_randint(state, 100);
+        len2 = n_randint(state, 100);
+
+        exp_bits = n_randint(state, 18/(nvars +
+                            mpoly_ordering_isdeg(ord) + (nvars == 1)) + 1) + 1;
+        exp_bits1 = n_randint(state, 18/(nvars +
+                            mpoly_ordering_isdeg(ord) + (nvars == 1)) + 1) + 1;
+        exp_bits2 = n_randint(state, 18/(nvars +
+                            mpoly_ordering_isdeg(ord) + (nvars == 1)) + 1) + 1;
+        exp_bound = n_randbits(state, exp_bits);
+        exp_bound1 = n_randbits(state, exp_bits1);
+        exp_bound2 = n_randbits(state, exp_bits2);
+
+        coeff_bits = n_randint(state, 200);
+
+        for (j = 0; j < 4; j++)
+        {
+            fmpz_mpoly_randtest(f, state, len1, exp_bound1, coeff_bits, ctx);
+            fmpz_mpoly_randtest(g, state, len2, exp_bound2, coeff_bits, ctx);
+            fmpz_mpoly_randtest(h, state, len, exp_bound, coeff_bits, ctx);
+            fmpz_mpoly_randtest(k, state, len, exp_bound, coeff_bits, ctx);
+
+            flint_set_num_threads(n_randint(state, max_threads) + 1);
+
+            fmpz_mpoly_mul_johnson(h, f, g, ctx);
+            fmpz_mpoly_test(h, ctx);
+
+            ok1 = fmpz_mpoly_mul_array_threaded(k, f, g, ctx);
+            fmpz_mpoly_test(k, ctx);
+
+            result = ok1 == 0 || fmpz_mpoly_equal(h, k, ctx);
+
+            if (!result)
+            {
+                printf("FAIL\n");
+
+                printf("ord = "); mpoly_ordering_print(ord);
+                printf(", len = %ld, exp_bits = %ld, exp_bound = %lx, "
+                    "len1 = %ld, exp_bits1 = %ld, exp_bound1 = %lx, "
+                    "len2 = %ld, exp_bits2 = %ld, exp_bound2 = %lx, "
+                                      "coeff_bits = %ld, nvars = %ld\n\n",
+                       len, exp_bits, exp_bound, len1, exp_bits1, exp_bound1,
+                               len2, exp_bits2, exp_bound2, coeff_bits, nvars);
+
+                fmpz_mpoly_print_pretty(f, NULL, ctx); printf("\n\n");
+                fmpz_mpoly_print_pretty(g, NULL, ctx); printf("\n\n");
+                fmpz_mpoly_print_pretty(h, NULL, ctx); printf("\n\n");
+                fmpz_mpoly_print_pretty(k, NULL, ctx); printf("\n\n");
+
+                flint_abort();
+            }
+        }
+
+        fmpz_mpoly_clear(f, ctx);
+        fmpz_mpoly_clear(g, ctx);
+        fmpz_mpoly_clear(h, ctx);
+        fmpz_mpoly_clear(k, ctx);
+    }
+
+    /* Check aliasing first argument */
+    for (i = 0; i < 10 * flint_test_multiplier(); i++)
+    {
+        fmpz_mpoly_ctx_t ctx;
+        fmpz_mpoly_t f, g, h;
+        ordering_t ord;
+        slong nvars, len, len1, len2, exp_bound, exp_bound1, exp_bound2;
+        slong coeff_bits, exp_bits, exp_bits1, exp_bits2;
+
+        ord = mpoly_ordering_randtest(state);
+        nvars = n_randint(state, 10) + 1;
+
+        fmpz_mpoly_ctx_init(ctx, nvars, ord);
+
+        fmpz_mpoly_init(f, ctx);
+        fmpz_mpoly_init(g, ctx);
+        fmpz_mpoly_init(h, ctx);
+
+        len = n_randint(state, 100);
+        len1 = n_randint(state, 100);
+        len2 = n_randint(state, 100);
+
+        exp_bits = n_randint(state, 18/(nvars +
+                            mpoly_ordering_isdeg(ord) + (nvars == 1)) + 1) + 1;
+        exp_bits1 = n_randint(state, 18/(nvars +
+                            mpoly_ordering_isdeg(ord) + (nvars == 1)) + 1) + 1;
+        exp_bits2 = n_randint(state, 18/(nvars +
+                            mpoly_ordering_isdeg(ord) + (nvars == 1)) + 1) + 1;
+        exp_bound = n_randbits(state, exp_bits);
+        exp_bound1 = n_randbits(state, exp_bits1);
+        exp_bound2 = n_randbits(state, exp_bits2);
+
+        coeff_bits = n_randint(state, 200);
+
+        for (j = 0; j < 4; j++)
+        {
+            fmpz_mpoly_randtest(f, state, len1, exp_bound1, coeff_bits, ctx);
+            fmpz_mpoly_randtest(g, state, len2, exp_bound2, coeff_bits, ctx);
+            fmpz_mpoly_randtest(h, state, len, exp_bound, coeff_bits, ctx);
+
+            flint_set_num_threads(n_randint(state, max_threads) + 1);
+
+            fmpz_mpoly_mul_johnson(h, f, g, ctx);
+            fmpz_mpoly_test(h, ctx);
+
+            ok1 = fmpz_mpoly_mul_array_threaded(f, f, g, ctx);
+            fmpz_mpoly_test(f, ctx);
+
+            result = ok1 == 0 || fmpz_mpoly_equal(h, f, ctx);
+
+            if (!result)
+            {
+                printf("FAIL\n");
+
+                printf("Aliasing test1\n");
+                printf("ord = "); mpoly_ordering_print(ord);
+                printf(", len = %ld, exp_bits = %ld, exp_bound = %lx, "
+                    "len1 = %ld, exp_bits1 = %ld, exp_bound1 = %lx, "
+                    "len2 = %ld, exp_bits2 = %ld, exp_bound2 = %lx, "
+                                      "coeff_bits = %ld, nvars = %ld\n\n",
+                       len, exp_bits, exp_bound, len1, exp_bits1, exp_bound1,
+                               len2, exp_bits2, exp_bound2, coeff_bits, nvars);
+
+                fmpz_mpoly_print_pretty(f, NULL, ctx); printf("\n\n");
+                fmpz_mpoly_print_pretty(g, NULL, ctx); printf("\n\n");
+                fmpz_mpoly_print_pretty(h, NULL, ctx); printf("\n\n");
+
+                flint_abort();
+            }
+        }
+
+        fmpz_mpoly_clear(f, ctx);
+        fmpz_mpoly_clear(g, ctx);
+        fmpz_mpoly_clear(h, ctx);
+    }
+
+    /* Check chunking with respect to several main variables */
+    for (i = 0; i < 10 * flint_test_multiplier(); i++)
+    {
+        fmpz_mpoly_ctx_t ctx;
+        fmpz_mpoly_t f, g, h, k;
+        ordering_t ord;
+        slong nvars, len, len1, len2, exp_bound1, exp_bound2, coeff_bits;
+        slong bits, nmain, nthreads;
+        ulong size, chunks, * mults, * max3;
+
+        ord = n_randint(state, 2) ? ORD_LEX : ORD_DEGLEX;
+        nvars = n_randint(state, 6) + 2 - mpoly_ordering_isdeg(ord);
+
+        fmpz_mpoly_ctx_init(ctx, nvars, ord);
+
+        fmpz_mpoly_init(f, ctx);
+        fmpz_mpoly_init(g, ctx);
+        fmpz_mpoly_init(h, ctx);
+        fmpz_mpoly_init(k, ctx);
+
+        mults = (ulong *) flint_malloc(ctx->n*sizeof(ulong));
+        max3 = (ulong *) flint_malloc(ctx->n*sizeof(ulong));
+
+        len1 = n_randint(state, 100) + 1;
+        len2 = n_randint(state, 100) + 1;
+        exp_bound1 = n_randint(state, 12) + 2;
+        exp_bound2 = n_randint(state, 12) + 2;
+        coeff_bits = n_randint(state, 200);
+
+        for (j = 0; j < 4; j++)
+        {
+            do {
+                fmpz_mpoly_randtest(f, state, len1, exp_bound1,
+                                                            coeff_bits, ctx);
+                fmpz_mpoly_randtest(g, state, len2, exp_bound2,
+                                                            coeff_bits, ctx);
+            } while (f->length == 0 || g->length == 0);
+
+            fmpz_mpoly_mul_johnson(h, f, g, ctx);
+
+            /* the product is small enough for one word exponents */
+            bits = FLINT_MAX(f->bits, g->bits);
+            fmpz_mpoly_fit_bits(f, bits, ctx);
+            fmpz_mpoly_fit_bits(g, bits, ctx);
+
+            if (words_per_exp(ctx->n, bits) != 1)
+                continue;
+
+            mpoly_max_degrees(mults, f->exps, f->length, bits, ctx->n);
+            mpoly_max_degrees(max3, g->exps, g->length, bits, ctx->n);
+            for (len = 0; len < ctx->n; len++)
+                mults[len] += max3[len] + 1;
+
+            /* keep both the chunks and the number of chunks small */
+            size = 1;
+            for (len = 0; len < ctx->n; len++)
+                size *= mults[len];
+
+            nmain = 0;
+            chunks = 1;
+            while (nmain < ctx->n - 1 && (size > 10000 ||
+                          ((nmain == 0 || n_randint(state, 2)) &&
+                               chunks*mults[ctx->n - nmain - 1] <= 1000)))
+            {
+                size /= mults[ctx->n - nmain - 1];
+                chunks *= mults[ctx->n - nmain - 1];
+                nmain++;
+            }
+
+            if (size > 10000 || chunks > 1000)
+                continue;
+
+            nthreads = n_randint(state, max_threads) + 1;
+            flint_set_num_threads(nthreads);
+
+            fmpz_mpoly_fit_length(k, f->length + g->length, ctx);
+            fmpz_mpoly_fit_bits(k, bits, ctx);
+            k->bits = bits;
+
+            len = _fmpz_mpoly_mul_array_chunked_threaded(
+                                      &k->coeffs, &k->exps, &k->alloc,
+                                      f->coeffs, f->exps, f->length,
+                                      g->coeffs, g->exps, g->length,
+                                      (slong *) mults, ctx->n - nmain, nmain,
+                                                             bits, nthreads);
+            _fmpz_mpoly_set_length(k, len, ctx);
+            fmpz_mpoly_test(k, ctx);
+
+            result = fmpz_mpoly_equal(h, k, ctx);
+
+            if (!result)
+            {
+                printf("FAIL\n");
+
+                printf("Chunking with several main variables\n");
+                printf("ord = "); mpoly_ordering_print(ord);
+                printf(", nvars = %ld, nmain = %ld, nthreads = %ld\n\n",
+                                                    nvars, nmain, nthreads);
+
+                fmpz_mpoly_print_pretty(f, NULL, ctx); printf("\n\n");
+                fmpz_mpoly_print_pretty(g, NULL, ctx); printf("\n\n");
+                fmpz_mpoly_print_pretty(h, NULL, ctx); printf("\n\n");
+                fmpz_mpoly_print_pretty(k, NULL, ctx); printf("\n\n");
+
+                flint_abort();
+            }
+        }
+
+        flint_free(mults);
+        flint_free(max3);
+
+        fmpz_mpoly_clear(f, ctx);
+        fmpz_mpoly_clear(g, ctx);
+        fmpz_mpoly_clear(h, ctx);
+        fmpz_mpoly_clear(k, ctx);
+    }
+
+    FLINT_TEST_CLEANUP(state);
+
+    flint_printf("PASS\n");
+    return 0;
+}
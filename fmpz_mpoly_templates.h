@@ -0,0 +1,207 @@
+/*
+    Copyright (C) 2026 agent
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+/*
+   Heap and monomial primitives for exponent vectors of exactly W words,
+   used to instantiate the kernels in fmpz_mpoly_templates for small W.
+   Unlike the mpoly_heap_s heap, whose entries point to exponent vectors
+   stored elsewhere, heap entries here contain the exponent vector itself,
+   as for mpoly_heap1_s. As W is a constant, all loops over the words of an
+   exponent vector can be unrolled by the compiler and comparisons,
+   additions and overflow checks are done in registers.
+*/
+
+#ifndef FMPZ_MPOLY_TEMPLATES_H
+#define FMPZ_MPOLY_TEMPLATES_H
+
+#define __WCAT(X, Y) X##Y
+#define _WCAT(X, Y) __WCAT(X, Y)
+#define __WCAT3(X, Y, Z) X##Y##Z
+#define _WCAT3(X, Y, Z) __WCAT3(X, Y, Z)
+
+/* append the number of words W to a name, e.g. X2 or X2_s */
+#define WTEMPLATE(X) _WCAT(X, W)
+#define WTEMPLATE3(X, Y) _WCAT3(X, W, Y)
+
+#endif
+
+#ifdef W
+
+typedef struct
+{
+   ulong exp[W];
+   void * next;
+} WTEMPLATE3(mpoly_heap, _s);
+
+static __inline__
+void WTEMPLATE(mpoly_monomial_set)(ulong * exp1, const ulong * exp2)
+{
+   slong i;
+   for (i = 0; i < W; i++)
+      exp1[i] = exp2[i];
+}
+
+static __inline__
+void WTEMPLATE(mpoly_monomial_add)(ulong * exp1, const ulong * exp2,
+                                                            const ulong * exp3)
+{
+   slong i;
+   for (i = 0; i < W; i++)
+      exp1[i] = exp2[i] + exp3[i];
+}
+
+static __inline__
+int WTEMPLATE(mpoly_monomial_equal)(const ulong * exp2, const ulong * exp3)
+{
+   slong i;
+   ulong t = 0;
+   for (i = 0; i < W; i++)
+      t |= exp2[i] ^ exp3[i];
+   return t == 0;
+}
+
+/* same as mpoly_monomial_gt */
+static __inline__
+int WTEMPLATE(mpoly_monomial_gt)(const ulong * exp2, const ulong * exp3,
+                                                    ulong maskhi, ulong masklo)
+{
+   slong i;
+
+   if (exp2[0] != exp3[0])
+      return (exp3[0]^maskhi) > (exp2[0]^maskhi);
+
+   for (i = 1; i < W - 1; i++)
+   {
+      if (exp2[i] != exp3[i])
+         return (exp3[i]^masklo) > (exp2[i]^masklo);
+   }
+
+   return (exp3[W - 1]^masklo) > (exp2[W - 1]^masklo);
+}
+
+static __inline__
+int WTEMPLATE(mpoly_monomial_overflows)(const ulong * exp, ulong mask)
+{
+   slong i;
+   ulong t = 0;
+   for (i = 0; i < W; i++)
+      t |= exp[i];
+   return (t & mask) != 0;
+}
+
+/* set exp1 to exp2 - exp3 and return 1 if no field underflowed */
+static __inline__
+int WTEMPLATE(mpoly_monomial_divides)(ulong * exp1, const ulong * exp2,
+                                              const ulong * exp3, ulong mask)
+{
+   slong i;
+   ulong t = 0;
+   for (i = 0; i < W; i++)
+   {
+      exp1[i] = exp2[i] - exp3[i];
+      t |= exp1[i];
+   }
+   return (t & mask) == 0;
+}
+
+static __inline__
+void * WTEMPLATE(_mpoly_heap_pop)(WTEMPLATE3(mpoly_heap, _s) * heap,
+                               slong * heap_len, ulong maskhi, ulong masklo)
+{
+   const ulong * exp;
+   slong i, j, s = --(*heap_len);
+   void * x = heap[1].next;
+
+   i = 1;
+   j = 2;
+
+   while (j < s)
+   {
+      if (!WTEMPLATE(mpoly_monomial_gt)(heap[j + 1].exp, heap[j].exp,
+                                                               maskhi, masklo))
+         j++;
+      heap[i] = heap[j];
+      i = j;
+      j = HEAP_LEFT(j);
+   }
+
+   /* insert last element into heap[i], heap[s] is not overwritten above */
+   exp = heap[s].exp;
+   j = HEAP_PARENT(i);
+
+   while (i > 1 && WTEMPLATE(mpoly_monomial_gt)(heap[j].exp, exp,
+                                                               maskhi, masklo))
+   {
+      heap[i] = heap[j];
+      i = j;
+      j = HEAP_PARENT(j);
+   }
+
+   heap[i] = heap[s];
+
+   return x;
+}
+
+static __inline__
+void WTEMPLATE(_mpoly_heap_insert)(WTEMPLATE3(mpoly_heap, _s) * heap,
+                 const ulong * exp, void * x, slong * next_loc,
+                                slong * heap_len, ulong maskhi, ulong masklo)
+{
+   slong i = *heap_len, j, n = *heap_len;
+
+   if (i != 1 && WTEMPLATE(mpoly_monomial_equal)(exp, heap[1].exp))
+   {
+      ((mpoly_heap_t *) x)->next = heap[1].next;
+      heap[1].next = x;
+
+      return;
+   }
+
+   if (*next_loc < *heap_len)
+   {
+      if (WTEMPLATE(mpoly_monomial_equal)(exp, heap[*next_loc].exp))
+      {
+         ((mpoly_heap_t *) x)->next = heap[*next_loc].next;
+         heap[*next_loc].next = x;
+
+         return;
+      }
+   }
+
+   while ((j = HEAP_PARENT(i)) >= 1)
+   {
+      if (WTEMPLATE(mpoly_monomial_equal)(exp, heap[j].exp))
+      {
+         ((mpoly_heap_t *) x)->next = heap[j].next;
+         heap[j].next = x;
+         *next_loc = j;
+
+         return;
+      } else if (WTEMPLATE(mpoly_monomial_gt)(heap[j].exp, exp,
+                                                               maskhi, masklo))
+         i = j;
+      else
+         break;
+   }
+
+   (*heap_len)++;
+
+   while (n > i)
+   {
+      heap[n] = heap[HEAP_PARENT(n)];
+      n = HEAP_PARENT(n);
+   }
+
+   WTEMPLATE(mpoly_monomial_set)(heap[i].exp, exp);
+   heap[i].next = x;
+}
+
+#endif
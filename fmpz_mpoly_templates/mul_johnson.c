@@ -0,0 +1,221 @@
+/*
+    Copyright (C) 2017 Daniel Schultz
+    Copyright (C) 2026 agent
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#ifdef W
+
+/*
+   Set poly1 to poly2*poly3 using Johnson's heap method. The function
+   realocates its output and returns the length of the product. This
+   version of the function assumes the exponent vectors all take exactly
+   W words. Assumes input polys are nonzero.
+*/
+slong WTEMPLATE(_fmpz_mpoly_mul_johnson)(fmpz ** poly1, ulong ** exp1,
+        slong * alloc, const fmpz * poly2, const ulong * exp2, slong len2,
+                       const fmpz * poly3, const ulong * exp3, slong len3,
+                                                    ulong maskhi, ulong masklo)
+{
+   slong i, j, k;
+   slong next_loc;
+   slong Q_len = 0, heap_len = 2; /* heap zero index unused */
+   WTEMPLATE3(mpoly_heap, _s) * heap;
+   mpoly_heap_t * chain;
+   slong * Q;
+   mpoly_heap_t * x;
+   fmpz * p1 = *poly1;
+   ulong * e1 = *exp1;
+   slong * hind;
+   ulong exp[W], texp[W], cy;
+   ulong c[3], p[2]; /* for accumulating coefficients */
+   int first, small;
+   TMP_INIT;
+
+   TMP_START;
+
+   /* whether input coeffs are small, thus output coeffs fit in three words */
+   small = _fmpz_mpoly_fits_small(poly2, len2) &&
+                                           _fmpz_mpoly_fits_small(poly3, len3);
+
+   next_loc = len2 + 4;   /* something bigger than heap can ever be */
+   heap = (WTEMPLATE3(mpoly_heap, _s) *)
+                   TMP_ALLOC((len2 + 1)*sizeof(WTEMPLATE3(mpoly_heap, _s)));
+   /* alloc array of heap nodes which can be chained together */
+   chain = (mpoly_heap_t *) TMP_ALLOC(len2*sizeof(mpoly_heap_t));
+   /* space for temporary storage of pointers to heap nodes */
+   Q = (slong *) TMP_ALLOC(2*len2*sizeof(slong));
+
+   /* space for heap indices */
+   hind = (slong *) TMP_ALLOC(len2*sizeof(slong));
+   for (i = 0; i < len2; i++)
+      hind[i] = 1;
+
+   /* put (0, 0, exp2[0] + exp3[0]) on heap */
+   x = chain + 0;
+   x->i = 0;
+   x->j = 0;
+   x->next = NULL;
+
+   WTEMPLATE(mpoly_monomial_add)(heap[1].exp, exp2, exp3);
+   heap[1].next = x;
+   hind[0] = 2*1 + 0;
+
+   /* output poly index starts at -1, will be immediately updated to 0 */
+   k = -WORD(1);
+
+   /* while heap is nonempty */
+   while (heap_len > 1)
+   {
+      /* get exponent field of heap top */
+      WTEMPLATE(mpoly_monomial_set)(exp, heap[1].exp);
+
+      /* realloc output poly ready for next product term */
+      k++;
+      _fmpz_mpoly_fit_length(&p1, &e1, alloc, k + 1, W);
+
+      /* whether we are on first coeff product for this output exponent */
+      first = 1;
+
+      /* set temporary coeff to zero */
+      c[0] = c[1] = c[2] = 0;
+
+      /* while heap nonempty and contains chain with current output exponent */
+      while (heap_len > 1 && WTEMPLATE(mpoly_monomial_equal)(heap[1].exp, exp))
+      {
+         /* pop chain from heap */
+         x = WTEMPLATE(_mpoly_heap_pop)(heap, &heap_len, maskhi, masklo);
+
+         /* take node out of heap and put into store */
+         hind[x->i] |= WORD(1);
+         Q[Q_len++] = x->i;
+         Q[Q_len++] = x->j;
+
+         /* if output coeffs will fit in three words */
+         if (small)
+         {
+            /* compute product of input poly coeffs */
+            if (first)
+            {
+               smul_ppmm(c[1], c[0], poly2[x->i], poly3[x->j]);
+               c[2] = -(c[1] >> (FLINT_BITS - 1));
+
+               /* set output monomial */
+               WTEMPLATE(mpoly_monomial_set)(e1 + k*W, exp);
+               first = 0;
+            } else /* addmul product of input poly coeffs */
+            {
+               smul_ppmm(p[1], p[0], poly2[x->i], poly3[x->j]);
+               add_sssaaaaaa(cy, c[1], c[0], 0, c[1], c[0], 0, p[1], p[0]);
+               c[2] += (0 <= (slong) p[1]) ? cy : cy - 1;
+            }
+
+            /* for every node in this chain */
+            while ((x = x->next) != NULL)
+            {
+               /* addmul product of input poly coeffs */
+               smul_ppmm(p[1], p[0], poly2[x->i], poly3[x->j]);
+               add_sssaaaaaa(cy, c[1], c[0], 0, c[1], c[0], 0, p[1], p[0]);
+               c[2] += (0 <= (slong) p[1]) ? cy : cy - 1;
+
+               /* take node out of heap and put into store */
+               hind[x->i] |= WORD(1);
+               Q[Q_len++] = x->i;
+               Q[Q_len++] = x->j;
+            }
+         } else /* output coeffs require multiprecision */
+         {
+            if (first) /* compute product of input poly coeffs */
+            {
+               fmpz_mul(p1 + k, poly2 + x->i, poly3 + x->j);
+
+               WTEMPLATE(mpoly_monomial_set)(e1 + k*W, exp);
+               first = 0;
+            } else
+            {  /* addmul product of input poly coeffs */
+               fmpz_addmul(p1 + k, poly2 + x->i, poly3 + x->j);
+            }
+
+            /* for each node in this chain */
+            while ((x = x->next) != NULL)
+            {
+               /* addmul product of input poly coeffs */
+               fmpz_addmul(p1 + k, poly2 + x->i, poly3 + x->j);
+
+               /* take node out of heap and put into store */
+               hind[x->i] |= WORD(1);
+               Q[Q_len++] = x->i;
+               Q[Q_len++] = x->j;
+            }
+         }
+      }
+
+      /* for each node temporarily stored */
+      while (Q_len > 0)
+      {
+         /* take node from store */
+         j = Q[--Q_len];
+         i = Q[--Q_len];
+
+         /* should we go right? */
+         if (  (i + 1 < len2)
+            && (hind[i + 1] == 2*j + 1)
+            )
+         {
+            x = chain + i + 1;
+            x->i = i + 1;
+            x->j = j;
+            x->next = NULL;
+
+            hind[x->i] = 2*(x->j+1) + 0;
+            WTEMPLATE(mpoly_monomial_add)(texp, exp2 + x->i*W, exp3 + x->j*W);
+            WTEMPLATE(_mpoly_heap_insert)(heap, texp, x,
+                                         &next_loc, &heap_len, maskhi, masklo);
+         }
+
+         /* should we go up? */
+         if (  (j + 1 < len3)
+            && ((hind[i] & 1) == 1)
+            && (  (i == 0)
+               || (hind[i - 1] >  2*(j + 2) + 1)
+               || (hind[i - 1] == 2*(j + 2) + 1) /* gcc should fuse */
+               )
+            )
+         {
+            x = chain + i;
+            x->i = i;
+            x->j = j + 1;
+            x->next = NULL;
+
+            hind[x->i] = 2*(x->j+1) + 0;
+            WTEMPLATE(mpoly_monomial_add)(texp, exp2 + x->i*W, exp3 + x->j*W);
+            WTEMPLATE(_mpoly_heap_insert)(heap, texp, x,
+                                         &next_loc, &heap_len, maskhi, masklo);
+         }
+      }
+
+      /* set output poly coeff from temporary accumulation, if not multiprec */
+      if (small)
+         fmpz_set_signed_uiuiui(p1 + k, c[2], c[1], c[0]);
+
+      if (fmpz_is_zero(p1 + k))
+         k--;
+   }
+
+   k++;
+
+   (*poly1) = p1;
+   (*exp1) = e1;
+
+   TMP_END;
+
+   return k;
+}
+
+#endif
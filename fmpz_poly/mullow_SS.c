@@ -12,7 +12,6 @@
 #include <stdlib.h>
 #include "fmpz_poly.h"
 #include "fft.h"
-#include "fft_tuning.h"
 #include "flint.h"
 
 #if HAVE_OPENMP
@@ -28,9 +27,7 @@ void _fmpz_poly_mullow_SS(fmpz * output, const fmpz * input1, slong len1,
     slong bits1, bits2;
     ulong size1, size2;
     int sign = 0;
-#if HAVE_OPENMP
-    int N;
-#endif
+    slong N;
     TMP_INIT;
 
     TMP_START;
@@ -53,21 +50,17 @@ void _fmpz_poly_mullow_SS(fmpz * output, const fmpz * input1, slong len1,
     output_bits = (((output_bits - 1) >> (loglen - 2)) + 1) << (loglen - 2);
 
     limbs = (output_bits - 1) / FLINT_BITS + 1; /* initial size of FFT coeffs */
-    if (limbs > FFT_MULMOD_2EXPP1_CUTOFF) /* can't be worse than next power of 2 limbs */
+    if (limbs > _fft_tuning_active()->mulmod_cutoff) /* can't be worse than next power of 2 limbs */
         limbs = (WORD(1) << FLINT_CLOG2(limbs));
     size = limbs + 1;
 
     /* allocate space for ffts */
 
-#if HAVE_OPENMP
-    N = omp_get_max_threads();
+    /* one set of temporaries for each thread */
+    N = fft_mfa_num_threads();
     ii = flint_malloc((4*(n + n*size) + 5*size*N)*sizeof(mp_limb_t));
-#else
-    ii = flint_malloc((4*(n + n*size) + 5*size)*sizeof(mp_limb_t));
-#endif
     for (i = 0, ptr = (mp_limb_t *) ii + 4*n; i < 4*n; i++, ptr += size) 
         ii[i] = ptr;
-#if HAVE_OPENMP
    t1 = TMP_ALLOC(N*sizeof(mp_limb_t *));
    t2 = TMP_ALLOC(N*sizeof(mp_limb_t *));
    s1 = TMP_ALLOC(N*sizeof(mp_limb_t *));
@@ -85,17 +78,6 @@ void _fmpz_poly_mullow_SS(fmpz * output, const fmpz * input1, slong len1,
       s1[i] = s1[i - 1] + size;
       tt[i] = tt[i - 1] + 2*size;
    }
-#else
-   t1 = TMP_ALLOC(sizeof(mp_limb_t *));
-   t2 = TMP_ALLOC(sizeof(mp_limb_t *));
-   s1 = TMP_ALLOC(sizeof(mp_limb_t *));
-   tt = TMP_ALLOC(sizeof(mp_limb_t *));
-
-   t1[0] = ptr;
-   t2[0] = t1[0] + size;
-   s1[0] = t2[0] + size;
-   tt[0] = s1[0] + size;
-#endif   
 
     if (input1 != input2)
     {
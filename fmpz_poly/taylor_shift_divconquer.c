@@ -10,7 +10,6 @@
 */
 
 #include <math.h>
-#include <pthread.h>
 #include <gmp.h>
 #include "flint.h"
 #include "fmpz.h"
@@ -37,7 +36,6 @@ _fmpz_poly_taylor_shift_dc_worker(void * arg_ptr)
     flint_set_num_threads(data->num_threads);
     _fmpz_poly_taylor_shift_dc(data->poly, data->c, data->len,
                                data->num_total_threads);
-    flint_cleanup();
     return NULL;
 }
 
@@ -85,7 +83,6 @@ _fmpz_poly_taylor_shift_dc(fmpz * poly, const fmpz_t c, slong len,
     }
     else
     {
-        pthread_t threads[2];
         worker_t args[2];
 
         args[0].poly = poly;
@@ -104,13 +101,8 @@ _fmpz_poly_taylor_shift_dc(fmpz * poly, const fmpz_t c, slong len,
         args[1].num_threads = args[0].num_threads;
         args[1].num_total_threads = args[0].num_total_threads;
 
-        pthread_create(&threads[0], NULL,
-            _fmpz_poly_taylor_shift_dc_worker, &args[0]);
-        pthread_create(&threads[1], NULL,
-            _fmpz_poly_taylor_shift_dc_worker, &args[1]);
-
-        pthread_join(threads[0], NULL);
-        pthread_join(threads[1], NULL);
+        flint_parallel_do(_fmpz_poly_taylor_shift_dc_worker,
+                                                  args, sizeof(worker_t), 2);
     }
 
     tmp = _fmpz_vec_init(len1 + 1);
@@ -9,7 +9,6 @@
     (at your option) any later version.  See <http://www.gnu.org/licenses/>.
 */
 
-#include <pthread.h>
 #include <gmp.h>
 #include "flint.h"
 #include "fmpz.h"
@@ -61,7 +60,6 @@ _fmpz_vec_multi_mod_ui_worker(void * arg_ptr)
     fmpz_comb_clear(comb);
     fmpz_comb_temp_clear(comb_temp);
 
-    flint_cleanup();
     return NULL;
 }
 
@@ -69,12 +67,10 @@ void
 _fmpz_vec_multi_mod_ui_threaded(mp_ptr * residues, fmpz * vec, slong len,
     mp_srcptr primes, slong num_primes, int crt)
 {
-    pthread_t * threads;
     mod_ui_arg_t * args;
     slong i, num_threads;
 
     num_threads = flint_get_num_threads();
-    threads = flint_malloc(sizeof(pthread_t) * num_threads);
     args = flint_malloc(sizeof(mod_ui_arg_t) * num_threads);
 
     for (i = 0; i < num_threads; i++)
@@ -86,15 +82,11 @@ _fmpz_vec_multi_mod_ui_threaded(mp_ptr * residues, fmpz * vec, slong len,
         args[i].primes = (mp_ptr) primes;
         args[i].num_primes = num_primes;
         args[i].crt = crt;
-
-        pthread_create(&threads[i], NULL,
-            _fmpz_vec_multi_mod_ui_worker, &args[i]);
     }
 
-    for (i = 0; i < num_threads; i++)
-        pthread_join(threads[i], NULL);
+    flint_parallel_do(_fmpz_vec_multi_mod_ui_worker,
+                                       args, sizeof(mod_ui_arg_t), num_threads);
 
-    flint_free(threads);
     flint_free(args);
 }
 
@@ -127,7 +119,6 @@ _fmpz_poly_multi_taylor_shift_worker(void * arg_ptr)
         _nmod_poly_taylor_shift(arg.residues[i], cm, arg.len, mod);
     }
 
-    flint_cleanup();
     return NULL;
 }
 
@@ -135,12 +126,10 @@ void
 _fmpz_poly_multi_taylor_shift_threaded(mp_ptr * residues, slong len,
     const fmpz_t c, mp_srcptr primes, slong num_primes)
 {
-    pthread_t * threads;
     taylor_shift_arg_t * args;
     slong i, num_threads;
 
     num_threads = flint_get_num_threads();
-    threads = flint_malloc(sizeof(pthread_t) * num_threads);
     args = flint_malloc(sizeof(taylor_shift_arg_t) * num_threads);
 
     for (i = 0; i < num_threads; i++)
@@ -152,15 +141,11 @@ _fmpz_poly_multi_taylor_shift_threaded(mp_ptr * residues, slong len,
         args[i].primes = (mp_ptr) primes;
         args[i].num_primes = num_primes;
         args[i].c = (fmpz *) c;
-
-        pthread_create(&threads[i], NULL,
-            _fmpz_poly_multi_taylor_shift_worker, &args[i]);
     }
 
-    for (i = 0; i < num_threads; i++)
-        pthread_join(threads[i], NULL);
+    flint_parallel_do(_fmpz_poly_multi_taylor_shift_worker,
+                                 args, sizeof(taylor_shift_arg_t), num_threads);
 
-    flint_free(threads);
     flint_free(args);
 }
 
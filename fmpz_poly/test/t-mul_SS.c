@@ -154,7 +154,9 @@ main(void)
         fmpz_poly_randtest(b, state, n_randint(state, 300), n_randint(state, 20000) + 1);
         fmpz_poly_randtest(c, state, n_randint(state, 300), n_randint(state, 20000) + 1);
 
+        flint_set_num_threads(1 + n_randint(state, 4));
         fmpz_poly_mul_SS(a, b, c);
+        flint_set_num_threads(1);
         fmpz_poly_mul_KS(d, b, c);
 
         result = (fmpz_poly_equal(a, d));
@@ -229,6 +229,19 @@ FLINT_DLL void _fmpz_vec_lcm(fmpz_t res, const fmpz * vec, slong len);
 
 FLINT_DLL void _fmpz_vec_dot(fmpz_t res, const fmpz * vec1, const fmpz * vec2, slong len2);
 
+/*  Primality testing  *******************************************************/
+
+#define FMPZ_VEC_PRIME_BLOCK 64 /* candidates sieved by each remainder tree */
+
+/* sieving primes are taken up to this times the maximum bit size */
+#define FMPZ_VEC_PRIME_SIEVE_MUL 64
+
+#define FMPZ_VEC_PRIME_SIEVE_MAX 65536 /* but no further than this */
+
+FLINT_DLL void _fmpz_vec_is_probabprime(int * res, const fmpz * vec, slong len);
+
+FLINT_DLL void _fmpz_vec_is_prime(int * res, const fmpz * vec, slong len);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,55 @@
+/*
+    Copyright (C) 2026 agent
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include <gmp.h>
+#include "flint.h"
+#include "fmpz.h"
+#include "fmpz_vec.h"
+
+typedef struct
+{
+    int * res;
+    const fmpz * vec;
+    slong * idx;     /* indices of the multi-limb probable primes */
+} _fmpz_vec_is_prime_arg_t;
+
+static void
+_fmpz_vec_is_prime_worker(void * arg_ptr, slong i)
+{
+    _fmpz_vec_is_prime_arg_t * arg = arg_ptr;
+    slong j = arg->idx[i];
+
+    arg->res[j] = fmpz_is_prime(arg->vec + j);
+}
+
+void
+_fmpz_vec_is_prime(int * res, const fmpz * vec, slong len)
+{
+    _fmpz_vec_is_prime_arg_t arg;
+    slong i, num;
+
+    /* single limb results are already proven */
+    _fmpz_vec_is_probabprime(res, vec, len);
+
+    arg.res = res;
+    arg.vec = vec;
+    arg.idx = flint_malloc(len*sizeof(slong));
+
+    for (i = num = 0; i < len; i++)
+    {
+        if (res[i] && !fmpz_abs_fits_ui(vec + i))
+            arg.idx[num++] = i;
+    }
+
+    flint_parallel_for(0, num, 1, _fmpz_vec_is_prime_worker, &arg);
+
+    flint_free(arg.idx);
+}
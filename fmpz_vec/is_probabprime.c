@@ -0,0 +1,145 @@
+/*
+    Copyright (C) 2026 agent
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include <gmp.h>
+#include "flint.h"
+#include "ulong_extras.h"
+#include "fmpz.h"
+#include "fmpz_vec.h"
+
+typedef struct
+{
+    int * res;
+    const fmpz * vec;
+    slong * idx;     /* indices of the multi-limb candidates */
+    slong num;       /* number of such candidates */
+    fmpz * P;        /* product of the sieving primes */
+} _fmpz_vec_is_probabprime_arg_t;
+
+/*
+   Remainder tree for block b of the multi-limb candidates: P is reduced
+   modulo the product of the block, then down the product tree, so that
+   candidate c is divisible by a sieving prime iff gcd(P mod c, c) != 1.
+   Candidates without a small factor are marked with res = -1.
+*/
+static void
+_fmpz_vec_is_probabprime_sieve(void * arg_ptr, slong b)
+{
+    _fmpz_vec_is_probabprime_arg_t * arg = arg_ptr;
+    slong start = b*FMPZ_VEC_PRIME_BLOCK;
+    slong n = FLINT_MIN(FMPZ_VEC_PRIME_BLOCK, arg->num - start);
+    slong i, k, levels, len[FLINT_BITS];
+    fmpz * tree[FLINT_BITS];
+    fmpz * rem[FLINT_BITS];
+    fmpz_t g;
+
+    for (levels = 1; (WORD(1) << (levels - 1)) < n; levels++) ;
+
+    /* tree[0] holds the candidates, tree[k] products of pairs from tree[k-1] */
+    len[0] = n;
+    tree[0] = _fmpz_vec_init(n);
+    rem[0] = _fmpz_vec_init(n);
+
+    for (i = 0; i < n; i++)
+        fmpz_set(tree[0] + i, arg->vec + arg->idx[start + i]);
+
+    for (k = 1; k < levels; k++)
+    {
+        len[k] = (len[k - 1] + 1)/2;
+        tree[k] = _fmpz_vec_init(len[k]);
+        rem[k] = _fmpz_vec_init(len[k]);
+
+        for (i = 0; i + 1 < len[k - 1]; i += 2)
+            fmpz_mul(tree[k] + i/2, tree[k - 1] + i, tree[k - 1] + i + 1);
+
+        if (i < len[k - 1])
+            fmpz_set(tree[k] + i/2, tree[k - 1] + i);
+    }
+
+    fmpz_mod(rem[levels - 1], arg->P, tree[levels - 1]);
+
+    for (k = levels - 2; k >= 0; k--)
+    {
+        for (i = 0; i < len[k]; i++)
+            fmpz_mod(rem[k] + i, rem[k + 1] + i/2, tree[k] + i);
+    }
+
+    fmpz_init(g);
+
+    for (i = 0; i < n; i++)
+    {
+        fmpz_gcd(g, rem[0] + i, tree[0] + i);
+        arg->res[arg->idx[start + i]] = fmpz_is_one(g) ? -1 : 0;
+    }
+
+    fmpz_clear(g);
+
+    for (k = 0; k < levels; k++)
+    {
+        _fmpz_vec_clear(tree[k], len[k]);
+        _fmpz_vec_clear(rem[k], len[k]);
+    }
+}
+
+static void
+_fmpz_vec_is_probabprime_BPSW(void * arg_ptr, slong i)
+{
+    _fmpz_vec_is_probabprime_arg_t * arg = arg_ptr;
+    slong j = arg->idx[i];
+
+    if (arg->res[j] == -1)
+        arg->res[j] = fmpz_is_probabprime_BPSW(arg->vec + j);
+}
+
+void
+_fmpz_vec_is_probabprime(int * res, const fmpz * vec, slong len)
+{
+    _fmpz_vec_is_probabprime_arg_t arg;
+    mp_bitcnt_t bits;
+    slong i, num;
+    fmpz_t P;
+
+    arg.idx = flint_malloc(len*sizeof(slong));
+
+    /* single limb candidates are dealt with directly */
+    for (i = num = 0; i < len; i++)
+    {
+        if (fmpz_sgn(vec + i) <= 0)
+            res[i] = 0;
+        else if (fmpz_abs_fits_ui(vec + i))
+            res[i] = n_is_prime(fmpz_get_ui(vec + i));
+        else
+            arg.idx[num++] = i;
+    }
+
+    if (num != 0)
+    {
+        bits = FLINT_ABS(_fmpz_vec_max_bits(vec, len));
+
+        arg.res = res;
+        arg.vec = vec;
+        arg.num = num;
+        arg.P = P;
+
+        fmpz_init(P);
+        fmpz_primorial(P, FLINT_MIN(FMPZ_VEC_PRIME_SIEVE_MAX,
+                                   bits*FMPZ_VEC_PRIME_SIEVE_MUL));
+
+        flint_parallel_for(0, (num + FMPZ_VEC_PRIME_BLOCK - 1)/FMPZ_VEC_PRIME_BLOCK,
+                                   1, _fmpz_vec_is_probabprime_sieve, &arg);
+
+        flint_parallel_for(0, num, 1, _fmpz_vec_is_probabprime_BPSW, &arg);
+
+        fmpz_clear(P);
+    }
+
+    flint_free(arg.idx);
+}
@@ -0,0 +1,113 @@
+/*
+    Copyright (C) 2026 agent
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <gmp.h>
+#include "flint.h"
+#include "fmpz.h"
+#include "fmpz_vec.h"
+#include "ulong_extras.h"
+
+/* random primes, products of them and random integers of up to bits bits */
+static void randtest_primes(fmpz * vec, flint_rand_t state,
+                                                     slong len, slong bits)
+{
+    slong i;
+    fmpz_t p;
+
+    fmpz_init(p);
+
+    for (i = 0; i < len; i++)
+    {
+        switch (n_randint(state, 4))
+        {
+            case 0:
+                fmpz_randtest(vec + i, state, bits);
+                break;
+            case 1:
+                fmpz_randprime(vec + i, state, n_randint(state, bits - 1) + 2, 0);
+                break;
+            default:
+                fmpz_randprime(vec + i, state, n_randint(state, bits/2) + 2, 0);
+                fmpz_randprime(p, state, n_randint(state, bits/2) + 2, 0);
+                fmpz_mul(vec + i, vec + i, p);
+        }
+    }
+
+    fmpz_clear(p);
+}
+
+int
+main(void)
+{
+    int i, j, result;
+    FLINT_TEST_INIT(state);
+
+    flint_printf("is_prime....");
+    fflush(stdout);
+
+    /* check is_probabprime and is_prime on the same vectors */
+    for (i = 0; i < 20 * flint_test_multiplier(); i++)
+    {
+        fmpz * f;
+        int * res1, * res2;
+        slong len = n_randint(state, 300);
+        slong bits = n_randint(state, 300) + 3;
+
+        flint_set_num_threads(n_randint(state, 4) + 1);
+
+        f = _fmpz_vec_init(len);
+        res1 = flint_malloc(len*sizeof(int));
+        res2 = flint_malloc(len*sizeof(int));
+
+        randtest_primes(f, state, len, bits);
+
+        _fmpz_vec_is_probabprime(res1, f, len);
+
+        /* proving primality is slower, so only for smaller entries */
+        if (bits <= 200)
+            _fmpz_vec_is_prime(res2, f, len);
+
+        for (j = 0; j < len; j++)
+        {
+            if (fmpz_sgn(f + j) <= 0)
+                result = (res1[j] == 0);
+            else if (fmpz_abs_fits_ui(f + j))
+                result = (res1[j] == n_is_prime(fmpz_get_ui(f + j)));
+            else
+                result = (res1[j] == fmpz_is_probabprime_BPSW(f + j));
+
+            if (bits <= 200 && result)
+                result = (res2[j] == (res1[j] ? fmpz_is_prime(f + j) : 0));
+
+            if (!result)
+            {
+                flint_printf("FAIL:\n");
+                fmpz_print(f + j), flint_printf("\n\n");
+                flint_printf("res1 = %d, res2 = %d\n", res1[j],
+                                                   bits <= 200 ? res2[j] : -1);
+                abort();
+            }
+        }
+
+        _fmpz_vec_clear(f, len);
+        flint_free(res1);
+        flint_free(res2);
+    }
+
+    flint_set_num_threads(1);
+
+    FLINT_TEST_CLEANUP(state);
+    
+    flint_printf("PASS\n");
+    return 0;
+}
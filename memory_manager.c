@@ -198,6 +198,10 @@ void flint_cleanup()
 {
     size_t i;
 
+    /* the loop that runs this task may still be using the caches */
+    if (_flint_parallel_in_task())
+        return;
+
 #if FLINT_REENTRANT && !HAVE_TLS
     pthread_mutex_lock(&register_lock);
 #endif
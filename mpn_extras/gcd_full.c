@@ -35,22 +35,22 @@ mp_size_t flint_mpn_gcd_full(mp_ptr arrayg,
    /* this many output limbs will be zero */
    flint_mpn_zero(arrayg, m);
 
-   /* set in1 to shifted array1 */
+   /* set in1 to shifted array1, mpn_gcd destroys its inputs so copy them */
+   in1 = flint_malloc(len1*sizeof(mp_limb_t));
    if (b1 == 0)
-      in1 = array1 + s1;
+      flint_mpn_copyi(in1, array1 + s1, len1);
    else
    {
-      in1 = flint_malloc(len1*sizeof(mp_limb_t));
       mpn_rshift(in1, array1 + s1, len1, b1);
       len1 -= (in1[len1 - 1] == 0); 
    }
 
    /* set in2 to shifted array2 */
+   in2 = flint_malloc(len2*sizeof(mp_limb_t));
    if (b2 == 0)
-      in2 = array2 + s2;
+      flint_mpn_copyi(in2, array2 + s2, len2);
    else
    {
-      in2 = flint_malloc(len2*sizeof(mp_limb_t));
       mpn_rshift(in2, array2 + s2, len2, b2);
       len2 -= (in2[len2 - 1] == 0); 
    }
@@ -69,8 +69,8 @@ mp_size_t flint_mpn_gcd_full(mp_ptr arrayg,
    }
 
    /* clean up */
-   if (b1) flint_free(in1);
-   if (b2) flint_free(in2);
+   flint_free(in1);
+   flint_free(in2);
 
    /* return total number of limbs in output */
    return m + leng;
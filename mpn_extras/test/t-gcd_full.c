@@ -19,7 +19,7 @@
 int main(void)
 {
     int i, result;
-    mpz_t a, b, c, g;
+    mpz_t a, b, c, g, a2, b2;
     gmp_randstate_t st;
     slong s1, s2;
     
@@ -31,6 +31,8 @@ int main(void)
     mpz_init(a);
     mpz_init(b);
     mpz_init(c);
+    mpz_init(a2);
+    mpz_init(b2);
     /* don't init g */
     gmp_randinit_default(st);
 
@@ -52,6 +54,8 @@ int main(void)
        mpz_mul_2exp(b, b, n_randint(state, 200));
 
        mpz_gcd(c, a, b);
+       mpz_set(a2, a);
+       mpz_set(b2, b);
 
        s1 = (mpz_sizeinbase(a, 2) - 1)/FLINT_BITS + 1;
        s2 = (mpz_sizeinbase(b, 2) - 1)/FLINT_BITS + 1;
@@ -60,7 +64,9 @@ int main(void)
 
        g->_mp_size = flint_mpn_gcd_full(g->_mp_d, a->_mp_d, a->_mp_size, b->_mp_d, b->_mp_size); 
 
-       result = (mpz_cmp(g, c) == 0);
+       /* the inputs must not be destroyed */
+       result = (mpz_cmp(g, c) == 0 && mpz_cmp(a, a2) == 0
+                                    && mpz_cmp(b, b2) == 0);
        if (!result)
        {
           flint_printf("FAIL:\n");
@@ -75,6 +81,8 @@ int main(void)
     mpz_clear(a);
     mpz_clear(b);
     mpz_clear(c);
+    mpz_clear(a2);
+    mpz_clear(b2);
     /* don't clear g */
     gmp_randclear(st);
     FLINT_TEST_CLEANUP(state);
@@ -548,6 +548,12 @@ FLINT_DLL void mpoly_search_monomials(
                 const ulong * a, slong a_len, const ulong * b, slong b_len,
                                           slong N, ulong maskhi, ulong masklo);
 
+FLINT_DLL void mpoly_monomials_min(ulong * emin, const ulong * exps,
+                                          slong len, slong bits, slong N);
+
+FLINT_DLL void mpoly_monomials_sort(slong * perm, const ulong * exps,
+                             slong len, slong N, ulong maskhi, ulong masklo);
+
 MPOLY_INLINE
 int mpoly_monomials_test(ulong * exps, slong len, slong N,
                                                     ulong maskhi, ulong masklo)
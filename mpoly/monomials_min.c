@@ -0,0 +1,35 @@
+/*
+    Copyright (C) 2026 agent
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include <gmp.h>
+#include "flint.h"
+#include "mpoly.h"
+
+void mpoly_monomials_min(ulong * emin, const ulong * exps, slong len,
+                                                        slong bits, slong N)
+{
+    slong i;
+    ulong mask = 0;
+
+    for (i = 0; i < FLINT_BITS/bits; i++)
+        mask = (mask << bits) + (UWORD(1) << (bits - 1));
+
+    if (len == 0)
+    {
+        for (i = 0; i < N; i++)
+            emin[i] = 0;
+        return;
+    }
+
+    mpoly_monomial_set(emin, exps, N);
+    for (i = 1; i < len; i++)
+        mpoly_monomial_min(emin, emin, exps + i*N, bits, N, mask);
+}
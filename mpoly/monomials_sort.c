@@ -0,0 +1,79 @@
+/*
+    Copyright (C) 2026 agent
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include <gmp.h>
+#include <stdlib.h>
+#include "flint.h"
+#include "mpoly.h"
+
+/*
+   Set perm to the permutation that puts the monomials (exps, N) of the
+   given length into descending order. A stable bottom up merge sort is
+   used, so that the sort costs O(len log len) comparisons.
+*/
+void mpoly_monomials_sort(slong * perm, const ulong * exps, slong len,
+                                           slong N, ulong maskhi, ulong masklo)
+{
+   slong i, j, k, l, w, mid, hi;
+   slong * t, * src, * dst, * tmp;
+   TMP_INIT;
+
+   for (i = 0; i < len; i++)
+      perm[i] = i;
+
+   if (len < 2)
+      return;
+
+   TMP_START;
+
+   t = (slong *) TMP_ALLOC(len*sizeof(slong));
+
+   src = perm;
+   dst = t;
+
+   for (w = 1; w < len; w *= 2)
+   {
+      for (i = 0; i < len; i += 2*w)
+      {
+         mid = FLINT_MIN(i + w, len);
+         hi = FLINT_MIN(i + 2*w, len);
+
+         /* merge src[i, mid) and src[mid, hi) into dst[i, hi) */
+         j = i;
+         k = mid;
+         l = i;
+         while (j < mid && k < hi)
+         {
+            if (mpoly_monomial_gt(exps + src[j]*N, exps + src[k]*N,
+                                                         N, maskhi, masklo))
+               dst[l++] = src[k++];
+            else
+               dst[l++] = src[j++];
+         }
+
+         while (j < mid)
+            dst[l++] = src[j++];
+
+         while (k < hi)
+            dst[l++] = src[k++];
+      }
+
+      tmp = src;
+      src = dst;
+      dst = tmp;
+   }
+
+   if (src != perm)
+      for (i = 0; i < len; i++)
+         perm[i] = src[i];
+
+   TMP_END;
+}
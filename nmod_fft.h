@@ -0,0 +1,117 @@
+/*
+    Copyright (C) 2026 agent
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef NMOD_FFT_H
+#define NMOD_FFT_H
+
+#ifdef NMOD_FFT_INLINES_C
+#define NMOD_FFT_INLINE FLINT_DLL
+#else
+#define NMOD_FFT_INLINE static __inline__
+#endif
+
+#undef ulong
+#define ulong ulongxx /* interferes with system includes */
+#include <stdlib.h>
+#undef ulong
+#include <gmp.h>
+#define ulong mp_limb_t
+
+#include "longlong.h"
+#include "ulong_extras.h"
+#include "flint.h"
+#include "nmod_vec.h"
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+/* primes must be below B/4 so that lazy butterflies fit in a limb */
+#define NMOD_FFT_MAX_BITS (FLINT_BITS - 2)
+
+/* number of built in primes used for multiplication */
+#define NMOD_FFT_NUM_PRIMES 3
+
+/* largest transform depth supported by all the built in primes */
+#if FLINT64
+#define NMOD_FFT_MUL_MAX_DEPTH 41
+#else
+#define NMOD_FFT_MUL_MAX_DEPTH 20
+#endif
+
+/* largest depth for which per thread cached contexts are kept */
+#define NMOD_FFT_CACHE_MAX_DEPTH 16
+
+typedef struct
+{
+   nmod_t mod;            /* the prime p */
+   mp_limb_t w;           /* root of unity of order 2^max_depth */
+   slong max_depth;       /* 2-adic valuation of p - 1 */
+   slong depth;           /* transforms of length up to 2^depth supported */
+   mp_ptr tab;            /* tab[m - 1 + j] = w_{2m}^j for 0 <= j < m */
+   mp_ptr tab_pre;        /* Shoup precomputations floor(tab*B/p) */
+} nmod_fft_ctx_struct;
+
+typedef nmod_fft_ctx_struct nmod_fft_ctx_t[1];
+
+FLINT_DLL extern const mp_limb_t nmod_fft_primes[NMOD_FFT_NUM_PRIMES];
+
+/* Lazy multiplication **********************************************/
+
+/* returns a*w mod p in [0, 2p) for any a, given wpre = floor(w*B/p) */
+NMOD_FFT_INLINE
+mp_limb_t _nmod_fft_mul_lazy(mp_limb_t a, mp_limb_t w, mp_limb_t wpre,
+                                                                mp_limb_t p)
+{
+   mp_limb_t q, lo;
+
+   umul_ppmm(q, lo, wpre, a);
+
+   return w*a - q*p;
+}
+
+/* Context ***********************************************************/
+
+FLINT_DLL void nmod_fft_ctx_init(nmod_fft_ctx_t ctx, mp_limb_t p);
+
+FLINT_DLL void nmod_fft_ctx_fit_depth(nmod_fft_ctx_t ctx, slong depth);
+
+FLINT_DLL void nmod_fft_ctx_clear(nmod_fft_ctx_t ctx);
+
+FLINT_DLL const nmod_fft_ctx_struct * _nmod_fft_ctx_cached(slong i,
+                                                               slong depth);
+
+/* Transforms ********************************************************/
+
+FLINT_DLL void _nmod_fft(mp_ptr a, slong len, slong depth,
+                                               const nmod_fft_ctx_t ctx);
+
+FLINT_DLL void nmod_fft(mp_ptr a, slong len, slong depth,
+                                               const nmod_fft_ctx_t ctx);
+
+FLINT_DLL void _nmod_ifft(mp_ptr a, slong trunc, slong depth,
+                                               const nmod_fft_ctx_t ctx);
+
+FLINT_DLL void nmod_ifft(mp_ptr a, slong trunc, slong depth,
+                                               const nmod_fft_ctx_t ctx);
+
+/* Multiplication ****************************************************/
+
+FLINT_DLL slong _nmod_fft_mul_num_primes(slong len, nmod_t mod);
+
+FLINT_DLL void _nmod_fft_mul(mp_ptr res, mp_srcptr poly1, slong len1,
+                  mp_srcptr poly2, slong len2, slong trunc, nmod_t mod);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,61 @@
+/*
+    Copyright (C) 2026 agent
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include <gmp.h>
+#include "flint.h"
+#include "ulong_extras.h"
+#include "nmod_vec.h"
+#include "nmod_fft.h"
+
+/*
+   contexts for the built in primes, kept per thread until flint_cleanup;
+   depth never exceeds NMOD_FFT_CACHE_MAX_DEPTH, which bounds their size
+*/
+FLINT_TLS_PREFIX nmod_fft_ctx_struct _nmod_fft_ctx_cache[NMOD_FFT_NUM_PRIMES];
+FLINT_TLS_PREFIX int _nmod_fft_ctx_cache_used = 0;
+#pragma omp threadprivate(_nmod_fft_ctx_cache, _nmod_fft_ctx_cache_used)
+
+void _nmod_fft_ctx_cache_clear(void)
+{
+   slong i;
+
+   if (_nmod_fft_ctx_cache_used)
+   {
+      for (i = 0; i < NMOD_FFT_NUM_PRIMES; i++)
+         nmod_fft_ctx_clear(_nmod_fft_ctx_cache + i);
+
+      _nmod_fft_ctx_cache_used = 0;
+   }
+}
+
+const nmod_fft_ctx_struct * _nmod_fft_ctx_cached(slong i, slong depth)
+{
+   slong j;
+
+   if (depth > NMOD_FFT_CACHE_MAX_DEPTH)
+   {
+      flint_printf("Exception (_nmod_fft_ctx_cached). Depth too large.\n");
+      flint_abort();
+   }
+
+   if (!_nmod_fft_ctx_cache_used)
+   {
+      for (j = 0; j < NMOD_FFT_NUM_PRIMES; j++)
+         nmod_fft_ctx_init(_nmod_fft_ctx_cache + j, nmod_fft_primes[j]);
+
+      _nmod_fft_ctx_cache_used = 1;
+      flint_register_cleanup_function(_nmod_fft_ctx_cache_clear);
+   }
+
+   nmod_fft_ctx_fit_depth(_nmod_fft_ctx_cache + i, depth);
+
+   return _nmod_fft_ctx_cache + i;
+}
@@ -0,0 +1,102 @@
+/*
+    Copyright (C) 2026 agent
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include <gmp.h>
+#include "flint.h"
+#include "ulong_extras.h"
+#include "nmod_vec.h"
+#include "nmod_fft.h"
+
+#if FLINT64
+const mp_limb_t nmod_fft_primes[NMOD_FFT_NUM_PRIMES] =
+   { UWORD(0x3fffc00000000001), UWORD(0x3fffbe0000000001),
+     UWORD(0x3fff840000000001) };
+#else
+const mp_limb_t nmod_fft_primes[NMOD_FFT_NUM_PRIMES] =
+   { UWORD(0x3ed00001), UWORD(0x3eb00001), UWORD(0x3e500001) };
+#endif
+
+void nmod_fft_ctx_init(nmod_fft_ctx_t ctx, mp_limb_t p)
+{
+   mp_limb_t a, x, e;
+   slong i;
+
+   if (FLINT_BIT_COUNT(p) > NMOD_FFT_MAX_BITS || (p & 1) == 0)
+   {
+      flint_printf("Exception (nmod_fft_ctx_init). Modulus not supported.\n");
+      flint_abort();
+   }
+
+   nmod_init(&ctx->mod, p);
+
+   for (e = p - 1, i = 0; (e & 1) == 0; e >>= 1, i++) ;
+   ctx->max_depth = i;
+
+   /* find an element of order exactly 2^max_depth */
+   for (a = 2; ; a++)
+   {
+      x = n_powmod2_preinv(a, e, p, ctx->mod.ninv);
+
+      if (n_powmod2_preinv(x, UWORD(1) << (i - 1), p, ctx->mod.ninv) != 1)
+         break;
+   }
+
+   ctx->w = x;
+   ctx->depth = 0;
+   ctx->tab = NULL;
+   ctx->tab_pre = NULL;
+}
+
+void nmod_fft_ctx_fit_depth(nmod_fft_ctx_t ctx, slong depth)
+{
+   mp_limb_t p = ctx->mod.n, w, x;
+   slong d, j, m;
+
+   if (depth <= ctx->depth)
+      return;
+
+   if (depth > ctx->max_depth)
+   {
+      flint_printf("Exception (nmod_fft_ctx_fit_depth). Transform length "
+                   "not supported by modulus.\n");
+      flint_abort();
+   }
+
+   ctx->tab = flint_realloc(ctx->tab, (WORD(1) << depth)*sizeof(mp_limb_t));
+   ctx->tab_pre = flint_realloc(ctx->tab_pre,
+                                      (WORD(1) << depth)*sizeof(mp_limb_t));
+
+   /* level d has m = 2^d butterflies using powers of w_{2m} */
+   for (d = ctx->depth; d < depth; d++)
+   {
+      m = WORD(1) << d;
+
+      w = n_powmod2_preinv(ctx->w, UWORD(1) << (ctx->max_depth - d - 1),
+                                                         p, ctx->mod.ninv);
+
+      x = 1;
+      for (j = 0; j < m; j++)
+      {
+         ctx->tab[m - 1 + j] = x;
+         ctx->tab_pre[m - 1 + j] = n_mulmod_precomp_shoup(x, p);
+
+         x = nmod_mul(x, w, ctx->mod);
+      }
+   }
+
+   ctx->depth = depth;
+}
+
+void nmod_fft_ctx_clear(nmod_fft_ctx_t ctx)
+{
+   flint_free(ctx->tab);
+   flint_free(ctx->tab_pre);
+}
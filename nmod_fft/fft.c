@@ -0,0 +1,132 @@
+/*
+    Copyright (C) 2026 agent
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include <gmp.h>
+#include "flint.h"
+#include "ulong_extras.h"
+#include "nmod_vec.h"
+#include "nmod_fft.h"
+
+/*
+   Decimation in frequency transform of length 2^depth with all inputs
+   present. Inputs and outputs are in [0, 2p).
+*/
+static void
+_nmod_fft_full(mp_ptr a, slong depth, const nmod_fft_ctx_struct * ctx)
+{
+   mp_limb_t p = ctx->mod.n, p2 = 2*ctx->mod.n, x, y;
+   mp_srcptr w, wpre;
+   slong k, h, i, j, N = WORD(1) << depth;
+
+   for (k = depth; k >= 1; k--)
+   {
+      h = WORD(1) << (k - 1);
+      w = ctx->tab + h - 1;
+      wpre = ctx->tab_pre + h - 1;
+
+      for (i = 0; i < N; i += 2*h)
+      {
+         mp_ptr b = a + i, c = a + i + h;
+
+         x = b[0];
+         y = c[0];
+         b[0] = x + y - (x + y >= p2 ? p2 : 0);
+         c[0] = x - y + (x < y ? p2 : 0);
+
+         for (j = 1; j < h; j++)
+         {
+            x = b[j];
+            y = c[j];
+            b[j] = x + y - (x + y >= p2 ? p2 : 0);
+            c[j] = _nmod_fft_mul_lazy(x - y + p2, w[j], wpre[j], p);
+         }
+      }
+   }
+}
+
+/* as above, but a[i] is taken to be zero for len <= i < 2^depth */
+static void
+_nmod_fft_trunc(mp_ptr a, slong len, slong depth,
+                                              const nmod_fft_ctx_struct * ctx)
+{
+   mp_limb_t p = ctx->mod.n, p2 = 2*ctx->mod.n, x, y;
+   mp_srcptr w, wpre;
+   slong j, h;
+
+   if (len == (WORD(1) << depth))
+   {
+      _nmod_fft_full(a, depth, ctx);
+      return;
+   }
+
+   if (depth == 0)
+      return;
+
+   h = WORD(1) << (depth - 1);
+   w = ctx->tab + h - 1;
+   wpre = ctx->tab_pre + h - 1;
+
+   if (len <= h)
+   {
+      a[h] = a[0];
+      for (j = 1; j < len; j++)
+         a[h + j] = _nmod_fft_mul_lazy(a[j], w[j], wpre[j], p);
+
+      _nmod_fft_trunc(a, len, depth - 1, ctx);
+      _nmod_fft_trunc(a + h, len, depth - 1, ctx);
+   } else
+   {
+      x = a[0];
+      y = a[h];
+      a[0] = x + y - (x + y >= p2 ? p2 : 0);
+      a[h] = x - y + (x < y ? p2 : 0);
+
+      for (j = 1; j < len - h; j++)
+      {
+         x = a[j];
+         y = a[h + j];
+         a[j] = x + y - (x + y >= p2 ? p2 : 0);
+         a[h + j] = _nmod_fft_mul_lazy(x - y + p2, w[j], wpre[j], p);
+      }
+
+      for ( ; j < h; j++)
+         a[h + j] = _nmod_fft_mul_lazy(a[j], w[j], wpre[j], p);
+
+      _nmod_fft_full(a, depth - 1, ctx);
+      _nmod_fft_full(a + h, depth - 1, ctx);
+   }
+}
+
+void _nmod_fft(mp_ptr a, slong len, slong depth, const nmod_fft_ctx_t ctx)
+{
+   slong i, N = WORD(1) << depth;
+
+   if (len == 0)
+   {
+      for (i = 0; i < N; i++)
+         a[i] = 0;
+
+      return;
+   }
+
+   _nmod_fft_trunc(a, len, depth, ctx);
+}
+
+void nmod_fft(mp_ptr a, slong len, slong depth, const nmod_fft_ctx_t ctx)
+{
+   mp_limb_t p = ctx->mod.n;
+   slong i, N = WORD(1) << depth;
+
+   _nmod_fft(a, len, depth, ctx);
+
+   for (i = 0; i < N; i++)
+      a[i] -= (a[i] >= p ? p : 0);
+}
@@ -0,0 +1,137 @@
+/*
+    Copyright (C) 2026 agent
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include <gmp.h>
+#include "flint.h"
+#include "ulong_extras.h"
+#include "nmod_vec.h"
+#include "nmod_fft.h"
+
+/*
+   Decimation in time inverse transform of length 2^depth, without the
+   division by 2^depth. Inputs and outputs are in [0, 2p). No inverse
+   tables are stored: for 0 < j < h we have w_{2h}^-j = -w_{2h}^(h - j),
+   so the butterflies use tab read backwards with the signs swapped.
+*/
+static void
+_nmod_ifft_full(mp_ptr a, slong depth, const nmod_fft_ctx_struct * ctx)
+{
+   mp_limb_t p = ctx->mod.n, p2 = 2*ctx->mod.n, x, t;
+   mp_srcptr w, wpre;
+   slong k, h, i, j, N = WORD(1) << depth;
+
+   for (k = 1; k <= depth; k++)
+   {
+      h = WORD(1) << (k - 1);
+      w = ctx->tab + 2*h - 1;
+      wpre = ctx->tab_pre + 2*h - 1;
+
+      for (i = 0; i < N; i += 2*h)
+      {
+         mp_ptr b = a + i, c = a + i + h;
+
+         x = b[0];
+         t = c[0];
+         b[0] = x + t - (x + t >= p2 ? p2 : 0);
+         c[0] = x - t + (x < t ? p2 : 0);
+
+         for (j = 1; j < h; j++)
+         {
+            x = b[j];
+            t = _nmod_fft_mul_lazy(c[j], w[-j], wpre[-j], p);
+            b[j] = x - t + (x < t ? p2 : 0);
+            c[j] = x + t - (x + t >= p2 ? p2 : 0);
+         }
+      }
+   }
+}
+
+/* as above, but only the first trunc outputs are computed */
+static void
+_nmod_ifft_trunc(mp_ptr a, slong trunc, slong depth,
+                                              const nmod_fft_ctx_struct * ctx)
+{
+   mp_limb_t p = ctx->mod.n, p2 = 2*ctx->mod.n, x, t;
+   mp_srcptr w, wpre;
+   slong j, h;
+
+   if (trunc == (WORD(1) << depth))
+   {
+      _nmod_ifft_full(a, depth, ctx);
+      return;
+   }
+
+   if (depth == 0)
+      return;
+
+   h = WORD(1) << (depth - 1);
+   w = ctx->tab + 2*h - 1;
+   wpre = ctx->tab_pre + 2*h - 1;
+
+   /* outputs j and j + h both depend only on entry j of each half */
+   _nmod_ifft_trunc(a, FLINT_MIN(trunc, h), depth - 1, ctx);
+   _nmod_ifft_trunc(a + h, FLINT_MIN(trunc, h), depth - 1, ctx);
+
+   x = a[0];
+   t = a[h];
+   a[0] = x + t - (x + t >= p2 ? p2 : 0);
+   a[h] = x - t + (x < t ? p2 : 0);
+
+   if (trunc <= h)
+   {
+      for (j = 1; j < trunc; j++)
+      {
+         x = a[j];
+         t = _nmod_fft_mul_lazy(a[h + j], w[-j], wpre[-j], p);
+         a[j] = x - t + (x < t ? p2 : 0);
+      }
+   } else
+   {
+      for (j = 1; j < trunc - h; j++)
+      {
+         x = a[j];
+         t = _nmod_fft_mul_lazy(a[h + j], w[-j], wpre[-j], p);
+         a[j] = x - t + (x < t ? p2 : 0);
+         a[h + j] = x + t - (x + t >= p2 ? p2 : 0);
+      }
+
+      for ( ; j < h; j++)
+      {
+         x = a[j];
+         t = _nmod_fft_mul_lazy(a[h + j], w[-j], wpre[-j], p);
+         a[j] = x - t + (x < t ? p2 : 0);
+      }
+   }
+}
+
+void _nmod_ifft(mp_ptr a, slong trunc, slong depth, const nmod_fft_ctx_t ctx)
+{
+   if (trunc > 0)
+      _nmod_ifft_trunc(a, trunc, depth, ctx);
+}
+
+void nmod_ifft(mp_ptr a, slong trunc, slong depth, const nmod_fft_ctx_t ctx)
+{
+   mp_limb_t p = ctx->mod.n, s, spre;
+   slong i;
+
+   _nmod_ifft(a, trunc, depth, ctx);
+
+   /* 2^-depth = ((p + 1)/2)^depth */
+   s = n_powmod2_preinv((p + 1)/2, depth, p, ctx->mod.ninv);
+   spre = n_mulmod_precomp_shoup(s, p);
+
+   for (i = 0; i < trunc; i++)
+   {
+      a[i] = _nmod_fft_mul_lazy(a[i], s, spre, p);
+      a[i] -= (a[i] >= p ? p : 0);
+   }
+}
@@ -0,0 +1,184 @@
+/*
+    Copyright (C) 2026 agent
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include <gmp.h>
+#include "flint.h"
+#include "ulong_extras.h"
+#include "nmod_vec.h"
+#include "nmod_fft.h"
+
+slong _nmod_fft_mul_num_primes(slong len, nmod_t mod)
+{
+   slong bits = 2*FLINT_BIT_COUNT(mod.n - 1) + FLINT_CLOG2(len);
+   slong np;
+
+   /* each built in prime exceeds 2^(FLINT_BITS - 3) */
+   np = (bits + FLINT_BITS - 4)/(FLINT_BITS - 3);
+
+   return np <= NMOD_FFT_NUM_PRIMES ? FLINT_MAX(np, 1) : 0;
+}
+
+/* residues of poly mod p in [0, p), with zero padding handled by the fft */
+static void
+_nmod_fft_reduce(mp_ptr a, mp_srcptr poly, slong len, nmod_t mod,
+                                               const nmod_fft_ctx_struct * ctx)
+{
+   slong j;
+
+   if (mod.n <= ctx->mod.n)
+   {
+      for (j = 0; j < len; j++)
+         a[j] = poly[j];
+   } else
+   {
+      for (j = 0; j < len; j++)
+         NMOD_RED(a[j], poly[j], ctx->mod);
+   }
+}
+
+void _nmod_fft_mul(mp_ptr res, mp_srcptr poly1, slong len1,
+                   mp_srcptr poly2, slong len2, slong trunc, nmod_t mod)
+{
+   const nmod_fft_ctx_struct * ctx;
+   nmod_fft_ctx_t big;
+   slong i, j, np, depth, N;
+   mp_limb_t p, a, b, s, spre;
+   mp_ptr fa, fb, r;
+   int squaring = (poly1 == poly2 && len1 == len2);
+
+   np = _nmod_fft_mul_num_primes(FLINT_MIN(len1, len2), mod);
+   depth = FLINT_CLOG2(len1 + len2 - 1);
+   N = WORD(1) << depth;
+
+   fa = flint_malloc((2*N + np*trunc)*sizeof(mp_limb_t));
+   fb = fa + N;
+   r = fb + N;
+
+   for (i = 0; i < np; i++)
+   {
+      /* large tables are not cached, so they are freed below */
+      if (depth <= NMOD_FFT_CACHE_MAX_DEPTH)
+         ctx = _nmod_fft_ctx_cached(i, depth);
+      else
+      {
+         nmod_fft_ctx_init(big, nmod_fft_primes[i]);
+         nmod_fft_ctx_fit_depth(big, depth);
+         ctx = big;
+      }
+
+      p = ctx->mod.n;
+
+      _nmod_fft_reduce(fa, poly1, len1, mod, ctx);
+      _nmod_fft(fa, len1, depth, ctx);
+
+      if (!squaring)
+      {
+         _nmod_fft_reduce(fb, poly2, len2, mod, ctx);
+         _nmod_fft(fb, len2, depth, ctx);
+      }
+
+      /* pointwise products, with the division by 2^depth folded in */
+      s = n_powmod2_preinv((p + 1)/2, depth, p, ctx->mod.ninv);
+      spre = n_mulmod_precomp_shoup(s, p);
+
+      if (squaring)
+      {
+         for (j = 0; j < N; j++)
+         {
+            a = fa[j] - (fa[j] >= p ? p : 0);
+            fa[j] = _nmod_fft_mul_lazy(nmod_mul(a, a, ctx->mod), s, spre, p);
+         }
+      } else
+      {
+         for (j = 0; j < N; j++)
+         {
+            a = fa[j] - (fa[j] >= p ? p : 0);
+            b = fb[j] - (fb[j] >= p ? p : 0);
+            fa[j] = _nmod_fft_mul_lazy(nmod_mul(a, b, ctx->mod), s, spre, p);
+         }
+      }
+
+      _nmod_ifft(fa, trunc, depth, ctx);
+
+      for (j = 0; j < trunc; j++)
+         r[i*trunc + j] = fa[j] - (fa[j] >= p ? p : 0);
+
+      if (depth > NMOD_FFT_CACHE_MAX_DEPTH)
+         nmod_fft_ctx_clear(big);
+   }
+
+   /*
+      Garner reconstruction. The product coefficients are smaller than the
+      product of the primes used, so the mixed radix digits determine them
+      exactly and we evaluate the digits mod n.
+   */
+   if (np == 1)
+   {
+      for (j = 0; j < trunc; j++)
+         NMOD_RED(res[j], r[j], mod);
+   } else
+   {
+      mp_limb_t p1 = nmod_fft_primes[0], p2 = nmod_fft_primes[1];
+      mp_limb_t c1, c2, c3, t2, t3, p1n, p12n = 0, i12, i12pre;
+      mp_limb_t i123 = 0, i123pre = 0, p1p3 = 0, p1p3pre = 0;
+      nmod_t mod2, mod3;
+
+      nmod_init(&mod2, p2);
+      nmod_init(&mod3, nmod_fft_primes[2]);
+      i12 = n_invmod(p1 % p2, p2);
+      i12pre = n_mulmod_precomp_shoup(i12, p2);
+
+      NMOD_RED(p1n, p1, mod);
+
+      if (np == 3)
+      {
+         p1p3 = p1 % mod3.n;
+         p1p3pre = n_mulmod_precomp_shoup(p1p3, mod3.n);
+         i123 = n_invmod(nmod_mul(p1p3, p2 % mod3.n, mod3), mod3.n);
+         i123pre = n_mulmod_precomp_shoup(i123, mod3.n);
+
+         NMOD_RED(p12n, p2, mod);
+         p12n = nmod_mul(p12n, p1n, mod);
+      }
+
+      for (j = 0; j < trunc; j++)
+      {
+         c1 = r[j];
+         c2 = r[trunc + j];
+
+         /* x = c1 + p1*t2 with t2 = (c2 - c1)/p1 mod p2 */
+         NMOD_RED(t2, c1, mod2);
+         t2 = nmod_sub(c2, t2, mod2);
+         t2 = n_mulmod_shoup(i12, t2, i12pre, p2);
+
+         NMOD_RED(a, c1, mod);
+         NMOD_RED(b, t2, mod);
+         res[j] = nmod_add(a, nmod_mul(b, p1n, mod), mod);
+
+         if (np == 3)
+         {
+            /* x += p1*p2*t3 with t3 = (c3 - c1 - p1*t2)/(p1*p2) mod p3 */
+            c3 = r[2*trunc + j];
+
+            NMOD_RED(a, c1, mod3);
+            NMOD_RED(b, t2, mod3);
+            t3 = nmod_add(a, n_mulmod_shoup(p1p3, b, p1p3pre, mod3.n), mod3);
+            t3 = nmod_sub(c3, t3, mod3);
+            t3 = n_mulmod_shoup(i123, t3, i123pre, mod3.n);
+
+            NMOD_RED(b, t3, mod);
+            res[j] = nmod_add(res[j], nmod_mul(b, p12n, mod), mod);
+         }
+      }
+   }
+
+   flint_free(fa);
+}
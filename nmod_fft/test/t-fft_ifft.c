@@ -0,0 +1,177 @@
+/*
+    Copyright (C) 2026 agent
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <gmp.h>
+#include "flint.h"
+#include "ulong_extras.h"
+#include "nmod_vec.h"
+#include "nmod_poly.h"
+#include "nmod_fft.h"
+
+/* random prime p = c*2^k + 1 of at most NMOD_FFT_MAX_BITS bits, k >= depth, k >= 1 */
+mp_limb_t fft_prime_randtest(flint_rand_t state, slong depth)
+{
+   mp_limb_t c, p;
+   slong k;
+
+   while (1)
+   {
+      k = FLINT_MAX(depth, 1) + n_randint(state, NMOD_FFT_MAX_BITS - depth - 1);
+      c = n_randbits(state, n_randint(state, NMOD_FFT_MAX_BITS - k) + 1);
+      p = (c << k) + 1;
+
+      if (FLINT_BIT_COUNT(p) <= NMOD_FFT_MAX_BITS && n_is_prime(p))
+         return p;
+   }
+}
+
+int
+main(void)
+{
+   slong i, j, k;
+   FLINT_TEST_INIT(state);
+
+   flint_printf("fft_ifft....");
+   fflush(stdout);
+
+   /* ifft(fft(a)) = a, and the first outputs are a(1) and a(-1) */
+   for (i = 0; i < 1000 * flint_test_multiplier(); i++)
+   {
+      nmod_fft_ctx_t ctx;
+      slong depth, N, len, trunc;
+      mp_limb_t p, v;
+      mp_ptr a, b;
+
+      depth = n_randint(state, 12);
+      N = WORD(1) << depth;
+      len = n_randint(state, N) + 1;
+      trunc = n_randint(state, N) + 1;
+
+      if (n_randint(state, 4) == 0)
+         p = nmod_fft_primes[n_randint(state, NMOD_FFT_NUM_PRIMES)];
+      else
+         p = fft_prime_randtest(state, depth);
+
+      nmod_fft_ctx_init(ctx, p);
+      nmod_fft_ctx_fit_depth(ctx, n_randint(state, depth + 1));
+      nmod_fft_ctx_fit_depth(ctx, depth);
+
+      a = _nmod_vec_init(N);
+      b = _nmod_vec_init(N);
+
+      _nmod_vec_randtest(a, state, len, ctx->mod);
+      _nmod_vec_set(b, a, len);
+
+      nmod_fft(b, len, depth, ctx);
+
+      v = _nmod_poly_evaluate_nmod(a, len, 1, ctx->mod);
+      if (b[0] != v)
+      {
+         flint_printf("FAIL (evaluation at 1):\n");
+         flint_printf("p = %wu, depth = %wd, len = %wd\n", p, depth, len);
+         abort();
+      }
+
+      v = _nmod_poly_evaluate_nmod(a, len, p - 1, ctx->mod);
+      if (depth > 0 && b[1] != v)
+      {
+         flint_printf("FAIL (evaluation at -1):\n");
+         flint_printf("p = %wu, depth = %wd, len = %wd\n", p, depth, len);
+         abort();
+      }
+
+      for (j = 0; j < N; j++)
+      {
+         if (b[j] >= p)
+         {
+            flint_printf("FAIL (unreduced output):\n");
+            flint_printf("p = %wu, depth = %wd, len = %wd\n", p, depth, len);
+            abort();
+         }
+      }
+
+      nmod_ifft(b, trunc, depth, ctx);
+
+      for (j = 0; j < trunc; j++)
+      {
+         if (b[j] != (j < len ? a[j] : 0))
+         {
+            flint_printf("FAIL (round trip):\n");
+            flint_printf("p = %wu, depth = %wd, len = %wd, trunc = %wd, "
+                                      "j = %wd\n", p, depth, len, trunc, j);
+            abort();
+         }
+      }
+
+      _nmod_vec_clear(a);
+      _nmod_vec_clear(b);
+      nmod_fft_ctx_clear(ctx);
+   }
+
+   /* pointwise products give the product of polynomials */
+   for (i = 0; i < 300 * flint_test_multiplier(); i++)
+   {
+      const nmod_fft_ctx_struct * ctx;
+      slong depth, N, len1, len2;
+      mp_ptr a, b, c;
+
+      depth = n_randint(state, 11) + 1;
+      N = WORD(1) << depth;
+      len1 = n_randint(state, N/2) + 1;
+      len2 = n_randint(state, N - len1) + 1;
+
+      k = n_randint(state, NMOD_FFT_NUM_PRIMES);
+      ctx = _nmod_fft_ctx_cached(k, depth);
+
+      a = _nmod_vec_init(N);
+      b = _nmod_vec_init(N);
+      c = _nmod_vec_init(len1 + len2 - 1);
+
+      _nmod_vec_randtest(a, state, len1, ctx->mod);
+      _nmod_vec_randtest(b, state, len2, ctx->mod);
+
+      _nmod_poly_mul_classical(c, a, len1, b, len2, ctx->mod);
+
+      /* values in [0, 2p) are accepted by the unreduced transforms */
+      for (j = 0; j < len1; j++)
+         a[j] += n_randint(state, 2) ? ctx->mod.n : 0;
+
+      _nmod_fft(a, len1, depth, ctx);
+      nmod_fft(b, len2, depth, ctx);
+
+      for (j = 0; j < N; j++)
+      {
+         NMOD_RED(a[j], a[j], ctx->mod);
+         a[j] = nmod_mul(a[j], b[j], ctx->mod);
+      }
+
+      nmod_ifft(a, len1 + len2 - 1, depth, ctx);
+
+      if (!_nmod_vec_equal(a, c, len1 + len2 - 1))
+      {
+         flint_printf("FAIL (convolution):\n");
+         flint_printf("depth = %wd, len1 = %wd, len2 = %wd\n",
+                                                         depth, len1, len2);
+         abort();
+      }
+
+      _nmod_vec_clear(a);
+      _nmod_vec_clear(b);
+      _nmod_vec_clear(c);
+   }
+
+   FLINT_TEST_CLEANUP(state);
+
+   flint_printf("PASS\n");
+   return 0;
+}
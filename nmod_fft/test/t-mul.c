@@ -0,0 +1,142 @@
+/*
+    Copyright (C) 2026 agent
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <gmp.h>
+#include "flint.h"
+#include "ulong_extras.h"
+#include "nmod_vec.h"
+#include "nmod_poly.h"
+#include "nmod_fft.h"
+
+int
+main(void)
+{
+   slong i, j;
+   FLINT_TEST_INIT(state);
+
+   flint_printf("mul....");
+   fflush(stdout);
+
+   /* compare with mul_classical */
+   for (i = 0; i < 2000 * flint_test_multiplier(); i++)
+   {
+      nmod_t mod;
+      mp_limb_t n;
+      slong len1, len2, trunc;
+      mp_ptr a, b, c, d;
+      int square = n_randint(state, 4) == 0;
+
+      n = n_randtest_not_zero(state);
+      nmod_init(&mod, n);
+
+      len1 = n_randint(state, 300) + 1;
+      len2 = square ? len1 : n_randint(state, 300) + 1;
+      trunc = n_randint(state, len1 + len2 - 1) + 1;
+
+      if (_nmod_fft_mul_num_primes(FLINT_MIN(len1, len2), mod) == 0 ||
+          FLINT_CLOG2(len1 + len2 - 1) > NMOD_FFT_MUL_MAX_DEPTH)
+         continue;
+
+      a = _nmod_vec_init(len1);
+      b = square ? a : _nmod_vec_init(len2);
+      c = _nmod_vec_init(len1 + len2 - 1);
+      d = _nmod_vec_init(len1 + len2 - 1);
+
+      if (n_randint(state, 2))
+      {
+         _nmod_vec_randtest(a, state, len1, mod);
+         if (!square)
+            _nmod_vec_randtest(b, state, len2, mod);
+      } else
+      {
+         /* all coefficients n - 1 maximise the integer product */
+         for (j = 0; j < len1; j++)
+            a[j] = n - 1;
+         for (j = 0; !square && j < len2; j++)
+            b[j] = n - 1;
+      }
+
+      if (len1 >= len2)
+         _nmod_poly_mul_classical(c, a, len1, b, len2, mod);
+      else
+         _nmod_poly_mul_classical(c, b, len2, a, len1, mod);
+
+      _nmod_fft_mul(d, a, len1, b, len2, trunc, mod);
+
+      if (!_nmod_vec_equal(c, d, trunc))
+      {
+         flint_printf("FAIL:\n");
+         flint_printf("n = %wu, len1 = %wd, len2 = %wd, trunc = %wd\n",
+                                                     n, len1, len2, trunc);
+         abort();
+      }
+
+      _nmod_vec_clear(a);
+      if (!square)
+         _nmod_vec_clear(b);
+      _nmod_vec_clear(c);
+      _nmod_vec_clear(d);
+   }
+
+   /* transforms too long for the cached contexts, check at random points */
+   for (i = 0; i < 3 * flint_test_multiplier(); i++)
+   {
+      nmod_t mod;
+      mp_limb_t n, x, y;
+      slong len1, len2;
+      mp_ptr a, b, d;
+
+      n = n_randtest_not_zero(state);
+      nmod_init(&mod, n);
+
+      len1 = (WORD(1) << (NMOD_FFT_CACHE_MAX_DEPTH - 1)) + 1
+           + n_randint(state, WORD(1) << (NMOD_FFT_CACHE_MAX_DEPTH - 1));
+      len2 = (WORD(1) << NMOD_FFT_CACHE_MAX_DEPTH) - len1 + 2
+           + n_randint(state, 1000);
+
+      if (FLINT_CLOG2(len1 + len2 - 1) > NMOD_FFT_MUL_MAX_DEPTH)
+         continue;
+
+      a = _nmod_vec_init(len1);
+      b = _nmod_vec_init(len2);
+      d = _nmod_vec_init(len1 + len2 - 1);
+
+      _nmod_vec_randtest(a, state, len1, mod);
+      _nmod_vec_randtest(b, state, len2, mod);
+
+      _nmod_fft_mul(d, a, len1, b, len2, len1 + len2 - 1, mod);
+
+      for (j = 0; j < 3; j++)
+      {
+         x = n_randint(state, n);
+         y = nmod_mul(_nmod_poly_evaluate_nmod(a, len1, x, mod),
+                      _nmod_poly_evaluate_nmod(b, len2, x, mod), mod);
+
+         if (y != _nmod_poly_evaluate_nmod(d, len1 + len2 - 1, x, mod))
+         {
+            flint_printf("FAIL (uncached):\n");
+            flint_printf("n = %wu, len1 = %wd, len2 = %wd\n", n, len1, len2);
+            abort();
+         }
+      }
+
+      _nmod_vec_clear(a);
+      _nmod_vec_clear(b);
+      _nmod_vec_clear(d);
+   }
+
+   FLINT_TEST_CLEANUP(state);
+
+   flint_printf("PASS\n");
+   return 0;
+}
@@ -163,6 +163,15 @@ FLINT_DLL void nmod_mat_mul_strassen(nmod_mat_t C, const nmod_mat_t A, const nmo
 FLINT_DLL void _nmod_mat_mul_classical(nmod_mat_t D, const nmod_mat_t C,
                                 const nmod_mat_t A, const nmod_mat_t B, int op);
 
+FLINT_DLL void nmod_mat_mul_classical_threaded(nmod_mat_t C,
+                                const nmod_mat_t A, const nmod_mat_t B);
+
+FLINT_DLL void _nmod_mat_mul_classical_threaded(nmod_mat_t D,
+            const nmod_mat_t C, const nmod_mat_t A, const nmod_mat_t B, int op);
+
+FLINT_DLL void nmod_mat_mul_strassen_threaded(nmod_mat_t C,
+                                const nmod_mat_t A, const nmod_mat_t B);
+
 FLINT_DLL void nmod_mat_addmul(nmod_mat_t D, const nmod_mat_t C,
                                 const nmod_mat_t A, const nmod_mat_t B);
 
@@ -276,9 +285,16 @@ FLINT_DLL void nmod_mat_similarity(nmod_mat_t M, slong r, ulong d);
 /* Size at which pre-transposing becomes faster in classical multiplication */
 #define NMOD_MAT_MUL_TRANSPOSE_CUTOFF 20
 
+/* Number of limbs of the transposed right factor processed per panel
+   in classical multiplication; should fit comfortably in L2 cache */
+#define NMOD_MAT_MUL_PANEL_LIMBS 32768
+
 /* Strassen multiplication */
 #define NMOD_MAT_MUL_STRASSEN_CUTOFF 256
 
+/* Size at which classical multiplication is split across threads */
+#define NMOD_MAT_MUL_THREADED_CUTOFF 64
+
 /* Cutoff between classical and recursive triangular solving */
 #define NMOD_MAT_SOLVE_TRI_ROWS_CUTOFF 64
 #define NMOD_MAT_SOLVE_TRI_COLS_CUTOFF 64
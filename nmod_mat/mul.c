@@ -28,7 +28,13 @@ nmod_mat_mul(nmod_mat_t C, const nmod_mat_t A, const nmod_mat_t B)
         n < NMOD_MAT_MUL_STRASSEN_CUTOFF ||
         k < NMOD_MAT_MUL_STRASSEN_CUTOFF)
     {
-        nmod_mat_mul_classical(C, A, B);
+        if (flint_get_num_threads() > 1 &&
+            m >= NMOD_MAT_MUL_THREADED_CUTOFF &&
+            n >= NMOD_MAT_MUL_THREADED_CUTOFF &&
+            k >= NMOD_MAT_MUL_THREADED_CUTOFF)
+            nmod_mat_mul_classical_threaded(C, A, B);
+        else
+            nmod_mat_mul_classical(C, A, B);
     }
     else
     {
@@ -44,13 +44,134 @@ _nmod_mat_addmul_basic(mp_ptr * D, mp_ptr * const C, mp_ptr * const A,
     }
 }
 
+/*
+    Three limb accumulation needs too many registers for a full 2x2 tile,
+    so rows are processed one at a time against two columns.
+*/
+static __inline__ void
+_nmod_mat_dot3_1x2(mp_ptr r, mp_srcptr a0, mp_srcptr b0, mp_srcptr b1,
+                                                        slong k, nmod_t mod)
+{
+    slong l;
+    mp_limb_t s0, s1, s2, e0, e1, e2, t0, t1;
+
+    s0 = s1 = s2 = e0 = e1 = e2 = UWORD(0);
+
+    for (l = 0; l < k; l++)
+    {
+        umul_ppmm(t1, t0, a0[l], b0[l]);
+        add_sssaaaaaa(s2, s1, s0, s2, s1, s0, 0, t1, t0);
+        umul_ppmm(t1, t0, a0[l], b1[l]);
+        add_sssaaaaaa(e2, e1, e0, e2, e1, e0, 0, t1, t0);
+    }
+
+    NMOD_RED(s2, s2, mod);
+    NMOD_RED3(r[0], s2, s1, s0, mod);
+    NMOD_RED(e2, e2, mod);
+    NMOD_RED3(r[1], e2, e1, e0, mod);
+}
+
+/*
+    Computes the four dot products of rows a0, a1 with columns b0, b1
+    (stored contiguously in the transposed copy of B), writing
+    r[0] = a0.b0, r[1] = a0.b1, r[2] = a1.b0, r[3] = a1.b1. Working on a
+    2x2 tile halves the number of loads per multiplication compared to
+    separate dot products and gives four independent carry chains.
+*/
+static __inline__ void
+_nmod_mat_dot_2x2(mp_ptr r, mp_srcptr a0, mp_srcptr a1,
+                  mp_srcptr b0, mp_srcptr b1, slong k, nmod_t mod, int nlimbs)
+{
+    slong l;
+    mp_limb_t s00, s01, s10, s11;
+    mp_limb_t h00, h01, h10, h11;
+    mp_limb_t t0, t1;
+
+    s00 = s01 = s10 = s11 = UWORD(0);
+    h00 = h01 = h10 = h11 = UWORD(0);
+
+    if (nlimbs == 1)
+    {
+        for (l = 0; l < k; l++)
+        {
+            s00 += a0[l] * b0[l];
+            s01 += a0[l] * b1[l];
+            s10 += a1[l] * b0[l];
+            s11 += a1[l] * b1[l];
+        }
+
+        NMOD_RED(r[0], s00, mod);
+        NMOD_RED(r[1], s01, mod);
+        NMOD_RED(r[2], s10, mod);
+        NMOD_RED(r[3], s11, mod);
+    }
+    else if (nlimbs == 2)
+    {
+        if (mod.n <= (UWORD(1) << (FLINT_BITS / 2)))
+        {
+            for (l = 0; l < k; l++)
+            {
+                add_ssaaaa(h00, s00, h00, s00, 0, a0[l] * b0[l]);
+                add_ssaaaa(h01, s01, h01, s01, 0, a0[l] * b1[l]);
+                add_ssaaaa(h10, s10, h10, s10, 0, a1[l] * b0[l]);
+                add_ssaaaa(h11, s11, h11, s11, 0, a1[l] * b1[l]);
+            }
+        }
+        else
+        {
+            for (l = 0; l < k; l++)
+            {
+                umul_ppmm(t1, t0, a0[l], b0[l]);
+                add_ssaaaa(h00, s00, h00, s00, t1, t0);
+                umul_ppmm(t1, t0, a0[l], b1[l]);
+                add_ssaaaa(h01, s01, h01, s01, t1, t0);
+                umul_ppmm(t1, t0, a1[l], b0[l]);
+                add_ssaaaa(h10, s10, h10, s10, t1, t0);
+                umul_ppmm(t1, t0, a1[l], b1[l]);
+                add_ssaaaa(h11, s11, h11, s11, t1, t0);
+            }
+        }
+
+        NMOD2_RED2(r[0], h00, s00, mod);
+        NMOD2_RED2(r[1], h01, s01, mod);
+        NMOD2_RED2(r[2], h10, s10, mod);
+        NMOD2_RED2(r[3], h11, s11, mod);
+    }
+    else
+    {
+        _nmod_mat_dot3_1x2(r, a0, b0, b1, k, mod);
+        _nmod_mat_dot3_1x2(r + 2, a1, b0, b1, k, mod);
+    }
+}
+
+static __inline__ mp_limb_t
+_nmod_mat_addmul_entry(mp_limb_t c, const mp_ptr * C, slong i, slong j,
+                                                        int op, nmod_t mod)
+{
+    if (op == 1)
+        c = nmod_add(C[i][j], c, mod);
+    else if (op == -1)
+        c = nmod_sub(C[i][j], c, mod);
+
+    return c;
+}
+
+/*
+    Multiplies by a transposed copy of B, processing the output in 2x2
+    register tiles. The columns of the output are split into panels
+    of NMOD_MAT_MUL_PANEL_LIMBS / k columns so that the corresponding rows
+    of the transposed copy stay in cache while all rows of A pass over
+    them. Odd trailing rows and columns are handled by repeating the last
+    row or column in the tile and discarding the duplicate results.
+*/
 static __inline__ void
 _nmod_mat_addmul_transpose(mp_ptr * D, const mp_ptr * C, const mp_ptr * A,
     const mp_ptr * B, slong m, slong k, slong n, int op, nmod_t mod, int nlimbs)
 {
     mp_ptr tmp;
-    mp_limb_t c;
-    slong i, j;
+    mp_limb_t r[4];
+    slong i, j, jj, jend, panel;
+    mp_srcptr a0, a1, b0, b1;
 
     tmp = flint_malloc(sizeof(mp_limb_t) * k * n);
 
@@ -58,18 +179,41 @@ _nmod_mat_addmul_transpose(mp_ptr * D, const mp_ptr * C, const mp_ptr * A,
         for (j = 0; j < n; j++)
             tmp[j*k + i] = B[i][j];
 
-    for (i = 0; i < m; i++)
+    panel = FLINT_MAX(NMOD_MAT_MUL_PANEL_LIMBS / k, 2);
+    panel += (panel & 1);
+
+    for (jj = 0; jj < n; jj += panel)
     {
-        for (j = 0; j < n; j++)
+        jend = FLINT_MIN(jj + panel, n);
+
+        for (i = 0; i < m; i += 2)
         {
-            c = _nmod_vec_dot(A[i], tmp + j*k, k, mod, nlimbs);
+            a0 = A[i];
+            a1 = (i + 1 < m) ? A[i + 1] : a0;
 
-            if (op == 1)
-                c = nmod_add(C[i][j], c, mod);
-            else if (op == -1)
-                c = nmod_sub(C[i][j], c, mod);
+            for (j = jj; j < jend; j += 2)
+            {
+                b0 = tmp + j*k;
+                b1 = (j + 1 < jend) ? b0 + k : b0;
 
-            D[i][j] = c;
+                _nmod_mat_dot_2x2(r, a0, a1, b0, b1, k, mod, nlimbs);
+
+                D[i][j] = _nmod_mat_addmul_entry(r[0], C, i, j, op, mod);
+
+                if (j + 1 < jend)
+                    D[i][j + 1] =
+                        _nmod_mat_addmul_entry(r[1], C, i, j + 1, op, mod);
+
+                if (i + 1 < m)
+                {
+                    D[i + 1][j] =
+                        _nmod_mat_addmul_entry(r[2], C, i + 1, j, op, mod);
+
+                    if (j + 1 < jend)
+                        D[i + 1][j + 1] = _nmod_mat_addmul_entry(r[3],
+                                                   C, i + 1, j + 1, op, mod);
+                }
+            }
         }
     }
 
@@ -81,12 +225,12 @@ void
 _nmod_mat_addmul_packed(mp_ptr * D, const mp_ptr * C, const mp_ptr * A,
     const mp_ptr * B, slong M, slong N, slong K, int op, nmod_t mod, int nlimbs)
 {
-    slong i, j, k;
+    slong i, j, k, r, jj, jend, panel, rows;
     slong Kpack;
     int pack, pack_bits;
-    mp_limb_t c, d, mask;
+    mp_limb_t c, d, e, mask;
     mp_ptr tmp;
-    mp_ptr Aptr, Tptr;
+    mp_ptr Aptr, A2ptr, Tptr;
 
     /* bound unreduced entry */
     c = N * (mod.n-1) * (mod.n-1);
@@ -115,40 +259,62 @@ _nmod_mat_addmul_packed(mp_ptr * D, const mp_ptr * C, const mp_ptr * A,
         }
     }
 
-    /* multiply */
-    for (i = 0; i < M; i++)
+    panel = FLINT_MAX(NMOD_MAT_MUL_PANEL_LIMBS / N, 1);
+
+    /* multiply, two rows of A at a time against a cached panel of tmp */
+    for (jj = 0; jj < Kpack; jj += panel)
     {
-        for (j = 0; j < Kpack; j++)
+        jend = FLINT_MIN(jj + panel, Kpack);
+
+        for (i = 0; i < M; i += 2)
         {
+            rows = (i + 1 < M) ? 2 : 1;
             Aptr = A[i];
-            Tptr = tmp + j * N;
-
-            c = 0;
-
-            /* unroll by 4 */
-            for (k = 0; k + 4 <= N; k += 4)
-            {
-                c += Aptr[k + 0] * Tptr[k + 0];
-                c += Aptr[k + 1] * Tptr[k + 1];
-                c += Aptr[k + 2] * Tptr[k + 2];
-                c += Aptr[k + 3] * Tptr[k + 3];
-            }
-
-            for ( ; k < N; k++)
-                c += Aptr[k] * Tptr[k];
+            A2ptr = A[i + rows - 1];
 
-            /* unpack and reduce */
-            for (k = 0; k < pack && j * pack + k < K; k++)
+            for (j = jj; j < jend; j++)
             {
-                d = (c >> (k * pack_bits)) & mask;
-                NMOD_RED(d, d, mod);
-
-                if (op == 1)
-                    d = nmod_add(C[i][j * pack + k], d, mod);
-                else if (op == -1)
-                    d = nmod_sub(C[i][j * pack + k], d, mod);
-
-                D[i][j * pack + k] = d;
+                Tptr = tmp + j * N;
+
+                c = e = 0;
+
+                /* unroll by 4 */
+                for (k = 0; k + 4 <= N; k += 4)
+                {
+                    c += Aptr[k + 0] * Tptr[k + 0];
+                    e += A2ptr[k + 0] * Tptr[k + 0];
+                    c += Aptr[k + 1] * Tptr[k + 1];
+                    e += A2ptr[k + 1] * Tptr[k + 1];
+                    c += Aptr[k + 2] * Tptr[k + 2];
+                    e += A2ptr[k + 2] * Tptr[k + 2];
+                    c += Aptr[k + 3] * Tptr[k + 3];
+                    e += A2ptr[k + 3] * Tptr[k + 3];
+                }
+
+                for ( ; k < N; k++)
+                {
+                    c += Aptr[k] * Tptr[k];
+                    e += A2ptr[k] * Tptr[k];
+                }
+
+                /* unpack and reduce */
+                for (r = 0; r < rows; r++)
+                {
+                    for (k = 0; k < pack && j * pack + k < K; k++)
+                    {
+                        d = (c >> (k * pack_bits)) & mask;
+                        NMOD_RED(d, d, mod);
+
+                        if (op == 1)
+                            d = nmod_add(C[i + r][j * pack + k], d, mod);
+                        else if (op == -1)
+                            d = nmod_sub(C[i + r][j * pack + k], d, mod);
+
+                        D[i + r][j * pack + k] = d;
+                    }
+
+                    c = e;
+                }
             }
         }
     }
@@ -0,0 +1,119 @@
+/*
+    Copyright (C) 2026 agent
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include <stdlib.h>
+#include <gmp.h>
+#include "flint.h"
+#include "nmod_mat.h"
+#include "nmod_vec.h"
+
+typedef struct
+{
+    nmod_mat_struct * D;
+    const nmod_mat_struct * C;
+    const nmod_mat_struct * A;
+    const nmod_mat_struct * B;
+    slong i1;
+    slong i2;
+    int by_cols;
+    int op;
+}
+nmod_mat_mul_classical_arg_t;
+
+void *
+_nmod_mat_mul_classical_worker(void * arg_ptr)
+{
+    nmod_mat_mul_classical_arg_t arg =
+                               *((nmod_mat_mul_classical_arg_t *) arg_ptr);
+    nmod_mat_t Dw, Cw, Aw, Bw;
+    slong m = arg.A->r, n = arg.B->c;
+
+    if (arg.by_cols)
+    {
+        /* every worker transposes (or packs) only its own slab of B */
+        nmod_mat_window_init(Dw, arg.D, 0, arg.i1, m, arg.i2);
+        nmod_mat_window_init(Bw, arg.B, 0, arg.i1, arg.B->r, arg.i2);
+        nmod_mat_window_init(Aw, arg.A, 0, 0, m, arg.A->c);
+
+        if (arg.op != 0)
+            nmod_mat_window_init(Cw, arg.C, 0, arg.i1, m, arg.i2);
+    }
+    else
+    {
+        nmod_mat_window_init(Dw, arg.D, arg.i1, 0, arg.i2, n);
+        nmod_mat_window_init(Aw, arg.A, arg.i1, 0, arg.i2, arg.A->c);
+        nmod_mat_window_init(Bw, arg.B, 0, 0, arg.B->r, n);
+
+        if (arg.op != 0)
+            nmod_mat_window_init(Cw, arg.C, arg.i1, 0, arg.i2, n);
+    }
+
+    _nmod_mat_mul_classical(Dw, arg.op == 0 ? NULL : Cw, Aw, Bw, arg.op);
+
+    nmod_mat_window_clear(Dw);
+    nmod_mat_window_clear(Aw);
+    nmod_mat_window_clear(Bw);
+
+    if (arg.op != 0)
+        nmod_mat_window_clear(Cw);
+
+    return NULL;
+}
+
+void
+_nmod_mat_mul_classical_threaded(nmod_mat_t D, const nmod_mat_t C,
+                                const nmod_mat_t A, const nmod_mat_t B, int op)
+{
+    nmod_mat_mul_classical_arg_t * args;
+    slong i, m, n, len, num_threads;
+    int by_cols;
+
+    m = A->r;
+    n = B->c;
+
+    /* split the larger output dimension */
+    by_cols = (n >= m);
+    len = by_cols ? n : m;
+
+    num_threads = FLINT_MIN(flint_get_num_threads(), len);
+
+    if (num_threads <= 1 || A->c == 0)
+    {
+        _nmod_mat_mul_classical(D, C, A, B, op);
+        return;
+    }
+
+    args = flint_malloc(sizeof(nmod_mat_mul_classical_arg_t) * num_threads);
+
+    for (i = 0; i < num_threads; i++)
+    {
+        args[i].D = D;
+        args[i].C = C;
+        args[i].A = A;
+        args[i].B = B;
+        args[i].i1 = (len * i) / num_threads;
+        args[i].i2 = (len * (i + 1)) / num_threads;
+        args[i].by_cols = by_cols;
+        args[i].op = op;
+    }
+
+    flint_parallel_do(_nmod_mat_mul_classical_worker,
+                     args, sizeof(nmod_mat_mul_classical_arg_t), num_threads);
+
+    flint_free(args);
+}
+
+void
+nmod_mat_mul_classical_threaded(nmod_mat_t C, const nmod_mat_t A,
+                                                            const nmod_mat_t B)
+{
+    _nmod_mat_mul_classical_threaded(C, NULL, A, B, 0);
+}
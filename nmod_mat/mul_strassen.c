@@ -39,6 +39,12 @@ nmod_mat_mul_strassen(nmod_mat_t C, const nmod_mat_t A, const nmod_mat_t B)
         return;
     }
 
+    if (flint_get_num_threads() > 1)
+    {
+        nmod_mat_mul_strassen_threaded(C, A, B);
+        return;
+    }
+
     anr = a / 2;
     anc = b / 2;
     bnr = anc;
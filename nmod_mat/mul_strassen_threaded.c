@@ -0,0 +1,235 @@
+/*
+    Copyright (C) 2026 agent
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include <stdlib.h>
+#include <gmp.h>
+#include <pthread.h>
+#include "flint.h"
+#include "nmod_vec.h"
+#include "nmod_mat.h"
+
+typedef struct
+{
+    nmod_mat_struct * P;      /* the seven products */
+    nmod_mat_struct * X;      /* left factors */
+    nmod_mat_struct * Y;      /* right factors */
+    slong * next;             /* index of the next unclaimed product */
+    slong num_threads;        /* threads available to each product */
+    pthread_mutex_t * mutex;
+}
+nmod_mat_strassen_arg_t;
+
+void *
+_nmod_mat_mul_strassen_worker(void * arg_ptr)
+{
+    nmod_mat_strassen_arg_t arg = *((nmod_mat_strassen_arg_t *) arg_ptr);
+    slong i;
+
+    /* products may themselves be threaded if there are spare threads */
+    flint_set_num_threads(arg.num_threads);
+
+    while (1)
+    {
+        pthread_mutex_lock(arg.mutex);
+        i = *arg.next;
+        *arg.next = i + 1;
+        pthread_mutex_unlock(arg.mutex);
+
+        if (i >= 7)
+            break;
+
+        nmod_mat_mul(arg.P + i, arg.X + i, arg.Y + i);
+    }
+
+    return NULL;
+}
+
+/*
+    Strassen-Winograd multiplication in which the seven half size products
+    are formed into separate temporaries so that they can be computed
+    concurrently. Workers repeatedly claim the next outstanding product,
+    so any number of threads keeps busy; threads beyond seven are handed
+    down to the products themselves.
+*/
+void
+nmod_mat_mul_strassen_threaded(nmod_mat_t C, const nmod_mat_t A,
+                                                        const nmod_mat_t B)
+{
+    slong a, b, c, i, next;
+    slong anr, anc, bnr, bnc;
+    slong num_threads, num_workers;
+    mp_limb_t n;
+
+    nmod_mat_t A11, A12, A21, A22;
+    nmod_mat_t B11, B12, B21, B22;
+    nmod_mat_t C11, C12, C21, C22;
+    nmod_mat_t S1, S2, S3, S4, T1, T2, T3, T4;
+    nmod_mat_struct X[7], Y[7], P[7];
+
+    pthread_mutex_t mutex;
+    nmod_mat_strassen_arg_t * args;
+
+    a = A->r;
+    b = A->c;
+    c = B->c;
+
+    num_threads = flint_get_num_threads();
+
+    if (a <= 4 || b <= 4 || c <= 4 || num_threads <= 1)
+    {
+        nmod_mat_mul_strassen(C, A, B);
+        return;
+    }
+
+    anr = a / 2;
+    anc = b / 2;
+    bnr = anc;
+    bnc = c / 2;
+    n = A->mod.n;
+
+    nmod_mat_window_init(A11, A, 0, 0, anr, anc);
+    nmod_mat_window_init(A12, A, 0, anc, anr, 2*anc);
+    nmod_mat_window_init(A21, A, anr, 0, 2*anr, anc);
+    nmod_mat_window_init(A22, A, anr, anc, 2*anr, 2*anc);
+
+    nmod_mat_window_init(B11, B, 0, 0, bnr, bnc);
+    nmod_mat_window_init(B12, B, 0, bnc, bnr, 2*bnc);
+    nmod_mat_window_init(B21, B, bnr, 0, 2*bnr, bnc);
+    nmod_mat_window_init(B22, B, bnr, bnc, 2*bnr, 2*bnc);
+
+    nmod_mat_window_init(C11, C, 0, 0, anr, bnc);
+    nmod_mat_window_init(C12, C, 0, bnc, anr, 2*bnc);
+    nmod_mat_window_init(C21, C, anr, 0, 2*anr, bnc);
+    nmod_mat_window_init(C22, C, anr, bnc, 2*anr, 2*bnc);
+
+    nmod_mat_init(S1, anr, anc, n);
+    nmod_mat_init(S2, anr, anc, n);
+    nmod_mat_init(S3, anr, anc, n);
+    nmod_mat_init(S4, anr, anc, n);
+    nmod_mat_init(T1, anc, bnc, n);
+    nmod_mat_init(T2, anc, bnc, n);
+    nmod_mat_init(T3, anc, bnc, n);
+    nmod_mat_init(T4, anc, bnc, n);
+
+    nmod_mat_add(S1, A21, A22);
+    nmod_mat_sub(S2, S1, A11);
+    nmod_mat_sub(S3, A11, A21);
+    nmod_mat_sub(S4, A12, S2);
+
+    nmod_mat_sub(T1, B12, B11);
+    nmod_mat_sub(T2, B22, T1);
+    nmod_mat_sub(T3, B22, B12);
+    nmod_mat_sub(T4, T2, B21);
+
+    X[0] = *A11; Y[0] = *B11;
+    X[1] = *A12; Y[1] = *B21;
+    X[2] = *S4;  Y[2] = *B22;
+    X[3] = *A22; Y[3] = *T4;
+    X[4] = *S1;  Y[4] = *T1;
+    X[5] = *S2;  Y[5] = *T2;
+    X[6] = *S3;  Y[6] = *T3;
+
+    for (i = 0; i < 7; i++)
+        nmod_mat_init(P + i, anr, bnc, n);
+
+    num_workers = FLINT_MIN(num_threads, 7);
+    args = flint_malloc(sizeof(nmod_mat_strassen_arg_t) * num_workers);
+
+    next = 0;
+    pthread_mutex_init(&mutex, NULL);
+
+    for (i = 0; i < num_workers; i++)
+    {
+        args[i].P = P;
+        args[i].X = X;
+        args[i].Y = Y;
+        args[i].next = &next;
+        args[i].num_threads = (num_threads * (i + 1)) / 7
+                            - (num_threads * i) / 7;
+        args[i].num_threads = FLINT_MAX(args[i].num_threads, 1);
+        args[i].mutex = &mutex;
+    }
+
+    flint_parallel_do(_nmod_mat_mul_strassen_worker,
+                             args, sizeof(nmod_mat_strassen_arg_t), num_workers);
+
+    pthread_mutex_destroy(&mutex);
+    flint_free(args);
+
+    /* C11 = P1 + P2, C12 = P1 + P6 + P5 + P3,
+       C21 = P1 + P6 + P7 - P4, C22 = P1 + P6 + P7 + P5 */
+    nmod_mat_add(C11, P + 0, P + 1);
+    nmod_mat_add(P + 5, P + 0, P + 5);
+    nmod_mat_add(P + 6, P + 5, P + 6);
+    nmod_mat_add(C12, P + 5, P + 4);
+    nmod_mat_add(C12, C12, P + 2);
+    nmod_mat_sub(C21, P + 6, P + 3);
+    nmod_mat_add(C22, P + 6, P + 4);
+
+    for (i = 0; i < 7; i++)
+        nmod_mat_clear(P + i);
+
+    nmod_mat_clear(S1);
+    nmod_mat_clear(S2);
+    nmod_mat_clear(S3);
+    nmod_mat_clear(S4);
+    nmod_mat_clear(T1);
+    nmod_mat_clear(T2);
+    nmod_mat_clear(T3);
+    nmod_mat_clear(T4);
+
+    nmod_mat_window_clear(A11);
+    nmod_mat_window_clear(A12);
+    nmod_mat_window_clear(A21);
+    nmod_mat_window_clear(A22);
+
+    nmod_mat_window_clear(B11);
+    nmod_mat_window_clear(B12);
+    nmod_mat_window_clear(B21);
+    nmod_mat_window_clear(B22);
+
+    nmod_mat_window_clear(C11);
+    nmod_mat_window_clear(C12);
+    nmod_mat_window_clear(C21);
+    nmod_mat_window_clear(C22);
+
+    if (c > 2*bnc) /* A by last col of B -> last col of C */
+    {
+        nmod_mat_t Bc, Cc;
+        nmod_mat_window_init(Bc, B, 0, 2*bnc, b, c);
+        nmod_mat_window_init(Cc, C, 0, 2*bnc, a, c);
+        nmod_mat_mul(Cc, A, Bc);
+        nmod_mat_window_clear(Bc);
+        nmod_mat_window_clear(Cc);
+    }
+
+    if (a > 2*anr) /* last row of A by B -> last row of C */
+    {
+        nmod_mat_t Ar, Cr;
+        nmod_mat_window_init(Ar, A, 2*anr, 0, a, b);
+        nmod_mat_window_init(Cr, C, 2*anr, 0, a, c);
+        nmod_mat_mul(Cr, Ar, B);
+        nmod_mat_window_clear(Ar);
+        nmod_mat_window_clear(Cr);
+    }
+
+    if (b > 2*anc) /* last col of A by last row of B -> C */
+    {
+        nmod_mat_t Ac, Br, Cb;
+        nmod_mat_window_init(Ac, A, 0, 2*anc, 2*anr, b);
+        nmod_mat_window_init(Br, B, 2*bnr, 0, b, 2*bnc);
+        nmod_mat_window_init(Cb, C, 0, 0, 2*anr, 2*bnc);
+        nmod_mat_addmul(Cb, Cb, Ac, Br);
+        nmod_mat_window_clear(Ac);
+        nmod_mat_window_clear(Br);
+        nmod_mat_window_clear(Cb);
+    }
+}
@@ -29,7 +29,13 @@ nmod_mat_submul(nmod_mat_t D, const nmod_mat_t C,
         n < NMOD_MAT_MUL_STRASSEN_CUTOFF ||
         k < NMOD_MAT_MUL_STRASSEN_CUTOFF)
     {
-        _nmod_mat_mul_classical(D, C, A, B, -1);
+        if (flint_get_num_threads() > 1 &&
+            m >= NMOD_MAT_MUL_THREADED_CUTOFF &&
+            n >= NMOD_MAT_MUL_THREADED_CUTOFF &&
+            k >= NMOD_MAT_MUL_THREADED_CUTOFF)
+            _nmod_mat_mul_classical_threaded(D, C, A, B, -1);
+        else
+            _nmod_mat_mul_classical(D, C, A, B, -1);
     }
     else
     {
@@ -0,0 +1,108 @@
+/*
+    Copyright (C) 2026 agent
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <gmp.h>
+#include "flint.h"
+#include "nmod_mat.h"
+#include "ulong_extras.h"
+
+int
+main(void)
+{
+    slong i;
+    FLINT_TEST_INIT(state);
+
+    flint_printf("mul_threaded....");
+    fflush(stdout);
+
+    for (i = 0; i < 200 * flint_test_multiplier(); i++)
+    {
+        nmod_mat_t A, B, C, D, E;
+        mp_limb_t mod;
+        slong m, k, n;
+
+        m = n_randint(state, 100);
+        k = n_randint(state, 100);
+        n = n_randint(state, 100);
+
+        switch (n_randint(state, 3))
+        {
+            case 0:
+                mod = n_randtest_not_zero(state);
+                break;
+            case 1:
+                mod = UWORD_MAX/2 + 1 - n_randbits(state, 4);
+                break;
+            case 2:
+            default:
+                mod = UWORD_MAX - n_randbits(state, 4);
+                break;
+        }
+
+        nmod_mat_init(A, m, k, mod);
+        nmod_mat_init(B, k, n, mod);
+        nmod_mat_init(C, m, n, mod);
+        nmod_mat_init(D, m, n, mod);
+        nmod_mat_init(E, m, n, mod);
+
+        nmod_mat_randtest(A, state);
+        nmod_mat_randtest(B, state);
+        nmod_mat_randtest(C, state);
+        nmod_mat_randtest(D, state);
+
+        flint_set_num_threads(1);
+        nmod_mat_mul_classical(E, A, B);
+
+        flint_set_num_threads(1 + n_randint(state, 10));
+
+        if (n_randint(state, 2))
+            nmod_mat_mul_classical_threaded(C, A, B);
+        else
+            nmod_mat_mul_strassen_threaded(C, A, B);
+
+        if (!nmod_mat_equal(C, E))
+        {
+            flint_printf("FAIL: results not equal\n");
+            flint_printf("threads = %d\n", flint_get_num_threads());
+            nmod_mat_print_pretty(A);
+            nmod_mat_print_pretty(B);
+            nmod_mat_print_pretty(C);
+            nmod_mat_print_pretty(E);
+            abort();
+        }
+
+        /* check addmul against add and mul */
+        nmod_mat_add(E, D, E);
+        _nmod_mat_mul_classical_threaded(D, D, A, B, 1);
+
+        if (!nmod_mat_equal(D, E))
+        {
+            flint_printf("FAIL: addmul results not equal\n");
+            flint_printf("threads = %d\n", flint_get_num_threads());
+            abort();
+        }
+
+        flint_set_num_threads(1);
+
+        nmod_mat_clear(A);
+        nmod_mat_clear(B);
+        nmod_mat_clear(C);
+        nmod_mat_clear(D);
+        nmod_mat_clear(E);
+    }
+
+    FLINT_TEST_CLEANUP(state);
+
+    flint_printf("PASS\n");
+    return 0;
+}
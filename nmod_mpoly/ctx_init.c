@@ -0,0 +1,23 @@
+/*
+    Copyright (C) 2026 agent
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include <gmp.h>
+#include "flint.h"
+#include "nmod_vec.h"
+#include "nmod_mpoly.h"
+
+void nmod_mpoly_ctx_init(nmod_mpoly_ctx_t ctx,
+                        slong nvars, const ordering_t ord, mp_limb_t modulus)
+{
+   ctx->n = (ord == ORD_DEGLEX || ord == ORD_DEGREVLEX) ? nvars + 1 : nvars;
+   ctx->ord = ord;
+   nmod_init(&ctx->mod, modulus);
+}
@@ -0,0 +1,585 @@
+/*
+    Copyright (C) 2026 agent
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include <gmp.h>
+#include <stdlib.h>
+#include "flint.h"
+#include "nmod_vec.h"
+#include "nmod_mpoly.h"
+
+/*
+   Set polyq to the quotient of poly2 by poly3, discarding the remainder,
+   and return the length of the quotient, or -1 if the exponents overflow.
+   This version of the function assumes the exponent vectors all fit in a
+   single word. The exponent vectors are
+   assumed to have fields with the given number of bits. Assumes input polys
+   are nonzero and that the leading coefficient of poly3 is invertible.
+   Implements "Polynomial division using dynamic arrays, heaps and packed
+   exponents" by Michael Monagan and Roman Pearce, with the heap ordered as
+   in fmpz_mpoly_divrem_monagan_pearce. The products poly3[i]*q[j] for each
+   term are accumulated unreduced in one word, or three words if they might
+   not fit in one, and reduced once before subtracting from the dividend
+   coefficient.
+*/
+slong _nmod_mpoly_div_monagan_pearce1(mp_limb_t ** polyq,
+           ulong ** expq, slong * allocq, const mp_limb_t * poly2,
+          const ulong * exp2, slong len2, const mp_limb_t * poly3,
+                 const ulong * exp3, slong len3, slong bits, ulong maskhi,
+                                                                  nmod_t mod)
+{
+    slong i, j, k, s;
+    slong next_loc, heap_len = 2;
+    mpoly_heap1_s * heap;
+    mpoly_heap_t * chain;
+    slong * store, * store_base;
+    mpoly_heap_t * x;
+    mp_limb_t * p1 = *polyq;
+    ulong * e1 = *expq;
+    slong * hind;
+    ulong mask, exp;
+    ulong acc[3], pp[2];
+    mp_limb_t a, c, lc_inv;
+    int lt_divides, small;
+    TMP_INIT;
+
+    /* whether the sum of products for a term fits in a single word */
+    small = _nmod_mpoly_acc_words(len3, mod) == 1;
+
+    /* throws if the leading coefficient is not invertible */
+    lc_inv = n_invmod(poly3[0], mod.n);
+
+    TMP_START;
+
+    /* alloc array of heap nodes which can be chained together */
+    next_loc = len3 + 4;   /* something bigger than heap can ever be */
+    heap = (mpoly_heap1_s *) TMP_ALLOC((len3 + 1)*sizeof(mpoly_heap1_s));
+    chain = (mpoly_heap_t *) TMP_ALLOC(len3*sizeof(mpoly_heap_t));
+    store = store_base = (slong *) TMP_ALLOC(2*len3*sizeof(mpoly_heap_t *));
+
+    /* space for flagged heap indicies */
+    hind = (slong *) TMP_ALLOC(len3*sizeof(slong));
+    for (i = 0; i < len3; i++)
+        hind[i] = 1;
+
+    /* mask with high bit set in each field of exponent vector */
+    mask = 0;
+    for (i = 0; i < FLINT_BITS/bits; i++)
+        mask = (mask << bits) + (UWORD(1) << (bits - 1));
+
+    /* quotient poly index starts at -1 */
+    k = -WORD(1);
+
+    /* s is the number of terms * (latest quotient) we should put into heap */
+    s = len3;
+
+    /* insert (-1, 0, exp2[0]) into heap */
+    x = chain + 0;
+    x->i = -WORD(1);
+    x->j = 0;
+    x->next = NULL;
+    HEAP_ASSIGN(heap[1], exp2[0], x);
+
+    while (heap_len > 1)
+    {
+        exp = heap[1].exp;
+
+        if (mpoly_monomial_overflows1(exp, mask))
+            goto exp_overflow;
+
+        k++;
+        _nmod_mpoly_fit_length(&p1, &e1, allocq, k + 1, 1);
+
+        lt_divides = mpoly_monomial_divides1(e1 + k, exp, exp3[0], mask);
+
+        /* take nodes from heap with exponent matching exp */
+        a = 0;
+        acc[0] = acc[1] = acc[2] = 0;
+        do
+        {
+            x = _mpoly_heap_pop1(heap, &heap_len, maskhi);
+            do
+            {
+                *store++ = x->i;
+                *store++ = x->j;
+                if (x->i != -WORD(1))
+                    hind[x->i] |= WORD(1);
+
+                if (x->i == -WORD(1))
+                    a = poly2[x->j];
+                else if (small)
+                    acc[0] += poly3[x->i]*p1[x->j];
+                else
+                {
+                    umul_ppmm(pp[1], pp[0], poly3[x->i], p1[x->j]);
+                    add_sssaaaaaa(acc[2], acc[1], acc[0], acc[2], acc[1],
+                                               acc[0], UWORD(0), pp[1], pp[0]);
+                }
+            } while ((x = x->next) != NULL);
+        } while (heap_len > 1 && heap[1].exp == exp);
+
+        /* process nodes taken from the heap */
+        while (store > store_base)
+        {
+            j = *--store;
+            i = *--store;
+
+            if (i == -WORD(1))
+            {
+                /* take next dividend term */
+                if (j + 1 < len2)
+                {
+                    x = chain + 0;
+                    x->i = i;
+                    x->j = j + 1;
+                    x->next = NULL;
+                    _mpoly_heap_insert1(heap, exp2[x->j], x,
+                                                 &next_loc, &heap_len, maskhi);
+                }
+            } else
+            {
+                /* should we go right? */
+                if (  (i + 1 < len3)
+                   && (hind[i + 1] == 2*j + 1)
+                   )
+                {
+                    x = chain + i + 1;
+                    x->i = i + 1;
+                    x->j = j;
+                    x->next = NULL;
+                    hind[x->i] = 2*(x->j + 1) + 0;
+                    _mpoly_heap_insert1(heap, exp3[x->i] + e1[x->j], x,
+                                                 &next_loc, &heap_len, maskhi);
+                }
+                /* should we go up? */
+                if (j + 1 == k)
+                {
+                    s++;
+                } else if (  ((hind[i] & 1) == 1)
+                          && ((i == 1) || (hind[i - 1] >= 2*(j + 2) + 1))
+                          )
+                {
+                    x = chain + i;
+                    x->i = i;
+                    x->j = j + 1;
+                    x->next = NULL;
+                    hind[x->i] = 2*(x->j + 1) + 0;
+                    _mpoly_heap_insert1(heap, exp3[x->i] + e1[x->j], x,
+                                                 &next_loc, &heap_len, maskhi);
+                }
+            }
+        }
+
+        /* subtract the reduced sum of products from the dividend term */
+        if (small)
+            NMOD_RED(c, acc[0], mod);
+        else
+            NMOD_RED3(c, acc[2], acc[1], acc[0], mod);
+
+        c = nmod_sub(a, c, mod);
+
+        if (c == 0 || !lt_divides)
+        {
+            k--;
+            continue;
+        }
+
+        p1[k] = nmod_mul(c, lc_inv, mod);
+
+        /* put newly generated quotient term back into the heap if neccesary */
+        if (s > 1)
+        {
+            i = 1;
+            x = chain + i;
+            x->i = i;
+            x->j = k;
+            x->next = NULL;
+            hind[x->i] = 2*(x->j + 1) + 0;
+            _mpoly_heap_insert1(heap, exp3[x->i] + e1[x->j], x,
+                                                 &next_loc, &heap_len, maskhi);
+        }
+        s = 1;
+    }
+
+    k++;
+
+cleanup:
+
+    (*polyq) = p1;
+    (*expq) = e1;
+
+    TMP_END;
+
+    return k;
+
+exp_overflow:
+    k = -WORD(1);
+    goto cleanup;
+}
+
+slong _nmod_mpoly_div_monagan_pearce(mp_limb_t ** polyq,
+           ulong ** expq, slong * allocq, const mp_limb_t * poly2,
+          const ulong * exp2, slong len2, const mp_limb_t * poly3,
+                 const ulong * exp3, slong len3, slong bits, slong N,
+                                       ulong maskhi, ulong masklo, nmod_t mod)
+{
+    slong i, j, k, s;
+    slong next_loc;
+    slong heap_len = 2; /* heap zero index unused */
+    mpoly_heap_s * heap;
+    mpoly_heap_t * chain;
+    slong * store, * store_base;
+    mpoly_heap_t * x;
+    mp_limb_t * p1 = *polyq;
+    ulong * e1 = *expq;
+    ulong * exp, * exps;
+    ulong ** exp_list;
+    slong exp_next;
+    ulong mask;
+    ulong acc[3], pp[2];
+    mp_limb_t a, c, lc_inv;
+    slong * hind;
+    int lt_divides, small;
+    TMP_INIT;
+
+    /* if exponent vectors fit in one word, call specialised version */
+    if (N == 1)
+        return _nmod_mpoly_div_monagan_pearce1(polyq, expq, allocq,
+                     poly2, exp2, len2, poly3, exp3, len3, bits, maskhi, mod);
+
+    /* whether the sum of products for a term fits in a single word */
+    small = _nmod_mpoly_acc_words(len3, mod) == 1;
+
+    /* throws if the leading coefficient is not invertible */
+    lc_inv = n_invmod(poly3[0], mod.n);
+
+    TMP_START;
+
+    /* alloc array of heap nodes which can be chained together */
+    next_loc = len3 + 4;   /* something bigger than heap can ever be */
+    heap = (mpoly_heap_s *) TMP_ALLOC((len3 + 1)*sizeof(mpoly_heap_s));
+    chain = (mpoly_heap_t *) TMP_ALLOC(len3*sizeof(mpoly_heap_t));
+    store = store_base = (slong *) TMP_ALLOC(2*len3*sizeof(mpoly_heap_t *));
+
+    /* array of exponent vectors, each of "N" words */
+    exps = (ulong *) TMP_ALLOC(len3*N*sizeof(ulong));
+    /* list of pointers to available exponent vectors */
+    exp_list = (ulong **) TMP_ALLOC(len3*sizeof(ulong *));
+    /* space to save copy of current exponent vector */
+    exp = (ulong *) TMP_ALLOC(N*sizeof(ulong));
+    /* set up list of available exponent vectors */
+    exp_next = 0;
+    for (i = 0; i < len3; i++)
+        exp_list[i] = exps + i*N;
+
+    /* space for flagged heap indicies */
+    hind = (slong *) TMP_ALLOC(len3*sizeof(slong));
+    for (i = 0; i < len3; i++)
+        hind[i] = 1;
+
+    /* mask with high bit set in each word of each field of exponent vector */
+    mask = 0;
+    for (i = 0; i < FLINT_BITS/bits; i++)
+        mask = (mask << bits) + (UWORD(1) << (bits - 1));
+
+    /* quotient poly index starts at -1 */
+    k = -WORD(1);
+
+    /* s is the number of terms * (latest quotient) we should put into heap */
+    s = len3;
+
+    /* insert (-1, 0, exp2[0]) into heap */
+    x = chain + 0;
+    x->i = -WORD(1);
+    x->j = 0;
+    x->next = NULL;
+    heap[1].next = x;
+    heap[1].exp = exp_list[exp_next++];
+    mpoly_monomial_set(heap[1].exp, exp2, N);
+
+    while (heap_len > 1)
+    {
+        mpoly_monomial_set(exp, heap[1].exp, N);
+
+        if (mpoly_monomial_overflows(exp, N, mask))
+            goto exp_overflow2;
+
+        k++;
+        _nmod_mpoly_fit_length(&p1, &e1, allocq, k + 1, N);
+
+        lt_divides = mpoly_monomial_divides(e1 + k*N, exp, exp3, N, mask);
+
+        /* take nodes from heap with exponent matching exp */
+        a = 0;
+        acc[0] = acc[1] = acc[2] = 0;
+        do
+        {
+            exp_list[--exp_next] = heap[1].exp;
+            x = _mpoly_heap_pop(heap, &heap_len, N, maskhi, masklo);
+            do
+            {
+                *store++ = x->i;
+                *store++ = x->j;
+                if (x->i != -WORD(1))
+                    hind[x->i] |= WORD(1);
+
+                if (x->i == -WORD(1))
+                    a = poly2[x->j];
+                else if (small)
+                    acc[0] += poly3[x->i]*p1[x->j];
+                else
+                {
+                    umul_ppmm(pp[1], pp[0], poly3[x->i], p1[x->j]);
+                    add_sssaaaaaa(acc[2], acc[1], acc[0], acc[2], acc[1],
+                                               acc[0], UWORD(0), pp[1], pp[0]);
+                }
+            } while ((x = x->next) != NULL);
+        } while (heap_len > 1 && mpoly_monomial_equal(heap[1].exp, exp, N));
+
+        /* process nodes taken from the heap */
+        while (store > store_base)
+        {
+            j = *--store;
+            i = *--store;
+
+            if (i == -WORD(1))
+            {
+                /* take next dividend term */
+                if (j + 1 < len2)
+                {
+                    x = chain + 0;
+                    x->i = i;
+                    x->j = j + 1;
+                    x->next = NULL;
+                    mpoly_monomial_set(exp_list[exp_next], exp2 + x->j*N, N);
+                    if (!_mpoly_heap_insert(heap, exp_list[exp_next++], x,
+                                      &next_loc, &heap_len, N, maskhi, masklo))
+                        exp_next--;
+                }
+            } else
+            {
+                /* should we go right? */
+                if (  (i + 1 < len3)
+                   && (hind[i + 1] == 2*j + 1)
+                   )
+                {
+                    x = chain + i + 1;
+                    x->i = i + 1;
+                    x->j = j;
+                    x->next = NULL;
+                    hind[x->i] = 2*(x->j + 1) + 0;
+                    mpoly_monomial_add(exp_list[exp_next], exp3 + x->i*N,
+                                                           e1   + x->j*N, N);
+                    if (!_mpoly_heap_insert(heap, exp_list[exp_next++], x,
+                                      &next_loc, &heap_len, N, maskhi, masklo))
+                        exp_next--;
+                }
+                /* should we go up? */
+                if (j + 1 == k)
+                {
+                    s++;
+                } else if (  ((hind[i] & 1) == 1)
+                          && ((i == 1) || (hind[i - 1] >= 2*(j + 2) + 1))
+                          )
+                {
+                    x = chain + i;
+                    x->i = i;
+                    x->j = j + 1;
+                    x->next = NULL;
+                    hind[x->i] = 2*(x->j + 1) + 0;
+                    mpoly_monomial_add(exp_list[exp_next], exp3 + x->i*N,
+                                                           e1   + x->j*N, N);
+                    if (!_mpoly_heap_insert(heap, exp_list[exp_next++], x,
+                                      &next_loc, &heap_len, N, maskhi, masklo))
+                        exp_next--;
+                }
+            }
+        }
+
+        /* subtract the reduced sum of products from the dividend term */
+        if (small)
+            NMOD_RED(c, acc[0], mod);
+        else
+            NMOD_RED3(c, acc[2], acc[1], acc[0], mod);
+
+        c = nmod_sub(a, c, mod);
+
+        if (c == 0 || !lt_divides)
+        {
+            k--;
+            continue;
+        }
+
+        p1[k] = nmod_mul(c, lc_inv, mod);
+
+        /* put newly generated quotient term back into the heap if neccesary */
+        if (s > 1)
+        {
+            i = 1;
+            x = chain + i;
+            x->i = i;
+            x->j = k;
+            x->next = NULL;
+            hind[x->i] = 2*(x->j + 1) + 0;
+            mpoly_monomial_add(exp_list[exp_next], exp3 + x->i*N,
+                                                   e1   + x->j*N, N);
+            if (!_mpoly_heap_insert(heap, exp_list[exp_next++], x,
+                                  &next_loc, &heap_len, N, maskhi, masklo))
+                exp_next--;
+        }
+        s = 1;
+    }
+
+    k++;
+
+cleanup2:
+
+    (*polyq) = p1;
+    (*expq) = e1;
+
+    TMP_END;
+
+    /* return quotient poly length */
+    return k;
+
+exp_overflow2:
+    k = -WORD(1);
+    goto cleanup2;
+}
+
+void nmod_mpoly_div_monagan_pearce(nmod_mpoly_t q, const nmod_mpoly_t poly2,
+                          const nmod_mpoly_t poly3, const nmod_mpoly_ctx_t ctx)
+{
+   slong exp_bits, N, lenq = 0;
+   ulong * exp2 = poly2->exps, * exp3 = poly3->exps;
+   ulong maskhi, masklo;
+   int free2 = 0, free3 = 0;
+   nmod_mpoly_t temp1;
+   nmod_mpoly_struct * tq;
+
+   /* check divisor is nonzero */
+   if (poly3->length == 0)
+      flint_throw(FLINT_DIVZERO, "Divide by zero in nmod_mpoly_div_monagan_pearce");
+
+   /* dividend zero, write out quotient */
+   if (poly2->length == 0)
+   {
+      nmod_mpoly_zero(q, ctx);
+
+      return;
+   }
+
+   /* maximum bits in quotient exps and inputs is max for poly2 and poly3 */
+   exp_bits = FLINT_MAX(poly2->bits, poly3->bits);
+
+   masks_from_bits_ord(maskhi, masklo, exp_bits, ctx->ord);
+   N = words_per_exp(ctx->n, exp_bits);
+
+   /* ensure input exponents packed to same size as output exponents */
+   if (exp_bits > poly2->bits)
+   {
+      free2 = 1;
+      exp2 = (ulong *) flint_malloc(N*poly2->length*sizeof(ulong));
+      mpoly_unpack_monomials(exp2, exp_bits, poly2->exps, poly2->bits,
+                                                        poly2->length, ctx->n);
+   }
+
+   if (exp_bits > poly3->bits)
+   {
+      free3 = 1;
+      exp3 = (ulong *) flint_malloc(N*poly3->length*sizeof(ulong));
+      mpoly_unpack_monomials(exp3, exp_bits, poly3->exps, poly3->bits,
+                                                        poly3->length, ctx->n);
+   }
+
+   /* check divisor leading monomial is at most that of the dividend */
+   if (mpoly_monomial_lt(exp3, exp2, N, maskhi, masklo))
+   {
+      nmod_mpoly_zero(q, ctx);
+
+      goto cleanup3;
+   }
+
+   /* take care of aliasing */
+   if (q == poly2 || q == poly3)
+   {
+      nmod_mpoly_init2(temp1, FLINT_MAX(poly2->length/poly3->length + 1, 1),
+                                                                          ctx);
+      nmod_mpoly_fit_bits(temp1, exp_bits, ctx);
+      temp1->bits = exp_bits;
+
+      tq = temp1;
+   } else
+   {
+      nmod_mpoly_fit_length(q, FLINT_MAX(poly2->length/poly3->length + 1, 1),
+                                                                          ctx);
+      nmod_mpoly_fit_bits(q, exp_bits, ctx);
+      q->bits = exp_bits;
+
+      tq = q;
+   }
+
+   /* do division with remainder */
+   while ((lenq = _nmod_mpoly_div_monagan_pearce(&tq->coeffs, &tq->exps,
+                         &tq->alloc, poly2->coeffs, exp2, poly2->length,
+                                     poly3->coeffs, exp3, poly3->length,
+                            exp_bits, N, maskhi, masklo, ctx->mod)) == -WORD(1)
+            && exp_bits < FLINT_BITS)
+   {
+      ulong * old_exp2 = exp2, * old_exp3 = exp3;
+      slong old_exp_bits = exp_bits;
+
+      exp_bits = mpoly_optimize_bits(exp_bits + 1, ctx->n);
+
+      masks_from_bits_ord(maskhi, masklo, exp_bits, ctx->ord);
+      N = words_per_exp(ctx->n, exp_bits);
+
+      exp2 = (ulong *) flint_malloc(N*poly2->length*sizeof(ulong));
+      mpoly_unpack_monomials(exp2, exp_bits, old_exp2, old_exp_bits,
+                                                        poly2->length, ctx->n);
+
+      exp3 = (ulong *) flint_malloc(N*poly3->length*sizeof(ulong));
+      mpoly_unpack_monomials(exp3, exp_bits, old_exp3, old_exp_bits,
+                                                        poly3->length, ctx->n);
+
+      if (free2)
+         flint_free(old_exp2);
+
+      if (free3)
+         flint_free(old_exp3);
+
+      free2 = free3 = 1;
+
+      nmod_mpoly_fit_bits(tq, exp_bits, ctx);
+      tq->bits = exp_bits;
+   }
+
+   if (lenq == -WORD(1))
+      flint_throw(FLINT_EXPOF,
+                      "Exponent overflow in nmod_mpoly_div_monagan_pearce");
+
+   /* take care of aliasing */
+   if (q == poly2 || q == poly3)
+   {
+      nmod_mpoly_swap(temp1, q, ctx);
+
+      nmod_mpoly_clear(temp1, ctx);
+   }
+
+   _nmod_mpoly_set_length(q, lenq, ctx);
+
+cleanup3:
+
+   if (free2)
+      flint_free(exp2);
+
+   if (free3)
+      flint_free(exp3);
+}
@@ -0,0 +1,488 @@
+/*
+    Copyright (C) 2026 agent
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include <gmp.h>
+#include <stdlib.h>
+#include "flint.h"
+#include "nmod_poly.h"
+#include "nmod_mpoly.h"
+
+/*
+   The functions in this file work in a lex context in which only the
+   variables x_0, ..., x_k occur. As x_k is then the least significant
+   variable, the terms with a given monomial in x_0, ..., x_{k-1} form a
+   contiguous run, whose coefficients make up a univariate polynomial in
+   x_k. The field of x_k is at word off, shift, and fmask is the mask of
+   that field within the word.
+*/
+
+/* return the index one past the end of the run starting at index i */
+static slong _nmod_mpoly_run_end(const nmod_mpoly_t A, slong i, slong N,
+                                                       slong off, ulong fmask)
+{
+   slong j, l;
+   ulong d;
+
+   for (j = i + 1; j < A->length; j++)
+   {
+      for (l = 0; l < N; l++)
+      {
+         d = A->exps[j*N + l] ^ A->exps[i*N + l];
+         if (l == off)
+            d &= ~fmask;
+         if (d != 0)
+            return j;
+      }
+   }
+
+   return A->length;
+}
+
+/* set r to the polynomial in x_k given by the terms [i, j) of A */
+static void _nmod_mpoly_run_get_poly(nmod_poly_t r, const nmod_mpoly_t A,
+            slong i, slong j, slong N, slong off, slong shift, ulong mask)
+{
+   nmod_poly_zero(r);
+
+   for ( ; i < j; i++)
+      nmod_poly_set_coeff_ui(r, (A->exps[i*N + off] >> shift) & mask,
+                                                                A->coeffs[i]);
+}
+
+/* set A to the polynomial r in x_k */
+static void _nmod_mpoly_set_poly_last(nmod_mpoly_t A, const nmod_poly_t r,
+                      slong bits, slong off, slong shift,
+                                                   const nmod_mpoly_ctx_t ctx)
+{
+   slong i, j, k, N = words_per_exp(ctx->n, bits);
+
+   nmod_mpoly_fit_length(A, r->length, ctx);
+   nmod_mpoly_fit_bits(A, bits, ctx);
+   A->bits = bits;
+
+   for (i = r->length - 1, k = 0; i >= 0; i--)
+   {
+      if (r->coeffs[i] != 0)
+      {
+         for (j = 0; j < N; j++)
+            A->exps[k*N + j] = 0;
+         A->exps[k*N + off] = ((ulong) i) << shift;
+         A->coeffs[k] = r->coeffs[i];
+         k++;
+      }
+   }
+
+   _nmod_mpoly_set_length(A, k, ctx);
+}
+
+/* set c to the monic gcd of the coefficients of A as polynomials in x_k */
+static void _nmod_mpoly_content_last(nmod_poly_t c, const nmod_mpoly_t A,
+                             slong N, slong off, slong shift, ulong mask)
+{
+   slong i, j;
+   nmod_poly_t r;
+
+   nmod_poly_init_preinv(r, c->mod.n, c->mod.ninv);
+   nmod_poly_zero(c);
+
+   for (i = 0; i < A->length; i = j)
+   {
+      j = _nmod_mpoly_run_end(A, i, N, off, mask << shift);
+      _nmod_mpoly_run_get_poly(r, A, i, j, N, off, shift, mask);
+      nmod_poly_gcd(c, c, r);
+
+      if (nmod_poly_degree(c) == 0)
+         break;
+   }
+
+   nmod_poly_clear(r);
+}
+
+/* set E to A evaluated at x_k = alpha; E and A may not alias */
+static void _nmod_mpoly_eval_last(nmod_mpoly_t E, const nmod_mpoly_t A,
+                   mp_limb_t alpha, slong off, slong shift, ulong mask,
+                                                   const nmod_mpoly_ctx_t ctx)
+{
+   slong i, j, k, N = words_per_exp(ctx->n, A->bits);
+   mp_limb_t v;
+
+   nmod_mpoly_fit_length(E, A->length, ctx);
+   nmod_mpoly_fit_bits(E, A->bits, ctx);
+   E->bits = A->bits;
+
+   for (i = k = 0; i < A->length; i = j)
+   {
+      j = _nmod_mpoly_run_end(A, i, N, off, mask << shift);
+
+      for (v = 0; i < j; i++)
+      {
+         ulong e = (A->exps[i*N + off] >> shift) & mask;
+         v = nmod_add(v, nmod_mul(A->coeffs[i],
+                            nmod_pow_ui(alpha, e, ctx->mod), ctx->mod), ctx->mod);
+      }
+
+      if (v != 0)
+      {
+         mpoly_monomial_set(E->exps + k*N, A->exps + (j - 1)*N, N);
+         E->exps[k*N + off] &= ~(mask << shift);
+         E->coeffs[k] = v;
+         k++;
+      }
+   }
+
+   _nmod_mpoly_set_length(E, k, ctx);
+}
+
+/*
+   compare the leading monomials of A and B ignoring the field of x_k;
+   return a positive value if the monomial of A is larger
+*/
+static int _nmod_mpoly_lead_cmp_last(const nmod_mpoly_t A,
+                       const nmod_mpoly_t B, slong N, slong off, ulong fmask)
+{
+   slong i;
+   ulong a, b;
+
+   for (i = 0; i < N; i++)
+   {
+      a = A->exps[i];
+      b = B->exps[i];
+
+      if (i == off)
+      {
+         a &= ~fmask;
+         b &= ~fmask;
+      }
+
+      if (a != b)
+         return a > b ? 1 : -1;
+   }
+
+   return 0;
+}
+
+int _nmod_mpoly_gcd_brown_rec(nmod_mpoly_t G, const nmod_mpoly_t A,
+                const nmod_mpoly_t B, slong k, int zippel, flint_rand_t state,
+                                                   const nmod_mpoly_ctx_t ctx)
+{
+   slong bits = A->bits, N, off, shift, i, degA, degB, bound;
+   ulong mask, fmask;
+   mp_limb_t p = ctx->mod.n, start, alpha, gam;
+   int ret = 0, changed, have_skel = 0;
+   nmod_poly_t cA, cB, c, lcA, lcB, gamma, M, t;
+   nmod_mpoly_t Ap, Bp, Ae, Be, g, H, Ha, D, C, S, Q, R;
+
+   FLINT_ASSERT(A->length != 0 && B->length != 0);
+   FLINT_ASSERT(A->bits == B->bits);
+
+   N = words_per_exp(ctx->n, bits);
+   mask = (-UWORD(1)) >> (FLINT_BITS - bits);
+   mpoly_off_shift(&off, &shift, k, 0, 0, FLINT_BITS/bits, ctx->n, bits);
+   fmask = mask << shift;
+
+   nmod_poly_init_preinv(cA, ctx->mod.n, ctx->mod.ninv);
+   nmod_poly_init_preinv(cB, ctx->mod.n, ctx->mod.ninv);
+
+   if (k == 0)
+   {
+      _nmod_mpoly_run_get_poly(cA, A, 0, A->length, N, off, shift, mask);
+      _nmod_mpoly_run_get_poly(cB, B, 0, B->length, N, off, shift, mask);
+      nmod_poly_gcd(cA, cA, cB);
+      _nmod_mpoly_set_poly_last(G, cA, bits, off, shift, ctx);
+
+      nmod_poly_clear(cA);
+      nmod_poly_clear(cB);
+
+      return 1;
+   }
+
+   degA = nmod_mpoly_degree(A, k, ctx);
+   degB = nmod_mpoly_degree(B, k, ctx);
+
+   if (degA == 0 && degB == 0)
+   {
+      nmod_poly_clear(cA);
+      nmod_poly_clear(cB);
+
+      return _nmod_mpoly_gcd_brown_rec(G, A, B, k - 1, zippel, state, ctx);
+   }
+
+   nmod_poly_init_preinv(c, ctx->mod.n, ctx->mod.ninv);
+   nmod_poly_init_preinv(lcA, ctx->mod.n, ctx->mod.ninv);
+   nmod_poly_init_preinv(lcB, ctx->mod.n, ctx->mod.ninv);
+   nmod_poly_init_preinv(gamma, ctx->mod.n, ctx->mod.ninv);
+   nmod_poly_init_preinv(M, ctx->mod.n, ctx->mod.ninv);
+   nmod_poly_init_preinv(t, ctx->mod.n, ctx->mod.ninv);
+
+   nmod_mpoly_init(Ap, ctx);
+   nmod_mpoly_init(Bp, ctx);
+   nmod_mpoly_init(Ae, ctx);
+   nmod_mpoly_init(Be, ctx);
+   nmod_mpoly_init(g, ctx);
+   nmod_mpoly_init(H, ctx);
+   nmod_mpoly_init(Ha, ctx);
+   nmod_mpoly_init(D, ctx);
+   nmod_mpoly_init(C, ctx);
+   nmod_mpoly_init(S, ctx);
+   nmod_mpoly_init(Q, ctx);
+   nmod_mpoly_init(R, ctx);
+
+   /* remove the contents in x_k */
+   _nmod_mpoly_content_last(cA, A, N, off, shift, mask);
+   _nmod_mpoly_content_last(cB, B, N, off, shift, mask);
+   nmod_poly_gcd(c, cA, cB);
+
+   _nmod_mpoly_set_poly_last(C, cA, bits, off, shift, ctx);
+   nmod_mpoly_div_monagan_pearce(Ap, A, C, ctx);
+   _nmod_mpoly_set_poly_last(C, cB, bits, off, shift, ctx);
+   nmod_mpoly_div_monagan_pearce(Bp, B, C, ctx);
+
+   /* the leading coefficient of the gcd in x_0, ..., x_{k-1} divides gamma */
+   _nmod_mpoly_run_get_poly(lcA, Ap, 0,
+                 _nmod_mpoly_run_end(Ap, 0, N, off, fmask), N, off, shift, mask);
+   _nmod_mpoly_run_get_poly(lcB, Bp, 0,
+                 _nmod_mpoly_run_end(Bp, 0, N, off, fmask), N, off, shift, mask);
+   nmod_poly_gcd(gamma, lcA, lcB);
+
+   degA = nmod_mpoly_degree(Ap, k, ctx);
+   degB = nmod_mpoly_degree(Bp, k, ctx);
+   bound = nmod_poly_degree(gamma) + FLINT_MIN(degA, degB);
+
+   nmod_poly_one(M);
+   start = n_randint(state, p);
+
+   for (i = 0; (mp_limb_t) i < p; i++)
+   {
+      alpha = (start >= p - i) ? start - (p - i) : start + i;
+
+      if (nmod_poly_evaluate_nmod(lcA, alpha) == 0
+       || nmod_poly_evaluate_nmod(lcB, alpha) == 0)
+         continue;
+
+      _nmod_mpoly_eval_last(Ae, Ap, alpha, off, shift, mask, ctx);
+      _nmod_mpoly_eval_last(Be, Bp, alpha, off, shift, mask, ctx);
+
+      if (!(zippel && have_skel && k > 1
+         && _nmod_mpoly_gcd_zippel_skel(g, Ae, Be, S, k, state, ctx)))
+      {
+         if (!_nmod_mpoly_gcd_brown_rec(g, Ae, Be, k - 1, zippel, state, ctx))
+            goto cleanup;
+      }
+
+      /* a constant image means the gcd is the content */
+      if (g->length == 1 && mpoly_monomial_is_zero(g->exps, N))
+      {
+         _nmod_mpoly_set_poly_last(G, c, bits, off, shift, ctx);
+         ret = 1;
+         goto cleanup;
+      }
+
+      if (H->length != 0)
+      {
+         int cmp = _nmod_mpoly_lead_cmp_last(g, H, N, off, fmask);
+
+         /* unlucky evaluation point */
+         if (cmp > 0)
+            continue;
+
+         /* all previous evaluation points were unlucky */
+         if (cmp < 0)
+         {
+            nmod_mpoly_zero(H, ctx);
+            nmod_poly_one(M);
+            have_skel = 0;
+         }
+      }
+
+      gam = nmod_poly_evaluate_nmod(gamma, alpha);
+      nmod_mpoly_scalar_mul_ui(g, g, gam, ctx);
+
+      if (H->length == 0)
+      {
+         nmod_mpoly_set(H, g, ctx);
+         nmod_mpoly_set(S, g, ctx);
+         have_skel = 1;
+         changed = 1;
+      } else
+      {
+         /* Newton interpolation: H += (g - H(alpha))*M/M(alpha) */
+         _nmod_mpoly_eval_last(Ha, H, alpha, off, shift, mask, ctx);
+         nmod_mpoly_sub(D, g, Ha, ctx);
+         changed = D->length != 0;
+
+         if (changed)
+         {
+            nmod_poly_scalar_mul_nmod(t, M,
+                  n_invmod(nmod_poly_evaluate_nmod(M, alpha), p));
+            _nmod_mpoly_set_poly_last(C, t, bits, off, shift, ctx);
+            nmod_mpoly_mul_johnson(Q, D, C, ctx);
+            nmod_mpoly_add(H, H, Q, ctx);
+         }
+      }
+
+      nmod_poly_zero(t);
+      nmod_poly_set_coeff_ui(t, 1, 1);
+      nmod_poly_set_coeff_ui(t, 0, nmod_neg(alpha, ctx->mod));
+      nmod_poly_mul(M, M, t);
+
+      if (!changed || nmod_poly_degree(M) > bound)
+      {
+         /* trial division by the primitive part of H */
+         _nmod_mpoly_content_last(t, H, N, off, shift, mask);
+         _nmod_mpoly_set_poly_last(C, t, bits, off, shift, ctx);
+         nmod_mpoly_div_monagan_pearce(g, H, C, ctx);
+
+         nmod_mpoly_divrem_monagan_pearce(Q, R, Ap, g, ctx);
+         if (R->length == 0)
+         {
+            nmod_mpoly_divrem_monagan_pearce(Q, R, Bp, g, ctx);
+            if (R->length == 0)
+            {
+               _nmod_mpoly_set_poly_last(C, c, bits, off, shift, ctx);
+               nmod_mpoly_mul_johnson(G, g, C, ctx);
+               nmod_mpoly_scalar_mul_ui(G, G,
+                                             n_invmod(G->coeffs[0], p), ctx);
+               ret = 1;
+               goto cleanup;
+            }
+         }
+
+         if (nmod_poly_degree(M) > bound)
+         {
+            nmod_mpoly_zero(H, ctx);
+            nmod_poly_one(M);
+            have_skel = 0;
+         }
+      }
+   }
+
+   /* ran out of evaluation points */
+
+cleanup:
+
+   nmod_poly_clear(cA);
+   nmod_poly_clear(cB);
+   nmod_poly_clear(c);
+   nmod_poly_clear(lcA);
+   nmod_poly_clear(lcB);
+   nmod_poly_clear(gamma);
+   nmod_poly_clear(M);
+   nmod_poly_clear(t);
+
+   nmod_mpoly_clear(Ap, ctx);
+   nmod_mpoly_clear(Bp, ctx);
+   nmod_mpoly_clear(Ae, ctx);
+   nmod_mpoly_clear(Be, ctx);
+   nmod_mpoly_clear(g, ctx);
+   nmod_mpoly_clear(H, ctx);
+   nmod_mpoly_clear(Ha, ctx);
+   nmod_mpoly_clear(D, ctx);
+   nmod_mpoly_clear(C, ctx);
+   nmod_mpoly_clear(S, ctx);
+   nmod_mpoly_clear(Q, ctx);
+   nmod_mpoly_clear(R, ctx);
+
+   return ret;
+}
+
+/*
+   Compute the monic gcd of A and B by converting to lex with enough bits
+   for the interpolation and calling the recursive algorithm. If zippel is
+   set, sparse interpolation is attempted for all but the first image in
+   each variable.
+*/
+int _nmod_mpoly_gcd_modular(nmod_mpoly_t G, const nmod_mpoly_t A,
+                const nmod_mpoly_t B, int zippel, const nmod_mpoly_ctx_t ctx)
+{
+   slong i, N, nvars, bits, max;
+   int deg, rev, ret;
+   slong * degs;
+   ulong * mab;
+   nmod_mpoly_ctx_t lctx;
+   nmod_mpoly_t Al, Bl, Gl;
+   flint_rand_t state;
+   TMP_INIT;
+
+   if (A->length == 0 || B->length == 0)
+   {
+      nmod_mpoly_set(G, A->length == 0 ? B : A, ctx);
+      if (G->length != 0)
+         nmod_mpoly_scalar_mul_ui(G, G, n_invmod(G->coeffs[0], ctx->mod.n),
+                                                                          ctx);
+      return 1;
+   }
+
+   TMP_START;
+
+   degrev_from_ord(deg, rev, ctx->ord);
+   nvars = ctx->n - deg;
+
+   /* leave room for the degree of the interpolation modulus */
+   degs = (slong *) TMP_ALLOC(nvars*sizeof(slong));
+   max = 0;
+   nmod_mpoly_degrees(degs, A, ctx);
+   for (i = 0; i < nvars; i++)
+      max = FLINT_MAX(max, degs[i]);
+   nmod_mpoly_degrees(degs, B, ctx);
+   for (i = 0; i < nvars; i++)
+      max = FLINT_MAX(max, degs[i]);
+
+   bits = FLINT_MAX(A->bits, B->bits);
+   bits = FLINT_MAX(bits, FLINT_BIT_COUNT(max + 1) + 1);
+   bits = mpoly_optimize_bits(bits, nvars);
+
+   nmod_mpoly_ctx_init(lctx, nvars, ORD_LEX, ctx->mod.n);
+   nmod_mpoly_init(Al, lctx);
+   nmod_mpoly_init(Bl, lctx);
+   nmod_mpoly_init(Gl, lctx);
+   flint_randinit(state);
+
+   _nmod_mpoly_convert_ord(Al, bits, lctx, A, ctx);
+   _nmod_mpoly_convert_ord(Bl, bits, lctx, B, ctx);
+
+   /* remove the monomial contents */
+   N = words_per_exp(nvars, bits);
+   mab = (ulong *) TMP_ALLOC(2*N*sizeof(ulong));
+   mpoly_monomials_min(mab, Al->exps, Al->length, bits, N);
+   mpoly_monomials_min(mab + N, Bl->exps, Bl->length, bits, N);
+   for (i = 0; i < Al->length; i++)
+      mpoly_monomial_sub(Al->exps + i*N, Al->exps + i*N, mab, N);
+   for (i = 0; i < Bl->length; i++)
+      mpoly_monomial_sub(Bl->exps + i*N, Bl->exps + i*N, mab + N, N);
+   mpoly_monomials_min(mab, mab, 2, bits, N);
+
+   ret = _nmod_mpoly_gcd_brown_rec(Gl, Al, Bl, nvars - 1, zippel, state, lctx);
+
+   if (ret)
+   {
+      for (i = 0; i < Gl->length; i++)
+         mpoly_monomial_add(Gl->exps + i*N, Gl->exps + i*N, mab, N);
+
+      _nmod_mpoly_convert_ord(G, FLINT_MAX(A->bits, B->bits), ctx, Gl, lctx);
+      nmod_mpoly_scalar_mul_ui(G, G, n_invmod(G->coeffs[0], ctx->mod.n), ctx);
+   }
+
+   flint_randclear(state);
+   nmod_mpoly_clear(Al, lctx);
+   nmod_mpoly_clear(Bl, lctx);
+   nmod_mpoly_clear(Gl, lctx);
+   nmod_mpoly_ctx_clear(lctx);
+
+   TMP_END;
+
+   return ret;
+}
+
+int nmod_mpoly_gcd_brown(nmod_mpoly_t G, const nmod_mpoly_t A,
+                           const nmod_mpoly_t B, const nmod_mpoly_ctx_t ctx)
+{
+   return _nmod_mpoly_gcd_modular(G, A, B, 0, ctx);
+}
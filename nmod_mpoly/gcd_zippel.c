@@ -0,0 +1,565 @@
+/*
+    Copyright (C) 2026 agent
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include <gmp.h>
+#include <stdlib.h>
+#include "flint.h"
+#include "nmod_vec.h"
+#include "nmod_poly.h"
+#include "nmod_mat.h"
+#include "nmod_mpoly.h"
+
+/*
+   Set vals[i] to the value at beta of the monomial of term i of A in the
+   variables x_0, ..., x_{nv-1} other than x_v, and set evs[i] to the
+   exponent of x_v in term i.
+*/
+static void _nmod_mpoly_monomial_values(mp_limb_t * vals, ulong * evs,
+                const nmod_mpoly_t A, const mp_limb_t * beta, slong nv,
+                                          slong v, const nmod_mpoly_ctx_t ctx)
+{
+   slong i, j, N = words_per_exp(ctx->n, A->bits);
+   ulong * user;
+   TMP_INIT;
+
+   TMP_START;
+   user = (ulong *) TMP_ALLOC(ctx->n*sizeof(ulong));
+
+   for (i = 0; i < A->length; i++)
+   {
+      mpoly_get_monomial(user, A->exps + i*N, A->bits, ctx->n, 0, 0);
+
+      vals[i] = 1;
+      for (j = 0; j < nv; j++)
+      {
+         if (j != v && user[j] != 0)
+            vals[i] = nmod_mul(vals[i],
+                                nmod_pow_ui(beta[j], user[j], ctx->mod), ctx->mod);
+      }
+
+      evs[i] = user[v];
+   }
+
+   TMP_END;
+}
+
+/*
+   Multiply the values cur of the terms of A by their monomial values and
+   set r to the resulting univariate polynomial in x_v.
+*/
+static void _nmod_mpoly_eval_step(nmod_poly_t r, mp_limb_t * cur,
+               const mp_limb_t * vals, const ulong * evs,
+                                 const nmod_mpoly_t A, const nmod_t mod)
+{
+   slong i;
+
+   nmod_poly_zero(r);
+
+   for (i = 0; i < A->length; i++)
+   {
+      cur[i] = nmod_mul(cur[i], vals[i], mod);
+      nmod_poly_set_coeff_ui(r, evs[i], nmod_add(nmod_poly_get_coeff_ui(r,
+                         evs[i]), nmod_mul(A->coeffs[i], cur[i], mod), mod));
+   }
+}
+
+/*
+   Solve sum_i c[i]*v[i]^j = y[j - 1] for j = 1, ..., n given distinct
+   nonzero v[i]. This is a transposed Vandermonde system, solved in O(n^2)
+   operations using the master polynomial P = prod_i (z - v[i]). Return 0
+   if the v[i] are not distinct.
+*/
+static int _nmod_vandermonde_solve(mp_limb_t * c, const mp_limb_t * v,
+                         const mp_limb_t * y, slong n, mp_limb_t * w, nmod_t mod)
+{
+   slong i, j;
+   mp_limb_t * P = w, * q = w + n + 1;
+   mp_limb_t s, d;
+
+   /* P = prod (z - v[i]) */
+   P[0] = 1;
+   for (i = 0; i < n; i++)
+   {
+      P[i + 1] = P[i];
+      for (j = i; j > 0; j--)
+         P[j] = nmod_sub(P[j - 1], nmod_mul(v[i], P[j], mod), mod);
+      P[0] = nmod_neg(nmod_mul(v[i], P[0], mod), mod);
+   }
+
+   for (i = 0; i < n; i++)
+   {
+      /* q = P/(z - v[i]) by synthetic division */
+      q[n - 1] = P[n];
+      for (j = n - 1; j > 0; j--)
+         q[j - 1] = nmod_add(P[j], nmod_mul(v[i], q[j], mod), mod);
+
+      s = d = 0;
+      for (j = n - 1; j >= 0; j--)
+      {
+         d = nmod_add(nmod_mul(d, v[i], mod), q[j], mod);
+         s = nmod_add(s, nmod_mul(q[j], y[j], mod), mod);
+      }
+
+      d = nmod_mul(d, v[i], mod);
+      if (d == 0)
+         return 0;
+
+      c[i] = nmod_mul(s, n_invmod(d, mod.n), mod);
+   }
+
+   return 1;
+}
+
+/*
+   The case where S is a single term m. If m involves some x_v, the gcd is
+   m if and only if the image of the gcd at a random point in the other
+   variables is x_v^d, assuming this point is not unlucky. Return 0 if m is
+   constant or the image does not agree.
+*/
+static int _nmod_mpoly_gcd_zippel_monomial(nmod_mpoly_t G,
+                 const nmod_mpoly_t A, const nmod_mpoly_t B,
+                 const nmod_mpoly_t S, slong nv, flint_rand_t state,
+                                                   const nmod_mpoly_ctx_t ctx)
+{
+   slong i, j, v, N = words_per_exp(ctx->n, S->bits);
+   slong * degs;
+   ulong * evA, * evB;
+   mp_limb_t * beta, * valA, * valB;
+   int ret = 0;
+   nmod_poly_t a, b, g;
+   TMP_INIT;
+
+   TMP_START;
+
+   degs = (slong *) TMP_ALLOC(ctx->n*sizeof(slong));
+   nmod_mpoly_degrees(degs, S, ctx);
+
+   for (v = 0; v < nv && degs[v] == 0; v++) ;
+
+   if (v == nv)
+   {
+      TMP_END;
+      return 0;
+   }
+
+   beta = (mp_limb_t *) TMP_ALLOC(ctx->n*sizeof(mp_limb_t));
+   evA = (ulong *) TMP_ALLOC(A->length*sizeof(ulong));
+   evB = (ulong *) TMP_ALLOC(B->length*sizeof(ulong));
+   valA = (mp_limb_t *) TMP_ALLOC(2*A->length*sizeof(mp_limb_t));
+   valB = (mp_limb_t *) TMP_ALLOC(2*B->length*sizeof(mp_limb_t));
+
+   for (j = 0; j < nv; j++)
+      beta[j] = n_randint(state, ctx->mod.n - 1) + 1;
+
+   _nmod_mpoly_monomial_values(valA, evA, A, beta, nv, v, ctx);
+   _nmod_mpoly_monomial_values(valB, evB, B, beta, nv, v, ctx);
+   for (i = 0; i < A->length; i++)
+      valA[A->length + i] = 1;
+   for (i = 0; i < B->length; i++)
+      valB[B->length + i] = 1;
+
+   nmod_poly_init_preinv(a, ctx->mod.n, ctx->mod.ninv);
+   nmod_poly_init_preinv(b, ctx->mod.n, ctx->mod.ninv);
+   nmod_poly_init_preinv(g, ctx->mod.n, ctx->mod.ninv);
+
+   _nmod_mpoly_eval_step(a, valA + A->length, valA, evA, A, ctx->mod);
+   _nmod_mpoly_eval_step(b, valB + B->length, valB, evB, B, ctx->mod);
+
+   if (nmod_poly_degree(a) == nmod_mpoly_degree(A, v, ctx)
+    && nmod_poly_degree(b) == nmod_mpoly_degree(B, v, ctx))
+   {
+      nmod_poly_gcd(g, a, b);
+
+      if (nmod_poly_degree(g) == degs[v])
+      {
+         for (i = 0; i < degs[v] && g->coeffs[i] == 0; i++) ;
+
+         if (i == degs[v])
+         {
+            nmod_mpoly_fit_length(G, 1, ctx);
+            nmod_mpoly_fit_bits(G, S->bits, ctx);
+            G->bits = S->bits;
+            mpoly_monomial_set(G->exps, S->exps, N);
+            G->coeffs[0] = 1;
+            _nmod_mpoly_set_length(G, 1, ctx);
+            ret = 1;
+         }
+      }
+   }
+
+   nmod_poly_clear(a);
+   nmod_poly_clear(b);
+   nmod_poly_clear(g);
+
+   TMP_END;
+
+   return ret;
+}
+
+/*
+   Use the support of S as the support of the monic gcd G of A and B in
+   the variables x_0, ..., x_{nv-1} of a lex context and recover G from
+   monic univariate images in the main variable x_v at the points beta^j.
+
+   The terms of S are grouped by their exponent in x_v. The image at
+   beta^j is G(beta^j) divided by the value L_j of the leading coefficient
+   of G in x_v. Thus the first images determine the coefficients of each
+   group, via a transposed Vandermonde system, as linear functions of the
+   coefficients of the leading group, and the remaining images give a
+   homogeneous linear system for the latter. If the leading coefficient is
+   a single term this system is trivial.
+
+   Return 1 on success and 0 if the images do not fit the skeleton. Return
+   -1 if the system does not have a one dimensional solution space, which
+   happens when G has a factor not involving x_v.
+*/
+static int _nmod_mpoly_gcd_zippel_var(nmod_mpoly_t G, const nmod_mpoly_t A,
+                 const nmod_mpoly_t B, const nmod_mpoly_t S, slong nv,
+       slong v, const slong * degs, flint_rand_t state, const nmod_mpoly_ctx_t ctx)
+{
+   slong i, j, l, e, n, T, J, sL, ng, N, degS, degA, degB, row, rows;
+   slong * cnt, * start, * order;
+   ulong * evS, * evA, * evB;
+   mp_limb_t * beta, * valS, * valA, * valB, * curA, * curB;
+   mp_limb_t * y, * vl, * z, * cv, * w, * pw, * pL, t;
+   int ret = 0, tries;
+   nmod_poly_t a, b, g;
+   nmod_mat_t M, X;
+   nmod_t mod = ctx->mod;
+   TMP_INIT;
+
+   TMP_START;
+
+   N = words_per_exp(ctx->n, S->bits);
+   degS = degs[v];
+   degA = nmod_mpoly_degree(A, v, ctx);
+   degB = nmod_mpoly_degree(B, v, ctx);
+
+   evS = (ulong *) TMP_ALLOC(S->length*sizeof(ulong));
+   valS = (mp_limb_t *) TMP_ALLOC(S->length*sizeof(mp_limb_t));
+   beta = (mp_limb_t *) TMP_ALLOC(ctx->n*sizeof(mp_limb_t));
+   for (j = 0; j < ctx->n; j++)
+      beta[j] = 1;
+
+   /* group the terms of S by their exponent in x_v */
+   _nmod_mpoly_monomial_values(valS, evS, S, beta, nv, v, ctx);
+
+   cnt = (slong *) TMP_ALLOC((degS + 1)*sizeof(slong));
+   for (l = 0; l <= degS; l++)
+      cnt[l] = 0;
+   for (i = 0; i < S->length; i++)
+      cnt[evS[i]]++;
+
+   sL = cnt[degS];
+   for (T = 0, l = 0; l < degS; l++)
+      T = FLINT_MAX(T, cnt[l]);
+
+   start = (slong *) TMP_ALLOC((degS + 2)*sizeof(slong));
+   order = (slong *) TMP_ALLOC(S->length*sizeof(slong));
+
+   start[0] = 0;
+   for (l = 0; l <= degS; l++)
+      start[l + 1] = start[l] + cnt[l];
+   for (l = 0; l <= degS; l++)
+      cnt[l] = start[l];
+   for (i = 0; i < S->length; i++)
+      order[cnt[evS[i]]++] = i;
+
+   /* enough images for at least sL equations for the leading group */
+   for (ng = 0, e = 0; e < degS; e++)
+      ng += start[e + 1] > start[e];
+   J = FLINT_MAX(T, (S->length + ng - 1)/ng);
+   rows = ng*J - (S->length - sL);
+
+   evA = (ulong *) flint_malloc(A->length*sizeof(ulong));
+   evB = (ulong *) flint_malloc(B->length*sizeof(ulong));
+   valA = (mp_limb_t *) flint_malloc(2*A->length*sizeof(mp_limb_t));
+   valB = (mp_limb_t *) flint_malloc(2*B->length*sizeof(mp_limb_t));
+   curA = valA + A->length;
+   curB = valB + B->length;
+   y = (mp_limb_t *) flint_malloc((degS + 1)*J*sizeof(mp_limb_t));
+   vl = (mp_limb_t *) flint_malloc(S->length*sizeof(mp_limb_t));
+   z = (mp_limb_t *) flint_malloc(S->length*sL*sizeof(mp_limb_t));
+   cv = (mp_limb_t *) flint_malloc((S->length + 3*T + 1)*sizeof(mp_limb_t));
+   w = cv + S->length;
+   pw = w + 2*T + 1;
+   pL = (mp_limb_t *) flint_malloc(sL*sizeof(mp_limb_t));
+
+   nmod_poly_init_preinv(a, mod.n, mod.ninv);
+   nmod_poly_init_preinv(b, mod.n, mod.ninv);
+   nmod_poly_init_preinv(g, mod.n, mod.ninv);
+   nmod_mat_init(M, rows, sL, mod.n);
+   nmod_mat_init(X, sL, sL, mod.n);
+
+   for (tries = 0; tries < 2 && ret == 0; tries++)
+   {
+      for (j = 0; j < nv; j++)
+         beta[j] = n_randint(state, mod.n - 1) + 1;
+
+      _nmod_mpoly_monomial_values(valS, evS, S, beta, nv, v, ctx);
+      for (i = 0; i < S->length; i++)
+         vl[i] = valS[order[i]];
+
+      _nmod_mpoly_monomial_values(valA, evA, A, beta, nv, v, ctx);
+      _nmod_mpoly_monomial_values(valB, evB, B, beta, nv, v, ctx);
+      for (i = 0; i < A->length; i++)
+         curA[i] = 1;
+      for (i = 0; i < B->length; i++)
+         curB[i] = 1;
+
+      /* monic images at beta^j for j = 1, ..., J */
+      for (j = 1; j <= J; j++)
+      {
+         _nmod_mpoly_eval_step(a, curA, valA, evA, A, mod);
+         _nmod_mpoly_eval_step(b, curB, valB, evB, B, mod);
+
+         if (nmod_poly_degree(a) != degA || nmod_poly_degree(b) != degB)
+            goto next_try;
+
+         nmod_poly_gcd(g, a, b);
+
+         /* wrong skeleton or unlucky point */
+         if (nmod_poly_degree(g) != degS)
+            goto next_try;
+
+         for (e = 0; e <= degS; e++)
+         {
+            y[e*J + j - 1] = nmod_poly_get_coeff_ui(g, e);
+
+            if (start[e + 1] == start[e] && y[e*J + j - 1] != 0)
+               goto next_try;
+         }
+      }
+
+      /*
+         For each group solve for the coefficients in terms of those of the
+         leading group using the first images, then use the remaining
+         images to give equations for the leading group.
+      */
+      row = 0;
+      for (e = 0; e < degS; e++)
+      {
+         mp_limb_t * ve = vl + start[e];
+
+         n = start[e + 1] - start[e];
+         if (n == 0)
+            continue;
+
+         for (l = 0; l < sL; l++)
+         {
+            for (t = 1, j = 1; j <= n; j++)
+            {
+               t = nmod_mul(t, vl[start[degS] + l], mod);
+               pw[j - 1] = nmod_mul(y[e*J + j - 1], t, mod);
+            }
+
+            if (!_nmod_vandermonde_solve(cv, ve, pw, n, w, mod))
+               goto next_try;
+
+            for (i = 0; i < n; i++)
+               z[(start[e] + i)*sL + l] = cv[i];
+
+            pL[l] = t;
+         }
+
+         for (i = 0; i < n; i++)
+            pw[i] = nmod_pow_ui(ve[i], n, mod);
+
+         for (j = n + 1; j <= J; j++, row++)
+         {
+            for (i = 0; i < n; i++)
+               pw[i] = nmod_mul(pw[i], ve[i], mod);
+
+            for (l = 0; l < sL; l++)
+            {
+               pL[l] = nmod_mul(pL[l], vl[start[degS] + l], mod);
+               t = nmod_neg(nmod_mul(y[e*J + j - 1], pL[l], mod), mod);
+               for (i = 0; i < n; i++)
+                  t = nmod_add(t, nmod_mul(z[(start[e] + i)*sL + l],
+                                                            pw[i], mod), mod);
+               nmod_mat_entry(M, row, l) = t;
+            }
+         }
+      }
+
+      if (nmod_mat_nullspace(X, M) != 1)
+      {
+         ret = -1;
+         break;
+      }
+
+      for (i = 0; i < start[degS]; i++)
+      {
+         t = 0;
+         for (l = 0; l < sL; l++)
+            t = nmod_add(t, nmod_mul(z[i*sL + l],
+                                          nmod_mat_entry(X, l, 0), mod), mod);
+         valS[order[i]] = t;
+      }
+
+      for (l = 0; l < sL; l++)
+         valS[order[start[degS] + l]] = nmod_mat_entry(X, l, 0);
+
+      ret = 1;
+
+next_try:
+      ;
+   }
+
+   if (ret == 1)
+   {
+      nmod_mpoly_fit_length(G, S->length, ctx);
+      nmod_mpoly_fit_bits(G, S->bits, ctx);
+      G->bits = S->bits;
+
+      for (i = l = 0; i < S->length; i++)
+      {
+         if (valS[i] != 0)
+         {
+            mpoly_monomial_set(G->exps + l*N, S->exps + i*N, N);
+            G->coeffs[l] = valS[i];
+            l++;
+         }
+      }
+
+      _nmod_mpoly_set_length(G, l, ctx);
+
+      if (l == 0)
+         ret = 0;
+      else
+         nmod_mpoly_scalar_mul_ui(G, G, n_invmod(G->coeffs[0], mod.n), ctx);
+   }
+
+   nmod_mat_clear(M);
+   nmod_mat_clear(X);
+   nmod_poly_clear(a);
+   nmod_poly_clear(b);
+   nmod_poly_clear(g);
+
+   flint_free(evA);
+   flint_free(evB);
+   flint_free(valA);
+   flint_free(valB);
+   flint_free(y);
+   flint_free(vl);
+   flint_free(z);
+   flint_free(cv);
+   flint_free(pL);
+
+   TMP_END;
+
+   return ret;
+}
+
+/*
+   Use the support of S as the support of the monic gcd G of A and B in
+   the variables x_0, ..., x_{nv-1} of a lex context, trying the main
+   variables in order of the number of terms in the leading coefficient
+   and then the size of the largest group. Return 0 if the skeleton is not
+   usable.
+*/
+int _nmod_mpoly_gcd_zippel_skel(nmod_mpoly_t G, const nmod_mpoly_t A,
+                 const nmod_mpoly_t B, const nmod_mpoly_t S, slong nv,
+                               flint_rand_t state, const nmod_mpoly_ctx_t ctx)
+{
+   slong i, j, l, v, T, bestT, bestL, maxdeg;
+   slong * degs, * cnt, * keyL, * keyT;
+   ulong * evS;
+   mp_limb_t * beta, * valS;
+   int ret = 0;
+   TMP_INIT;
+
+   FLINT_ASSERT(A->bits == S->bits && B->bits == S->bits);
+
+   if (S->length == 0 || A->length == 0 || B->length == 0)
+      return 0;
+
+   if (S->length == 1)
+      return _nmod_mpoly_gcd_zippel_monomial(G, A, B, S, nv, state, ctx);
+
+   TMP_START;
+
+   degs = (slong *) TMP_ALLOC(ctx->n*sizeof(slong));
+   nmod_mpoly_degrees(degs, S, ctx);
+
+   for (maxdeg = 0, j = 0; j < nv; j++)
+      maxdeg = FLINT_MAX(maxdeg, degs[j]);
+
+   evS = (ulong *) TMP_ALLOC(S->length*sizeof(ulong));
+   valS = (mp_limb_t *) TMP_ALLOC(S->length*sizeof(mp_limb_t));
+   beta = (mp_limb_t *) TMP_ALLOC(ctx->n*sizeof(mp_limb_t));
+   cnt = (slong *) TMP_ALLOC((maxdeg + 1)*sizeof(slong));
+   keyL = (slong *) TMP_ALLOC(nv*sizeof(slong));
+   keyT = (slong *) TMP_ALLOC(nv*sizeof(slong));
+   for (j = 0; j < ctx->n; j++)
+      beta[j] = 1;
+
+   /* a variable is usable if some term is not in the leading group */
+   for (j = 0; j < nv; j++)
+   {
+      keyL[j] = -WORD(1);
+
+      if (degs[j] <= 0)
+         continue;
+
+      _nmod_mpoly_monomial_values(valS, evS, S, beta, nv, j, ctx);
+
+      for (l = 0; l <= degs[j]; l++)
+         cnt[l] = 0;
+      for (i = 0; i < S->length; i++)
+         cnt[evS[i]]++;
+
+      for (T = 0, l = 0; l < degs[j]; l++)
+         T = FLINT_MAX(T, cnt[l]);
+
+      if (T == 0)
+         continue;
+
+      keyL[j] = cnt[degs[j]];
+      keyT[j] = T;
+   }
+
+   for (;;)
+   {
+      v = -WORD(1);
+      bestL = bestT = WORD_MAX;
+      for (j = 0; j < nv; j++)
+      {
+         if (keyL[j] >= 0 && (keyL[j] < bestL
+                          || (keyL[j] == bestL && keyT[j] < bestT)))
+         {
+            bestL = keyL[j];
+            bestT = keyT[j];
+            v = j;
+         }
+      }
+
+      if (v < 0)
+         break;
+
+      ret = _nmod_mpoly_gcd_zippel_var(G, A, B, S, nv, v, degs, state, ctx);
+      if (ret >= 0)
+         break;
+
+      ret = 0;
+      keyL[v] = -WORD(1);
+   }
+
+   TMP_END;
+
+   return ret;
+}
+
+int nmod_mpoly_gcd_zippel(nmod_mpoly_t G, const nmod_mpoly_t A,
+                           const nmod_mpoly_t B, const nmod_mpoly_ctx_t ctx)
+{
+   return _nmod_mpoly_gcd_modular(G, A, B, 1, ctx);
+}
@@ -0,0 +1,47 @@
+/*
+    Copyright (C) 2026 agent
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include <gmp.h>
+#include <stdlib.h>
+#include "flint.h"
+#include "nmod_mpoly.h"
+
+void nmod_mpoly_gen(nmod_mpoly_t poly, slong i, const nmod_mpoly_ctx_t ctx)
+{
+    int deg, rev;
+    slong j;
+    ulong * mon;
+    TMP_INIT;
+
+    degrev_from_ord(deg, rev, ctx->ord);
+
+    /* x_i = 0 modulo 1 */
+    if (ctx->mod.n == 1)
+    {
+       nmod_mpoly_zero(poly, ctx);
+       return;
+    }
+
+    nmod_mpoly_fit_length(poly, 1, ctx);
+
+    poly->coeffs[0] = 1;
+
+    TMP_START;
+
+    mon = (ulong *) TMP_ALLOC((ctx->n - deg)*sizeof(ulong));
+    for (j = 0; j < ctx->n - deg; j++)
+       mon[j] = (j == i);
+    mpoly_set_monomial(poly->exps, mon, poly->bits, ctx->n, deg, rev);
+
+    TMP_END;
+
+    _nmod_mpoly_set_length(poly, 1, ctx);
+}
@@ -0,0 +1,46 @@
+/*
+    Copyright (C) 2026 agent
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include <gmp.h>
+#include <stdlib.h>
+#include "flint.h"
+#include "fmpz.h"
+#include "nmod_mpoly.h"
+
+/*
+   Lift poly2 to an fmpz_mpoly with coefficients in [0, n) in the context
+   with the same variables and ordering as ctx.
+*/
+void nmod_mpoly_get_fmpz_mpoly(fmpz_mpoly_t poly1, const nmod_mpoly_t poly2,
+                                                    const nmod_mpoly_ctx_t ctx)
+{
+   slong i, N;
+   int deg, rev;
+   fmpz_mpoly_ctx_t zctx;
+
+   degrev_from_ord(deg, rev, ctx->ord);
+   fmpz_mpoly_ctx_init(zctx, ctx->n - deg, ctx->ord);
+
+   N = words_per_exp(ctx->n, poly2->bits);
+
+   fmpz_mpoly_fit_length(poly1, poly2->length, zctx);
+   fmpz_mpoly_fit_bits(poly1, poly2->bits, zctx);
+   poly1->bits = poly2->bits;
+
+   for (i = 0; i < poly2->length; i++)
+      fmpz_set_ui(poly1->coeffs + i, poly2->coeffs[i]);
+
+   mpoly_monomial_set(poly1->exps, poly2->exps, N*poly2->length);
+
+   _fmpz_mpoly_set_length(poly1, poly2->length, zctx);
+
+   fmpz_mpoly_ctx_clear(zctx);
+}
@@ -0,0 +1,687 @@
+/*
+    Copyright (C) 2026 agent
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include <gmp.h>
+#include <stdlib.h>
+#include "flint.h"
+#include "nmod_vec.h"
+#include "nmod_mpoly.h"
+
+/* improve locality */
+#define BLOCK 128
+#define MAX_ARRAY_SIZE (WORD(300000))
+
+/*
+   Addmul into a dense array poly1, given polys with reduced coefficients,
+   and exponents tightly packed with mixed bases equal to the largest
+   exponent for each variable, e.g. the input polys have exponents of the
+   form a_0 + a_1*b1 + a_2*b_2*b_2 + .... where b_0, b_1, b_2, etc, are
+   the bases, which are equal to the largest possible exponent for each of
+   the respective variables in the exponent. These exponents are use as
+   array indices in the output polynomial. The unreduced sums of products
+   are assumed to fit into one word per coefficient. The input polynomials
+   are broken into blocks to improve cache efficiency.
+*/
+void _nmod_mpoly_addmul_array1_ulong1(ulong * poly1,
+                 const mp_limb_t * poly2, const ulong * exp2, slong len2,
+                       const mp_limb_t * poly3, const ulong * exp3, slong len3)
+{
+   slong ii, i, jj, j;
+   ulong * c2;
+
+   for (ii = 0; ii < len2 + BLOCK; ii += BLOCK)
+   {
+      for (jj = 0; jj < len3 + BLOCK; jj += BLOCK)
+      {
+         for (i = ii; i < FLINT_MIN(ii + BLOCK, len2); i++)
+         {
+            c2 = poly1 + (slong) exp2[i];
+
+            for (j = jj; j < FLINT_MIN(jj + BLOCK, len3); j++)
+               c2[(slong) exp3[j]] += poly2[i]*poly3[j];
+         }
+      }
+   }
+}
+
+/*
+   As above, but the unreduced sums of products are assumed to fit into
+   two words per coefficient.
+*/
+void _nmod_mpoly_addmul_array1_ulong2(ulong * poly1,
+                 const mp_limb_t * poly2, const ulong * exp2, slong len2,
+                       const mp_limb_t * poly3, const ulong * exp3, slong len3)
+{
+   slong ii, i, jj, j;
+   ulong p[2]; /* for products of coefficients */
+   ulong * c2, * c;
+
+   for (ii = 0; ii < len2 + BLOCK; ii += BLOCK)
+   {
+      for (jj = 0; jj < len3 + BLOCK; jj += BLOCK)
+      {
+         for (i = ii; i < FLINT_MIN(ii + BLOCK, len2); i++)
+         {
+            c2 = poly1 + 2*((slong) exp2[i]);
+
+            for (j = jj; j < FLINT_MIN(jj + BLOCK, len3); j++)
+            {
+               c = c2 + 2*((slong) exp3[j]);
+
+               umul_ppmm(p[1], p[0], poly2[i], poly3[j]);
+               add_ssaaaa(c[1], c[0], c[1], c[0], p[1], p[0]);
+            }
+         }
+      }
+   }
+}
+
+/*
+   As above, but the unreduced sums of products are assumed to fit into
+   three words per coefficient.
+*/
+void _nmod_mpoly_addmul_array1_ulong(ulong * poly1,
+                 const mp_limb_t * poly2, const ulong * exp2, slong len2,
+                       const mp_limb_t * poly3, const ulong * exp3, slong len3)
+{
+   slong ii, i, jj, j;
+   ulong p[2]; /* for products of coefficients */
+   ulong * c2, * c;
+
+   for (ii = 0; ii < len2 + BLOCK; ii += BLOCK)
+   {
+      for (jj = 0; jj < len3 + BLOCK; jj += BLOCK)
+      {
+         for (i = ii; i < FLINT_MIN(ii + BLOCK, len2); i++)
+         {
+            c2 = poly1 + 3*((slong) exp2[i]);
+
+            for (j = jj; j < FLINT_MIN(jj + BLOCK, len3); j++)
+            {
+               c = c2 + 3*((slong) exp3[j]);
+
+               umul_ppmm(p[1], p[0], poly2[i], poly3[j]);
+               add_sssaaaaaa(c[2], c[1], c[0], c[2], c[1], c[0],
+                                                       UWORD(0), p[1], p[0]);
+            }
+         }
+      }
+   }
+}
+
+/*
+   Convert a polynomial in dense array format to an nmod_mpoly with
+   the given number of bits per exponent field, reducing the coefficients.
+   This function destroys poly2 and starts writing poly1 at index k. The
+   function may reallocate its output. The array "mults" is a list of
+   bases uses in encoding the array indices from the exponents. The value
+   num is the number of fields in the output exponent vectors, also the
+   number of entries in mults. Exponents are assumed to be packed into a
+   single word. The array, poly2 is assumed to have three words per
+   coefficient.
+*/
+slong _nmod_mpoly_from_ulong_array(mp_limb_t ** poly1, ulong ** exp1,
+                 slong * alloc, ulong * poly2, const slong * mults, slong num,
+                                              slong bits, slong k, nmod_t mod)
+{
+   slong i, j;
+   ulong exp, r;
+   ulong * c;
+   slong * prods;
+   mp_limb_t * p1 = *poly1;
+   ulong * e1 = *exp1;
+   /* exponents take up this many bits */
+   slong shift = bits*(FLINT_BITS/bits - num);
+   TMP_INIT;
+
+   TMP_START;
+
+   prods = (slong *) TMP_ALLOC((num + 1)*sizeof(slong));
+
+   /*
+      compute products 1, b0, b0*b1, b0*b1*b2 ...
+      from list of bases b0, b1, b2, ...
+   */
+   prods[0] = 1;
+   for (i = 1; i <= num; i++)
+     prods[i] = mults[i - 1]*prods[i - 1];
+
+   /* for each coeff in array */
+   for (i = prods[num] - 1; i >= 0; i--)
+   {
+      c = poly2 + i*3;
+
+      /* if coeff is nonzero */
+      if (c[0] != 0 || c[1] != 0 || c[2] != 0)
+      {
+         NMOD_RED3(r, c[2], c[1], c[0], mod);
+
+         if (r == 0)
+            continue;
+
+         _nmod_mpoly_fit_length(&p1, &e1, alloc, k + 1, 1);
+
+         exp = 0;
+
+         /* compute exponent from index */
+         for (j = 0; j < num; j++)
+            exp += (i % prods[j + 1])/prods[j] << bits*j;
+
+         /* shift exponent vector into place */
+         e1[k] = exp << shift;
+
+         /* set coefficient */
+         p1[k] = r;
+
+         k++;
+      }
+   }
+
+   *poly1 = p1;
+   *exp1 = e1;
+
+   TMP_END;
+
+   return k;
+}
+
+/*
+   As above, but the array poly2 is assumed to have two words per
+   coefficient.
+*/
+slong _nmod_mpoly_from_ulong_array2(mp_limb_t ** poly1, ulong ** exp1,
+                 slong * alloc, ulong * poly2, const slong * mults, slong num,
+                                              slong bits, slong k, nmod_t mod)
+{
+   slong i, j;
+   ulong exp, r;
+   ulong * c;
+   slong * prods;
+   mp_limb_t * p1 = *poly1;
+   ulong * e1 = *exp1;
+   /* exponents take up this many bits */
+   slong shift = bits*(FLINT_BITS/bits - num);
+   TMP_INIT;
+
+   TMP_START;
+
+   prods = (slong *) TMP_ALLOC((num + 1)*sizeof(slong));
+
+   /*
+      compute products 1, b0, b0*b1, b0*b1*b2 ...
+      from list of bases b0, b1, b2, ...
+   */
+   prods[0] = 1;
+   for (i = 1; i <= num; i++)
+     prods[i] = mults[i - 1]*prods[i - 1];
+
+   /* for each coeff in array */
+   for (i = prods[num] - 1; i >= 0; i--)
+   {
+      c = poly2 + i*2;
+
+      /* if coeff is nonzero */
+      if (c[0] != 0 || c[1] != 0)
+      {
+         NMOD2_RED2(r, c[1], c[0], mod);
+
+         if (r == 0)
+            continue;
+
+         _nmod_mpoly_fit_length(&p1, &e1, alloc, k + 1, 1);
+
+         exp = 0;
+
+         /* compute exponent from index */
+         for (j = 0; j < num; j++)
+            exp += (i % prods[j + 1])/prods[j] << bits*j;
+
+         /* shift exponent vector into place */
+         e1[k] = exp << shift;
+
+         /* set coefficient */
+         p1[k] = r;
+
+         k++;
+      }
+   }
+
+   *poly1 = p1;
+   *exp1 = e1;
+
+   TMP_END;
+
+   return k;
+}
+
+/*
+   As above, but the array poly2 is assumed to have one word per
+   coefficient.
+*/
+slong _nmod_mpoly_from_ulong_array1(mp_limb_t ** poly1, ulong ** exp1,
+                 slong * alloc, ulong * poly2, const slong * mults, slong num,
+                                              slong bits, slong k, nmod_t mod)
+{
+   slong i, j;
+   ulong exp, r;
+   slong * prods;
+   mp_limb_t * p1 = *poly1;
+   ulong * e1 = *exp1;
+   /* exponents take up this many bits */
+   slong shift = bits*(FLINT_BITS/bits - num);
+   TMP_INIT;
+
+   TMP_START;
+
+   prods = (slong *) TMP_ALLOC((num + 1)*sizeof(slong));
+
+   /*
+      compute products 1, b0, b0*b1, b0*b1*b2 ...
+      from list of bases b0, b1, b2, ...
+   */
+   prods[0] = 1;
+   for (i = 1; i <= num; i++)
+     prods[i] = mults[i - 1]*prods[i - 1];
+
+   /* for each coeff in array */
+   for (i = prods[num] - 1; i >= 0; i--)
+   {
+      /* if coeff is nonzero */
+      if (poly2[i] != 0)
+      {
+         NMOD_RED(r, poly2[i], mod);
+
+         if (r == 0)
+            continue;
+
+         _nmod_mpoly_fit_length(&p1, &e1, alloc, k + 1, 1);
+
+         exp = 0;
+
+         /* compute exponent from index */
+         for (j = 0; j < num; j++)
+            exp += (i % prods[j + 1])/prods[j] << bits*j;
+
+         /* shift exponent vector into place */
+         e1[k] = exp << shift;
+
+         /* set coefficient */
+         p1[k] = r;
+
+         k++;
+      }
+   }
+
+   *poly1 = p1;
+   *exp1 = e1;
+
+   TMP_END;
+
+   return k;
+}
+
+/*
+   Use dense array multiplication to set poly1 to poly2*poly3 in num + 1
+   variables, given a list of multipliers to tightly pack exponents and a
+   number of bits for the fields of the exponents of the result, assuming
+   no aliasing. Classical multiplication in main variable, array
+   multiplication for multivariate coefficients in remaining num variables.
+   The array "mults" is a list of bases to be used in encoding the array
+   indices from the exponents. The function reallocates its output.
+*/
+slong _nmod_mpoly_mul_array_chunked(mp_limb_t ** poly1, ulong ** exp1,
+     slong * alloc, const mp_limb_t * poly2, const ulong * exp2, slong len2,
+                    const mp_limb_t * poly3, const ulong * exp3, slong len3,
+                              slong * mults, slong num, slong bits, nmod_t mod)
+{
+   slong i, j, k = 0, len, l1, l2, l3, prod;
+   slong shift = bits*(FLINT_BITS/bits - 1);
+   slong * i2, * i3, * n2, * n3;
+   ulong * e2, * e3, * p1;
+   int words;
+   TMP_INIT;
+
+   /*
+      compute products 1, b0, b0*b1, b0*b1*b2 ...
+      from list of bases b0, b1, b2, ...
+   */
+   prod = 1;
+   for (i = 0; i < num; i++)
+      prod *= mults[i];
+
+   /* compute lengths of poly2 and poly3 in chunks */
+   l2 = 1 + (slong) (exp2[0] >> shift);
+   l3 = 1 + (slong) (exp3[0] >> shift);
+
+   TMP_START;
+
+   /* compute indices and lengths of coefficients of polys in main variable */
+
+   i2 = (slong *) TMP_ALLOC(l2*sizeof(slong));
+   n2 = (slong *) TMP_ALLOC(l2*sizeof(slong));
+   i3 = (slong *) TMP_ALLOC(l3*sizeof(slong));
+   n3 = (slong *) TMP_ALLOC(l3*sizeof(slong));
+
+   /* compute chunks of the input polys with respect to the main variable */
+   mpoly_main_variable_terms1(i2, n2, exp2, l2, len2, num + 1, num + 1, bits);
+   mpoly_main_variable_terms1(i3, n3, exp3, l3, len3, num + 1, num + 1, bits);
+
+   /* pack input exponents tightly with mixed bases specified by "mults" */
+   e2 = (ulong *) TMP_ALLOC(len2*sizeof(ulong));
+   e3 = (ulong *) TMP_ALLOC(len3*sizeof(ulong));
+
+   mpoly_pack_monomials_tight(e2, exp2, len2, mults, num, 1, bits);
+   mpoly_pack_monomials_tight(e3, exp3, len3, mults, num, 1, bits);
+
+   /*
+      each output coefficient is a sum of at most min(len2, len3) products,
+      whatever the chunks they come from
+   */
+   words = _nmod_mpoly_acc_words(FLINT_MIN(len2, len3), mod);
+
+   /* classical multiplication one output chunk at a time */
+
+   l1 = l2 + l3 - 1; /* length of output in chunks */
+
+   p1 = (ulong *) TMP_ALLOC(words*prod*sizeof(ulong));
+
+   /* for each output chunk */
+   for (i = 0; i < l1; i++)
+   {
+      for (j = 0; j < words*prod; j++)
+         p1[j] = 0;
+
+      /* addmuls for each cross product of chunks */
+      for (j = 0; j < l2 && j <= i; j++)
+      {
+         if (i - j < l3)
+         {
+            if (words == 1)
+               _nmod_mpoly_addmul_array1_ulong1(p1,
+                              poly2 + i2[j], e2 + i2[j], n2[j],
+                              poly3 + i3[i - j], e3 + i3[i - j], n3[i - j]);
+            else if (words == 2)
+               _nmod_mpoly_addmul_array1_ulong2(p1,
+                              poly2 + i2[j], e2 + i2[j], n2[j],
+                              poly3 + i3[i - j], e3 + i3[i - j], n3[i - j]);
+            else
+               _nmod_mpoly_addmul_array1_ulong(p1,
+                              poly2 + i2[j], e2 + i2[j], n2[j],
+                              poly3 + i3[i - j], e3 + i3[i - j], n3[i - j]);
+         }
+      }
+
+      /* convert array to nmod_mpoly */
+      if (words == 1)
+         len = _nmod_mpoly_from_ulong_array1(poly1, exp1, alloc,
+                                            p1, mults, num, bits, k, mod) - k;
+      else if (words == 2)
+         len = _nmod_mpoly_from_ulong_array2(poly1, exp1, alloc,
+                                            p1, mults, num, bits, k, mod) - k;
+      else
+         len = _nmod_mpoly_from_ulong_array(poly1, exp1, alloc,
+                                            p1, mults, num, bits, k, mod) - k;
+
+      /* insert main variable into exponents */
+      for (j = 0; j < len; j++)
+         (*exp1)[k + j] = ((*exp1)[k + j] >> bits) + ((l1 - i - 1) << shift);
+
+      k += len;
+   }
+
+   TMP_END;
+
+   return k;
+}
+
+/*
+   Use array multiplication to set poly1 to poly2*poly3 in num variables, given
+   a list of multipliers to tightly pack exponents and a number of bits for the
+   fields of the exponents of the result, assuming no aliasing. The array "mults"
+   is a list of bases to be used in encoding the array indices from the exponents.
+   The function reallocates its output.
+*/
+slong _nmod_mpoly_mul_array(mp_limb_t ** poly1, ulong ** exp1, slong * alloc,
+                    const mp_limb_t * poly2, const ulong * exp2, slong len2,
+                    const mp_limb_t * poly3, const ulong * exp3, slong len3,
+                              slong * mults, slong num, slong bits, nmod_t mod)
+{
+   slong i;
+   ulong * e2, * e3;
+   slong prod, len;
+   int words;
+   TMP_INIT;
+
+   /*
+      compute products 1, b0, b0*b1, b0*b1*b2 ...
+      from list of bases b0, b1, b2, ...
+   */
+   prod = 1;
+   for (i = 0; i < num; i++)
+      prod *= mults[i];
+
+   /* if array size will be too large, chunk the polynomials */
+   if (prod > MAX_ARRAY_SIZE)
+      return _nmod_mpoly_mul_array_chunked(poly1, exp1, alloc,
+              poly2, exp2, len2, poly3, exp3, len3, mults, num - 1, bits, mod);
+
+   TMP_START;
+
+   /* pack input exponents tightly with mixed bases specified by "mults" */
+
+   e2 = (ulong *) TMP_ALLOC(len2*sizeof(ulong));
+   e3 = (ulong *) TMP_ALLOC(len3*sizeof(ulong));
+
+   mpoly_pack_monomials_tight(e2, exp2, len2, mults, num, 0, bits);
+   mpoly_pack_monomials_tight(e3, exp3, len3, mults, num, 0, bits);
+
+   /* each output coeff is a sum of at most min(len2, len3) products */
+   words = _nmod_mpoly_acc_words(FLINT_MIN(len2, len3), mod);
+
+   if (words == 1) /* output coeffs fit in one word */
+   {
+      ulong * p1 = (ulong *) TMP_ALLOC(prod*sizeof(ulong));
+
+      for (i = 0; i < prod; i++)
+         p1[i] = 0;
+
+      /* array multiplication */
+      _nmod_mpoly_addmul_array1_ulong1(p1, poly2, e2, len2, poly3, e3, len3);
+
+      /* convert to nmod_mpoly */
+      len = _nmod_mpoly_from_ulong_array1(poly1, exp1, alloc,
+                                                 p1, mults, num, bits, 0, mod);
+   } else if (words == 2) /* output coeffs in two words */
+   {
+      ulong * p1 = (ulong *) TMP_ALLOC(2*prod*sizeof(ulong));
+
+      for (i = 0; i < 2*prod; i++)
+         p1[i] = 0;
+
+      /* array multiplication */
+      _nmod_mpoly_addmul_array1_ulong2(p1, poly2, e2, len2, poly3, e3, len3);
+
+      /* convert to nmod_mpoly */
+      len = _nmod_mpoly_from_ulong_array2(poly1, exp1, alloc,
+                                                 p1, mults, num, bits, 0, mod);
+   } else /* three words per output coeff */
+   {
+      ulong * p1 = (ulong *) TMP_ALLOC(3*prod*sizeof(ulong));
+
+      for (i = 0; i < 3*prod; i++)
+         p1[i] = 0;
+
+      /* array multiplication */
+      _nmod_mpoly_addmul_array1_ulong(p1, poly2, e2, len2, poly3, e3, len3);
+
+      /* convert to nmod_mpoly */
+      len = _nmod_mpoly_from_ulong_array(poly1, exp1, alloc,
+                                                 p1, mults, num, bits, 0, mod);
+   }
+
+   TMP_END;
+
+   return len;
+}
+
+int nmod_mpoly_mul_array(nmod_mpoly_t poly1, const nmod_mpoly_t poly2,
+                          const nmod_mpoly_t poly3, const nmod_mpoly_ctx_t ctx)
+{
+   slong i, bits, exp_bits, N, len = 0, array_size;
+   ulong * max_degs2;
+   ulong * max_degs3;
+   ulong max2 = 0, max3 = 0, max;
+   ulong * exp2 = poly2->exps, * exp3 = poly3->exps;
+   int free2 = 0, free3 = 0;
+   int res = 1;
+
+   TMP_INIT;
+
+   /* input poly is zero */
+   if (poly2->length == 0 || poly3->length == 0)
+   {
+      nmod_mpoly_zero(poly1, ctx);
+
+      return 1;
+   }
+
+   TMP_START;
+
+   /* compute maximum exponents for each variable */
+   max_degs2 = (ulong *) TMP_ALLOC(ctx->n*sizeof(ulong));
+   max_degs3 = (ulong *) TMP_ALLOC(ctx->n*sizeof(ulong));
+
+   mpoly_max_degrees(max_degs2, poly2->exps, poly2->length, poly2->bits, ctx->n);
+   mpoly_max_degrees(max_degs3, poly3->exps, poly3->length, poly3->bits, ctx->n);
+
+   for (i = 0; i < ctx->n; i++)
+   {
+      if (max_degs2[i] > max2)
+         max2 = max_degs2[i];
+
+      if (max_degs3[i] > max3)
+         max3 = max_degs3[i];
+   }
+
+   /* check that exponents won't overflow a word */
+   max = max2 + max3;
+   if (max < max2 || 0 > (slong) max)
+      flint_throw(FLINT_EXPOF, "Exponent overflow in nmod_mpoly_mul_array");
+
+   /* compute number of bits required for output exponents */
+   bits = FLINT_BIT_COUNT(max);
+
+   exp_bits = 8;
+   while (bits >= exp_bits)
+      exp_bits += 1;
+
+   exp_bits = FLINT_MAX(exp_bits, poly2->bits);
+   exp_bits = FLINT_MAX(exp_bits, poly3->bits);
+
+   /* number of words for exponents */
+   N = words_per_exp(ctx->n, exp_bits);
+
+   /* array multiplication expects each exponent vector in one word */
+   /* current code is wrong for reversed orderings */
+   if (N != 1 || mpoly_ordering_isrev(ctx->ord))
+   {
+      res = 0;
+      goto cleanup;
+   }
+
+   /* compute bounds on output exps, used as mixed bases for packing exps */
+   array_size = 1;
+   for (i = 0; i < ctx->n - 1; i++)
+   {
+      max_degs2[i] += max_degs3[i] + 1;
+      array_size *= max_degs2[i];
+   }
+   max_degs2[ctx->n - 1] += max_degs3[ctx->n - 1] + 1;
+
+   /* if exponents too large for array multiplication, exit silently */
+   if (array_size > MAX_ARRAY_SIZE)
+   {
+      res = 0;
+      goto cleanup;
+   }
+
+   /* expand input exponents to same number of bits as output */
+   if (exp_bits > poly2->bits)
+   {
+      free2 = 1;
+      exp2 = (ulong *) flint_malloc(N*poly2->length*sizeof(ulong));
+      mpoly_unpack_monomials(exp2, exp_bits, poly2->exps, poly2->bits,
+                                                        poly2->length, ctx->n);
+   }
+
+   if (exp_bits > poly3->bits)
+   {
+      free3 = 1;
+      exp3 = (ulong *) flint_malloc(N*poly3->length*sizeof(ulong));
+      mpoly_unpack_monomials(exp3, exp_bits, poly3->exps, poly3->bits,
+                                                        poly3->length, ctx->n);
+   }
+
+   /* handle aliasing and do array multiplication */
+   if (poly1 == poly2 || poly1 == poly3)
+   {
+      nmod_mpoly_t temp;
+
+      nmod_mpoly_init2(temp, poly2->length + poly3->length - 1, ctx);
+      nmod_mpoly_fit_bits(temp, exp_bits, ctx);
+      temp->bits = exp_bits;
+
+      if (poly2->length >= poly3->length)
+         len = _nmod_mpoly_mul_array(&temp->coeffs, &temp->exps, &temp->alloc,
+                                           poly3->coeffs, exp3, poly3->length,
+                                           poly2->coeffs, exp2, poly2->length,
+                              (slong *) max_degs2, ctx->n, exp_bits, ctx->mod);
+      else
+         len = _nmod_mpoly_mul_array(&temp->coeffs, &temp->exps, &temp->alloc,
+                                           poly2->coeffs, exp2, poly2->length,
+                                           poly3->coeffs, exp3, poly3->length,
+                              (slong *) max_degs2, ctx->n, exp_bits, ctx->mod);
+
+      nmod_mpoly_swap(temp, poly1, ctx);
+
+      nmod_mpoly_clear(temp, ctx);
+   } else
+   {
+      nmod_mpoly_fit_length(poly1, poly2->length + poly3->length - 1, ctx);
+      nmod_mpoly_fit_bits(poly1, exp_bits, ctx);
+      poly1->bits = exp_bits;
+
+      if (poly2->length >= poly3->length)
+         len = _nmod_mpoly_mul_array(&poly1->coeffs, &poly1->exps, &poly1->alloc,
+                                            poly3->coeffs, exp3, poly3->length,
+                                            poly2->coeffs, exp2, poly2->length,
+                              (slong *) max_degs2, ctx->n, exp_bits, ctx->mod);
+      else
+         len = _nmod_mpoly_mul_array(&poly1->coeffs, &poly1->exps, &poly1->alloc,
+                                            poly2->coeffs, exp2, poly2->length,
+                                            poly3->coeffs, exp3, poly3->length,
+                              (slong *) max_degs2, ctx->n, exp_bits, ctx->mod);
+   }
+
+   _nmod_mpoly_set_length(poly1, len, ctx);
+
+   if (free2)
+      flint_free(exp2);
+
+   if (free3)
+      flint_free(exp3);
+
+cleanup:
+
+   TMP_END;
+
+   return res;
+}
@@ -0,0 +1,65 @@
+/*
+    Copyright (C) 2026 agent
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include <gmp.h>
+#include <stdlib.h>
+#include "flint.h"
+#include "nmod_vec.h"
+#include "nmod_mpoly.h"
+
+/*
+   Set poly1 to c*poly2 and return its length, where c is reduced. Terms
+   are dropped when the modulus is composite and the product is zero.
+*/
+slong _nmod_mpoly_scalar_mul_ui(mp_limb_t * poly1, ulong * exps1,
+                     const mp_limb_t * poly2, const ulong * exps2, slong len2,
+                                                  slong N, ulong c, nmod_t mod)
+{
+   slong i, k = 0;
+
+   for (i = 0; i < len2; i++)
+   {
+      poly1[k] = nmod_mul(poly2[i], c, mod);
+
+      if (poly1[k] != 0)
+      {
+         mpoly_monomial_set(exps1 + k*N, exps2 + i*N, N);
+         k++;
+      }
+   }
+
+   return k;
+}
+
+void nmod_mpoly_scalar_mul_ui(nmod_mpoly_t poly1, const nmod_mpoly_t poly2,
+                                          ulong c, const nmod_mpoly_ctx_t ctx)
+{
+   slong N, len;
+
+   NMOD_RED(c, c, ctx->mod);
+
+   if (c == 0)
+   {
+      _nmod_mpoly_set_length(poly1, 0, ctx);
+      return;
+   }
+
+   N = words_per_exp(ctx->n, poly2->bits);
+
+   nmod_mpoly_fit_length(poly1, poly2->length, ctx);
+   nmod_mpoly_fit_bits(poly1, poly2->bits, ctx);
+
+   len = _nmod_mpoly_scalar_mul_ui(poly1->coeffs, poly1->exps,
+                   poly2->coeffs, poly2->exps, poly2->length, N, c, ctx->mod);
+
+   _nmod_mpoly_set_length(poly1, len, ctx);
+   poly1->bits = poly2->bits;
+}
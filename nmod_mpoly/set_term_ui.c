@@ -0,0 +1,88 @@
+/*
+    Copyright (C) 2026 agent
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include <gmp.h>
+#include <stdlib.h>
+#include "flint.h"
+#include "nmod_vec.h"
+#include "nmod_mpoly.h"
+
+void nmod_mpoly_set_term_ui(nmod_mpoly_t poly,
+                        ulong const * exp, ulong c, const nmod_mpoly_ctx_t ctx)
+{
+   slong i, N, index, exp_bits;
+   ulong maskhi, masklo;
+   ulong * packed_exp;
+   int exists, deg, rev;
+
+   TMP_INIT;
+
+   TMP_START;
+
+   NMOD_RED(c, c, ctx->mod);
+
+   degrev_from_ord(deg, rev, ctx->ord);
+
+   /* compute how many bits are required to represent exp */
+   exp_bits = mpoly_exp_bits(exp, ctx->n, deg);
+   if (exp_bits > FLINT_BITS)
+       flint_throw(FLINT_EXPOF, "Exponent overflow in nmod_mpoly_set_term_ui");
+
+   /* reallocate the number of bits of the exponents of the polynomial */
+   exp_bits = mpoly_optimize_bits(exp_bits, ctx->n);
+   nmod_mpoly_fit_bits(poly, exp_bits, ctx);
+
+   masks_from_bits_ord(maskhi, masklo, poly->bits, ctx->ord);
+   N = words_per_exp(ctx->n, poly->bits);
+
+   packed_exp = (ulong *) TMP_ALLOC(N*sizeof(ulong));
+
+   /* pack exponent vector */
+   mpoly_set_monomial(packed_exp, exp, poly->bits, ctx->n, deg, rev);
+
+   /* work out at what index term should be placed */
+   exists = mpoly_monomial_exists(&index, poly->exps,
+                                  packed_exp, poly->length, N, maskhi, masklo);
+
+   if (!exists) /* term with that exponent doesn't exist */
+   {
+      if (c != 0) /* only set if coeff is nonzero */
+      {
+         nmod_mpoly_fit_length(poly, poly->length + 1, ctx);
+
+         /* shift coeffs and exps by one to make space */
+         for (i = poly->length; i >= index + 1; i--)
+         {
+            poly->coeffs[i] = poly->coeffs[i - 1];
+            mpoly_monomial_set(poly->exps + N*i, poly->exps + N*(i - 1), N);
+         }
+
+         /* set exponent and coeff */
+         mpoly_monomial_set(poly->exps + N*index, packed_exp, N);
+         poly->coeffs[index] = c;
+
+         poly->length++;
+      }
+   } else if (c == 0) /* zero coeff, remove term */
+   {
+      /* shift coeffs and exps by one to fill the gap */
+      for (i = index; i < poly->length - 1; i++)
+      {
+         poly->coeffs[i] = poly->coeffs[i + 1];
+         mpoly_monomial_set(poly->exps + N*i, poly->exps + N*(i + 1), N);
+      }
+
+      _nmod_mpoly_set_length(poly, poly->length - 1, ctx);
+   } else /* term with that monomial exists, coeff is nonzero */
+      poly->coeffs[index] = c;
+
+   TMP_END;
+}
@@ -0,0 +1,101 @@
+/*
+    Copyright (C) 2026 agent
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <gmp.h>
+#include "flint.h"
+#include "nmod_mpoly.h"
+#include "ulong_extras.h"
+
+int
+main(void)
+{
+    int i, j, result;
+    FLINT_TEST_INIT(state);
+
+    flint_printf("add_sub....");
+    fflush(stdout);
+
+    /* Check (f + g) - g = f, with and without aliasing */
+    for (i = 0; i < 10 * flint_test_multiplier(); i++)
+    {
+       nmod_mpoly_ctx_t ctx;
+       nmod_mpoly_t f, g, h, k;
+       ordering_t ord;
+       mp_limb_t modulus;
+       slong nvars, len1, len2, exp_bound;
+
+       ord = mpoly_ordering_randtest(state);
+       nvars = n_randint(state, 10) + 1;
+       modulus = n_randtest_not_zero(state);
+
+       nmod_mpoly_ctx_init(ctx, nvars, ord, modulus);
+
+       nmod_mpoly_init(f, ctx);
+       nmod_mpoly_init(g, ctx);
+       nmod_mpoly_init(h, ctx);
+       nmod_mpoly_init(k, ctx);
+
+       len1 = n_randint(state, 100);
+       len2 = n_randint(state, 100);
+
+       exp_bound = n_randbits(state, n_randint(state, FLINT_BITS/2 - 2) + 1);
+
+       for (j = 0; j < 4; j++)
+       {
+          nmod_mpoly_randtest(f, state, len1, exp_bound, ctx);
+          nmod_mpoly_randtest(g, state, len2, exp_bound, ctx);
+
+          nmod_mpoly_add(h, f, g, ctx);
+          nmod_mpoly_test(h, ctx);
+          nmod_mpoly_sub(k, h, g, ctx);
+          nmod_mpoly_test(k, ctx);
+
+          result = nmod_mpoly_equal(f, k, ctx);
+
+          /* aliasing */
+          nmod_mpoly_set(k, f, ctx);
+          nmod_mpoly_add(k, k, g, ctx);
+          result = result && nmod_mpoly_equal(h, k, ctx);
+          nmod_mpoly_sub(k, k, g, ctx);
+          result = result && nmod_mpoly_equal(f, k, ctx);
+
+          /* f - g = -(g - f) */
+          nmod_mpoly_sub(h, f, g, ctx);
+          nmod_mpoly_sub(k, g, f, ctx);
+          nmod_mpoly_neg(k, k, ctx);
+          nmod_mpoly_test(k, ctx);
+          result = result && nmod_mpoly_equal(h, k, ctx);
+
+          if (!result)
+          {
+             flint_printf("FAIL\n");
+             flint_printf("modulus = %wu, nvars = %wd\n", modulus, nvars);
+             nmod_mpoly_print_pretty(f, NULL, ctx); flint_printf("\n\n");
+             nmod_mpoly_print_pretty(g, NULL, ctx); flint_printf("\n\n");
+             nmod_mpoly_print_pretty(h, NULL, ctx); flint_printf("\n\n");
+             nmod_mpoly_print_pretty(k, NULL, ctx); flint_printf("\n\n");
+             flint_abort();
+          }
+       }
+
+       nmod_mpoly_clear(f, ctx);
+       nmod_mpoly_clear(g, ctx);
+       nmod_mpoly_clear(h, ctx);
+       nmod_mpoly_clear(k, ctx);
+    }
+
+    FLINT_TEST_CLEANUP(state);
+
+    flint_printf("PASS\n");
+    return 0;
+}
@@ -0,0 +1,212 @@
+/*
+    Copyright (C) 2026 agent
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <gmp.h>
+#include "flint.h"
+#include "nmod_mpoly.h"
+#include "ulong_extras.h"
+
+typedef int (* gcd_func)(nmod_mpoly_t, const nmod_mpoly_t,
+                                 const nmod_mpoly_t, const nmod_mpoly_ctx_t);
+
+/* each algorithm, with a bound on the variables it is tested with */
+static const gcd_func gcd_funcs[2] =
+    { nmod_mpoly_gcd_brown, nmod_mpoly_gcd_zippel };
+
+static const char * gcd_names[2] = { "gcd_brown", "gcd_zippel" };
+
+static const slong gcd_max_vars[2] = { 4, 8 };
+
+/*
+   check that g is a monic gcd of a and b which is divisible by c, with
+   coprime cofactors, returning 0 if gcd fails
+*/
+int check_gcd(nmod_mpoly_t g, nmod_mpoly_t a, nmod_mpoly_t b,
+                    const nmod_mpoly_t c, int k, const nmod_mpoly_ctx_t ctx)
+{
+    nmod_mpoly_t t, r;
+
+    if (!gcd_funcs[k](g, a, b, ctx))
+        return 0;
+
+    nmod_mpoly_test(g, ctx);
+
+    if (nmod_mpoly_is_zero(g, ctx))
+    {
+        if (!nmod_mpoly_is_zero(a, ctx) || !nmod_mpoly_is_zero(b, ctx))
+        {
+            flint_printf("FAIL\n%s is zero but both inputs are not\n",
+                                                                gcd_names[k]);
+            flint_abort();
+        }
+
+        return 1;
+    }
+
+    if (g->coeffs[0] != 1)
+    {
+        flint_printf("FAIL\n%s is not monic\n", gcd_names[k]);
+        flint_abort();
+    }
+
+    nmod_mpoly_init(t, ctx);
+    nmod_mpoly_init(r, ctx);
+
+    nmod_mpoly_divrem_monagan_pearce(t, r, g, c, ctx);
+    if (!nmod_mpoly_is_zero(r, ctx))
+    {
+        flint_printf("FAIL\n%s is not divisible by common factor\n",
+                                                                gcd_names[k]);
+        flint_abort();
+    }
+
+    nmod_mpoly_divrem_monagan_pearce(a, r, a, g, ctx);
+    if (!nmod_mpoly_is_zero(r, ctx))
+    {
+        flint_printf("FAIL\n%s doesn't divide first input\n", gcd_names[k]);
+        flint_abort();
+    }
+
+    nmod_mpoly_divrem_monagan_pearce(b, r, b, g, ctx);
+    if (!nmod_mpoly_is_zero(r, ctx))
+    {
+        flint_printf("FAIL\n%s doesn't divide second input\n", gcd_names[k]);
+        flint_abort();
+    }
+
+    /* small moduli may not have enough evaluation points */
+    if (gcd_funcs[k](t, a, b, ctx) && !nmod_mpoly_is_one(t, ctx))
+    {
+        flint_printf("FAIL\n%s: cofactors are not relatively prime\n",
+                                                                gcd_names[k]);
+        flint_abort();
+    }
+
+    nmod_mpoly_clear(t, ctx);
+    nmod_mpoly_clear(r, ctx);
+
+    return 1;
+}
+
+int
+main(void)
+{
+    int i, j, k;
+    FLINT_TEST_INIT(state);
+
+    flint_printf("gcd....");
+    fflush(stdout);
+
+    /* check gcd(a*c, b*c) is divisible by c and has coprime cofactors */
+    for (k = 0; k < 2; k++)
+    {
+        for (i = 0; i < 50 * flint_test_multiplier(); i++)
+        {
+            nmod_mpoly_ctx_t ctx;
+            nmod_mpoly_t a, b, c, g;
+            ordering_t ord;
+            mp_limb_t modulus;
+            slong nvars, len1, len2, len3;
+            slong exp_bound1, exp_bound2, exp_bound3;
+
+            ord = mpoly_ordering_randtest(state);
+            nvars = n_randint(state, gcd_max_vars[k]) + 1;
+            modulus = n_randtest_prime(state, 0);
+
+            nmod_mpoly_ctx_init(ctx, nvars, ord, modulus);
+
+            nmod_mpoly_init(a, ctx);
+            nmod_mpoly_init(b, ctx);
+            nmod_mpoly_init(c, ctx);
+            nmod_mpoly_init(g, ctx);
+
+            for (j = 0; j < 4; j++)
+            {
+                len1 = n_randint(state, 30);
+                len2 = n_randint(state, 30);
+                len3 = n_randint(state, 20) + 1;
+                exp_bound1 = n_randint(state, 6) + 2;
+                exp_bound2 = n_randint(state, 6) + 2;
+                exp_bound3 = n_randint(state, 6) + 2;
+                nmod_mpoly_randtest(a, state, len1, exp_bound1, ctx);
+                nmod_mpoly_randtest(b, state, len2, exp_bound2, ctx);
+                do {
+                    nmod_mpoly_randtest(c, state, len3, exp_bound3, ctx);
+                } while (c->length == 0);
+
+                nmod_mpoly_mul_johnson(a, a, c, ctx);
+                nmod_mpoly_mul_johnson(b, b, c, ctx);
+
+                check_gcd(g, a, b, c, k, ctx);
+            }
+
+            nmod_mpoly_clear(a, ctx);
+            nmod_mpoly_clear(b, ctx);
+            nmod_mpoly_clear(c, ctx);
+            nmod_mpoly_clear(g, ctx);
+        }
+    }
+
+    /*
+       many variables and cofactors with thousands of terms, which only the
+       sparse algorithm is expected to handle
+    */
+    for (i = 0; i < 2; i++)
+    {
+        nmod_mpoly_ctx_t ctx;
+        nmod_mpoly_t a, b, c, g;
+        ordering_t ord;
+        slong nvars;
+
+        ord = mpoly_ordering_randtest(state);
+        nvars = n_randint(state, 9) + 12;
+
+        nmod_mpoly_ctx_init(ctx, nvars, ord,
+                                       n_randprime(state, FLINT_BITS - 1, 1));
+
+        nmod_mpoly_init(a, ctx);
+        nmod_mpoly_init(b, ctx);
+        nmod_mpoly_init(c, ctx);
+        nmod_mpoly_init(g, ctx);
+
+        do {
+            nmod_mpoly_randtest(c, state, 20, 4, ctx);
+        } while (c->length < 10);
+
+        do {
+            nmod_mpoly_randtest(a, state, 150, 4, ctx);
+            nmod_mpoly_mul_johnson(a, a, c, ctx);
+        } while (a->length < 1000);
+
+        do {
+            nmod_mpoly_randtest(b, state, 150, 4, ctx);
+            nmod_mpoly_mul_johnson(b, b, c, ctx);
+        } while (b->length < 1000);
+
+        if (!check_gcd(g, a, b, c, 1, ctx))
+        {
+            flint_printf("FAIL\ngcd_zippel of %wd variables failed\n", nvars);
+            flint_abort();
+        }
+
+        nmod_mpoly_clear(a, ctx);
+        nmod_mpoly_clear(b, ctx);
+        nmod_mpoly_clear(c, ctx);
+        nmod_mpoly_clear(g, ctx);
+    }
+
+    FLINT_TEST_CLEANUP(state);
+
+    printf("PASS\n");
+    return 0;
+}
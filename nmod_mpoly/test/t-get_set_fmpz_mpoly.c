@@ -0,0 +1,108 @@
+/*
+    Copyright (C) 2026 agent
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <gmp.h>
+#include "flint.h"
+#include "fmpz.h"
+#include "fmpz_mpoly.h"
+#include "nmod_mpoly.h"
+#include "ulong_extras.h"
+
+int
+main(void)
+{
+    int i, j, result;
+    FLINT_TEST_INIT(state);
+
+    flint_printf("get_set_fmpz_mpoly....");
+    fflush(stdout);
+
+    /* Check reduction commutes with addition and the round trip */
+    for (i = 0; i < 10 * flint_test_multiplier(); i++)
+    {
+       fmpz_mpoly_ctx_t zctx;
+       nmod_mpoly_ctx_t ctx;
+       fmpz_mpoly_t f, g, h;
+       nmod_mpoly_t a, b, c;
+       ordering_t ord;
+       mp_limb_t modulus;
+       slong nvars, len1, len2, exp_bound, coeff_bits;
+
+       ord = mpoly_ordering_randtest(state);
+       nvars = n_randint(state, 10) + 1;
+       modulus = n_randtest_not_zero(state);
+
+       fmpz_mpoly_ctx_init(zctx, nvars, ord);
+       nmod_mpoly_ctx_init(ctx, nvars, ord, modulus);
+
+       fmpz_mpoly_init(f, zctx);
+       fmpz_mpoly_init(g, zctx);
+       fmpz_mpoly_init(h, zctx);
+       nmod_mpoly_init(a, ctx);
+       nmod_mpoly_init(b, ctx);
+       nmod_mpoly_init(c, ctx);
+
+       len1 = n_randint(state, 100);
+       len2 = n_randint(state, 100);
+
+       exp_bound = n_randbits(state, n_randint(state, FLINT_BITS/2 - 2) + 1);
+       coeff_bits = n_randint(state, 200);
+
+       for (j = 0; j < 4; j++)
+       {
+          fmpz_mpoly_randtest(f, state, len1, exp_bound, coeff_bits, zctx);
+          fmpz_mpoly_randtest(g, state, len2, exp_bound, coeff_bits, zctx);
+
+          fmpz_mpoly_add(h, f, g, zctx);
+
+          nmod_mpoly_set_fmpz_mpoly(a, f, ctx);
+          nmod_mpoly_set_fmpz_mpoly(b, g, ctx);
+          nmod_mpoly_add(a, a, b, ctx);
+
+          nmod_mpoly_set_fmpz_mpoly(c, h, ctx);
+          nmod_mpoly_test(a, ctx);
+          nmod_mpoly_test(c, ctx);
+
+          result = nmod_mpoly_equal(a, c, ctx);
+
+          /* lift and reduce again */
+          nmod_mpoly_get_fmpz_mpoly(f, a, ctx);
+          fmpz_mpoly_test(f, zctx);
+          nmod_mpoly_set_fmpz_mpoly(b, f, ctx);
+
+          result = result && nmod_mpoly_equal(a, b, ctx);
+
+          if (!result)
+          {
+             flint_printf("FAIL\n");
+             flint_printf("modulus = %wu, nvars = %wd\n", modulus, nvars);
+             nmod_mpoly_print_pretty(a, NULL, ctx); flint_printf("\n\n");
+             nmod_mpoly_print_pretty(b, NULL, ctx); flint_printf("\n\n");
+             nmod_mpoly_print_pretty(c, NULL, ctx); flint_printf("\n\n");
+             flint_abort();
+          }
+       }
+
+       fmpz_mpoly_clear(f, zctx);
+       fmpz_mpoly_clear(g, zctx);
+       fmpz_mpoly_clear(h, zctx);
+       nmod_mpoly_clear(a, ctx);
+       nmod_mpoly_clear(b, ctx);
+       nmod_mpoly_clear(c, ctx);
+    }
+
+    FLINT_TEST_CLEANUP(state);
+
+    flint_printf("PASS\n");
+    return 0;
+}
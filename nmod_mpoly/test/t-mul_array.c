@@ -0,0 +1,99 @@
+/*
+    Copyright (C) 2026 agent
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <gmp.h>
+#include "flint.h"
+#include "nmod_mpoly.h"
+#include "ulong_extras.h"
+
+int
+main(void)
+{
+    int i, j, result, ok1, ok2;
+    FLINT_TEST_INIT(state);
+
+    flint_printf("mul_array....");
+    fflush(stdout);
+
+    /* Check mul_array agrees with mul_johnson */
+    for (i = 0; i < 20 * flint_test_multiplier(); i++)
+    {
+       nmod_mpoly_ctx_t ctx;
+       nmod_mpoly_t f, g, h, k;
+       ordering_t ord;
+       mp_limb_t modulus;
+       slong nvars, len1, len2, exp_bound1, exp_bound2;
+
+       ord = mpoly_ordering_randtest(state);
+       nvars = n_randint(state, 4) + 1;
+       modulus = n_randtest_not_zero(state);
+
+       nmod_mpoly_ctx_init(ctx, nvars, ord, modulus);
+
+       nmod_mpoly_init(f, ctx);
+       nmod_mpoly_init(g, ctx);
+       nmod_mpoly_init(h, ctx);
+       nmod_mpoly_init(k, ctx);
+
+       /* long enough inputs to exercise all accumulator widths */
+       len1 = n_randint(state, 1000);
+       len2 = n_randint(state, 1000);
+
+       /* small enough degrees that the array is used, large enough to chunk */
+       exp_bound1 = n_randint(state, 200/nvars + 2) + 1;
+       exp_bound2 = n_randint(state, 200/nvars + 2) + 1;
+
+       for (j = 0; j < 4; j++)
+       {
+          nmod_mpoly_randtest(f, state, len1, exp_bound1, ctx);
+          nmod_mpoly_randtest(g, state, len2, exp_bound2, ctx);
+
+          nmod_mpoly_mul_johnson(h, f, g, ctx);
+
+          ok1 = nmod_mpoly_mul_array(k, f, g, ctx);
+
+          result = !ok1 || nmod_mpoly_equal(h, k, ctx);
+
+          if (ok1)
+             nmod_mpoly_test(k, ctx);
+
+          /* aliasing */
+          nmod_mpoly_set(k, f, ctx);
+          ok2 = nmod_mpoly_mul_array(k, k, g, ctx);
+
+          result = result && ok1 == ok2 && (!ok2 || nmod_mpoly_equal(h, k, ctx));
+
+          if (!result)
+          {
+             flint_printf("FAIL\n");
+             flint_printf("modulus = %wu, nvars = %wd, ok1 = %d, ok2 = %d\n",
+                                                     modulus, nvars, ok1, ok2);
+             nmod_mpoly_print_pretty(f, NULL, ctx); flint_printf("\n\n");
+             nmod_mpoly_print_pretty(g, NULL, ctx); flint_printf("\n\n");
+             nmod_mpoly_print_pretty(h, NULL, ctx); flint_printf("\n\n");
+             nmod_mpoly_print_pretty(k, NULL, ctx); flint_printf("\n\n");
+             flint_abort();
+          }
+       }
+
+       nmod_mpoly_clear(f, ctx);
+       nmod_mpoly_clear(g, ctx);
+       nmod_mpoly_clear(h, ctx);
+       nmod_mpoly_clear(k, ctx);
+    }
+
+    FLINT_TEST_CLEANUP(state);
+
+    flint_printf("PASS\n");
+    return 0;
+}
@@ -0,0 +1,111 @@
+/*
+    Copyright (C) 2026 agent
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <gmp.h>
+#include "flint.h"
+#include "fmpz.h"
+#include "fmpz_mpoly.h"
+#include "nmod_mpoly.h"
+#include "ulong_extras.h"
+
+int
+main(void)
+{
+    int i, j, result;
+    FLINT_TEST_INIT(state);
+
+    flint_printf("mul_johnson....");
+    fflush(stdout);
+
+    /* Check product agrees with reduction of product over Z */
+    for (i = 0; i < 10 * flint_test_multiplier(); i++)
+    {
+       fmpz_mpoly_ctx_t zctx;
+       nmod_mpoly_ctx_t ctx;
+       fmpz_mpoly_t f, g, h;
+       nmod_mpoly_t a, b, c, d;
+       ordering_t ord;
+       mp_limb_t modulus;
+       slong nvars, len1, len2, exp_bound1, exp_bound2;
+
+       ord = mpoly_ordering_randtest(state);
+       nvars = n_randint(state, 10) + 1;
+       modulus = n_randtest_not_zero(state);
+
+       fmpz_mpoly_ctx_init(zctx, nvars, ord);
+       nmod_mpoly_ctx_init(ctx, nvars, ord, modulus);
+
+       fmpz_mpoly_init(f, zctx);
+       fmpz_mpoly_init(g, zctx);
+       fmpz_mpoly_init(h, zctx);
+       nmod_mpoly_init(a, ctx);
+       nmod_mpoly_init(b, ctx);
+       nmod_mpoly_init(c, ctx);
+       nmod_mpoly_init(d, ctx);
+
+       len1 = n_randint(state, 100);
+       len2 = n_randint(state, 100);
+
+       exp_bound1 = n_randbits(state, n_randint(state, FLINT_BITS/2 - 2) + 1);
+       exp_bound2 = n_randbits(state, n_randint(state, FLINT_BITS/2 - 2) + 1);
+
+       for (j = 0; j < 4; j++)
+       {
+          nmod_mpoly_randtest(a, state, len1, exp_bound1, ctx);
+          nmod_mpoly_randtest(b, state, len2, exp_bound2, ctx);
+
+          nmod_mpoly_mul_johnson(c, a, b, ctx);
+          nmod_mpoly_test(c, ctx);
+
+          nmod_mpoly_get_fmpz_mpoly(f, a, ctx);
+          nmod_mpoly_get_fmpz_mpoly(g, b, ctx);
+          fmpz_mpoly_mul_johnson(h, f, g, zctx);
+          nmod_mpoly_set_fmpz_mpoly(d, h, ctx);
+
+          result = nmod_mpoly_equal(c, d, ctx);
+
+          /* aliasing */
+          nmod_mpoly_set(d, a, ctx);
+          nmod_mpoly_mul_johnson(d, d, b, ctx);
+          result = result && nmod_mpoly_equal(c, d, ctx);
+
+          nmod_mpoly_set(d, b, ctx);
+          nmod_mpoly_mul_johnson(d, a, d, ctx);
+          result = result && nmod_mpoly_equal(c, d, ctx);
+
+          if (!result)
+          {
+             flint_printf("FAIL\n");
+             flint_printf("modulus = %wu, nvars = %wd\n", modulus, nvars);
+             nmod_mpoly_print_pretty(a, NULL, ctx); flint_printf("\n\n");
+             nmod_mpoly_print_pretty(b, NULL, ctx); flint_printf("\n\n");
+             nmod_mpoly_print_pretty(c, NULL, ctx); flint_printf("\n\n");
+             nmod_mpoly_print_pretty(d, NULL, ctx); flint_printf("\n\n");
+             flint_abort();
+          }
+       }
+
+       fmpz_mpoly_clear(f, zctx);
+       fmpz_mpoly_clear(g, zctx);
+       fmpz_mpoly_clear(h, zctx);
+       nmod_mpoly_clear(a, ctx);
+       nmod_mpoly_clear(b, ctx);
+       nmod_mpoly_clear(c, ctx);
+       nmod_mpoly_clear(d, ctx);
+    }
+
+    FLINT_TEST_CLEANUP(state);
+
+    flint_printf("PASS\n");
+    return 0;
+}
@@ -46,6 +46,9 @@
 #define NMOD_POLY_GCD_CUTOFF  340       /* GCD:  Euclidean -> HGCD          */
 #define NMOD_POLY_SMALL_GCD_CUTOFF 200  /* GCD (small n): Euclidean -> HGCD */
 
+#define NMOD_POLY_FFT_MUL_CUTOFF 4096         /* Mul: KS -> nmod_fft        */
+#define NMOD_POLY_SMALL_FFT_MUL_CUTOFF 16384  /* Mul (8 to 15 bit n): same  */
+
 NMOD_POLY_INLINE
 slong NMOD_DIVREM_BC_ITCH(slong lenA, slong lenB, nmod_t mod)
 {
@@ -540,6 +543,9 @@ FLINT_DLL void _nmod_poly_mullow_KS(mp_ptr out, mp_srcptr in1, slong len1,
 FLINT_DLL void nmod_poly_mullow_KS(nmod_poly_t res, const nmod_poly_t poly1, 
                              const nmod_poly_t poly2, mp_bitcnt_t bits, slong n);
 
+FLINT_DLL int _nmod_poly_mul_use_fft(slong len1, slong len2, slong bits,
+                                                                 nmod_t mod);
+
 FLINT_DLL void _nmod_poly_mul(mp_ptr res, mp_srcptr poly1, slong len1, 
                                        mp_srcptr poly2, slong len2, nmod_t mod);
 
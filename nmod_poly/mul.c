@@ -14,6 +14,22 @@
 #include "flint.h"
 #include "nmod_vec.h"
 #include "nmod_poly.h"
+#include "nmod_fft.h"
+
+int _nmod_poly_mul_use_fft(slong len1, slong len2, slong bits, nmod_t mod)
+{
+    slong cutoff;
+
+    if (bits < 8)
+        return 0;
+
+    cutoff = (bits < 16) ? NMOD_POLY_SMALL_FFT_MUL_CUTOFF
+                         : NMOD_POLY_FFT_MUL_CUTOFF;
+
+    return len2 >= cutoff
+        && _nmod_fft_mul_num_primes(len2, mod) != 0
+        && FLINT_CLOG2(len1 + len2 - 1) <= NMOD_FFT_MUL_MAX_DEPTH;
+}
 
 void _nmod_poly_mul(mp_ptr res, mp_srcptr poly1, slong len1, 
                              mp_srcptr poly2, slong len2, nmod_t mod)
@@ -31,6 +47,8 @@ void _nmod_poly_mul(mp_ptr res, mp_srcptr poly1, slong len1,
 
     if (2 * bits + bits2 <= FLINT_BITS && len1 + len2 < 16)
         _nmod_poly_mul_classical(res, poly1, len1, poly2, len2, mod);
+    else if (_nmod_poly_mul_use_fft(len1, len2, bits, mod))
+        _nmod_fft_mul(res, poly1, len1, poly2, len2, len1 + len2 - 1, mod);
     else if (bits * len2 > 2000)
         _nmod_poly_mul_KS4(res, poly1, len1, poly2, len2, mod);
     else if (bits * len2 > 200)
@@ -126,6 +126,39 @@ main(void)
         nmod_poly_clear(d);
     }
 
+    /* Compare with mul_KS4 above the FFT cutoff */
+    for (i = 0; i < 10 * flint_test_multiplier(); i++)
+    {
+        nmod_poly_t a1, a2, b, c;
+        mp_limb_t n = n_randbits(state, 8 + n_randint(state, FLINT_BITS - 7));
+
+        nmod_poly_init(a1, n);
+        nmod_poly_init(a2, n);
+        nmod_poly_init(b, n);
+        nmod_poly_init(c, n);
+        nmod_poly_randtest(b, state,
+                      NMOD_POLY_FFT_MUL_CUTOFF + n_randint(state, 10000));
+        nmod_poly_randtest(c, state,
+                      NMOD_POLY_FFT_MUL_CUTOFF + n_randint(state, 10000));
+
+        nmod_poly_mul(a1, b, c);
+        nmod_poly_mul_KS4(a2, b, c);
+
+        result = (nmod_poly_equal(a1, a2));
+        if (!result)
+        {
+            flint_printf("FAIL (FFT):\n");
+            flint_printf("n = %wu, len1 = %wd, len2 = %wd\n",
+                                                     n, b->length, c->length);
+            abort();
+        }
+
+        nmod_poly_clear(a1);
+        nmod_poly_clear(a2);
+        nmod_poly_clear(b);
+        nmod_poly_clear(c);
+    }
+
     FLINT_TEST_CLEANUP(state);
     
     flint_printf("PASS\n");
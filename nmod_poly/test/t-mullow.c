@@ -59,6 +59,39 @@ main(void)
         nmod_poly_clear(c);
     }
 
+    /* Compare with truncated product above the FFT cutoff */
+    for (i = 0; i < 10 * flint_test_multiplier(); i++)
+    {
+        nmod_poly_t a, b, c;
+        slong trunc;
+        mp_limb_t n = n_randbits(state, 8 + n_randint(state, FLINT_BITS - 7));
+
+        nmod_poly_init(a, n);
+        nmod_poly_init(b, n);
+        nmod_poly_init(c, n);
+        nmod_poly_randtest(b, state,
+                      NMOD_POLY_FFT_MUL_CUTOFF + n_randint(state, 10000));
+        nmod_poly_randtest(c, state,
+                      NMOD_POLY_FFT_MUL_CUTOFF + n_randint(state, 10000));
+        trunc = n_randint(state, b->length + c->length + 100);
+
+        nmod_poly_mullow(a, b, c, trunc);
+        nmod_poly_mul_KS4(b, b, c);
+        nmod_poly_truncate(b, trunc);
+
+        result = (nmod_poly_equal(a, b));
+        if (!result)
+        {
+            flint_printf("FAIL (FFT):\n");
+            flint_printf("n = %wu, trunc = %wd\n", n, trunc);
+            abort();
+        }
+
+        nmod_poly_clear(a);
+        nmod_poly_clear(b);
+        nmod_poly_clear(c);
+    }
+
     FLINT_TEST_CLEANUP(state);
     
     flint_printf("PASS\n");
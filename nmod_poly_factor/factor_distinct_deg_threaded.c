@@ -14,7 +14,6 @@
 #define ulong ulongxx/* interferes with system includes */
 
 #include <math.h>
-#include <pthread.h>
 
 #undef ulong
 
@@ -67,7 +66,6 @@ void nmod_poly_factor_distinct_deg_threaded(nmod_poly_factor_t res,
     slong num_threads = flint_get_num_threads();
     nmod_mat_t * HH;
     double beta;
-    pthread_t *threads;
     nmod_poly_matrix_precompute_arg_t * args1;
     nmod_poly_compose_mod_precomp_preinv_arg_t * args2;
     nmod_poly_interval_poly_arg_t * args3;
@@ -115,7 +113,6 @@ void nmod_poly_factor_distinct_deg_threaded(nmod_poly_factor_t res,
         nmod_poly_init_preinv(scratch[i], poly->mod.n, poly->mod.ninv);
 
     HH      = flint_malloc(sizeof(nmod_mat_t) * (num_threads + 1));
-    threads = flint_malloc(sizeof(pthread_t) * num_threads);
     args1   = flint_malloc(num_threads *
                            sizeof(nmod_poly_matrix_precompute_arg_t));
     args2   = flint_malloc(num_threads *
@@ -233,12 +230,10 @@ void nmod_poly_factor_distinct_deg_threaded(nmod_poly_factor_t res,
                 args1[i].poly1    = *scratch[i];
                 args1[i].poly2    = *v;
                 args1[i].poly2inv = *vinv;
-
-                pthread_create(&threads[i], NULL,
-                            _nmod_poly_precompute_matrix_worker, &args1[i]);
             }
-            for (i = 1; i < c1; i++)
-                pthread_join(threads[i], NULL);
+
+            flint_parallel_do(_nmod_poly_precompute_matrix_worker,
+                    args1 + 1, sizeof(nmod_poly_matrix_precompute_arg_t), c1 - 1);
 
             nmod_poly_rem(tmp, H[num_threads - 1], v);
             for (i = 0; i < c1; i++)
@@ -251,15 +246,13 @@ void nmod_poly_factor_distinct_deg_threaded(nmod_poly_factor_t res,
                 args2[i].poly1    = *tmp;
                 args2[i].poly3    = *v;
                 args2[i].poly3inv = *vinv;
-
-                pthread_create(&threads[i], NULL,
-        _nmod_poly_compose_mod_brent_kung_precomp_preinv_worker, &args2[i]);
             }
+
+            flint_parallel_do(_nmod_poly_compose_mod_brent_kung_precomp_preinv_worker,
+                    args2, sizeof(nmod_poly_compose_mod_precomp_preinv_arg_t), c1);
+
             for (i = 0; i < c1; i++)
-            {
-                pthread_join(threads[i], NULL);
                 _nmod_poly_normalise(H[num_threads + i]);
-            }
 
             for (i = 0; i < c1; i++)
             {
@@ -272,16 +265,13 @@ void nmod_poly_factor_distinct_deg_threaded(nmod_poly_factor_t res,
                 args3[i].res  = *I[num_threads + i];
                 args3[i].v    = *v;
                 args3[i].vinv = *vinv;
-
-                pthread_create(&threads[i], NULL,
-                               _nmod_poly_interval_poly_worker, &args3[i]);
             }
 
+            flint_parallel_do(_nmod_poly_interval_poly_worker,
+                    args3, sizeof(nmod_poly_interval_poly_arg_t), c1);
+
             for (i = 0; i < c1; i++)
-            {
-                pthread_join(threads[i], NULL);
                 _nmod_poly_normalise(I[num_threads + i]);
-            }
 
             nmod_poly_one(II);
 
@@ -339,15 +329,13 @@ void nmod_poly_factor_distinct_deg_threaded(nmod_poly_factor_t res,
                 args2[i].poly1    = *tmp;
                 args2[i].poly3    = *v;
                 args2[i].poly3inv = *vinv;
-
-                pthread_create(&threads[i], NULL,
-        _nmod_poly_compose_mod_brent_kung_precomp_preinv_worker, &args2[i]);
             }
+
+            flint_parallel_do(_nmod_poly_compose_mod_brent_kung_precomp_preinv_worker,
+                    args2, sizeof(nmod_poly_compose_mod_precomp_preinv_arg_t), c2);
+
             for (i = 0; i < c2; i++)
-            {
-                pthread_join(threads[i], NULL);
                 _nmod_poly_normalise(H[j * num_threads + i]);
-            }
 
             for (i = 0; i < c2; i++)
             {
@@ -361,16 +349,13 @@ void nmod_poly_factor_distinct_deg_threaded(nmod_poly_factor_t res,
                 args3[i].res  = *I[j * num_threads + i];
                 args3[i].v    = *v;
                 args3[i].vinv = *vinv;
-
-                pthread_create(&threads[i], NULL,
-                               _nmod_poly_interval_poly_worker, &args3[i]);
             }
 
+            flint_parallel_do(_nmod_poly_interval_poly_worker,
+                    args3, sizeof(nmod_poly_interval_poly_arg_t), c2);
+
             for (i = 0; i < c2; i++)
-            {
-                pthread_join(threads[i], NULL);
                 _nmod_poly_normalise(I[j * num_threads + i]);
-            }
 
             nmod_poly_one(II);
 
@@ -463,5 +448,4 @@ void nmod_poly_factor_distinct_deg_threaded(nmod_poly_factor_t res,
     flint_free(args1);
     flint_free(args2);
     flint_free(args3);
-    flint_free(threads);
 }
@@ -25,10 +25,6 @@
 #include "fmpz_vec.h"
 #include "fmpz_factor.h"
 
-#if HAVE_OPENMP
-#include <omp.h> /* must include flint.h first */
-#endif
-
 #ifdef __cplusplus
  extern "C" {
 #endif
@@ -39,6 +35,10 @@
 
 #define BLOCK_SIZE 65536 /* size of sieving cache block */
 
+#define QS_STORE_VERSION 2 /* version of the binary relation store format */
+
+#define QS_FILTER_EXCESS 64 /* relations kept by filtering beyond extra_rels */
+
 typedef struct prime_t
 {
    mp_limb_t pinv;     /* precomputed inverse */
@@ -65,11 +65,13 @@ typedef struct hash_t   /* entry in hash table */
    mp_limb_t prime;    /* value of prime */
    mp_limb_t next;     /* next prime which have same hash value as 'prime' */
    mp_limb_t count;    /* number of occurrence of 'prime' */
+   mp_limb_t parent;   /* parent of 'prime' in its component of the graph */
 } hash_t;
 
 typedef struct relation_t  /* format for relation */
 {
    mp_limb_t lp;          /* large prime, is 1, if relation is full */
+   mp_limb_t lp2;         /* second large prime, is 1 if there is at most one */
    slong num_factors;     /* number of factors, excluding small factor */
    slong small_primes;   /* number of small factors */
    slong * small;         /* exponent of small factors */
@@ -87,6 +89,14 @@ typedef struct qs_poly_s
    slong * small;     /* exponents of small prime factors in relations */
    fac_t * factor;    /* factors for a relation */
    slong num_factors; /* number of factors found in a relation */
+
+   unsigned char * rels; /* relations found but not yet in the store */
+   slong rels_len;       /* bytes of relations in the buffer */
+   slong rels_alloc;     /* bytes allocated for the buffer */
+   slong num_full;       /* number of full relations in the buffer */
+   mp_limb_t * lp;       /* large primes of partials in the buffer, in pairs */
+   slong num_lp;         /* number of partials in the buffer */
+   slong lp_alloc;       /* space allocated for large primes */
 } qs_poly_s;
 
 typedef qs_poly_s qs_poly_t[1];
@@ -162,20 +172,34 @@ typedef struct qs_s
 #endif
 
    qs_poly_s * poly;         /* poly data per thread */
+   slong num_threads;        /* number of sieving threads */
 
    /***************************************************************************
                        RELATION DATA
    ***************************************************************************/
 
-   FILE * siqs;          /* pointer to file for storing relations */
+   FILE * siqs;          /* relation store of this process */
+   char * fname;         /* path of the store, NULL for a temporary file */
+   char ** merge_fname;  /* read only stores written by other processes */
+   slong num_merge;      /* number of such stores */
+   slong store_rank;     /* this process sieves the A0 with index equal to */
+   slong store_procs;    /* store_rank modulo store_procs */
+
+   fmpz_factor_progress_t progress; /* polled before each A, may cancel */
+   void * progress_arg;  /* passed to progress */
+
+   slong A0_count;       /* index of the current A0 */
+   slong A_done;         /* A values already sieved according to checkpoint */
 
    slong full_relation;  /* number of full relations */
    slong num_cycles;     /* number of possible full relations from partials */
 
-   slong vertices;       /* number of different primes in partials */
-   slong components;     /* equal to 1 */
+   slong vertices;       /* number of different primes in partials, and 1 */
+   slong components;     /* number of connected components of the graph */
    slong edges;          /* total number of partials */
 
+   slong dlp_bits;       /* extra bits allowed for two large primes */
+
    slong table_size;     /* size of table */
    hash_t * table;       /* store 'prime' occurring in partial */
    mp_limb_t * hash_table;  /* to keep track of location of primes in 'table' */
@@ -295,14 +319,41 @@ static const mp_limb_t qsieve_tune[][6] =
 /* number of entries in the tuning table */
 #define QS_TUNE_SIZE (sizeof(qsieve_tune)/(6*sizeof(mp_limb_t)))
 
+/*
+   Tuning parameters { bits, dlp_bits } for the double large prime
+   variation, where dlp_bits is the number of bits by which the sieve
+   threshold is lowered so that values which are smooth apart from two
+   large primes are found, and is 0 if only one large prime is allowed
+*/
+
+static const mp_limb_t qsieve_dlp_tune[][2] =
+{
+   {0,     0},
+   {230,  12},
+   {245,  16}
+};
+
+/* number of entries in the double large prime tuning table */
+#define QS_DLP_TUNE_SIZE (sizeof(qsieve_dlp_tune)/(2*sizeof(mp_limb_t)))
+
 void qsieve_init(qs_t qs_inf, const fmpz_t n);
 
 mp_limb_t qsieve_knuth_schroeppel(qs_t qs_inf);
 
 void qsieve_clear(qs_t qs_inf);
 
+int _qsieve_factor(fmpz_factor_t factors, const fmpz_t n,
+              const char * fname, const char * const * merge, slong num_merge,
+                               fmpz_factor_progress_t progress, void * arg);
+
 void qsieve_factor(fmpz_factor_t factors, const fmpz_t n);
 
+void qsieve_factor_store(fmpz_factor_t factors, const fmpz_t n,
+             const char * fname, const char * const * merge, slong num_merge);
+
+int qsieve_factor_progress(fmpz_factor_t factors, const fmpz_t n,
+                              fmpz_factor_progress_t progress, void * arg);
+
 prime_t * compute_factor_base(mp_limb_t * small_factor, qs_t qs_inf,
                                                              slong num_primes);
 
@@ -354,13 +405,98 @@ slong qsieve_merge_relations(qs_t qs_inf);
 
 slong qsieve_insert_relation(qs_t qs_inf, fmpz_t Y);
 
-void qsieve_write_to_file(qs_t qs_inf, mp_limb_t prime, fmpz_t Y, qs_poly_t poly);
+slong qsieve_store_open(qs_t qs_inf, const char * fname,
+                               const char * const * merge, slong num_merge);
+
+void qsieve_store_reset(qs_t qs_inf);
+
+void qsieve_store_close(qs_t qs_inf);
+
+void qsieve_store_checkpoint(qs_t qs_inf);
+
+void qsieve_store_count_partials(qs_t qs_inf);
+
+FILE * qsieve_store_begin(qs_t qs_inf, slong i, long * pos);
+
+void qsieve_store_end(qs_t qs_inf, slong i, FILE * file, long pos);
+
+int qsieve_store_read(FILE * file, int * tag, unsigned char ** buf,
+                                                   slong * alloc, slong * len);
+
+mp_limb_t qsieve_store_relation_lp(mp_limb_t * lp2,
+                                         const unsigned char * buf, slong len);
+
+void qsieve_write_to_file(qs_t qs_inf, mp_limb_t prime, mp_limb_t prime2,
+                                                    fmpz_t Y, qs_poly_t poly);
+
+void qsieve_store_flush(qs_t qs_inf, qs_poly_t poly);
+
+/* varint encoding of the relation store, 7 bits per byte, low bits first */
+
+static __inline__ slong qsieve_store_put_ui(unsigned char * p, mp_limb_t x)
+{
+   slong n = 0;
+
+   while (x >= 128)
+   {
+      p[n++] = (unsigned char) (x | 128);
+      x >>= 7;
+   }
+
+   p[n++] = (unsigned char) x;
+
+   return n;
+}
+
+/* returns 0 if the encoding runs past end or overflows a limb */
+static __inline__ int qsieve_store_get_ui(mp_limb_t * x,
+                             const unsigned char ** p, const unsigned char * end)
+{
+   mp_limb_t r = 0;
+   int shift = 0;
+
+   while (*p < end && shift < FLINT_BITS)
+   {
+      r |= ((mp_limb_t) (**p & 127)) << shift;
+
+      if ((*((*p)++) & 128) == 0)
+      {
+         *x = r;
+         return 1;
+      }
+
+      shift += 7;
+   }
+
+   return 0;
+}
+
+/* index of the current A, which is A0 times the prime with index q_idx */
+static __inline__ slong qsieve_store_A_index(qs_t qs_inf)
+{
+   return qs_inf->A0_count*qs_inf->ks_primes
+        + qs_inf->q_idx - qs_inf->num_primes;
+}
+
+/* whether this process has A left to sieve with the current A0 */
+static __inline__ int qsieve_store_own_A0(qs_t qs_inf)
+{
+   return (qs_inf->A0_count + 1)*qs_inf->ks_primes > qs_inf->A_done
+       && qs_inf->A0_count % qs_inf->store_procs == qs_inf->store_rank;
+}
 
 hash_t * qsieve_get_table_entry(qs_t qs_inf, mp_limb_t prime);
 
+void qsieve_reset_hashtable(qs_t qs_inf);
+
 void qsieve_add_to_hashtable(qs_t qs_inf, mp_limb_t prime);
 
-relation_t qsieve_parse_relation(qs_t qs_inf, char * str);
+void qsieve_add_edge(qs_t qs_inf, mp_limb_t lp, mp_limb_t lp2);
+
+relation_t qsieve_parse_relation(qs_t qs_inf, const unsigned char * buf,
+                                                                   slong len);
+
+int qsieve_is_relation(qs_t qs_inf, relation_t a);
 
 relation_t qsieve_merge_relation(qs_t qs_inf, relation_t  a, relation_t  b);
 
@@ -373,6 +509,9 @@ void qsieve_insert_relation2(qs_t qs_inf, relation_t * rel_list,
 
 int qsieve_process_relation(qs_t qs_inf);
 
+slong qsieve_filter_relations(qs_t qs_inf, slong * nrows,
+                      relation_t * rel_list, slong num_relations, slong excess);
+
 static __inline__ void insert_col_entry(la_col_t * col, slong entry)
 {
    if (((col->weight >> 4) << 4) == col->weight) /* need more space */
@@ -420,6 +559,9 @@ void reduce_matrix(qs_t qs_inf, slong *nrows, slong *ncols, la_col_t *cols);
 uint64_t * block_lanczos(flint_rand_t state, slong nrows,
 			slong dense_rows, slong ncols, la_col_t *B);
 
+uint64_t * _block_lanczos(flint_rand_t state, slong nrows,
+			slong dense_rows, slong ncols, la_col_t *B, slong W);
+
 void qsieve_square_root(fmpz_t X, fmpz_t Y, qs_t qs_inf,
    uint64_t * nullrows, slong ncols, slong l, fmpz_t N);
 
@@ -177,232 +177,528 @@ void reduce_matrix(qs_t qs_inf, slong *nrows, slong *ncols, la_col_t *cols) {
         *nrows = reduced_rows;
 }
 
+
+/*--------------------------------------------------------------------
+
+   The iteration works on blocks of N = 64*W vectors at once, where W
+   is the number of 64-bit words in each row of a block. A block of n
+   vectors is stored as n rows of W words and an N x N matrix as N rows
+   of W words, row i being the image of the i-th unit vector. Doubling
+   W halves the number of iterations and the number of passes over the
+   matrix entries, and the W words of each row are processed together
+   in tight loops the compiler can vectorise. But the dense products of
+   a block by an N x N matrix cost O(W) per vector, so wide blocks only
+   pay off once the sparse products dominate, i.e. for matrices much
+   larger than those of the quadratic sieve.
+
+--------------------------------------------------------------------*/
+
+typedef struct {
+	slong nrows;
+	slong ncols;
+	slong *row_start;	/* row i has entries row_idx[row_start[i]] */
+	uint32_t *row_idx;	/*   up to row_idx[row_start[i + 1] - 1] */
+	slong *col_start;	/* likewise column i */
+	uint32_t *col_idx;
+} la_mat_t;
+
 /*-------------------------------------------------------------------*/
-static void mul_64x64_64x64(uint64_t *a, uint64_t *b, uint64_t *c ) {
-
-	/* c[][] = x[][] * y[][], where all operands are 64 x 64
-	   (i.e. contain 64 words of 64 bits each). The result
-	   may overwrite a or b. */
-
-	uint64_t ai, bj, accum;
-	uint64_t tmp[64];
-	ulong i, j;
-
-	for (i = 0; i < 64; i++) {
-		j = 0;
-		accum = 0;
-		ai = a[i];
-
-		while (ai) {
-			bj = b[j];
-			if( ai & 1 )
-				accum ^= bj;
-			ai >>= 1;
-			j++;
+static void la_mat_init(la_mat_t *A, slong nrows, slong dense_rows,
+			slong ncols, la_col_t *B) {
+
+	/* Build compressed row and column forms of the nrows x ncols
+	   matrix B. Both B*x and B'*y then become gathers, in which
+	   each row of the output is computed independently from a
+	   contiguous list of indices. The dense rows of B are folded
+	   into the sparse entries */
+
+	slong i, j, k, nnz;
+	slong *pos;
+
+	A->nrows = nrows;
+	A->ncols = ncols;
+	A->col_start = (slong *)flint_malloc((ncols + 1) * sizeof(slong));
+	A->row_start = (slong *)flint_calloc(nrows + 1, sizeof(slong));
+
+	for (i = nnz = 0; i < ncols; i++) {
+		slong *dense = B[i].data + B[i].weight;
+
+		A->col_start[i] = nnz;
+		nnz += B[i].weight;
+		for (j = 0; j < dense_rows; j++) {
+			if (dense[j / 32] & ((slong)1 << (j % 32)))
+				nnz++;
 		}
+	}
+	A->col_start[ncols] = nnz;
+
+	A->col_idx = (uint32_t *)flint_malloc(FLINT_MAX(nnz, 1) * sizeof(uint32_t));
+	A->row_idx = (uint32_t *)flint_malloc(FLINT_MAX(nnz, 1) * sizeof(uint32_t));
+
+	for (i = k = 0; i < ncols; i++) {
+		slong *dense = B[i].data + B[i].weight;
+
+		for (j = 0; j < B[i].weight; j++)
+			A->col_idx[k++] = B[i].data[j];
+		for (j = 0; j < dense_rows; j++) {
+			if (dense[j / 32] & ((slong)1 << (j % 32)))
+				A->col_idx[k++] = j;
+		}
+	}
+
+	/* count the entries of each row and transpose */
+
+	for (k = 0; k < nnz; k++)
+		A->row_start[A->col_idx[k] + 1]++;
+	for (i = 0; i < nrows; i++)
+		A->row_start[i + 1] += A->row_start[i];
+
+	pos = (slong *)flint_malloc(FLINT_MAX(nrows, 1) * sizeof(slong));
+	memcpy(pos, A->row_start, nrows * sizeof(slong));
+
+	for (i = 0; i < ncols; i++) {
+		for (k = A->col_start[i]; k < A->col_start[i + 1]; k++)
+			A->row_idx[pos[A->col_idx[k]]++] = i;
+	}
+
+	flint_free(pos);
+}
+
+/*-------------------------------------------------------------------*/
+static void la_mat_clear(la_mat_t *A) {
+
+	flint_free(A->row_start);
+	flint_free(A->row_idx);
+	flint_free(A->col_start);
+	flint_free(A->col_idx);
+}
+
+/*-------------------------------------------------------------------*/
+static slong la_num_chunks(slong len) {
+
+	/* number of pieces to split len rows into among the threads;
+	   small problems are not worth splitting */
+
+	slong num_threads = flint_get_num_threads();
+
+	if (num_threads <= 1 || len < 2048)
+		return 1;
+
+	return FLINT_MIN(4 * num_threads, len / 512);
+}
+
+typedef struct {
+	const slong *start;
+	const uint32_t *idx;
+	const uint64_t *x;
+	uint64_t *b;
+	slong len;
+	slong W;
+	slong chunks;
+} la_gather_arg_t;
+
+/*-------------------------------------------------------------------*/
+static void la_gather_worker(void *arg_ptr, slong c) {
+
+	/* set chunk c of the rows of b[][] to the sum of
+	   the rows of x[][] listed for them in idx[] */
+
+	la_gather_arg_t *arg = (la_gather_arg_t *) arg_ptr;
+	const slong *start = arg->start;
+	const uint32_t *idx = arg->idx;
+	const uint64_t *x = arg->x;
+	slong W = arg->W;
+	slong i, j, k;
+	slong i0 = (arg->len * c) / arg->chunks;
+	slong i1 = (arg->len * (c + 1)) / arg->chunks;
+
+	if (W == 1) {
+		for (i = i0; i < i1; i++) {
+			uint64_t accum = 0;
+
+			for (j = start[i]; j < start[i + 1]; j++)
+				accum ^= x[idx[j]];
+			arg->b[i] = accum;
+		}
+		return;
+	}
+
+	for (i = i0; i < i1; i++) {
+		uint64_t *bi = arg->b + i * W;
+
+		for (k = 0; k < W; k++)
+			bi[k] = 0;
+
+		for (j = start[i]; j < start[i + 1]; j++) {
+			const uint64_t *xj = x + (slong) idx[j] * W;
+
+			for (k = 0; k < W; k++)
+				bi[k] ^= xj[k];
+		}
+	}
+}
+
+/*-------------------------------------------------------------------*/
+static void la_gather(const slong *start, const uint32_t *idx,
+		const uint64_t *x, uint64_t *b, slong len, slong W) {
+
+	la_gather_arg_t arg;
+
+	arg.start = start;
+	arg.idx = idx;
+	arg.x = x;
+	arg.b = b;
+	arg.len = len;
+	arg.W = W;
+	arg.chunks = la_num_chunks(len);
+
+	flint_parallel_for(0, arg.chunks, 1, la_gather_worker, &arg);
+}
 
-		tmp[i] = accum;
+/*-------------------------------------------------------------------*/
+static void mul_MxN_NxB(la_mat_t *A, uint64_t *x, uint64_t *b, slong W) {
+
+	/* Multiply the block x[][] of ncols rows by the matrix
+	   A and put the result, of nrows rows, in b[][] */
+
+	la_gather(A->row_start, A->row_idx, x, b, A->nrows, W);
+}
+
+/*-------------------------------------------------------------------*/
+static void mul_trans_MxN_NxB(la_mat_t *A, uint64_t *x, uint64_t *b,
+			slong W) {
+
+	/* Multiply the block x[][] of nrows rows by the transpose
+	   of A and put the result, of ncols rows, in b[][] */
+
+	la_gather(A->col_start, A->col_idx, x, b, A->ncols, W);
+}
+
+/*-------------------------------------------------------------------*/
+static void mul_NxN_NxN(slong W, uint64_t *a, uint64_t *b, uint64_t *c) {
+
+	/* c[][] = a[][] * b[][], where all operands are N x N.
+	   The result may overwrite a or b. */
+
+	slong N = 64 * W;
+	slong i, j, k, w;
+	uint64_t ai, *tmp;
+
+	tmp = (uint64_t *)flint_calloc(N * W, sizeof(uint64_t));
+
+	for (i = 0; i < N; i++) {
+		uint64_t *ti = tmp + i * W;
+
+		for (w = 0; w < W; w++) {
+			ai = a[i * W + w];
+			j = 64 * w;
+
+			while (ai) {
+				if (ai & 1) {
+					for (k = 0; k < W; k++)
+						ti[k] ^= b[j * W + k];
+				}
+				ai >>= 1;
+				j++;
+			}
+		}
 	}
-	memcpy(c, tmp, sizeof(tmp));
+
+	memcpy(c, tmp, N * W * sizeof(uint64_t));
+	flint_free(tmp);
 }
 
 /*-----------------------------------------------------------------------*/
-static void precompute_Nx64_64x64(uint64_t *x, uint64_t *c) {
+static void precompute_NxB_NxN(slong W, uint64_t *x, uint64_t *c) {
 
-	/* Let x[][] be a 64 x 64 matrix in GF(2), represented
-	   as 64 words of 64 bits each. Let c[][] be an 8 x 256
-	   matrix of 64-bit words. This code fills c[][] with
-	   a bunch of "partial matrix multiplies". For 0<=i<256,
-	   the j_th row of c[][] contains the matrix product
+	/* Let x[][] be an N x N matrix in GF(2). For each of
+	   the 8*W bytes of a row of a block and 0 <= i < 256,
+	   this fills row j*256 + i of c[][] with the product
 
 	   	( i << (8*j) ) * x[][]
 
-	   where the quantity in parentheses is considered a 
-	   1 x 64 vector of elements in GF(2). The resulting
-	   table can dramatically speed up matrix multiplies
-	   by x[][]. */
-
-	uint64_t accum, xk;
-	ulong i, j, k, index;
-
-	for (j = 0; j < 8; j++) {
-		for (i = 0; i < 256; i++) {
-			k = 0;
-			index = i;
-			accum = 0;
-			while (index) {
-				xk = x[k];
-				if (index & 1)
-					accum ^= xk;
-				index >>= 1;
-				k++;
-			}
-			c[i] = accum;
+	   where the quantity in parentheses is considered a
+	   1 x N vector of elements in GF(2). Each entry is
+	   the sum of an earlier one and a single row of x[][] */
+
+	slong i, j, k, low;
+
+	for (j = 0; j < 8 * W; j++) {
+		uint64_t *cj = c + j * 256 * W;
+		uint64_t *xj = x + 8 * j * W;
+
+		for (k = 0; k < W; k++)
+			cj[k] = 0;
+
+		for (i = 1; i < 256; i++) {
+			uint64_t *prev = cj + (i & (i - 1)) * W;
+
+			for (low = 0; !((i >> low) & 1); low++) ;
+
+			for (k = 0; k < W; k++)
+				cj[i * W + k] = prev[k] ^ xj[low * W + k];
+		}
+	}
+}
+
+typedef struct {
+	const uint64_t *x;
+	const uint64_t *y;
+	uint64_t *c;
+	uint64_t *z;
+	slong n;
+	slong W;
+	slong chunks;
+} la_dense_arg_t;
+
+/*-------------------------------------------------------------------*/
+static void mul_NxB_NxN_worker(void *arg_ptr, slong ch) {
+
+	/* XOR chunk ch of the rows of x[][] * (the matrix
+	   tabulated in c[][]) into z[][] */
+
+	la_dense_arg_t *arg = (la_dense_arg_t *) arg_ptr;
+	const uint64_t *c = arg->c;
+	slong W = arg->W;
+	slong i, j, k, w;
+	slong i0 = (arg->n * ch) / arg->chunks;
+	slong i1 = (arg->n * (ch + 1)) / arg->chunks;
+
+	if (W == 1) {
+		for (i = i0; i < i1; i++) {
+			uint64_t word = arg->x[i];
+			arg->z[i] ^= c[ 0*256 + ((word>> 0) & 0xff) ]
+				   ^ c[ 1*256 + ((word>> 8) & 0xff) ]
+				   ^ c[ 2*256 + ((word>>16) & 0xff) ]
+				   ^ c[ 3*256 + ((word>>24) & 0xff) ]
+				   ^ c[ 4*256 + ((word>>32) & 0xff) ]
+				   ^ c[ 5*256 + ((word>>40) & 0xff) ]
+				   ^ c[ 6*256 + ((word>>48) & 0xff) ]
+				   ^ c[ 7*256 + ((word>>56)       ) ];
 		}
+		return;
+	}
+
+	for (i = i0; i < i1; i++) {
+		uint64_t *zi = arg->z + i * W;
+
+		for (w = 0; w < W; w++) {
+			uint64_t word = arg->x[i * W + w];
 
-		x += 8;
-		c += 256;
+			for (j = 0; j < 8; j++) {
+				const uint64_t *cj = c + ((8 * w + j) * 256
+						+ ((word >> (8 * j)) & 0xff)) * W;
+
+				for (k = 0; k < W; k++)
+					zi[k] ^= cj[k];
+			}
+		}
 	}
 }
 
 /*-------------------------------------------------------------------*/
-static void mul_Nx64_64x64_acc(uint64_t *v, uint64_t *x, uint64_t *c, 
-				uint64_t *y, slong n) {
-
-	/* let v[][] be a n x 64 matrix with elements in GF(2), 
-	   represented as an array of n 64-bit words. Let c[][]
-	   be an 8 x 256 scratch matrix of 64-bit words.
-	   This code multiplies v[][] by the 64x64 matrix 
-	   x[][], then XORs the n x 64 result into y[][] */
-
-    slong i;
-	uint64_t word;
-
-	precompute_Nx64_64x64(x, c);
-
-	for (i = 0; i < n; i++) {
-		word = v[i];
-		y[i] ^=  c[ 0*256 + ((word>> 0) & 0xff) ]
-		       ^ c[ 1*256 + ((word>> 8) & 0xff) ]
-		       ^ c[ 2*256 + ((word>>16) & 0xff) ]
-		       ^ c[ 3*256 + ((word>>24) & 0xff) ]
-		       ^ c[ 4*256 + ((word>>32) & 0xff) ]
-		       ^ c[ 5*256 + ((word>>40) & 0xff) ]
-		       ^ c[ 6*256 + ((word>>48) & 0xff) ]
-		       ^ c[ 7*256 + ((word>>56)       ) ];
+static void mul_NxB_NxN_acc(slong W, uint64_t *v, uint64_t *x,
+			uint64_t *c, uint64_t *y, slong n) {
+
+	/* Let v[][] be an n x N block and x[][] an N x N matrix,
+	   both with elements in GF(2). This code multiplies v[][]
+	   by x[][] and XORs the n x N result into y[][]. c[][] is
+	   a scratch table of 8*W*256 rows */
+
+	la_dense_arg_t arg;
+
+	precompute_NxB_NxN(W, x, c);
+
+	arg.x = v;
+	arg.c = c;
+	arg.z = y;
+	arg.n = n;
+	arg.W = W;
+	arg.chunks = la_num_chunks(n);
+
+	flint_parallel_for(0, arg.chunks, 1, mul_NxB_NxN_worker, &arg);
+}
+
+/*-------------------------------------------------------------------*/
+static void mul_BxN_NxB_worker(void *arg_ptr, slong ch) {
+
+	/* accumulate chunk ch of the rows of y[][] in the
+	   table of chunk ch, indexed by the bytes of x[][] */
+
+	la_dense_arg_t *arg = (la_dense_arg_t *) arg_ptr;
+	slong W = arg->W;
+	slong size = 8 * W * 256 * W;
+	uint64_t *c = arg->c + ch * size;
+	slong i, j, k, w;
+	slong i0 = (arg->n * ch) / arg->chunks;
+	slong i1 = (arg->n * (ch + 1)) / arg->chunks;
+
+	memset(c, 0, size * sizeof(uint64_t));
+
+	if (W == 1) {
+		for (i = i0; i < i1; i++) {
+			uint64_t xi = arg->x[i];
+			uint64_t yi = arg->y[i];
+			c[ 0*256 + ( xi        & 0xff) ] ^= yi;
+			c[ 1*256 + ((xi >>  8) & 0xff) ] ^= yi;
+			c[ 2*256 + ((xi >> 16) & 0xff) ] ^= yi;
+			c[ 3*256 + ((xi >> 24) & 0xff) ] ^= yi;
+			c[ 4*256 + ((xi >> 32) & 0xff) ] ^= yi;
+			c[ 5*256 + ((xi >> 40) & 0xff) ] ^= yi;
+			c[ 6*256 + ((xi >> 48) & 0xff) ] ^= yi;
+			c[ 7*256 + ((xi >> 56)       ) ] ^= yi;
+		}
+		return;
+	}
+
+	for (i = i0; i < i1; i++) {
+		const uint64_t *yi = arg->y + i * W;
+
+		for (w = 0; w < W; w++) {
+			uint64_t word = arg->x[i * W + w];
+
+			for (j = 0; j < 8; j++) {
+				uint64_t *cj = c + ((8 * w + j) * 256
+						+ ((word >> (8 * j)) & 0xff)) * W;
+
+				for (k = 0; k < W; k++)
+					cj[k] ^= yi[k];
+			}
+		}
 	}
 }
 
 /*-------------------------------------------------------------------*/
-static void mul_64xN_Nx64(uint64_t *x, uint64_t *y,
+static void mul_BxN_NxB(slong W, uint64_t *x, uint64_t *y,
 			   uint64_t *c, uint64_t *xy, slong n) {
 
-	/* Let x and y be n x 64 matrices. This routine computes
-	   the 64 x 64 matrix xy[][] given by transpose(x) * y.
-	   c[][] is a 256 x 8 scratch matrix of 64-bit words. */
-
-	slong i;
-
-	memset(c, 0, 256 * 8 * sizeof(uint64_t));
-	memset(xy, 0, 64 * sizeof(uint64_t));
-
-	for (i = 0; i < n; i++) {
-		uint64_t xi = x[i];
-		uint64_t yi = y[i];
-		c[ 0*256 + ( xi        & 0xff) ] ^= yi;
-		c[ 1*256 + ((xi >>  8) & 0xff) ] ^= yi;
-		c[ 2*256 + ((xi >> 16) & 0xff) ] ^= yi;
-		c[ 3*256 + ((xi >> 24) & 0xff) ] ^= yi;
-		c[ 4*256 + ((xi >> 32) & 0xff) ] ^= yi;
-		c[ 5*256 + ((xi >> 40) & 0xff) ] ^= yi;
-		c[ 6*256 + ((xi >> 48) & 0xff) ] ^= yi;
-		c[ 7*256 + ((xi >> 56)       ) ] ^= yi;
+	/* Let x and y be n x N blocks. This routine computes
+	   the N x N matrix xy[][] given by transpose(x) * y.
+	   c[][] is scratch space for one table of 8*W*256 rows
+	   per chunk of x and y */
+
+	la_dense_arg_t arg;
+	slong size = 8 * W * 256 * W;
+	slong i, j, k, b, ch;
+
+	arg.x = x;
+	arg.y = y;
+	arg.c = c;
+	arg.n = n;
+	arg.W = W;
+	arg.chunks = la_num_chunks(n);
+
+	flint_parallel_for(0, arg.chunks, 1, mul_BxN_NxB_worker, &arg);
+
+	for (ch = 1; ch < arg.chunks; ch++) {
+		for (i = 0; i < size; i++)
+			c[i] ^= c[ch * size + i];
 	}
 
+	/* row 8*j + b of xy[][] is the sum of the entries of
+	   table j whose index has bit b set */
 
-	for(i = 0; i < 8; i++) {
+	for (j = 0; j < 8 * W; j++) {
+		for (b = 0; b < 8; b++) {
+			uint64_t *r = xy + (8 * j + b) * W;
 
-		ulong j;
-		uint64_t a0, a1, a2, a3, a4, a5, a6, a7;
+			for (k = 0; k < W; k++)
+				r[k] = 0;
 
-		a0 = a1 = a2 = a3 = 0;
-		a4 = a5 = a6 = a7 = 0;
+			for (i = 0; i < 256; i++) {
+				if ((i >> b) & 1) {
+					uint64_t *ci = c + (j * 256 + i) * W;
 
-		for (j = 0; j < 256; j++) {
-			if ((j >> i) & 1) {
-				a0 ^= c[0*256 + j];
-				a1 ^= c[1*256 + j];
-				a2 ^= c[2*256 + j];
-				a3 ^= c[3*256 + j];
-				a4 ^= c[4*256 + j];
-				a5 ^= c[5*256 + j];
-				a6 ^= c[6*256 + j];
-				a7 ^= c[7*256 + j];
+					for (k = 0; k < W; k++)
+						r[k] ^= ci[k];
+				}
 			}
 		}
-
-		xy[ 0] = a0; xy[ 8] = a1; xy[16] = a2; xy[24] = a3;
-		xy[32] = a4; xy[40] = a5; xy[48] = a6; xy[56] = a7;
-		xy++;
 	}
 }
 
 /*-------------------------------------------------------------------*/
-static slong find_nonsingular_sub(uint64_t *t, slong *s, 
-				slong *last_s, slong last_dim, 
+static slong find_nonsingular_sub(slong W, uint64_t *t, slong *s,
+				slong *last_s, slong last_dim,
 				uint64_t *w) {
 
-	/* given a 64x64 matrix t[][] (i.e. sixty-four
-	   64-bit words) and a list of 'last_dim' column 
-	   indices enumerated in last_s[]: 
-	   
-	     - find a submatrix of t that is invertible 
+	/* given an N x N matrix t[][] and a list of 'last_dim'
+	   column indices enumerated in last_s[]:
+
+	     - find a submatrix of t that is invertible
 	     - invert it and copy to w[][]
 	     - enumerate in s[] the columns represented in w[][] */
 
-	slong i, j;
-	slong dim;
-	slong cols[64];
-	uint64_t M[64][2];
-	uint64_t mask, *row_i, *row_j;
-	uint64_t m0, m1;
+	slong N = 64 * W, W2 = 2 * W;
+	slong i, j, k;
+	slong dim = 0;
+	slong *cols;
+	uint64_t *M, *used;
+	uint64_t mask, *row_i, *row_j, m;
+	slong word;
+
+	M = (uint64_t *)flint_malloc(N * W2 * sizeof(uint64_t));
+	used = (uint64_t *)flint_calloc(W, sizeof(uint64_t));
+	cols = (slong *)flint_malloc(N * sizeof(slong));
 
-	/* M = [t | I] for I the 64x64 identity matrix */
+	/* M = [t | I] for I the N x N identity matrix */
 
-	for (i = 0; i < 64; i++) {
-		M[i][0] = t[i]; 
-		M[i][1] = bitmask[i];
+	for (i = 0; i < N; i++) {
+		for (k = 0; k < W; k++) {
+			M[i * W2 + k] = t[i * W + k];
+			M[i * W2 + W + k] = 0;
+		}
+		M[i * W2 + W + i / 64] = bitmask[i % 64];
 	}
 
 	/* put the column indices from last_s[] into the
 	   back of cols[], and copy to the beginning of cols[]
 	   any column indices not in last_s[] */
 
-	mask = 0;
 	for (i = 0; i < last_dim; i++) {
-		cols[63 - i] = last_s[i];
-		mask |= bitmask[last_s[i]];
+		cols[N - 1 - i] = last_s[i];
+		used[last_s[i] / 64] |= bitmask[last_s[i] % 64];
 	}
-	for (i = j = 0; i < 64; i++) {
-		if (!(mask & bitmask[i]))
+	for (i = j = 0; i < N; i++) {
+		if (!(used[i / 64] & bitmask[i % 64]))
 			cols[j++] = i;
 	}
 
 	/* compute the inverse of t[][] */
 
-	for (i = dim = 0; i < 64; i++) {
-	
+	for (i = 0; i < N; i++) {
+
 		/* find the next pivot row and put in row i */
 
-		mask = bitmask[cols[i]];
-		row_i = M[cols[i]];
-
-		for (j = i; j < 64; j++) {
-			row_j = M[cols[j]];
-			if (row_j[0] & mask) {
-				m0 = row_j[0];
-				m1 = row_j[1];
-				row_j[0] = row_i[0];
-				row_j[1] = row_i[1];
-				row_i[0] = m0; 
-				row_i[1] = m1;
+		mask = bitmask[cols[i] % 64];
+		word = cols[i] / 64;
+		row_i = M + cols[i] * W2;
+
+		for (j = i; j < N; j++) {
+			row_j = M + cols[j] * W2;
+			if (row_j[word] & mask) {
+				for (k = 0; k < W2; k++) {
+					m = row_j[k];
+					row_j[k] = row_i[k];
+					row_i[k] = m;
+				}
 				break;
 			}
 		}
-				
+
 		/* if a pivot row was found, eliminate the pivot
 		   column from all other rows */
 
-		if (j < 64) {
-			for (j = 0; j < 64; j++) {
-				row_j = M[cols[j]];
-				if ((row_i != row_j) && (row_j[0] & mask)) {
-					row_j[0] ^= row_i[0];
-					row_j[1] ^= row_i[1];
+		if (j < N) {
+			for (j = 0; j < N; j++) {
+				row_j = M + cols[j] * W2;
+				if ((row_i != row_j) && (row_j[word] & mask)) {
+					for (k = 0; k < W2; k++)
+						row_j[k] ^= row_i[k];
 				}
 			}
 
-			/* add the pivot column to the list of 
+			/* add the pivot column to the list of
 			   accepted columns */
 
 			s[dim++] = cols[i];
@@ -412,227 +708,156 @@ static slong find_nonsingular_sub(uint64_t *t, slong *s,
 		/* otherwise, use the right-hand half of M[]
 		   to compensate for the absence of a pivot column */
 
-		for (j = i; j < 64; j++) {
-			row_j = M[cols[j]];
-			if (row_j[1] & mask) {
-				m0 = row_j[0];
-				m1 = row_j[1];
-				row_j[0] = row_i[0];
-				row_j[1] = row_i[1];
-				row_i[0] = m0; 
-				row_i[1] = m1;
+		for (j = i; j < N; j++) {
+			row_j = M + cols[j] * W2;
+			if (row_j[W + word] & mask) {
+				for (k = 0; k < W2; k++) {
+					m = row_j[k];
+					row_j[k] = row_i[k];
+					row_i[k] = m;
+				}
 				break;
 			}
 		}
-				
-		if (j == 64) {
+
+		if (j == N) {
 #if QS_DEBUG
 			flint_printf("lanczos error: submatrix "
 					"is not invertible\n");
 #endif
-			return 0;
+			dim = 0;
+			goto cleanup;
 		}
-			
+
 		/* eliminate the pivot column from the other rows
 		   of the inverse */
 
-		for (j = 0; j < 64; j++) {
-			row_j = M[cols[j]];
-			if ((row_i != row_j) && (row_j[1] & mask)) {
-				row_j[0] ^= row_i[0];
-				row_j[1] ^= row_i[1];
+		for (j = 0; j < N; j++) {
+			row_j = M + cols[j] * W2;
+			if ((row_i != row_j) && (row_j[W + word] & mask)) {
+				for (k = 0; k < W2; k++)
+					row_j[k] ^= row_i[k];
 			}
 		}
 
 		/* wipe out the pivot row */
 
-		row_i[0] = row_i[1] = 0;
+		for (k = 0; k < W2; k++)
+			row_i[k] = 0;
 	}
 
 	/* the right-hand half of M[] is the desired inverse */
-	
-	for (i = 0; i < 64; i++) 
-		w[i] = M[i][1];
+
+	for (i = 0; i < N; i++) {
+		for (k = 0; k < W; k++)
+			w[i * W + k] = M[i * W2 + W + k];
+	}
 
 	/* The block Lanczos recurrence depends on all columns
-	   of t[][] appearing in s[] and/or last_s[]. 
+	   of t[][] appearing in s[] and/or last_s[].
 	   Verify that condition here */
 
-	mask = 0;
 	for (i = 0; i < dim; i++)
-		mask |= bitmask[s[i]];
-	for (i = 0; i < last_dim; i++)
-		mask |= bitmask[last_s[i]];
+		used[s[i] / 64] |= bitmask[s[i] % 64];
 
-	if (mask != (uint64_t)(-1)) {
+	for (k = 0; k < W; k++) {
+		if (used[k] != (uint64_t)(-1)) {
 #if QS_DEBUG
-		flint_printf("lanczos error: not all columns used\n");
+			flint_printf("lanczos error: not all columns used\n");
 #endif
-		return 0;
-	}
-
-	return dim;
-}
-
-/*-------------------------------------------------------------------*/
-void mul_MxN_Nx64(slong vsize, slong dense_rows,
-		slong ncols, la_col_t *A,
-		uint64_t *x, uint64_t *b) {
-
-	/* Multiply the vector x[] by the matrix A (stored
-	   columnwise) and put the result in b[]. vsize
-	   refers to the number of uint64_t's allocated for
-	   x[] and b[]; vsize is probably different from ncols */
-
-	slong i, j;
-
-	memset(b, 0, vsize * sizeof(uint64_t));
-	
-	for (i = 0; i < ncols; i++) {
-		la_col_t *col = A + i;
-		slong *row_entries = col->data;
-		uint64_t tmp = x[i];
-
-		for (j = 0; j < col->weight; j++) {
-			b[row_entries[j]] ^= tmp;
+			dim = 0;
+			break;
 		}
 	}
 
-	if (dense_rows) {
-		for (i = 0; i < ncols; i++) {
-			la_col_t *col = A + i;
-			slong *row_entries = col->data + col->weight;
-			uint64_t tmp = x[i];
-	
-			for (j = 0; j < dense_rows; j++) {
-				if (row_entries[j / 32] & 
-						((slong)1 << (j % 32))) {
-					b[j] ^= tmp;
-				}
-			}
-		}
-	}
-}
+cleanup:
+	flint_free(M);
+	flint_free(used);
+	flint_free(cols);
 
-/*-------------------------------------------------------------------*/
-void mul_trans_MxN_Nx64(slong dense_rows, slong ncols,
-			la_col_t *A, uint64_t *x, uint64_t *b) {
-
-	/* Multiply the vector x[] by the transpose of the
-	   matrix A and put the result in b[]. Since A is stored
-	   by columns, this is just a matrix-vector product */
-
-	slong i, j;
-
-	for (i = 0; i < ncols; i++) {
-		la_col_t *col = A + i;
-		slong *row_entries = col->data;
-		uint64_t accum = 0;
-
-		for (j = 0; j < col->weight; j++) {
-			accum ^= x[row_entries[j]];
-		}
-		b[i] = accum;
-	}
-
-	if (dense_rows) {
-		for (i = 0; i < ncols; i++) {
-			la_col_t *col = A + i;
-			slong *row_entries = col->data + col->weight;
-			uint64_t accum = b[i];
-	
-			for (j = 0; j < dense_rows; j++) {
-				if (row_entries[j / 32] &
-						((slong)1 << (j % 32))) {
-					accum ^= x[j];
-				}
-			}
-			b[i] = accum;
-		}
-	}
+	return dim;
 }
 
 /*-----------------------------------------------------------------------*/
-static void transpose_vector(slong ncols, uint64_t *v, uint64_t **trans) {
+static void transpose_vector(slong W, slong nrows, uint64_t *v,
+				uint64_t **trans) {
 
-	/* Hideously inefficent routine to transpose a
-	   vector v[] of 64-bit words into a 2-D array
-	   trans[][] of 64-bit words */
+	/* Transpose the nrows x N block v[][] into the N rows
+	   trans[][] of (nrows + 63)/64 words each */
 
-	slong i, j;
+	slong i, j, w;
 	slong col;
 	uint64_t mask, word;
 
-	for (i = 0; i < ncols; i++) {
+	for (i = 0; i < nrows; i++) {
 		col = i / 64;
 		mask = bitmask[i % 64];
-		word = v[i];
-		j = 0;
-		while (word) {
-			if (word & 1)
-				trans[j][col] |= mask;
-			word = word >> 1;
-			j++;
+		for (w = 0; w < W; w++) {
+			word = v[i * W + w];
+			j = 64 * w;
+			while (word) {
+				if (word & 1)
+					trans[j][col] |= mask;
+				word = word >> 1;
+				j++;
+			}
 		}
 	}
 }
 
 /*-----------------------------------------------------------------------*/
-void combine_cols(slong ncols, 
-		uint64_t *x, uint64_t *v, 
-		uint64_t *ax, uint64_t *av) {
+static void combine_cols(slong W, slong ncols, slong nrows,
+		uint64_t *x, uint64_t *v,
+		uint64_t *ax, uint64_t *av, uint64_t *deps) {
 
-	/* Once the block Lanczos iteration has finished, 
+	/* Once the block Lanczos iteration has finished,
 	   x[] and v[] will contain mostly nullspace vectors
 	   between them, as well as possibly some columns
 	   that are linear combinations of nullspace vectors.
 	   Given vectors ax[] and av[] that are the result of
-	   multiplying x[] and v[] by the matrix, this routine 
-	   will use Gauss elimination on the columns of [ax | av] 
+	   multiplying x[] and v[] by the matrix, this routine
+	   will use Gauss elimination on the columns of [ax | av]
 	   to find all of the linearly dependent columns. The
 	   column operations needed to accomplish this are mir-
 	   rored in [x | v] and the columns that are independent
-	   are skipped. Finally, the dependent columns are copied
-	   back into x[] and represent the nullspace vector output
-	   of the block Lanczos code.
-	   
-	   v[] and av[] can be NULL, in which case the elimination
-	   process assumes 64 dependencies instead of 128 */
+	   are skipped. Finally, up to 64 of the dependent columns
+	   are copied into deps[] and represent the nullspace
+	   vector output of the block Lanczos code */
 
-	slong i, j, k, bitpos, col, col_words, num_deps;
+	slong i, j, k, bitpos, col, col_words, acol_words, num_deps;
 	uint64_t mask;
-	uint64_t *matrix[128], *amatrix[128], *tmp;
+	uint64_t **matrix, **amatrix, *tmp;
 
-	num_deps = 128;
-	if (v == NULL || av == NULL)
-		num_deps = 64;
+	num_deps = 2 * 64 * W;
 
 	col_words = (ncols + 63) / 64;
+	acol_words = (nrows + 63) / 64;
+
+	matrix = (uint64_t **)flint_malloc(num_deps * sizeof(uint64_t *));
+	amatrix = (uint64_t **)flint_malloc(num_deps * sizeof(uint64_t *));
 
 	for (i = 0; i < num_deps; i++) {
-		matrix[i] = (uint64_t *)flint_calloc((size_t)col_words, 
+		matrix[i] = (uint64_t *)flint_calloc((size_t)col_words,
 					     sizeof(uint64_t));
-		amatrix[i] = (uint64_t *)flint_calloc((size_t)col_words, 
+		amatrix[i] = (uint64_t *)flint_calloc((size_t)acol_words,
 					      sizeof(uint64_t));
 	}
 
-	/* operations on columns can more conveniently become 
+	/* operations on columns can more conveniently become
 	   operations on rows if all the vectors are first
 	   transposed */
 
-	transpose_vector(ncols, x, matrix);
-	transpose_vector(ncols, ax, amatrix);
-	if (num_deps == 128) {
-		transpose_vector(ncols, v, matrix + 64);
-		transpose_vector(ncols, av, amatrix + 64);
-	}
+	transpose_vector(W, ncols, x, matrix);
+	transpose_vector(W, nrows, ax, amatrix);
+	transpose_vector(W, ncols, v, matrix + num_deps / 2);
+	transpose_vector(W, nrows, av, amatrix + num_deps / 2);
 
 	/* Keep eliminating rows until the unprocessed part
 	   of amatrix[][] is all zero. The rows where this
 	   happens correspond to linearly dependent vectors
 	   in the nullspace */
 
-	for (i = bitpos = 0; i < num_deps && bitpos < ncols; bitpos++) {
+	for (i = bitpos = 0; i < num_deps && bitpos < nrows; bitpos++) {
 
 		/* find the next pivot row */
 
@@ -664,16 +889,16 @@ void combine_cols(slong ncols,
 				   corresponding (dense) row of matrix[][]
 				   must have the same operation applied */
 
-				for (k = 0; k < col_words; k++) {
+				for (k = 0; k < acol_words; k++)
 					amatrix[j][k] ^= amatrix[i][k];
+				for (k = 0; k < col_words; k++)
 					matrix[j][k] ^= matrix[i][k];
-				}
 			}
 		}
 		i++;
 	}
 
-	/* transpose rows i to 64 back into x[] */
+	/* transpose up to 64 of rows i onwards into deps[] */
 
 	for (j = 0; j < ncols; j++) {
 		uint64_t word = 0;
@@ -681,40 +906,58 @@ void combine_cols(slong ncols,
 		col = j / 64;
 		mask = bitmask[j % 64];
 
-		for (k = i; k < 64; k++) {
+		for (k = i; k < num_deps && k < i + 64; k++) {
 			if (matrix[k][col] & mask)
-				word |= bitmask[k];
+				word |= bitmask[k - i];
 		}
-		x[j] = word;
+		deps[j] = word;
 	}
 
 	for (i = 0; i < num_deps; i++) {
 		flint_free(matrix[i]);
 		flint_free(amatrix[i]);
 	}
+
+	flint_free(matrix);
+	flint_free(amatrix);
 }
 
 /*-----------------------------------------------------------------------*/
-uint64_t * block_lanczos(flint_rand_t state, slong nrows, 
+uint64_t * block_lanczos(flint_rand_t state, slong nrows,
 			slong dense_rows, slong ncols, la_col_t *B) {
-	
-	/* Solve Bx = 0 for some nonzero x; the computed
-	   solution, containing up to 64 of these nullspace
-	   vectors, is returned */
 
-	uint64_t *vnext, *v[3], *x, *v0;
+	/* 64-bit blocks are fastest at the sizes the quadratic
+	   sieve produces, as the dense block products grow with
+	   the width, see _block_lanczos */
+
+	return _block_lanczos(state, nrows, dense_rows, ncols, B, 1);
+}
+
+/*-----------------------------------------------------------------------*/
+uint64_t * _block_lanczos(flint_rand_t state, slong nrows,
+			slong dense_rows, slong ncols, la_col_t *B, slong W) {
+
+	/* Solve Bx = 0 for some nonzero x, working on blocks
+	   of 64*W vectors; the computed solution, containing
+	   up to 64 of these nullspace vectors, is returned */
+
+	la_mat_t A;
+	uint64_t *vnext, *v[3], *x, *v0, *deps;
 	uint64_t *winv[3];
 	uint64_t *vt_a_v[2], *vt_a2_v[2];
-	uint64_t *scratch;
+	uint64_t *scratch, *table;
 	uint64_t *d, *e, *f, *f2;
+	uint64_t *mask0, *mask1;
 	uint64_t *tmp;
-	slong s[2][64];
-	slong i, iter;
+	slong *s[2], *stmp;
+	slong i, k, iter;
 	slong n = ncols;
+	slong N = 64 * W;
 	slong dim0, dim1;
-	uint64_t mask0, mask1;
 	slong vsize;
 
+	la_mat_init(&A, nrows, dense_rows, ncols, B);
+
 	/* allocate all of the size-n variables. Note that because
 	   B has been preprocessed to ignore singleton rows, the
 	   number of rows may really be less than nrows and may
@@ -722,27 +965,37 @@ uint64_t * block_lanczos(flint_rand_t state, slong nrows,
 	   two numbers  */
 
 	vsize = FLINT_MAX(nrows, ncols);
-	v[0] = (uint64_t *)flint_malloc(vsize * sizeof(uint64_t));
-	v[1] = (uint64_t *)flint_malloc(vsize * sizeof(uint64_t));
-	v[2] = (uint64_t *)flint_malloc(vsize * sizeof(uint64_t));
-	vnext = (uint64_t *)flint_malloc(vsize * sizeof(uint64_t));
-	x = (uint64_t *)flint_malloc(vsize * sizeof(uint64_t));
-	v0 = (uint64_t *)flint_malloc(vsize * sizeof(uint64_t));
-	scratch = (uint64_t *)flint_malloc(FLINT_MAX(vsize, 256 * 8) * sizeof(uint64_t));
-
-	/* allocate all the 64x64 variables */
-
-	winv[0] = (uint64_t *)flint_malloc(64 * sizeof(uint64_t));
-	winv[1] = (uint64_t *)flint_malloc(64 * sizeof(uint64_t));
-	winv[2] = (uint64_t *)flint_malloc(64 * sizeof(uint64_t));
-	vt_a_v[0] = (uint64_t *)flint_malloc(64 * sizeof(uint64_t));
-	vt_a_v[1] = (uint64_t *)flint_malloc(64 * sizeof(uint64_t));
-	vt_a2_v[0] = (uint64_t *)flint_malloc(64 * sizeof(uint64_t));
-	vt_a2_v[1] = (uint64_t *)flint_malloc(64 * sizeof(uint64_t));
-	d = (uint64_t *)flint_malloc(64 * sizeof(uint64_t));
-	e = (uint64_t *)flint_malloc(64 * sizeof(uint64_t));
-	f = (uint64_t *)flint_malloc(64 * sizeof(uint64_t));
-	f2 = (uint64_t *)flint_malloc(64 * sizeof(uint64_t));
+	v[0] = (uint64_t *)flint_calloc(vsize * W, sizeof(uint64_t));
+	v[1] = (uint64_t *)flint_calloc(vsize * W, sizeof(uint64_t));
+	v[2] = (uint64_t *)flint_calloc(vsize * W, sizeof(uint64_t));
+	vnext = (uint64_t *)flint_calloc(vsize * W, sizeof(uint64_t));
+	x = (uint64_t *)flint_calloc(vsize * W, sizeof(uint64_t));
+	v0 = (uint64_t *)flint_calloc(vsize * W, sizeof(uint64_t));
+	scratch = (uint64_t *)flint_calloc(vsize * W, sizeof(uint64_t));
+
+	/* one table of 8*W*256 rows for each chunk the rows
+	   of a block are split into */
+
+	table = (uint64_t *)flint_malloc(la_num_chunks(vsize)
+				* 8 * W * 256 * W * sizeof(uint64_t));
+
+	/* allocate all the N x N variables */
+
+	winv[0] = (uint64_t *)flint_malloc(N * W * sizeof(uint64_t));
+	winv[1] = (uint64_t *)flint_malloc(N * W * sizeof(uint64_t));
+	winv[2] = (uint64_t *)flint_malloc(N * W * sizeof(uint64_t));
+	vt_a_v[0] = (uint64_t *)flint_malloc(N * W * sizeof(uint64_t));
+	vt_a_v[1] = (uint64_t *)flint_malloc(N * W * sizeof(uint64_t));
+	vt_a2_v[0] = (uint64_t *)flint_malloc(N * W * sizeof(uint64_t));
+	vt_a2_v[1] = (uint64_t *)flint_malloc(N * W * sizeof(uint64_t));
+	d = (uint64_t *)flint_malloc(N * W * sizeof(uint64_t));
+	e = (uint64_t *)flint_malloc(N * W * sizeof(uint64_t));
+	f = (uint64_t *)flint_malloc(N * W * sizeof(uint64_t));
+	f2 = (uint64_t *)flint_malloc(N * W * sizeof(uint64_t));
+	mask0 = (uint64_t *)flint_malloc(W * sizeof(uint64_t));
+	mask1 = (uint64_t *)flint_malloc(W * sizeof(uint64_t));
+	s[0] = (slong *)flint_malloc(N * sizeof(slong));
+	s[1] = (slong *)flint_malloc(N * sizeof(slong));
 
 	/* The iterations computes v[0], vt_a_v[0],
 	   vt_a2_v[0], s[0] and winv[0]. Subscripts larger
@@ -750,36 +1003,36 @@ uint64_t * block_lanczos(flint_rand_t state, slong nrows,
 	   quantities, which start off empty (except for
 	   the past version of s[], which contains all
 	   the column indices */
-	   
-	memset(v[1], 0, vsize * sizeof(uint64_t));
-	memset(v[2], 0, vsize * sizeof(uint64_t));
-	for (i = 0; i < 64; i++) {
+
+	for (i = 0; i < N; i++)
 		s[1][i] = i;
+	for (i = 0; i < N * W; i++) {
 		vt_a_v[1][i] = 0;
 		vt_a2_v[1][i] = 0;
 		winv[1][i] = 0;
 		winv[2][i] = 0;
 	}
+	for (k = 0; k < W; k++)
+		mask1[k] = (uint64_t)(-1);
 	dim0 = 0;
-	dim1 = 64;
-	mask1 = (uint64_t)(-1);
+	dim1 = N;
 	iter = 0;
 
 	/* The computed solution 'x' starts off random,
 	   and v[0] starts off as B*x. This initial copy
 	   of v[0] must be saved off separately */
 
-	for (i = 0; i < n; i++)
+	for (i = 0; i < n * W; i++)
 #if FLINT_BITS==64
 		v[0][i] = (uint64_t) n_randlimb(state);
 #else
 		v[0][i] = (uint64_t) n_randlimb(state) + ((uint64_t) n_randlimb(state) << 32);
 #endif
 
-	memcpy(x, v[0], vsize * sizeof(uint64_t));
-	mul_MxN_Nx64(vsize, dense_rows, ncols, B, v[0], scratch);
-	mul_trans_MxN_Nx64(dense_rows, ncols, B, scratch, v[0]);
-	memcpy(v0, v[0], vsize * sizeof(uint64_t));
+	memcpy(x, v[0], vsize * W * sizeof(uint64_t));
+	mul_MxN_NxB(&A, v[0], scratch, W);
+	mul_trans_MxN_NxB(&A, scratch, v[0], W);
+	memcpy(v0, v[0], vsize * W * sizeof(uint64_t));
 
 	/* perform the iteration */
 
@@ -787,25 +1040,25 @@ uint64_t * block_lanczos(flint_rand_t state, slong nrows,
 		iter++;
 
 		/* multiply the current v[0] by a symmetrized
-		   version of B, or B'B (apostrophe means 
+		   version of B, or B'B (apostrophe means
 		   transpose). Use "A" to refer to B'B  */
 
-		mul_MxN_Nx64(vsize, dense_rows, ncols, B, v[0], scratch);
-		mul_trans_MxN_Nx64(dense_rows, ncols, B, scratch, vnext);
+		mul_MxN_NxB(&A, v[0], scratch, W);
+		mul_trans_MxN_NxB(&A, scratch, vnext, W);
 
 		/* compute v0'*A*v0 and (A*v0)'(A*v0) */
 
-		mul_64xN_Nx64(v[0], vnext, scratch, vt_a_v[0], n);
-		mul_64xN_Nx64(vnext, vnext, scratch, vt_a2_v[0], n);
+		mul_BxN_NxB(W, v[0], vnext, table, vt_a_v[0], n);
+		mul_BxN_NxB(W, vnext, vnext, table, vt_a2_v[0], n);
 
 		/* if the former is orthogonal to itself, then
 		   the iteration has finished */
 
-		for (i = 0; i < 64; i++) {
+		for (i = 0; i < N * W; i++) {
 			if (vt_a_v[0][i] != 0)
 				break;
 		}
-		if (i == 64) {
+		if (i == N * W) {
 			break;
 		}
 
@@ -813,7 +1066,7 @@ uint64_t * block_lanczos(flint_rand_t state, slong nrows,
 		   of v0'*A*v0, invert it, and list the column
 		   indices present in the submatrix */
 
-		dim0 = find_nonsingular_sub(vt_a_v[0], s[0], 
+		dim0 = find_nonsingular_sub(W, vt_a_v[0], s[0],
 					    s[1], dim1, winv[0]);
 		if (dim0 == 0)
 			break;
@@ -822,76 +1075,86 @@ uint64_t * block_lanczos(flint_rand_t state, slong nrows,
 		   that participates in the inverted submatrix
 		   computed above */
 
-		mask0 = 0;
+		for (k = 0; k < W; k++)
+			mask0[k] = 0;
 		for (i = 0; i < dim0; i++)
-			mask0 |= bitmask[s[0][i]];
+			mask0[s[0][i] / 64] |= bitmask[s[0][i] % 64];
 
 		/* compute d */
 
-		for (i = 0; i < 64; i++)
-			d[i] = (vt_a2_v[0][i] & mask0) ^ vt_a_v[0][i];
+		for (i = 0; i < N; i++) {
+			for (k = 0; k < W; k++)
+				d[i * W + k] = (vt_a2_v[0][i * W + k] & mask0[k])
+						^ vt_a_v[0][i * W + k];
+		}
 
-		mul_64x64_64x64(winv[0], d, d);
+		mul_NxN_NxN(W, winv[0], d, d);
 
-		for (i = 0; i < 64; i++)
-			d[i] = d[i] ^ bitmask[i];
+		for (i = 0; i < N; i++)
+			d[i * W + i / 64] ^= bitmask[i % 64];
 
 		/* compute e */
 
-		mul_64x64_64x64(winv[1], vt_a_v[0], e);
+		mul_NxN_NxN(W, winv[1], vt_a_v[0], e);
 
-		for (i = 0; i < 64; i++)
-			e[i] = e[i] & mask0;
+		for (i = 0; i < N; i++) {
+			for (k = 0; k < W; k++)
+				e[i * W + k] &= mask0[k];
+		}
 
 		/* compute f */
 
-		mul_64x64_64x64(vt_a_v[1], winv[1], f);
+		mul_NxN_NxN(W, vt_a_v[1], winv[1], f);
 
-		for (i = 0; i < 64; i++)
-			f[i] = f[i] ^ bitmask[i];
+		for (i = 0; i < N; i++)
+			f[i * W + i / 64] ^= bitmask[i % 64];
 
-		mul_64x64_64x64(winv[2], f, f);
+		mul_NxN_NxN(W, winv[2], f, f);
 
-		for (i = 0; i < 64; i++)
-			f2[i] = ((vt_a2_v[1][i] & mask1) ^ 
-				   vt_a_v[1][i]) & mask0;
+		for (i = 0; i < N; i++) {
+			for (k = 0; k < W; k++)
+				f2[i * W + k] = ((vt_a2_v[1][i * W + k] & mask1[k])
+					^ vt_a_v[1][i * W + k]) & mask0[k];
+		}
 
-		mul_64x64_64x64(f, f2, f);
+		mul_NxN_NxN(W, f, f2, f);
 
 		/* compute the next v */
 
-		for (i = 0; i < n; i++)
-			vnext[i] = vnext[i] & mask0;
+		for (i = 0; i < n; i++) {
+			for (k = 0; k < W; k++)
+				vnext[i * W + k] &= mask0[k];
+		}
+
+		mul_NxB_NxN_acc(W, v[0], d, table, vnext, n);
+		mul_NxB_NxN_acc(W, v[1], e, table, vnext, n);
+		mul_NxB_NxN_acc(W, v[2], f, table, vnext, n);
 
-		mul_Nx64_64x64_acc(v[0], d, scratch, vnext, n);
-		mul_Nx64_64x64_acc(v[1], e, scratch, vnext, n);
-		mul_Nx64_64x64_acc(v[2], f, scratch, vnext, n);
-		
 		/* update the computed solution 'x' */
 
-		mul_64xN_Nx64(v[0], v0, scratch, d, n);
-		mul_64x64_64x64(winv[0], d, d);
-		mul_Nx64_64x64_acc(v[0], d, scratch, x, n);
+		mul_BxN_NxB(W, v[0], v0, table, d, n);
+		mul_NxN_NxN(W, winv[0], d, d);
+		mul_NxB_NxN_acc(W, v[0], d, table, x, n);
 
 		/* rotate all the variables */
 
-		tmp = v[2]; 
-		v[2] = v[1]; 
-		v[1] = v[0]; 
-		v[0] = vnext; 
+		tmp = v[2];
+		v[2] = v[1];
+		v[1] = v[0];
+		v[0] = vnext;
 		vnext = tmp;
-		
-		tmp = winv[2]; 
-		winv[2] = winv[1]; 
-		winv[1] = winv[0]; 
+
+		tmp = winv[2];
+		winv[2] = winv[1];
+		winv[1] = winv[0];
 		winv[0] = tmp;
-		
+
 		tmp = vt_a_v[1]; vt_a_v[1] = vt_a_v[0]; vt_a_v[0] = tmp;
-		
+
 		tmp = vt_a2_v[1]; vt_a2_v[1] = vt_a2_v[0]; vt_a2_v[0] = tmp;
 
-		memcpy(s[1], s[0], 64 * sizeof(slong));
-		mask1 = mask0;
+		stmp = s[1]; s[1] = s[0]; s[0] = stmp;
+		tmp = mask1; mask1 = mask0; mask0 = tmp;
 		dim1 = dim0;
 	}
 
@@ -901,9 +1164,9 @@ uint64_t * block_lanczos(flint_rand_t state, slong nrows,
 
 	/* free unneeded storage */
 
-        flint_free(vnext);
-	flint_free(scratch);
+	flint_free(vnext);
 	flint_free(v0);
+	flint_free(table);
 	flint_free(vt_a_v[0]);
 	flint_free(vt_a_v[1]);
 	flint_free(vt_a2_v[0]);
@@ -915,6 +1178,10 @@ uint64_t * block_lanczos(flint_rand_t state, slong nrows,
 	flint_free(e);
 	flint_free(f);
 	flint_free(f2);
+	flint_free(mask0);
+	flint_free(mask1);
+	flint_free(s[0]);
+	flint_free(s[1]);
 
 	/* if a recoverable failure occurred, start everything
 	   over again */
@@ -923,36 +1190,44 @@ uint64_t * block_lanczos(flint_rand_t state, slong nrows,
 #if QS_DEBUG
 		flint_printf("linear algebra failed; retrying...\n");
 #endif
+		flint_free(scratch);
 		flint_free(x);
 		flint_free(v[0]);
 		flint_free(v[1]);
 		flint_free(v[2]);
+		la_mat_clear(&A);
 		return NULL;
 	}
 
 	/* convert the output of the iteration to an actual
 	   collection of nullspace vectors */
 
-	mul_MxN_Nx64(vsize, dense_rows, ncols, B, x, v[1]);
-	mul_MxN_Nx64(vsize, dense_rows, ncols, B, v[0], v[2]);
+	mul_MxN_NxB(&A, x, v[1], W);
+	mul_MxN_NxB(&A, v[0], v[2], W);
+
+	deps = (uint64_t *)flint_malloc(FLINT_MAX(ncols, 1) * sizeof(uint64_t));
 
-	combine_cols(ncols, x, v[0], v[1], v[2]);
+	combine_cols(W, ncols, nrows, x, v[0], v[1], v[2], deps);
 
 	/* verify that these really are linear dependencies of B */
 
-	mul_MxN_Nx64(vsize, dense_rows, ncols, B, x, v[0]);
-	
-	for (i = 0; i < ncols; i++) {
-		if (v[0][i] != 0)
+	mul_MxN_NxB(&A, deps, scratch, 1);
+
+	for (i = 0; i < nrows; i++) {
+		if (scratch[i] != 0)
 			break;
 	}
-	if (i < ncols) {
+	if (i < nrows) {
 		flint_printf("lanczos error: dependencies don't work %wd\n",i);
 		flint_abort();
 	}
-	
+
+	flint_free(scratch);
+	flint_free(x);
 	flint_free(v[0]);
 	flint_free(v[1]);
 	flint_free(v[2]);
-	return x;
+	la_mat_clear(&A);
+
+	return deps;
 }
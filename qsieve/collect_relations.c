@@ -10,6 +10,7 @@
     (at your option) any later version.  See <http://www.gnu.org/licenses/>.
 */
 
+#include <pthread.h>
 #include "qsieve.h"
 
 #include <time.h>
@@ -236,6 +237,31 @@ void qsieve_do_sieving2(qs_t qs_inf, unsigned char * sieve, qs_poly_t poly)
     }
 }
 
+/*
+   return a nontrivial factor of a composite n without small factors, or 0
+   if none is found quickly
+*/
+
+static mp_limb_t _qsieve_split_cofactor(mp_limb_t n)
+{
+   mp_limb_t f, normbits, ninv, a;
+
+   if ((f = n_factor_SQUFOF(n, 2000)) != 0 && f != 1 && f != n)
+      return f;
+
+   count_leading_zeros(normbits, n);
+   ninv = n_preinvert_limb(n << normbits);
+
+   for (a = 1; a <= 3; a++)
+   {
+      if (n_factor_pollard_brent_single(&f, n << normbits, ninv,
+                           a << normbits, UWORD(2) << normbits, normbits, 10000))
+         return f >> normbits;
+   }
+
+   return 0;
+}
+
 /* check position 'i' in sieve array for smoothness */
 
 slong qsieve_evaluate_candidate(qs_t qs_inf, ulong i, unsigned char * sieve, qs_poly_t poly)
@@ -282,7 +308,7 @@ slong qsieve_evaluate_candidate(qs_t qs_inf, ulong i, unsigned char * sieve, qs_
 
    sieve[i] -= qs_inf->sieve_fill;
    bits = FLINT_ABS(fmpz_bits(res));
-   bits -= BITS_ADJUST;
+   bits -= BITS_ADJUST + qs_inf->dlp_bits;
    extra_bits = 0;
 
    if (factor_base[0].p != 1) /* divide out powers of the multiplier */
@@ -332,12 +358,14 @@ slong qsieve_evaluate_candidate(qs_t qs_inf, ulong i, unsigned char * sieve, qs_
    {
       sieve[i] += extra_bits;
 
-      /* pull out remaining primes */
+      /*
+         pull out remaining primes, i and the primes fit in an int, for
+         which a hardware division is cheaper than a precomputed inverse
+      */
       for (j = qs_inf->small_primes; j < num_primes && extra_bits < sieve[i]; j++)
       {
          prime = factor_base[j].p;
-         pinv = factor_base[j].pinv;
-         modp = n_mod2_preinv(i, prime, pinv);
+         modp = (unsigned int) i % (unsigned int) prime;
 
          if (soln2[j] != 0)
          {
@@ -398,12 +426,8 @@ slong qsieve_evaluate_candidate(qs_t qs_inf, ulong i, unsigned char * sieve, qs_
 
          poly->num_factors = num_factors;
 
-#pragma omp critical
-         {
-            qsieve_write_to_file(qs_inf, 1, Y, poly);
-         
-            qs_inf->full_relation++;
-         }
+         qsieve_write_to_file(qs_inf, 1, 1, Y, poly);
+
          relations++;
 
 #if 0
@@ -443,8 +467,14 @@ slong qsieve_evaluate_candidate(qs_t qs_inf, ulong i, unsigned char * sieve, qs_
           if (fmpz_bits(res) <= 30)
           {
               prime = fmpz_get_ui(res);
-              
-              if (prime < 60 * factor_base[qs_inf->num_primes - 1].p && n_gcd(prime, qs_inf->k) == 1)
+
+              /*
+                 the large prime must exceed all factor base primes, those past
+                 num_primes may be the q of another A, giving the same relation
+                 with the roles of q and the large prime swapped
+              */
+              if (prime < 60 * factor_base[qs_inf->num_primes - 1].p && n_gcd(prime, qs_inf->k) == 1
+                  && prime > factor_base[qs_inf->num_primes + qs_inf->ks_primes - 1].p)
               {
                   for (k = 0; k < qs_inf->s; k++)  /* commit any outstanding A factor */
                   {
@@ -460,15 +490,47 @@ slong qsieve_evaluate_candidate(qs_t qs_inf, ulong i, unsigned char * sieve, qs_
 
                   poly->num_factors = num_factors;
 
-#pragma omp critical
+                  /* buffer this partial for the store */
+                  qsieve_write_to_file(qs_inf, prime, 1, Y, poly);
+              }
+          } else if (qs_inf->dlp_bits != 0)
+          {
+              mp_limb_t lp2, bound = 60 * factor_base[qs_inf->num_primes - 1].p;
+
+              /* split a cofactor which may be a product of two large primes */
+              if (fmpz_bits(res) <= 2*FLINT_BIT_COUNT(bound) && fmpz_bits(res) < FLINT_BITS
+                  && (prime = fmpz_get_ui(res)) < bound*bound
+                  && n_gcd(prime, qs_inf->k) == 1 && !n_is_probabprime(prime)
+                  && (lp2 = _qsieve_split_cofactor(prime)) != 0)
+              {
+                  prime /= lp2;
+
+                  if (prime < lp2)
                   {
-                     /* store this partial in file */
+                      mp_limb_t t = prime;
+                      prime = lp2;
+                      lp2 = t;
+                  }
 
-                     qsieve_write_to_file(qs_inf, prime, Y, poly);
+                  /* as above, both must exceed all factor base primes */
+                  if (prime < bound && lp2 > factor_base[qs_inf->num_primes
+                                                    + qs_inf->ks_primes - 1].p)
+                  {
+                      for (k = 0; k < qs_inf->s; k++)  /* commit any outstanding A factor */
+                      {
+                          if (A_ind[k] >= j)
+                          {
+                              factor[num_factors].ind = A_ind[k];
+                              factor[num_factors++].exp = 1;
+                          }
+                      }
+
+                      factor[num_factors].ind = qs_inf->q_idx;
+                      factor[num_factors++].exp = 1;
 
-                     qs_inf->edges++;
+                      poly->num_factors = num_factors;
 
-                     qsieve_add_to_hashtable(qs_inf, prime);
+                      qsieve_write_to_file(qs_inf, prime, lp2, Y, poly);
                   }
               }
           }
@@ -523,47 +585,96 @@ slong qsieve_evaluate_sieve(qs_t qs_inf, unsigned char * sieve, qs_poly_t poly)
     return rels;
 }
 
+typedef struct
+{
+   qs_s * inf;
+   unsigned char * sieve;   /* sieve of this thread */
+   qs_poly_s * poly;        /* polynomial and relation buffer of this thread */
+   slong * next;            /* next polynomial to be claimed */
+   slong rels;              /* relations found by this thread */
+   pthread_mutex_t * mutex;
+}
+qsieve_worker_arg_t;
+
+/*
+   Sieve polynomials until all 2^s of them are claimed. The polynomials must
+   be generated in order, so this and writing the relations buffered since
+   the last polynomial to the store is done under the mutex. Everything else
+   uses the data of this thread and the read only parts of qs_inf.
+*/
+void * _qsieve_collect_relations_worker(void * arg_ptr)
+{
+   qsieve_worker_arg_t * arg = (qsieve_worker_arg_t *) arg_ptr;
+   qs_s * qs_inf = arg->inf;
+   slong i;
+
+   while (1)
+   {
+      pthread_mutex_lock(arg->mutex);
+
+      qsieve_store_flush(qs_inf, arg->poly);
+
+      i = *arg->next;
+
+      if (i < (WORD(1) << qs_inf->s))
+      {
+         if (i != 0)
+            qsieve_init_poly_next(qs_inf, i);
+
+         qsieve_poly_copy(arg->poly, qs_inf);
+
+         *arg->next = i + 1;
+      }
+
+      pthread_mutex_unlock(arg->mutex);
+
+      if (i >= (WORD(1) << qs_inf->s))
+         break;
+
+      if (qs_inf->sieve_size < 2*BLOCK_SIZE)
+         qsieve_do_sieving(qs_inf, arg->sieve, arg->poly);
+      else
+         qsieve_do_sieving2(qs_inf, arg->sieve, arg->poly);
+
+      arg->rels += qsieve_evaluate_sieve(qs_inf, arg->sieve, arg->poly);
+   }
+
+   return NULL;
+}
+
 /* procedure to call polynomial initialization and sieving procedure */
 
 slong qsieve_collect_relations(qs_t qs_inf, unsigned char * sieve)
 {
-    slong relations = 0, rels, i, j = 0;
+    slong i, next = 0, relations = 0;
+    slong num_threads = FLINT_MIN(qs_inf->num_threads, WORD(1) << qs_inf->s);
+    qsieve_worker_arg_t * args;
+    pthread_mutex_t mutex;
 
     qsieve_init_poly_first(qs_inf);
 
-#pragma omp parallel for
-    for (i = 0; i < (1 << qs_inf->s); i++)
-    {
-#if HAVE_OPENMP
-        unsigned char * thread_sieve = sieve + (qs_inf->sieve_size + sizeof(ulong) + 64)*omp_get_thread_num();
-        qs_poly_s * thread_poly = qs_inf->poly + omp_get_thread_num();
-#else
-        unsigned char * thread_sieve = sieve;
-        qs_poly_s * thread_poly = qs_inf->poly;
-#endif
+    args = flint_malloc(num_threads*sizeof(qsieve_worker_arg_t));
 
-#pragma omp critical
-        {
-           if (j == 0)
-              qsieve_poly_copy(thread_poly, qs_inf);
-           else
-           {
-              qsieve_init_poly_next(qs_inf, j);
-              qsieve_poly_copy(thread_poly, qs_inf);
-           }
-           j++;
-        }
+    pthread_mutex_init(&mutex, NULL);
 
-        if (qs_inf->sieve_size < 2*BLOCK_SIZE)
-           qsieve_do_sieving(qs_inf, thread_sieve, thread_poly);
-        else
-           qsieve_do_sieving2(qs_inf, thread_sieve, thread_poly);
+    for (i = 0; i < num_threads; i++)
+    {
+        args[i].inf = qs_inf;
+        args[i].sieve = sieve + (qs_inf->sieve_size + sizeof(ulong) + 64)*i;
+        args[i].poly = qs_inf->poly + i;
+        args[i].next = &next;
+        args[i].rels = 0;
+        args[i].mutex = &mutex;
+    }
 
-        rels = qsieve_evaluate_sieve(qs_inf, thread_sieve, thread_poly);
+    flint_parallel_do(_qsieve_collect_relations_worker,
+                              args, sizeof(qsieve_worker_arg_t), num_threads);
 
-#pragma omp atomic
-        relations += rels;
-    }
+    for (i = 0; i < num_threads; i++)
+        relations += args[i].rels;
+
+    pthread_mutex_destroy(&mutex);
+    flint_free(args);
 
     return relations;
 }
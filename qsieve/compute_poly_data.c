@@ -141,6 +141,9 @@ mp_limb_t qsieve_next_A0(qs_t qs_inf)
     qs_inf->m = m;
     fmpz_set(qs_inf->A0, prod);
 
+    if (ret)
+        qs_inf->A0_count++;
+
     fmpz_clear(prod);
     fmpz_clear(temp);
 
@@ -182,6 +185,7 @@ void qsieve_re_init_A0(qs_t qs_inf)
     qs_inf->low = low;
     qs_inf->high = high;
     qs_inf->span = span;
+    qs_inf->A0_count = 0;
     fmpz_set(qs_inf->A0, prod);
 
     fmpz_clear(prod);
@@ -389,6 +393,7 @@ int qsieve_init_A0(qs_t qs_inf)
     qs_inf->low = low;
     qs_inf->high = high;
     qs_inf->span = span;
+    qs_inf->A0_count = 0;
 
     fmpz_set(qs_inf->A0, prod);
 
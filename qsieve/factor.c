@@ -31,6 +31,40 @@ int compare_facs(const void * a, const void * b)
 */
 
 void qsieve_factor(fmpz_factor_t factors, const fmpz_t n)
+{
+    _qsieve_factor(factors, n, NULL, NULL, 0, NULL, NULL);
+}
+
+void qsieve_factor_store(fmpz_factor_t factors, const fmpz_t n,
+              const char * fname, const char * const * merge, slong num_merge)
+{
+    _qsieve_factor(factors, n, fname, merge, num_merge, NULL, NULL);
+}
+
+int qsieve_factor_progress(fmpz_factor_t factors, const fmpz_t n,
+                               fmpz_factor_progress_t progress, void * arg)
+{
+    return _qsieve_factor(factors, n, NULL, NULL, 0, progress, arg);
+}
+
+/* report the relations found so far out of those needed, nonzero to cancel */
+static int _qsieve_progress(qs_t qs_inf)
+{
+    if (qs_inf->progress == NULL)
+        return 0;
+
+    return qs_inf->progress(qs_inf->progress_arg, FMPZ_FACTOR_STAGE_QS,
+          qs_inf->n, qs_inf->full_relation + qs_inf->num_cycles,
+          (slong) (1.10*qs_inf->num_primes) + qs_inf->ks_primes + qs_inf->extra_rels);
+}
+
+/*
+   Returns 1 once the factors of n are appended to factors, or 0 if the
+   progress callback cancelled the factorisation, leaving factors unchanged.
+*/
+int _qsieve_factor(fmpz_factor_t factors, const fmpz_t n,
+              const char * fname, const char * const * merge, slong num_merge,
+                                fmpz_factor_progress_t progress, void * arg)
 {
     qs_t qs_inf;
     mp_limb_t small_factor, delta;
@@ -43,6 +77,7 @@ void qsieve_factor(fmpz_factor_t factors, const fmpz_t n)
     fmpz_t temp, X, Y;
     slong num_facs;
     fmpz * facs;
+    int ret = 1;
 
     if (fmpz_sgn(n) < 0)
     {
@@ -53,11 +88,12 @@ void qsieve_factor(fmpz_factor_t factors, const fmpz_t n)
 
        factors->sign *= -1;
        
-       qsieve_factor(factors, n2);
+       ret = _qsieve_factor(factors, n2, fname, merge, num_merge,
+                                                               progress, arg);
 
        fmpz_clear(n2);
        
-       return;
+       return ret;
     }
 
     fmpz_init(temp);
@@ -73,6 +109,9 @@ void qsieve_factor(fmpz_factor_t factors, const fmpz_t n)
 
     qsieve_init(qs_inf, n);
 
+    qs_inf->progress = progress;
+    qs_inf->progress_arg = arg;
+
 #if QS_DEBUG
     flint_printf("factoring ");
     fmpz_print(qs_inf->n);
@@ -114,7 +153,7 @@ void qsieve_factor(fmpz_factor_t factors, const fmpz_t n)
 
         fmpz_clear(temp);
         
-        return;
+        return 1;
     }
 
     /* compute kn */
@@ -138,6 +177,16 @@ void qsieve_factor(fmpz_factor_t factors, const fmpz_t n)
     /* compute factor base primes and associated data */
     small_factor = qsieve_primes_init(qs_inf);
 
+    /* open the relation store, resuming with the factor base it was using */
+    if (!small_factor)
+    {
+        num_primes = qsieve_store_open(qs_inf, fname, merge, num_merge);
+
+        if (num_primes > qs_inf->num_primes)
+            small_factor = qsieve_primes_increment(qs_inf,
+                                               num_primes - qs_inf->num_primes);
+    }
+
     if (small_factor)
     {
 
@@ -154,13 +203,14 @@ void qsieve_factor(fmpz_factor_t factors, const fmpz_t n)
 
         _fmpz_factor_append_ui(factors, small_factor, expt);
         
+        qsieve_store_close(qs_inf);
         qsieve_clear(qs_inf);
 
         fmpz_factor_no_trial(factors, temp);
 
         fmpz_clear(temp);
 
-        return;
+        return 1;
     }
 
     fmpz_init(X);
@@ -177,6 +227,9 @@ void qsieve_factor(fmpz_factor_t factors, const fmpz_t n)
 
     qsieve_linalg_init(qs_inf);
 
+    /* account for relations found by earlier runs and other processes */
+    qsieve_store_count_partials(qs_inf);
+
     /**************************************************************************
         POLYNOMIAL INITIALIZATION AND SIEVING:
         Sieve for relations
@@ -186,15 +239,10 @@ void qsieve_factor(fmpz_factor_t factors, const fmpz_t n)
     flint_printf("\nPolynomial Initialisation and Sieving\n");
 #endif
 
-#if HAVE_OPENMP
-    /* ensure cache lines don't overlap */
-    sieve = flint_malloc((qs_inf->sieve_size + sizeof(ulong) + 64)*omp_get_max_threads());
-#else
-    sieve = flint_malloc(qs_inf->sieve_size + sizeof(ulong));
-#endif
+    /* one sieve per thread, ensuring cache lines don't overlap */
+    sieve = flint_malloc((qs_inf->sieve_size + sizeof(ulong) + 64)*qs_inf->num_threads);
 
     qs_inf->q_idx = qs_inf->num_primes;
-    qs_inf->siqs = fopen("siqs.dat", "w");
 
     for (j = qs_inf->small_primes; j < qs_inf->num_primes; j++)
     {
@@ -220,6 +268,10 @@ void qsieve_factor(fmpz_factor_t factors, const fmpz_t n)
 
         do
         {
+            /* skip A0 done before a checkpoint or left to other processes */
+            if (!qsieve_store_own_A0(qs_inf))
+                continue;
+
             qsieve_compute_pre_data(qs_inf);
             
             for (j = qs_inf->num_primes; j < qs_inf->num_primes + qs_inf->ks_primes; j++)
@@ -228,6 +280,18 @@ void qsieve_factor(fmpz_factor_t factors, const fmpz_t n)
                 printf("j = %ld, num_primes + ks_primes = %ld\n", j, qs_inf->num_primes + qs_inf->ks_primes);
 #endif
                 qs_inf->q_idx  = j;
+
+                /* skip A done before a checkpoint */
+                if (qsieve_store_A_index(qs_inf) < qs_inf->A_done)
+                    continue;
+
+                /* polled once polynomials are set up, and after each checkpoint */
+                if (_qsieve_progress(qs_inf))
+                {
+                    ret = 0;
+                    goto cleanup;
+                }
+
                 relation += qsieve_collect_relations(qs_inf, sieve);
                 
                 qs_inf->num_cycles = qs_inf->edges + qs_inf->components - qs_inf->vertices;
@@ -244,8 +308,6 @@ void qsieve_factor(fmpz_factor_t factors, const fmpz_t n)
                 {
                     int ok;
 
-                    fclose(qs_inf->siqs);
-
                     ok = qsieve_process_relation(qs_inf);
 
                     if (ok == -1)
@@ -268,7 +330,7 @@ void qsieve_factor(fmpz_factor_t factors, const fmpz_t n)
                        num_primes = qs_inf->num_primes;
                        qs_inf->num_primes += qs_inf->ks_primes;
 
-                       ncols = qs_inf->num_primes + qs_inf->extra_rels;
+                       ncols = qs_inf->columns; /* relations kept by filtering */
                        nrows = qs_inf->num_primes;
 
                        reduce_matrix(qs_inf, &nrows, &ncols, qs_inf->matrix);
@@ -364,11 +426,12 @@ void qsieve_factor(fmpz_factor_t factors, const fmpz_t n)
 
                        _fmpz_vec_clear(facs, 100);
 
-                       qs_inf->siqs = fopen("siqs.dat", "w");
                        qs_inf->num_primes = num_primes; /* linear algebra adjusts this */
                        goto more_primes; /* need more primes */
                     }
                 }
+
+                qsieve_store_checkpoint(qs_inf);
             }
         } while (qsieve_next_A0(qs_inf));
 
@@ -428,6 +491,10 @@ found_small_factor:
 
         qsieve_linalg_re_alloc(qs_inf);
         relation = 0;
+
+        /* relations refer to factor base indices, so start a new store */
+        qsieve_store_reset(qs_inf);
+        qsieve_store_count_partials(qs_inf);
     }
 
     /**************************************************************************
@@ -446,8 +513,10 @@ cleanup:
     qsieve_clear(qs_inf);
     qsieve_linalg_clear(qs_inf);
     qsieve_poly_clear(qs_inf);
-    remove("siqs.dat");
+    qsieve_store_close(qs_inf);
     fmpz_clear(X);
     fmpz_clear(Y);
     fmpz_clear(temp);
+
+    return ret;
 }
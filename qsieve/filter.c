@@ -0,0 +1,336 @@
+/*
+    Copyright (C) 2026 agent
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include "qsieve.h"
+
+/*
+   Relations are filtered as columns of the matrix over GF(2), i.e. by the
+   primes which they contain to an odd power (the rows).
+
+   A relation containing a prime which no other relation contains cannot
+   be part of a dependency, and is removed (singleton removal). As removing
+   it can leave other primes in only one relation, this is repeated until
+   every remaining prime is in at least two relations.
+
+   The excess, the number of relations less the number of primes they
+   contain, is then at least what it was. Relations are removed until it
+   is brought down to the requested value, choosing them so as to shrink
+   the matrix as much as possible (clique removal). Relations sharing a
+   prime which only they contain are linked, and a connected set of such
+   relations is a clique. Removing a whole clique of k relations removes
+   at least k - 1 primes, so lowers the excess by at most one, and it is
+   best to remove the largest cliques first.
+*/
+
+typedef struct
+{
+    slong num_rels;
+    slong num_rows;
+    slong * rel_start;  /* rows of relation i are rel_row[rel_start[i]] ... */
+    slong * rel_row;
+    slong * row_start;  /* relations of row i are row_rel[row_start[i]] ... */
+    slong * row_rel;
+    slong * weight;     /* number of active relations each row is in */
+    char * active;      /* whether each relation is kept */
+    slong * stack;      /* rows which may have become singletons */
+    slong top;
+}
+qsieve_filter_s;
+
+typedef struct
+{
+    slong root;
+    slong size;
+    slong weight;
+}
+qsieve_clique_t;
+
+static void _qsieve_filter_remove(qsieve_filter_s * F, slong i)
+{
+    slong k, r;
+
+    F->active[i] = 0;
+
+    for (k = F->rel_start[i]; k < F->rel_start[i + 1]; k++)
+    {
+        r = F->rel_row[k];
+
+        if (--F->weight[r] == 1)
+            F->stack[F->top++] = r;
+    }
+}
+
+static void _qsieve_filter_singletons(qsieve_filter_s * F)
+{
+    slong k, r;
+
+    while (F->top > 0)
+    {
+        r = F->stack[--F->top];
+
+        if (F->weight[r] != 1)
+            continue;
+
+        for (k = F->row_start[r]; k < F->row_start[r + 1]; k++)
+        {
+            if (F->active[F->row_rel[k]])
+            {
+                _qsieve_filter_remove(F, F->row_rel[k]);
+                break;
+            }
+        }
+    }
+}
+
+static slong _qsieve_filter_find(slong * parent, slong i)
+{
+    while (parent[i] != i)
+    {
+        parent[i] = parent[parent[i]];
+        i = parent[i];
+    }
+
+    return i;
+}
+
+static int _qsieve_clique_cmp(const void * a, const void * b)
+{
+    const qsieve_clique_t * c1 = (const qsieve_clique_t *) a;
+    const qsieve_clique_t * c2 = (const qsieve_clique_t *) b;
+
+    /* largest, then heaviest, first */
+    if (c1->size != c2->size)
+        return c1->size > c2->size ? -1 : 1;
+
+    if (c1->weight != c2->weight)
+        return c1->weight > c2->weight ? -1 : 1;
+
+    return (c1->root > c2->root) - (c1->root < c2->root);
+}
+
+/*
+   remove up to num cliques, returning the number of relations removed
+*/
+static slong _qsieve_filter_cliques(qsieve_filter_s * F, slong num)
+{
+    slong i, k, r, a, b, num_cliques, removed = 0;
+    slong * parent, * index;
+    qsieve_clique_t * cliques;
+
+    parent = flint_malloc(F->num_rels * sizeof(slong));
+    index = flint_malloc(F->num_rels * sizeof(slong));
+
+    for (i = 0; i < F->num_rels; i++)
+        parent[i] = i;
+
+    /* link the two relations of each prime of weight two */
+    for (r = 0; r < F->num_rows; r++)
+    {
+        if (F->weight[r] != 2)
+            continue;
+
+        for (a = -1, k = F->row_start[r]; k < F->row_start[r + 1]; k++)
+        {
+            i = F->row_rel[k];
+
+            if (!F->active[i])
+                continue;
+
+            if (a == -1)
+                a = _qsieve_filter_find(parent, i);
+            else
+            {
+                b = _qsieve_filter_find(parent, i);
+                if (a != b)
+                    parent[b] = a;
+                break;
+            }
+        }
+    }
+
+    /* gather the size and weight of each clique */
+    cliques = flint_malloc(F->num_rels * sizeof(qsieve_clique_t));
+
+    for (i = 0, num_cliques = 0; i < F->num_rels; i++)
+    {
+        if (F->active[i] && _qsieve_filter_find(parent, i) == i)
+        {
+            index[i] = num_cliques;
+            cliques[num_cliques].root = i;
+            cliques[num_cliques].size = 0;
+            cliques[num_cliques].weight = 0;
+            num_cliques++;
+        }
+    }
+
+    for (i = 0; i < F->num_rels; i++)
+    {
+        if (F->active[i])
+        {
+            k = index[_qsieve_filter_find(parent, i)];
+            cliques[k].size++;
+            cliques[k].weight += F->rel_start[i + 1] - F->rel_start[i];
+        }
+    }
+
+    qsort(cliques, num_cliques, sizeof(qsieve_clique_t), _qsieve_clique_cmp);
+
+    /* mark the roots of the cliques to remove */
+    num = FLINT_MIN(num, num_cliques);
+
+    for (i = 0; i < F->num_rels; i++)
+        index[i] = 0;
+
+    for (k = 0; k < num; k++)
+        index[cliques[k].root] = 1;
+
+    for (i = 0; i < F->num_rels; i++)
+    {
+        if (F->active[i] && index[_qsieve_filter_find(parent, i)])
+        {
+            _qsieve_filter_remove(F, i);
+            removed++;
+        }
+    }
+
+    flint_free(cliques);
+    flint_free(parent);
+    flint_free(index);
+
+    return removed;
+}
+
+slong qsieve_filter_relations(qs_t qs_inf, slong * nrows,
+                       relation_t * rel_list, slong num_relations, slong excess)
+{
+    qsieve_filter_s F[1];
+    slong i, j, k, r, num_rels, num_rows;
+    relation_t t;
+
+    F->num_rels = num_relations;
+    F->num_rows = qs_inf->num_primes + qs_inf->ks_primes;
+
+    /* rows of each relation */
+    F->rel_start = flint_malloc((num_relations + 1) * sizeof(slong));
+
+    for (i = 0, k = 0; i < num_relations; i++)
+        k += qs_inf->small_primes + rel_list[i].num_factors;
+
+    F->rel_row = flint_malloc(FLINT_MAX(k, 1) * sizeof(slong));
+
+    for (i = 0, k = 0; i < num_relations; i++)
+    {
+        F->rel_start[i] = k;
+
+        for (j = 0; j < qs_inf->small_primes; j++)
+        {
+            if (rel_list[i].small[j] & 1)
+                F->rel_row[k++] = j;
+        }
+
+        for (j = 0; j < rel_list[i].num_factors; j++)
+        {
+            if (rel_list[i].factor[j].exp & 1)
+                F->rel_row[k++] = rel_list[i].factor[j].ind;
+        }
+    }
+
+    F->rel_start[num_relations] = k;
+
+    /* relations of each row */
+    F->weight = flint_calloc(F->num_rows, sizeof(slong));
+    F->row_start = flint_malloc((F->num_rows + 1) * sizeof(slong));
+    F->row_rel = flint_malloc(FLINT_MAX(k, 1) * sizeof(slong));
+
+    for (k = 0; k < F->rel_start[num_relations]; k++)
+        F->weight[F->rel_row[k]]++;
+
+    for (r = 0, k = 0; r < F->num_rows; r++)
+    {
+        F->row_start[r] = k;
+        k += F->weight[r];
+    }
+
+    F->row_start[F->num_rows] = k;
+
+    for (r = 0; r < F->num_rows; r++)
+        F->weight[r] = F->row_start[r];
+
+    for (i = 0; i < num_relations; i++)
+    {
+        for (k = F->rel_start[i]; k < F->rel_start[i + 1]; k++)
+            F->row_rel[F->weight[F->rel_row[k]]++] = i;
+    }
+
+    for (r = 0; r < F->num_rows; r++)
+        F->weight[r] = F->row_start[r + 1] - F->row_start[r];
+
+    F->active = flint_malloc(FLINT_MAX(num_relations, 1));
+    memset(F->active, 1, num_relations);
+
+    /* every row is pushed at most once per relation it loses */
+    F->stack = flint_malloc(FLINT_MAX(F->rel_start[num_relations] + F->num_rows, 1)
+                                                               * sizeof(slong));
+    F->top = 0;
+
+    for (r = 0; r < F->num_rows; r++)
+    {
+        if (F->weight[r] == 1)
+            F->stack[F->top++] = r;
+    }
+
+    _qsieve_filter_singletons(F);
+
+    while (1)
+    {
+        for (i = 0, num_rels = 0; i < num_relations; i++)
+            num_rels += F->active[i];
+
+        for (r = 0, num_rows = 0; r < F->num_rows; r++)
+            num_rows += (F->weight[r] != 0);
+
+        if (num_rels - num_rows <= excess)
+            break;
+
+        /*
+           each clique lowers the excess by at most one, and singleton
+           removal never lowers it, so this cannot overshoot
+        */
+        if (_qsieve_filter_cliques(F, (num_rels - num_rows - excess + 1)/2) == 0)
+            break;
+
+        _qsieve_filter_singletons(F);
+    }
+
+    /* move the remaining relations to the front, keeping their order */
+    for (i = 0, j = 0; i < num_relations; i++)
+    {
+        if (F->active[i])
+        {
+            t = rel_list[j];
+            rel_list[j] = rel_list[i];
+            rel_list[i] = t;
+            j++;
+        }
+    }
+
+    *nrows = num_rows;
+
+    flint_free(F->rel_start);
+    flint_free(F->rel_row);
+    flint_free(F->row_start);
+    flint_free(F->row_rel);
+    flint_free(F->weight);
+    flint_free(F->active);
+    flint_free(F->stack);
+
+    return j;
+}
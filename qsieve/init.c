@@ -40,9 +40,12 @@ void qsieve_init(qs_t qs_inf, const fmpz_t n)
     qs_inf->vertices = 0;
     qs_inf->components = 0;
     qs_inf->edges = 0;
+    qs_inf->dlp_bits = 0;
 #if QS_DEBUG
     qs_inf->poly_count = 0;
 #endif
+    qs_inf->poly = NULL;
+    qs_inf->num_threads = FLINT_MAX(flint_get_num_threads(), 1);
 
     fmpz_init(qs_inf->kn); /* initialise kn */
 
@@ -50,4 +53,15 @@ void qsieve_init(qs_t qs_inf, const fmpz_t n)
     qs_inf->sqrts       = NULL;
 
     qs_inf->s = 0;
+
+    qs_inf->siqs = NULL;
+    qs_inf->fname = NULL;
+    qs_inf->merge_fname = NULL;
+    qs_inf->num_merge = 0;
+    qs_inf->store_rank = 0;
+    qs_inf->store_procs = 1;
+    qs_inf->progress = NULL;
+    qs_inf->progress_arg = NULL;
+    qs_inf->A0_count = 0;
+    qs_inf->A_done = 0;
 }
@@ -10,7 +10,6 @@
     (at your option) any later version.  See <http://www.gnu.org/licenses/>.
 */
 
-#include <ctype.h>
 #include "qsieve.h"
 
 #define HASH_MULT (2654435761U)       /* hash function, taken from 'msieve' */
@@ -22,7 +21,7 @@ void qsieve_display_relation(qs_t qs_inf, relation_t a)
 {
     slong i;
 
-    flint_printf("%wu ", a.lp);
+    flint_printf("%wu %wu ", a.lp, a.lp2);
 
     for (i = 0; i < qs_inf->small_primes; i++)
         flint_printf("%wd ", a.small[i]);
@@ -65,6 +64,7 @@ int qsieve_is_relation(qs_t qs_inf, relation_t a)
     }
 
     fmpz_mul_ui(temp2, temp2, a.lp);
+    fmpz_mul_ui(temp2, temp2, a.lp2);
     fmpz_pow_ui(temp, a.Y, UWORD(2));
     fmpz_mod(temp, temp, qs_inf->kn);
     fmpz_mod(temp2, temp2, qs_inf->kn);
@@ -80,31 +80,6 @@ int qsieve_is_relation(qs_t qs_inf, relation_t a)
     return 1;
 }
 
-/* write partial or full relation to file */
-void qsieve_write_to_file(qs_t qs_inf, mp_limb_t prime, fmpz_t Y, qs_poly_t poly)
-{
-    slong i;
-    char * str = NULL;
-    slong num_factors = poly->num_factors;
-    slong * small = poly->small;
-    fac_t * factor = poly->factor;
-
-    flint_fprintf(qs_inf->siqs, "%X ", prime);  /* write large prime */
-
-    for (i = 0; i < qs_inf->small_primes; i++)   /* write small primes */
-        flint_fprintf(qs_inf->siqs, "%X ", small[i]);
-
-    flint_fprintf(qs_inf->siqs, "%X ", num_factors);  /* write number of factors */
-
-    for (i = 0; i < num_factors; i++)               /* write factor along with exponent */
-        flint_fprintf(qs_inf->siqs, "%wx %X ", factor[i].ind, factor[i].exp);
-
-    str = fmpz_get_str(str, 16, Y);    /* converting value of 'Y'  to hex */
-
-    flint_fprintf(qs_inf->siqs, "%s\n", str);   /* write value of 'Y' */
-    flint_free(str);
-}
-
 /*********************************************************
     main function starts here
 **********************************************************/
@@ -154,12 +129,30 @@ hash_t * qsieve_get_table_entry(qs_t qs_inf, mp_limb_t prime)
         entry->prime = prime;
         entry->next = hash_table[first_offset];
         entry->count = 0;
+        entry->parent = qs_inf->vertices;
         hash_table[first_offset] = qs_inf->vertices;
+        qs_inf->components++;
     }
     
     return entry;
 }
 
+/*
+   empty the hash table, touching only the slots in use rather than
+   the whole table
+*/
+
+void qsieve_reset_hashtable(qs_t qs_inf)
+{
+    slong i;
+
+    for (i = 1; i <= qs_inf->vertices; i++)
+        qs_inf->hash_table[HASH(qs_inf->table[i].prime)] = 0;
+
+    qs_inf->vertices = 0;
+    qs_inf->components = 0;
+}
+
 /*
    add prime to hashtable, increase size of table if neccessay
    and increment count for the added prime
@@ -173,59 +166,43 @@ void qsieve_add_to_hashtable(qs_t qs_inf, mp_limb_t prime)
     entry->count++;
 }
 
-/*
-   given a string representing a relation, parse it to
-   obtain relation
-*/
-
-relation_t qsieve_parse_relation(qs_t qs_inf, char * str)
+static slong _qsieve_table_find(hash_t * table, slong i)
 {
-    slong i;
-    char * next;
-    relation_t rel;
-
-    rel.lp = UWORD(1);
-    rel.small = flint_malloc(qs_inf->small_primes * sizeof(slong));
-    rel.factor = flint_malloc(qs_inf->max_factors * sizeof(fac_t));
-
-    for (i = 0; i < qs_inf->small_primes; i++)
+    while (table[i].parent != i)
     {
-        while (isspace(*str))
-            str++;
-
-        rel.small[i] = strtoul(str, &next, 16);
-        str = next;
+        table[i].parent = table[table[i].parent].parent;
+        i = table[i].parent;
     }
 
-    while (isspace(*str))
-        str++;
-
-    rel.num_factors = strtoul(str, &next, 16);
-    rel.small_primes = qs_inf->small_primes;
-    str = next;
-
-    for (i = 0; i < rel.num_factors; i++)
-    {
-        while (isspace(*str))
-            str++;
+    return i;
+}
 
-        rel.factor[i].ind = strtoul(str, &next, 16);
-        str = next;
+/*
+   add a partial to the graph whose vertices are the large primes and 1,
+   the partial being an edge between its two large primes, or its large
+   prime and 1, keeping track of the connected components so that the
+   number of independent cycles is edges + components - vertices
+*/
 
-        while (isspace(*str))
-            str++;
+void qsieve_add_edge(qs_t qs_inf, mp_limb_t lp, mp_limb_t lp2)
+{
+    slong a, b;
 
-        rel.factor[i].exp = strtoul(str, &next, 16);
-        str = next;
-    }
+    a = qsieve_get_table_entry(qs_inf, lp) - qs_inf->table;
+    b = qsieve_get_table_entry(qs_inf, lp2) - qs_inf->table;
 
-    while (isspace(*str))
-        str++;
+    qs_inf->table[a].count++;
+    qs_inf->table[b].count++;
+    qs_inf->edges++;
 
-    fmpz_init(rel.Y);
-    fmpz_set_str(rel.Y, str, 16);
+    a = _qsieve_table_find(qs_inf->table, a);
+    b = _qsieve_table_find(qs_inf->table, b);
 
-    return rel;
+    if (a != b)
+    {
+        qs_inf->table[b].parent = a;
+        qs_inf->components--;
+    }
 }
 
 /*
@@ -240,6 +217,7 @@ relation_t qsieve_merge_relation(qs_t qs_inf, relation_t a, relation_t b)
     fmpz_t temp;
 
     c.lp = UWORD(1);
+    c.lp2 = UWORD(1);
     c.small = flint_malloc(qs_inf->small_primes * sizeof(slong));
     c.factor = flint_malloc(qs_inf->max_factors * sizeof(fac_t));
     fmpz_init(c.Y);
@@ -320,7 +298,7 @@ relation_t qsieve_merge_relation(qs_t qs_inf, relation_t a, relation_t b)
 
 /*
    compare two relations in the following order,
-   large_prime, number of factors, factor, small_prime
+   large primes, number of factors, factor, small_prime
 */
 
 int qsieve_compare_relation(const void * a, const void * b)
@@ -335,6 +313,12 @@ int qsieve_compare_relation(const void * a, const void * b)
     if (r1->lp < r2->lp)
         return -1;
 
+    if (r1->lp2 > r2->lp2)
+        return 1;
+
+    if (r1->lp2 < r2->lp2)
+        return -1;
+
     if (r1->num_factors > r2->num_factors)
         return 1;
 
@@ -460,118 +444,566 @@ void qsieve_insert_relation2(qs_t qs_inf, relation_t * rel_list, slong num_relat
 }
 
 /*
-   process relations from the file
+   Partials are combined into full relations along the cycles of the graph
+   of partials. Edges which are on no cycle are removed first, by deleting
+   the edge at a vertex of degree one for as long as there is such a vertex.
+   A spanning forest of the rest is found by breadth first search. Each
+   remaining edge which is not in the forest closes a cycle with the paths
+   in the forest from its ends to their common ancestor, and these cycles
+   are independent. The product of the relations around a cycle contains
+   each of its vertices twice, so dividing it by the product of the
+   vertices gives a full relation.
+*/
+
+typedef struct
+{
+    mp_limb_t lp;   /* large primes, both 1 for a full relation */
+    mp_limb_t lp2;
+    uint64_t hash;  /* hash of the record, to detect duplicates */
+    slong rec;      /* number of the record in the stores */
+} qsieve_edge_t;
+
+static int _qsieve_edge_cmp(const void * a, const void * b)
+{
+    const qsieve_edge_t * e1 = (const qsieve_edge_t *) a;
+    const qsieve_edge_t * e2 = (const qsieve_edge_t *) b;
+
+    if (e1->lp != e2->lp)
+        return e1->lp > e2->lp ? 1 : -1;
+
+    if (e1->lp2 != e2->lp2)
+        return e1->lp2 > e2->lp2 ? 1 : -1;
+
+    if (e1->hash != e2->hash)
+        return e1->hash > e2->hash ? 1 : -1;
+
+    return (e1->rec > e2->rec) - (e1->rec < e2->rec);
+}
+
+static int _qsieve_slong_cmp(const void * a, const void * b)
+{
+    slong x = *((const slong *) a);
+    slong y = *((const slong *) b);
+
+    return (x > y) - (x < y);
+}
+
+/*
+   hash of the factorisation in a relation record, but not of Y, as the
+   same relation can be found with Y and -Y
+*/
+
+static uint64_t _qsieve_record_hash(qs_t qs_inf,
+                                          const unsigned char * buf, slong len)
+{
+    uint64_t h = UINT64_C(14695981039346656037);
+    const unsigned char * p = buf, * end = buf + len;
+    mp_limb_t x, num;
+    slong i;
+
+    for (i = 0; i < qs_inf->small_primes + 2; i++)
+        qsieve_store_get_ui(&x, &p, end);
+
+    if (qsieve_store_get_ui(&num, &p, end))
+    {
+        for (i = 0; i < 2*num && qsieve_store_get_ui(&x, &p, end); i++) ;
+    }
+
+    for (i = 0; i < p - buf; i++)
+        h = (h ^ buf[i]) * UINT64_C(1099511628211);
+
+    return h;
+}
+
+/*
+   combine the num relations in rels, whose large primes form a cycle,
+   into a full relation c, returning 0 if it has too many factors; exp
+   must be zero at every factor base index and is left so
+*/
+
+static int _qsieve_merge_cycle(qs_t qs_inf, relation_t * c,
+                     relation_t ** rels, slong num, slong * exp, slong * ind)
+{
+    slong i, j, k = 0, small = 0;
+    fmpz_t L;
+
+    c->small = flint_calloc(qs_inf->small_primes, sizeof(slong));
+    fmpz_init_set_ui(c->Y, 1);
+    fmpz_init_set_ui(L, 1);
+
+    for (i = 0; i < num; i++)
+    {
+        for (j = 0; j < qs_inf->small_primes; j++)
+            c->small[j] += rels[i]->small[j];
+
+        for (j = 0; j < rels[i]->num_factors; j++)
+        {
+            if (exp[rels[i]->factor[j].ind] == 0)
+                ind[k++] = rels[i]->factor[j].ind;
+
+            exp[rels[i]->factor[j].ind] += rels[i]->factor[j].exp;
+        }
+
+        fmpz_mul(c->Y, c->Y, rels[i]->Y);
+        fmpz_mod(c->Y, c->Y, qs_inf->kn);
+        fmpz_mul_ui(L, L, rels[i]->lp);
+        fmpz_mul_ui(L, L, rels[i]->lp2);
+    }
+
+    for (j = 0; j < qs_inf->small_primes; j++)
+        small += (c->small[j] != 0);
+
+    /* each factor takes two entries of the relation array and the count one */
+    if (small + k >= qs_inf->max_factors)
+    {
+        for (i = 0; i < k; i++)
+            exp[ind[i]] = 0;
+
+        flint_free(c->small);
+        fmpz_clear(c->Y);
+        fmpz_clear(L);
+
+        return 0;
+    }
+
+    qsort(ind, k, sizeof(slong), _qsieve_slong_cmp);
+
+    c->factor = flint_malloc(qs_inf->max_factors * sizeof(fac_t));
+
+    for (i = 0; i < k; i++)
+    {
+        c->factor[i].ind = ind[i];
+        c->factor[i].exp = exp[ind[i]];
+        exp[ind[i]] = 0;
+    }
+
+    c->num_factors = k;
+    c->small_primes = qs_inf->small_primes;
+    c->lp = UWORD(1);
+    c->lp2 = UWORD(1);
+
+    /* every vertex of the cycle occurs twice */
+    fmpz_sqrt(L, L);
+
+    if (fmpz_invmod(L, L, qs_inf->kn) == 0)
+    {
+        flint_printf("Inverse doesn't exist !!\n");
+        abort();
+    }
+
+    fmpz_mul(c->Y, c->Y, L);
+    fmpz_mod(c->Y, c->Y, qs_inf->kn);
+    fmpz_clear(L);
+
+    return 1;
+}
+
+/*
+   process relations from the stores
 */
 
 int qsieve_process_relation(qs_t qs_inf)
 {
-    char buf[1024];
-    char * str;
-    slong i, j, num_relations = 0, num_relations2, full = 0;
-    mp_limb_t prime;
-    hash_t * entry;
-    mp_limb_t * hash_table = qs_inf->hash_table;
-    slong rel_size = 50000;
-    relation_t * rel_list = (relation_t *) flint_malloc(rel_size * sizeof(relation_t));
-    relation_t * rlist;
-    int done = 0;
-  
-    qs_inf->siqs = fopen("siqs.dat", "r");
+    unsigned char * buf = NULL;
+    slong alloc = 0, len;
+    slong i, j, k, e, f, r, x, y, top, bottom, num;
+    slong num_edges = 0, edge_alloc = 1024, num_full = 0, num_partials;
+    slong num_vertices, num_rels = 0, num_cycles = 0, m = 0;
+    slong num_relations2, nrows;
+    mp_limb_t lp, lp2;
+    qsieve_edge_t * edges;
+    slong * rec_start, * slot, * head, * tail, * deg, * adj_start, * adj;
+    slong * stack, * depth, * parent, * exp, * ind, * path;
+    char * alive, * tree, * parsed;
+    relation_t * rel_list, * rlist, * mlist, ** cycle;
+    FILE * file;
+    long pos = 0;
+    int done = 0, tag;
 
 #if QS_DEBUG & 64
     printf("Getting relations\n");
 #endif
 
-    while (fgets(buf, sizeof(buf), qs_inf->siqs) != NULL)
+    /* read the large primes of all relations in all stores */
+    edges = flint_malloc(edge_alloc * sizeof(qsieve_edge_t));
+    rec_start = flint_malloc((qs_inf->num_merge + 2) * sizeof(slong));
+
+    for (k = 0; k <= qs_inf->num_merge; k++)
     {
-        prime = strtoul(buf, &str, 16);
-        entry = qsieve_get_table_entry(qs_inf, prime);
+        rec_start[k] = num_edges;
 
-        if (num_relations == rel_size)
-        {
-           rel_list = (relation_t *) flint_realloc(rel_list, 2*rel_size * sizeof(relation_t));
-           rel_size *= 2;
-        }
-        
-        if (prime == 1 || entry->count >= 2)
+        if ((file = qsieve_store_begin(qs_inf, k, &pos)) == NULL)
+            continue;
+
+        while (qsieve_store_read(file, &tag, &buf, &alloc, &len))
         {
-            rel_list[num_relations] = qsieve_parse_relation(qs_inf, str);
-            rel_list[num_relations].lp = prime;
-            num_relations++;
+            if (tag != 'R' || (lp = qsieve_store_relation_lp(&lp2, buf, len)) == 0)
+                continue;
+
+            if (num_edges == edge_alloc)
+            {
+                edge_alloc *= 2;
+                edges = flint_realloc(edges, edge_alloc * sizeof(qsieve_edge_t));
+            }
+
+            edges[num_edges].lp = lp;
+            edges[num_edges].lp2 = lp2;
+            edges[num_edges].hash = _qsieve_record_hash(qs_inf, buf, len);
+            edges[num_edges].rec = num_edges;
+            num_edges++;
         }
+
+        qsieve_store_end(qs_inf, k, file, pos);
     }
 
-    fclose(qs_inf->siqs);
+    rec_start[qs_inf->num_merge + 1] = num_edges;
 
 #if QS_DEBUG & 64
     printf("Removing duplicates\n");
 #endif
 
-    num_relations = qsieve_remove_duplicates(rel_list, num_relations);
+    /* full relations come first, then partials by large primes */
+    qsort(edges, num_edges, sizeof(qsieve_edge_t), _qsieve_edge_cmp);
+
+    for (i = 1, j = FLINT_MIN(num_edges, 1); i < num_edges; i++)
+    {
+        if (edges[i].lp != edges[j - 1].lp || edges[i].lp2 != edges[j - 1].lp2
+                                       || edges[i].hash != edges[j - 1].hash)
+            edges[j++] = edges[i];
+    }
+
+#if QS_DEBUG
+    flint_printf("%wd duplicates out of %wd\n", num_edges - j, num_edges);
+#endif
+
+    num_edges = j;
+
+    while (num_full < num_edges && edges[num_full].lp == 1
+                                && edges[num_full].lp2 == 1)
+        num_full++;
+
+    num_partials = num_edges - num_full;
 
 #if QS_DEBUG & 64
-    printf("Merging relations\n");
+    printf("Finding cycles\n");
 #endif
 
-    rlist = flint_malloc(num_relations * sizeof(relation_t));
-    memset(hash_table, 0, (1 << 25) * sizeof(mp_limb_t));
-    qs_inf->vertices = 0;
+    /* the graph of partials, whose edge e is the relation num_full + e */
+    qsieve_reset_hashtable(qs_inf);
+
+    /* vertex 1, the first, is the root of the search */
+    qsieve_get_table_entry(qs_inf, 1);
 
-    for (i = 0, j = 0; i < num_relations; i++)
+    head = flint_malloc((num_partials + 1) * sizeof(slong));
+    tail = flint_malloc((num_partials + 1) * sizeof(slong));
+
+    for (e = 0; e < num_partials; e++)
     {
-        if (rel_list[i].lp == UWORD(1))
-        {
-            rlist[j++] = rel_list[i];
-            full++;
-        }
-        else
+        head[e] = qsieve_get_table_entry(qs_inf, edges[num_full + e].lp)
+                                                              - qs_inf->table;
+        tail[e] = qsieve_get_table_entry(qs_inf, edges[num_full + e].lp2)
+                                                              - qs_inf->table;
+    }
+
+    num_vertices = qs_inf->vertices + 1;
+
+    deg = flint_calloc(num_vertices, sizeof(slong));
+    adj_start = flint_malloc((num_vertices + 1) * sizeof(slong));
+    adj = flint_malloc(2 * (num_partials + 1) * sizeof(slong));
+    alive = flint_malloc(num_partials + 1);
+    tree = flint_calloc(num_partials + 1, 1);
+
+    for (e = 0; e < num_partials; e++)
+    {
+        deg[head[e]]++;
+        deg[tail[e]]++;
+        alive[e] = 1;
+    }
+
+    for (x = 0, k = 0; x < num_vertices; x++)
+    {
+        adj_start[x] = k;
+        k += deg[x];
+    }
+
+    adj_start[num_vertices] = k;
+
+    for (x = 0; x < num_vertices; x++)
+        deg[x] = adj_start[x];
+
+    for (e = 0; e < num_partials; e++)
+    {
+        adj[deg[head[e]]++] = e;
+        adj[deg[tail[e]]++] = e;
+    }
+
+    for (x = 0; x < num_vertices; x++)
+        deg[x] = adj_start[x + 1] - adj_start[x];
+
+    /* remove the edges on no cycle, each vertex reaches degree 1 once */
+    stack = flint_malloc(num_vertices * sizeof(slong));
+
+    for (x = 0, top = 0; x < num_vertices; x++)
+    {
+        if (deg[x] == 1)
+            stack[top++] = x;
+    }
+
+    while (top > 0)
+    {
+        x = stack[--top];
+
+        if (deg[x] != 1)
+            continue;
+
+        for (k = adj_start[x]; !alive[adj[k]]; k++) ;
+
+        e = adj[k];
+        alive[e] = 0;
+        deg[head[e]]--;
+        deg[tail[e]]--;
+
+        y = (head[e] == x) ? tail[e] : head[e];
+
+        if (deg[y] == 1)
+            stack[top++] = y;
+    }
+
+    /* spanning forest by breadth first search */
+    depth = flint_malloc(num_vertices * sizeof(slong));
+    parent = flint_malloc(num_vertices * sizeof(slong));
+
+    for (x = 0; x < num_vertices; x++)
+        depth[x] = -1;
+
+    for (r = 1; r < num_vertices; r++)
+    {
+        if (depth[r] != -1 || deg[r] == 0)
+            continue;
+
+        depth[r] = 0;
+        parent[r] = -1;
+        stack[0] = r;
+
+        for (bottom = 0, top = 1; bottom < top; bottom++)
         {
-            entry = qsieve_get_table_entry(qs_inf, rel_list[i].lp);
+            x = stack[bottom];
 
-            if (entry->count == 0) entry->count = i;
-            else
+            for (k = adj_start[x]; k < adj_start[x + 1]; k++)
             {
-                if (fmpz_fdiv_ui(qs_inf->kn, rel_list[i].lp) == 0)
+                e = adj[k];
+                y = (head[e] == x) ? tail[e] : head[e];
+
+                if (alive[e] && depth[y] == -1)
                 {
-                   qs_inf->small_factor = rel_list[i].lp;
-                   
-                   done = -1;
-                   goto cleanup;
+                    depth[y] = depth[x] + 1;
+                    parent[y] = e;
+                    tree[e] = 1;
+                    stack[top++] = y;
                 }
-                rlist[j++] = qsieve_merge_relation(qs_inf, rel_list[i], rel_list[entry->count]);
             }
         }
     }
 
-    num_relations = j;
+    /* a large prime dividing kn is a factor */
+    for (x = 2; x < num_vertices; x++)
+    {
+        if (deg[x] != 0 && fmpz_fdiv_ui(qs_inf->kn, qs_inf->table[x].prime) == 0)
+        {
+            qs_inf->small_factor = qs_inf->table[x].prime;
+            done = -1;
+        }
+    }
+
+#if QS_DEBUG & 64
+    printf("Reading relations\n");
+#endif
+
+    /* parse the full relations and the partials on cycles */
+    slot = flint_malloc((rec_start[qs_inf->num_merge + 1] + 1) * sizeof(slong));
+
+    for (i = 0; i < rec_start[qs_inf->num_merge + 1]; i++)
+        slot[i] = -1;
+
+    for (i = 0; i < num_edges; i++)
+    {
+        if (i < num_full || alive[i - num_full])
+            slot[edges[i].rec] = num_rels++;
+
+        if (i >= num_full && alive[i - num_full] && !tree[i - num_full])
+            num_cycles++;
+    }
+
+    rel_list = flint_malloc((num_rels + 1) * sizeof(relation_t));
+    parsed = flint_calloc(num_rels + 1, 1);
+
+    for (k = 0; k <= qs_inf->num_merge && done != -1; k++)
+    {
+        if ((file = qsieve_store_begin(qs_inf, k, &pos)) == NULL)
+            continue;
+
+        /* only the records read before, as other stores may have grown */
+        r = rec_start[k];
+
+        while (r < rec_start[k + 1]
+                         && qsieve_store_read(file, &tag, &buf, &alloc, &len))
+        {
+            if (tag != 'R' || qsieve_store_relation_lp(&lp2, buf, len) == 0)
+                continue;
+
+            if (slot[r] != -1)
+            {
+                rel_list[slot[r]] = qsieve_parse_relation(qs_inf, buf, len);
+                parsed[slot[r]] = 1;
+            }
+
+            r++;
+        }
+
+        qsieve_store_end(qs_inf, k, file, pos);
+    }
+
+    flint_free(buf);
+
+    /* each relation now refers to its parsed form, or -1 */
+    for (i = 0; i < num_edges; i++)
+    {
+        j = slot[edges[i].rec];
+
+        edges[i].rec = (j != -1 && parsed[j] && rel_list[j].num_factors >= 0)
+                                                                      ? j : -1;
+    }
+
+    rlist = flint_malloc((num_full + num_cycles + 1) * sizeof(relation_t));
+    mlist = flint_malloc((num_cycles + 1) * sizeof(relation_t));
+    exp = flint_calloc(qs_inf->num_primes + qs_inf->ks_primes, sizeof(slong));
+    ind = flint_malloc((qs_inf->num_primes + qs_inf->ks_primes) * sizeof(slong));
+    path = flint_malloc(2 * num_vertices * sizeof(slong));
+    cycle = flint_malloc(2 * num_vertices * sizeof(relation_t *));
+
+    if (done == -1)
+        goto cleanup;
+
+    for (i = 0, j = 0; i < num_full; i++)
+    {
+        if (edges[i].rec != -1)
+            rlist[j++] = rel_list[edges[i].rec];
+    }
 
 #if QS_DEBUG & 64
-    printf("Sorting relations\n");
+    printf("Merging relations\n");
 #endif
 
-    if (j < qs_inf->num_primes + qs_inf->ks_primes + qs_inf->extra_rels)
+    /* merged relations follow the full ones */
+    for (e = 0; e < num_partials; e++)
     {
+        if (!alive[e] || tree[e])
+            continue;
+
+        num = 0;
+        path[num++] = e;
+        x = head[e];
+        y = tail[e];
+
+        while (x != y)
+        {
+            if (depth[x] >= depth[y])
+            {
+                f = parent[x];
+                x = (head[f] == x) ? tail[f] : head[f];
+            } else
+            {
+                f = parent[y];
+                y = (head[f] == y) ? tail[f] : head[f];
+            }
+
+            path[num++] = f;
+        }
+
+        for (k = 0; k < num; k++)
+        {
+            if (edges[num_full + path[k]].rec == -1)
+                break;
+
+            cycle[k] = rel_list + edges[num_full + path[k]].rec;
+        }
+
+        if (k == num && _qsieve_merge_cycle(qs_inf, mlist + m, cycle, num, exp, ind))
+            rlist[j++] = mlist[m++];
+    }
+
+#if QS_DEBUG
+    flint_printf("%wd full relations, %wd cycles, %wd merged\n",
+                                                        j - m, num_cycles, m);
+#endif
+
+#if QS_DEBUG & 64
+    printf("Filtering relations\n");
+#endif
+
+    num_relations2 = qsieve_filter_relations(qs_inf, &nrows, rlist, j,
+                                         qs_inf->extra_rels + QS_FILTER_EXCESS);
+
+#if QS_DEBUG
+    flint_printf("filtering: %wd x %wd matrix reduced to %wd x %wd\n",
+                 qs_inf->num_primes + qs_inf->ks_primes, j, nrows, num_relations2);
+#endif
+
+    if (num_relations2 < nrows + qs_inf->extra_rels)
+    {
+       /* restore the graph of partials and sieve for a while longer */
+       qsieve_store_count_partials(qs_inf);
        qs_inf->edges -= 100;
        done = 0;
-       qs_inf->siqs = fopen("siqs.dat", "a");
     } else
     {
        done = 1;
-       num_relations2 = qs_inf->num_primes + qs_inf->ks_primes + qs_inf->extra_rels;
+       num_relations2 = FLINT_MIN(num_relations2,
+                                  nrows + qs_inf->extra_rels + QS_FILTER_EXCESS);
        qsort(rlist, (size_t) num_relations2, sizeof(relation_t), qsieve_compare_relation);
        qsieve_insert_relation2(qs_inf, rlist, num_relations2);
     }
 
 cleanup:
 
-    for (i = 0; i < num_relations; i++)
+    for (i = 0; i < m; i++)
     {
-       flint_free(rel_list[i].small);
-       flint_free(rel_list[i].factor);
+       flint_free(mlist[i].small);
+       flint_free(mlist[i].factor);
+       fmpz_clear(mlist[i].Y);
     }
+
+    for (i = 0; i < num_rels; i++)
+    {
+       if (parsed[i])
+       {
+          flint_free(rel_list[i].small);
+          flint_free(rel_list[i].factor);
+          fmpz_clear(rel_list[i].Y);
+       }
+    }
+
     flint_free(rel_list);
+    flint_free(parsed);
     flint_free(rlist);
+    flint_free(mlist);
+    flint_free(edges);
+    flint_free(rec_start);
+    flint_free(slot);
+    flint_free(head);
+    flint_free(tail);
+    flint_free(deg);
+    flint_free(adj_start);
+    flint_free(adj);
+    flint_free(alive);
+    flint_free(tree);
+    flint_free(stack);
+    flint_free(depth);
+    flint_free(parent);
+    flint_free(exp);
+    flint_free(ind);
+    flint_free(path);
+    flint_free(cycle);
 
     return done;
 }
-
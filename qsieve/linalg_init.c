@@ -48,7 +48,7 @@ void qsieve_linalg_init(qs_t qs_inf)
     qs_inf->full_relation = 0;
     qs_inf->edges = 0;
     qs_inf->vertices = 0;
-    qs_inf->components = 1;
+    qs_inf->components = 0;
     qs_inf->num_cycles = 0;
 
     qs_inf->table_size = 10000;
@@ -78,7 +78,7 @@ void qsieve_linalg_re_init(qs_t qs_inf)
     qs_inf->full_relation = 0;
     qs_inf->edges = 0;
     qs_inf->vertices = 0;
-    qs_inf->components = 1;
+    qs_inf->components = 0;
     qs_inf->num_cycles = 0;
 
     memset(qs_inf->hash_table, 0, (1 << 25) * sizeof(mp_limb_t));
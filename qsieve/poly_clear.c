@@ -48,8 +48,7 @@ void qsieve_poly_clear(qs_t qs_inf)
 
    flint_free(qs_inf->A_inv2B);
 
-#if HAVE_OPENMP
-   for (i = 0; i < omp_get_max_threads(); i++)
+   for (i = 0; qs_inf->poly != NULL && i < qs_inf->num_threads; i++)
    {
       fmpz_clear(qs_inf->poly[i].B);
       flint_free(qs_inf->poly[i].posn1);
@@ -58,16 +57,11 @@ void qsieve_poly_clear(qs_t qs_inf)
       flint_free(qs_inf->poly[i].soln2);
       flint_free(qs_inf->poly[i].small);
       flint_free(qs_inf->poly[i].factor);
+      flint_free(qs_inf->poly[i].rels);
+      flint_free(qs_inf->poly[i].lp);
    }
-#else
-   fmpz_clear(qs_inf->poly[0].B);
-   flint_free(qs_inf->poly[0].posn1);
-   flint_free(qs_inf->poly[0].posn2);
-   flint_free(qs_inf->poly[0].soln1);
-   flint_free(qs_inf->poly[0].soln2);
-   flint_free(qs_inf->poly[0].small);
-   flint_free(qs_inf->poly[0].factor);
-#endif
+
+   flint_free(qs_inf->poly);
 
    qs_inf->B_terms = NULL;
    qs_inf->A_ind = NULL;
@@ -78,6 +72,7 @@ void qsieve_poly_clear(qs_t qs_inf)
    qs_inf->soln2 = NULL;
    qs_inf->A_inv2B = NULL;
    qs_inf->curr_subset = NULL;
+   qs_inf->poly = NULL;
 }
 
 
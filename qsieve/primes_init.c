@@ -120,6 +120,18 @@ mp_limb_t qsieve_primes_init(qs_t qs_inf)
     qs_inf->small_primes = qsieve_tune[i][3]; /* number of primes to not sieve with */
     
     bits = qsieve_tune[i][5];
+
+    /* lower the threshold when two large primes are allowed */
+    for (i = 1; i < QS_DLP_TUNE_SIZE; i++)
+    {
+        if (qsieve_dlp_tune[i][0] > qs_inf->bits)
+            break;
+    }
+    i--;
+
+    qs_inf->dlp_bits = qsieve_dlp_tune[i][1];
+    bits -= qs_inf->dlp_bits;
+
     if (bits >= 64)
     {
        qs_inf->sieve_bits = bits;
@@ -0,0 +1,615 @@
+/*
+    Copyright (C) 2026 agent
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include "qsieve.h"
+
+/*
+   A relation store is a sequence of records
+
+      tag (one byte), payload length (varint), payload, checksum (4 bytes)
+
+   where the checksum is the 32 bit FNV-1a hash of the tag and payload. The
+   first record has tag 'H' and identifies the factorisation. Relations have
+   tag 'R' and checkpoints tag 'C'. A reader stops at the first record that
+   is incomplete or fails its checksum, so a store that was being written
+   when its process died is still valid up to its last complete record.
+*/
+
+#define QS_STORE_MAX_RECORD (WORD(1) << 24)
+
+static uint32_t _qsieve_store_hash(int tag, const unsigned char * buf,
+                                                                   slong len)
+{
+   uint32_t h = UWORD(2166136261);
+   slong i;
+
+   h = (h ^ (unsigned char) tag) * UWORD(16777619);
+
+   for (i = 0; i < len; i++)
+      h = (h ^ buf[i]) * UWORD(16777619);
+
+   return h;
+}
+
+static void _qsieve_store_put_hash(unsigned char * p, uint32_t h)
+{
+   p[0] = (unsigned char) h;
+   p[1] = (unsigned char) (h >> 8);
+   p[2] = (unsigned char) (h >> 16);
+   p[3] = (unsigned char) (h >> 24);
+}
+
+static void _qsieve_store_fwrite(FILE * file, const unsigned char * buf,
+                                                                    slong len)
+{
+   if (fwrite(buf, 1, len, file) != (size_t) len)
+   {
+      flint_printf("Exception (qsieve_factor). Unable to write relation store.\n");
+      flint_abort();
+   }
+}
+
+static void _qsieve_store_write(FILE * file, int tag,
+                                         const unsigned char * buf, slong len)
+{
+   unsigned char head[16], tail[4];
+   slong n;
+
+   head[0] = (unsigned char) tag;
+   n = 1 + qsieve_store_put_ui(head + 1, len);
+
+   _qsieve_store_put_hash(tail, _qsieve_store_hash(tag, buf, len));
+
+   _qsieve_store_fwrite(file, head, n);
+   _qsieve_store_fwrite(file, buf, len);
+   _qsieve_store_fwrite(file, tail, 4);
+}
+
+int qsieve_store_read(FILE * file, int * tag, unsigned char ** buf,
+                                                    slong * alloc, slong * len)
+{
+   unsigned char tail[4];
+   uint32_t h;
+   slong l = 0;
+   int c, shift = 0;
+
+   c = getc(file);
+   if (c != 'H' && c != 'R' && c != 'C')
+      return 0;
+
+   *tag = c;
+
+   do
+   {
+      c = getc(file);
+      if (c == EOF || shift > 21)
+         return 0;
+
+      l |= ((slong) (c & 127)) << shift;
+      shift += 7;
+   } while (c & 128);
+
+   if (l > QS_STORE_MAX_RECORD)
+      return 0;
+
+   if (l > *alloc)
+   {
+      *buf = flint_realloc(*buf, l);
+      *alloc = l;
+   }
+
+   if (fread(*buf, 1, l, file) != (size_t) l || fread(tail, 1, 4, file) != 4)
+      return 0;
+
+   h = _qsieve_store_hash(*tag, *buf, l);
+
+   if (tail[0] != (unsigned char) h || tail[1] != (unsigned char) (h >> 8) ||
+       tail[2] != (unsigned char) (h >> 16) || tail[3] != (unsigned char) (h >> 24))
+      return 0;
+
+   *len = l;
+
+   return 1;
+}
+
+/* sign and magnitude, the magnitude as little endian bytes */
+static slong _qsieve_store_put_fmpz(unsigned char * p, const fmpz_t x)
+{
+   mpz_t z;
+   size_t count;
+   slong n;
+
+   mpz_init(z);
+   fmpz_get_mpz(z, x);
+
+   count = fmpz_is_zero(x) ? 0 : mpz_sizeinbase(z, 256);
+   n = qsieve_store_put_ui(p, 2*count + (fmpz_sgn(x) < 0));
+
+   if (count != 0)
+      mpz_export(p + n, NULL, -1, 1, 0, 0, z);
+
+   mpz_clear(z);
+
+   return n + count;
+}
+
+static int _qsieve_store_get_fmpz(fmpz_t x, const unsigned char ** p,
+                                                    const unsigned char * end)
+{
+   mp_limb_t c;
+   mpz_t z;
+
+   if (!qsieve_store_get_ui(&c, p, end) || (c >> 1) > (mp_limb_t) (end - *p))
+      return 0;
+
+   mpz_init(z);
+   mpz_import(z, c >> 1, -1, 1, 0, 0, *p);
+   fmpz_set_mpz(x, z);
+   mpz_clear(z);
+
+   if (c & 1)
+      fmpz_neg(x, x);
+
+   *p += c >> 1;
+
+   return 1;
+}
+
+static void _qsieve_store_write_header(qs_t qs_inf)
+{
+   unsigned char * buf;
+   slong n = 0;
+
+   buf = flint_malloc(60 + (fmpz_bits(qs_inf->n) + 7)/8);
+
+   n += qsieve_store_put_ui(buf + n, QS_STORE_VERSION);
+   n += qsieve_store_put_ui(buf + n, qs_inf->k);
+   n += qsieve_store_put_ui(buf + n, qs_inf->num_primes);
+   n += qsieve_store_put_ui(buf + n, qs_inf->small_primes);
+   n += qsieve_store_put_ui(buf + n, qs_inf->ks_primes);
+   n += _qsieve_store_put_fmpz(buf + n, qs_inf->n);
+
+   _qsieve_store_write(qs_inf->siqs, 'H', buf, n);
+
+   flint_free(buf);
+}
+
+/*
+   reads the header of the store at the current position of file and
+   returns the number of factor base primes it was written with, or 0 if it
+   does not belong to the current factorisation
+*/
+static slong _qsieve_store_read_header(qs_t qs_inf, FILE * file)
+{
+   unsigned char * buf = NULL;
+   const unsigned char * p, * end;
+   slong alloc = 0, len, num_primes = 0;
+   mp_limb_t version, k, np, small_primes, ks_primes;
+   fmpz_t n;
+   int tag;
+
+   fmpz_init(n);
+
+   if (qsieve_store_read(file, &tag, &buf, &alloc, &len) && tag == 'H')
+   {
+      p = buf;
+      end = buf + len;
+
+      if (qsieve_store_get_ui(&version, &p, end)
+       && qsieve_store_get_ui(&k, &p, end)
+       && qsieve_store_get_ui(&np, &p, end)
+       && qsieve_store_get_ui(&small_primes, &p, end)
+       && qsieve_store_get_ui(&ks_primes, &p, end)
+       && _qsieve_store_get_fmpz(n, &p, end)
+       && version == QS_STORE_VERSION && k == qs_inf->k
+       && small_primes == qs_inf->small_primes
+       && ks_primes == qs_inf->ks_primes && fmpz_equal(n, qs_inf->n))
+         num_primes = np;
+   }
+
+   fmpz_clear(n);
+   flint_free(buf);
+
+   return num_primes;
+}
+
+static void _qsieve_store_create(qs_t qs_inf)
+{
+   if (qs_inf->fname != NULL)
+      qs_inf->siqs = fopen(qs_inf->fname, "w+b");
+   else
+      qs_inf->siqs = tmpfile();
+
+   if (qs_inf->siqs == NULL)
+   {
+      flint_printf("Exception (qsieve_factor). Unable to create relation store.\n");
+      flint_abort();
+   }
+
+   _qsieve_store_write_header(qs_inf);
+   fflush(qs_inf->siqs);
+
+   qs_inf->A_done = 0;
+}
+
+slong qsieve_store_open(qs_t qs_inf, const char * fname,
+                                const char * const * merge, slong num_merge)
+{
+   unsigned char * buf = NULL;
+   const unsigned char * p;
+   slong i, alloc = 0, len, num_primes;
+   mp_limb_t done;
+   FILE * file;
+   long pos;
+   int tag;
+
+   qs_inf->fname = NULL;
+   qs_inf->merge_fname = NULL;
+   qs_inf->num_merge = 0;
+   qs_inf->store_rank = 0;
+   qs_inf->store_procs = 1;
+   qs_inf->A0_count = 0;
+   qs_inf->A_done = 0;
+
+   if (fname != NULL)
+   {
+      qs_inf->fname = flint_malloc(strlen(fname) + 1);
+      strcpy(qs_inf->fname, fname);
+
+      /* cooperating processes are given the same set of stores */
+      if (num_merge > 0)
+      {
+         qs_inf->merge_fname = flint_malloc(num_merge*sizeof(char *));
+
+         for (i = 0; i < num_merge; i++)
+         {
+            qs_inf->merge_fname[i] = flint_malloc(strlen(merge[i]) + 1);
+            strcpy(qs_inf->merge_fname[i], merge[i]);
+
+            if (strcmp(merge[i], fname) < 0)
+               qs_inf->store_rank++;
+         }
+
+         qs_inf->num_merge = num_merge;
+         qs_inf->store_procs = num_merge + 1;
+      }
+
+      /* resume from an existing store for the same factorisation */
+      if ((file = fopen(fname, "r+b")) != NULL)
+      {
+         num_primes = _qsieve_store_read_header(qs_inf, file);
+
+         if (num_primes >= qs_inf->num_primes)
+         {
+            pos = ftell(file);
+
+            while (qsieve_store_read(file, &tag, &buf, &alloc, &len))
+            {
+               pos = ftell(file);
+
+               p = buf;
+               if (tag == 'C' && qsieve_store_get_ui(&done, &p, buf + len))
+                  qs_inf->A_done = done;
+            }
+
+            /* anything after the last complete record is overwritten */
+            fseek(file, pos, SEEK_SET);
+
+            flint_free(buf);
+            qs_inf->siqs = file;
+
+            return num_primes;
+         }
+
+         fclose(file);
+      }
+   }
+
+   _qsieve_store_create(qs_inf);
+
+   return qs_inf->num_primes;
+}
+
+void qsieve_store_reset(qs_t qs_inf)
+{
+   fclose(qs_inf->siqs);
+
+   _qsieve_store_create(qs_inf);
+}
+
+void qsieve_store_close(qs_t qs_inf)
+{
+   slong i;
+
+   if (qs_inf->siqs != NULL)
+      fclose(qs_inf->siqs);
+
+   qs_inf->siqs = NULL;
+
+   for (i = 0; i < qs_inf->num_merge; i++)
+      flint_free(qs_inf->merge_fname[i]);
+
+   flint_free(qs_inf->merge_fname);
+   flint_free(qs_inf->fname);
+
+   qs_inf->merge_fname = NULL;
+   qs_inf->fname = NULL;
+   qs_inf->num_merge = 0;
+}
+
+void qsieve_store_checkpoint(qs_t qs_inf)
+{
+   unsigned char buf[16];
+   slong n;
+
+   n = qsieve_store_put_ui(buf, qsieve_store_A_index(qs_inf) + 1);
+
+   _qsieve_store_write(qs_inf->siqs, 'C', buf, n);
+
+   fflush(qs_inf->siqs);
+}
+
+/*
+   Store 0 is the store of this process and stores 1 to num_merge are those
+   of other processes. Returns NULL if a store is missing or was written for
+   a different factor base. The position of the writer is saved in pos.
+*/
+FILE * qsieve_store_begin(qs_t qs_inf, slong i, long * pos)
+{
+   FILE * file;
+
+   if (i == 0)
+   {
+      file = qs_inf->siqs;
+
+      fflush(file);
+      *pos = ftell(file);
+      rewind(file);
+   } else
+   {
+      file = fopen(qs_inf->merge_fname[i - 1], "rb");
+
+      if (file == NULL)
+         return NULL;
+   }
+
+   if (_qsieve_store_read_header(qs_inf, file) != qs_inf->num_primes)
+   {
+      qsieve_store_end(qs_inf, i, file, *pos);
+      return NULL;
+   }
+
+   return file;
+}
+
+void qsieve_store_end(qs_t qs_inf, slong i, FILE * file, long pos)
+{
+   if (i == 0)
+      fseek(file, pos, SEEK_SET);
+   else
+      fclose(file);
+}
+
+/*
+   returns the large prime of a relation record, setting lp2 to the second
+   large prime, or returns 0 if it is malformed
+*/
+mp_limb_t qsieve_store_relation_lp(mp_limb_t * lp2,
+                                          const unsigned char * buf, slong len)
+{
+   mp_limb_t lp;
+
+   if (!qsieve_store_get_ui(&lp, &buf, buf + len)
+    || !qsieve_store_get_ui(lp2, &buf, buf + len) || *lp2 == 0)
+      return 0;
+
+   return lp;
+}
+
+/*
+   recompute the number of full relations and the graph of partials from
+   the relations in all the stores
+*/
+void qsieve_store_count_partials(qs_t qs_inf)
+{
+   unsigned char * buf = NULL;
+   slong i, alloc = 0, len;
+   mp_limb_t lp, lp2;
+   FILE * file;
+   long pos = 0;
+   int tag;
+
+   qsieve_reset_hashtable(qs_inf);
+   qs_inf->edges = 0;
+   qs_inf->full_relation = 0;
+
+   for (i = 0; i <= qs_inf->num_merge; i++)
+   {
+      if ((file = qsieve_store_begin(qs_inf, i, &pos)) == NULL)
+         continue;
+
+      while (qsieve_store_read(file, &tag, &buf, &alloc, &len))
+      {
+         if (tag != 'R')
+            continue;
+
+         lp = qsieve_store_relation_lp(&lp2, buf, len);
+
+         if (lp == 1)
+            qs_inf->full_relation++;
+         else if (lp != 0)
+            qsieve_add_edge(qs_inf, lp, lp2);
+      }
+
+      qsieve_store_end(qs_inf, i, file, pos);
+   }
+
+   flint_free(buf);
+}
+
+/*
+   append a partial or full relation to the relation buffer of poly, as a
+   complete record; the buffer is written to the store by qsieve_store_flush
+*/
+void qsieve_write_to_file(qs_t qs_inf, mp_limb_t prime, mp_limb_t prime2,
+                                                     fmpz_t Y, qs_poly_t poly)
+{
+   slong i, n = 0, ind = 0, h;
+   slong num_factors = poly->num_factors;
+   slong * small = poly->small;
+   fac_t * factor = poly->factor;
+   slong max = 10*(3 + qs_inf->small_primes + 2*num_factors)
+                                                  + 20 + (fmpz_bits(Y) + 7)/8;
+   unsigned char * rec, * buf;
+
+   /* room for the tag, the length and the checksum of the record */
+   if (poly->rels_len + max + 16 > poly->rels_alloc)
+   {
+      poly->rels_alloc = FLINT_MAX(poly->rels_len + max + 16,
+                                                         2*poly->rels_alloc);
+      poly->rels = flint_realloc(poly->rels, poly->rels_alloc);
+   }
+
+   /* encode the payload after space for the tag and length */
+   rec = poly->rels + poly->rels_len;
+   buf = rec + 11;
+
+   n += qsieve_store_put_ui(buf + n, prime);
+   n += qsieve_store_put_ui(buf + n, prime2);
+
+   for (i = 0; i < qs_inf->small_primes; i++)
+      n += qsieve_store_put_ui(buf + n, small[i]);
+
+   n += qsieve_store_put_ui(buf + n, num_factors);
+
+   /* indices are nearly sorted, so zigzag encoded differences are short */
+   for (i = 0; i < num_factors; i++)
+   {
+      slong d = factor[i].ind - ind;
+
+      n += qsieve_store_put_ui(buf + n, d >= 0 ? 2*(mp_limb_t) d
+                                               : 2*(mp_limb_t) (-d) - 1);
+      n += qsieve_store_put_ui(buf + n, factor[i].exp);
+
+      ind = factor[i].ind;
+   }
+
+   n += _qsieve_store_put_fmpz(buf + n, Y);
+
+   /* then move it down behind the header */
+   rec[0] = 'R';
+   h = 1 + qsieve_store_put_ui(rec + 1, n);
+   memmove(rec + h, buf, n);
+   _qsieve_store_put_hash(rec + h + n, _qsieve_store_hash('R', rec + h, n));
+   poly->rels_len += h + n + 4;
+
+   if (prime == 1)
+      poly->num_full++;
+   else
+   {
+      if (2*poly->num_lp == poly->lp_alloc)
+      {
+         poly->lp_alloc = FLINT_MAX(16, 2*poly->lp_alloc);
+         poly->lp = flint_realloc(poly->lp, poly->lp_alloc*sizeof(mp_limb_t));
+      }
+
+      poly->lp[2*poly->num_lp] = prime;
+      poly->lp[2*poly->num_lp + 1] = prime2;
+      poly->num_lp++;
+   }
+}
+
+/*
+   write the relations buffered by poly to the store and add them to the
+   relation counts and the graph of partials; the caller must make sure no
+   other thread is writing to the store at the same time
+*/
+void qsieve_store_flush(qs_t qs_inf, qs_poly_t poly)
+{
+   slong i;
+
+   if (poly->rels_len != 0)
+      _qsieve_store_fwrite(qs_inf->siqs, poly->rels, poly->rels_len);
+
+   qs_inf->full_relation += poly->num_full;
+
+   for (i = 0; i < poly->num_lp; i++)
+      qsieve_add_edge(qs_inf, poly->lp[2*i], poly->lp[2*i + 1]);
+
+   poly->rels_len = 0;
+   poly->num_full = 0;
+   poly->num_lp = 0;
+}
+
+/*
+   given the payload of a relation record, parse it to obtain the
+   relation; num_factors is set to -1 if the record is malformed
+*/
+relation_t qsieve_parse_relation(qs_t qs_inf, const unsigned char * buf,
+                                                                    slong len)
+{
+   const unsigned char * end = buf + len;
+   slong i, ind = 0;
+   mp_limb_t x, y;
+   relation_t rel;
+
+   rel.small = flint_malloc(qs_inf->small_primes * sizeof(slong));
+   rel.factor = flint_malloc(qs_inf->max_factors * sizeof(fac_t));
+   rel.small_primes = qs_inf->small_primes;
+   rel.num_factors = -1;
+   fmpz_init(rel.Y);
+
+   if (!qsieve_store_get_ui(&x, &buf, end))
+      return rel;
+
+   rel.lp = x;
+
+   if (!qsieve_store_get_ui(&x, &buf, end))
+      return rel;
+
+   rel.lp2 = x;
+
+   for (i = 0; i < qs_inf->small_primes; i++)
+   {
+      if (!qsieve_store_get_ui(&x, &buf, end))
+         return rel;
+
+      rel.small[i] = x;
+   }
+
+   if (!qsieve_store_get_ui(&x, &buf, end) || x > qs_inf->max_factors)
+      return rel;
+
+   for (i = 0; i < (slong) x; i++)
+   {
+      if (!qsieve_store_get_ui(&y, &buf, end))
+         return rel;
+
+      ind += (y & 1) ? -(slong) ((y + 1)/2) : (slong) (y/2);
+
+      if (ind < 0 || ind >= qs_inf->num_primes + qs_inf->ks_primes)
+         return rel;
+
+      rel.factor[i].ind = ind;
+
+      if (!qsieve_store_get_ui(&y, &buf, end))
+         return rel;
+
+      rel.factor[i].exp = y;
+   }
+
+   if (!_qsieve_store_get_fmpz(rel.Y, &buf, end))
+      return rel;
+
+   rel.num_factors = x;
+
+   return rel;
+}
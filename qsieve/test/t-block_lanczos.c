@@ -0,0 +1,119 @@
+/*
+    Copyright (C) 2026 agent
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <gmp.h>
+#include "flint.h"
+#include "ulong_extras.h"
+#include "qsieve.h"
+
+int main(void)
+{
+   slong i, j, k;
+   FLINT_TEST_INIT(state);
+
+   flint_printf("block_lanczos....");
+   fflush(stdout);
+
+   for (i = 0; i < 16; i++) /* random sparse matrices, all block widths */
+   {
+      slong W = WORD(1) << (i % 4);
+      slong nrows, ncols, tries;
+      la_col_t * cols;
+      uint64_t * deps, * prod, mask;
+      qs_t qs_inf;
+
+      flint_set_num_threads(1 + n_randint(state, 4));
+
+      nrows = 256*W + n_randint(state, 256*W);
+      ncols = nrows + 64;
+
+      cols = flint_malloc(ncols*sizeof(la_col_t));
+
+      for (j = 0; j < ncols; j++)
+      {
+         slong weight = 10 + n_randint(state, 10);
+
+         cols[j].weight = 0;
+         cols[j].data = NULL;
+         cols[j].orig = j;
+
+         while (cols[j].weight < weight)
+         {
+            slong r = n_randint(state, nrows);
+
+            for (k = 0; k < cols[j].weight && cols[j].data[k] != r; k++) ;
+
+            if (k == cols[j].weight)
+               insert_col_entry(cols + j, r);
+         }
+      }
+
+      /* only the number of extra relations is used by the filtering */
+      qs_inf->extra_rels = 64;
+      reduce_matrix(qs_inf, &nrows, &ncols, cols);
+
+      deps = NULL;
+      for (tries = 0; deps == NULL && tries < 10; tries++)
+         deps = _block_lanczos(state, nrows, 0, ncols, cols, W);
+
+      if (deps == NULL)
+      {
+         flint_printf("FAIL:\n");
+         flint_printf("no result after %wd tries, W = %wd, %wd x %wd\n",
+                                                     tries, W, nrows, ncols);
+         abort();
+      }
+
+      prod = flint_calloc(nrows, sizeof(uint64_t));
+
+      for (j = 0, mask = 0; j < ncols; j++)
+      {
+         for (k = 0; k < cols[j].weight; k++)
+            prod[cols[j].data[k]] ^= deps[j];
+
+         mask |= deps[j];
+      }
+
+      for (j = 0; j < nrows; j++)
+      {
+         if (prod[j] != 0)
+         {
+            flint_printf("FAIL:\n");
+            flint_printf("W = %wd, row %wd of the product is nonzero\n",
+                                                                       W, j);
+            abort();
+         }
+      }
+
+      if (mask == 0)
+      {
+         flint_printf("FAIL:\n");
+         flint_printf("W = %wd, no dependencies found\n", W);
+         abort();
+      }
+
+      flint_free(prod);
+      flint_free(deps);
+
+      for (j = 0; j < ncols; j++)
+         free_col(cols + j);
+      flint_free(cols);
+   }
+
+   flint_set_num_threads(1);
+
+   FLINT_TEST_CLEANUP(state);
+
+   flint_printf("PASS\n");
+   return 0;
+}
@@ -104,6 +104,33 @@ int main(void)
       fmpz_factor_clear(factors);
    }
 
+   for (i = 0; i < 10; i++) /* Test random n, two factors, several threads */
+   {
+      flint_set_num_threads(2 + n_randint(state, 3));
+
+      randprime(x, state, 50 + n_randint(state, 10));
+      do {
+         randprime(y, state, 50 + n_randint(state, 10));
+      } while (fmpz_equal(x, y));
+
+      fmpz_mul(n, x, y);
+
+      fmpz_factor_init(factors);
+
+      qsieve_factor(factors, n);
+
+      if (factors->num < 2)
+      {
+         flint_printf("FAIL (threads):\n");
+         flint_printf("%ld factors found\n", factors->num);
+         abort();
+      }
+
+      fmpz_factor_clear(factors);
+   }
+
+   flint_set_num_threads(1);
+
    for (i = 0; i < 30; i++) /* Test random n, three factors */
    {
       randprime(x, state, 40);
@@ -0,0 +1,314 @@
+/*
+    Copyright (C) 2026 agent
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <gmp.h>
+#include "flint.h"
+#include "ulong_extras.h"
+#include "fmpz.h"
+#include "qsieve.h"
+
+#define STORE1 "t-factor_store1.tmp"
+#define STORE2 "t-factor_store2.tmp"
+
+void randprime(fmpz_t p, flint_rand_t state, slong bits)
+{
+    fmpz_randbits(p, state, bits);
+
+    if (fmpz_sgn(p) < 0)
+       fmpz_neg(p, p);
+
+    if (fmpz_is_even(p))
+       fmpz_add_ui(p, p, 1);
+
+    while (!fmpz_is_probabprime(p))
+       fmpz_add_ui(p, p, 2);
+}
+
+typedef struct
+{
+   slong calls;   /* number of A0 polled so far */
+   slong limit;   /* cancel on this call, 0 for never */
+   slong loaded;  /* relations counted when first called */
+} progress_t;
+
+int progress(void * arg, int stage, const fmpz_t n, slong done, slong total)
+{
+   progress_t * p = (progress_t *) arg;
+
+   if (p->calls == 0)
+      p->loaded = done;
+
+   return ++p->calls == p->limit;
+}
+
+/* returns 0 if cancelled, otherwise checks the factors of n */
+int check_factors(const fmpz_t n, const char * fname,
+                  const char * const * merge, slong num_merge,
+                  progress_t * prog, const char * s)
+{
+   fmpz_factor_t factors;
+   fmpz_t m;
+   int ret;
+
+   fmpz_init(m);
+   fmpz_factor_init(factors);
+   factors->sign = 1;
+
+   prog->calls = 0;
+   prog->loaded = 0;
+
+   ret = _qsieve_factor(factors, n, fname, merge, num_merge, progress, prog);
+
+   fmpz_factor_expand(m, factors);
+
+   if (ret && (factors->num < 2 || !fmpz_equal(m, n)))
+   {
+      flint_printf("FAIL (%s):\n", s);
+      fmpz_print(n); flint_printf("\n");
+      flint_printf("%wd factors found\n", factors->num);
+      abort();
+   }
+
+   fmpz_factor_clear(factors);
+   fmpz_clear(m);
+
+   return ret;
+}
+
+/*
+   open the store for n as qsieve_factor does, setting rels to the number of
+   relations in it and done to its checkpoint; fails if a relation is not
+   one for n or anything follows the last complete record
+*/
+void check_store(slong * rels, slong * done, const fmpz_t n,
+                                            const char * fname, const char * s)
+{
+   qs_t qs_inf;
+   unsigned char * buf = NULL;
+   slong alloc = 0, len, num_primes;
+   long pos = 0, end;
+   FILE * file;
+   int tag;
+
+   *rels = 0;
+
+   file = fopen(fname, "rb");
+   if (file == NULL)
+   {
+      flint_printf("FAIL (%s):\n", s);
+      flint_printf("relation store not kept\n");
+      abort();
+   }
+
+   fseek(file, 0, SEEK_END);
+   end = ftell(file);
+   fclose(file);
+
+   qsieve_init(qs_inf, n);
+   qsieve_knuth_schroeppel(qs_inf);
+   fmpz_mul_ui(qs_inf->kn, qs_inf->n, qs_inf->k);
+   qs_inf->bits = fmpz_bits(qs_inf->kn);
+   qsieve_primes_init(qs_inf);
+
+   num_primes = qsieve_store_open(qs_inf, fname, NULL, 0);
+   if (num_primes > qs_inf->num_primes)
+      qsieve_primes_increment(qs_inf, num_primes - qs_inf->num_primes);
+
+   qsieve_linalg_init(qs_inf);
+
+   *done = qs_inf->A_done;
+
+   file = qsieve_store_begin(qs_inf, 0, &pos);
+
+   while (file != NULL && qsieve_store_read(file, &tag, &buf, &alloc, &len))
+   {
+      relation_t rel;
+
+      if (tag != 'R')
+         continue;
+
+      rel = qsieve_parse_relation(qs_inf, buf, len);
+
+      if (rel.num_factors < 0 || !qsieve_is_relation(qs_inf, rel))
+      {
+         flint_printf("FAIL (%s):\n", s);
+         flint_printf("relation %wd of the store is not one for n\n", *rels);
+         fmpz_print(n); flint_printf("\n");
+         abort();
+      }
+
+      flint_free(rel.small);
+      flint_free(rel.factor);
+      fmpz_clear(rel.Y);
+
+      (*rels)++;
+   }
+
+   if (file == NULL || ftell(file) != end)
+   {
+      flint_printf("FAIL (%s):\n", s);
+      flint_printf("store not readable up to its end\n");
+      fmpz_print(n); flint_printf("\n");
+      abort();
+   }
+
+   qsieve_store_end(qs_inf, 0, file, pos);
+
+   flint_free(buf);
+   qsieve_linalg_clear(qs_inf);
+   qsieve_store_close(qs_inf);
+   qsieve_clear(qs_inf);
+}
+
+int main(void)
+{
+   slong i, rels, rels1, rels2, done, done1, calls;
+   fmpz_t n, x, y;
+   FILE * file;
+   const char * merge[1];
+   progress_t prog;
+   FLINT_TEST_INIT(state);
+
+   fmpz_init(x);
+   fmpz_init(y);
+   fmpz_init(n);
+
+   flint_printf("factor_store....");
+   fflush(stdout);
+
+   prog.limit = 0;
+
+   for (i = 0; i < 3; i++)
+   {
+      /* large enough to need a good number of A0 */
+      randprime(x, state, 45 + n_randint(state, 6));
+      do {
+         randprime(y, state, 45 + n_randint(state, 6));
+      } while (fmpz_equal(x, y));
+
+      fmpz_mul(n, x, y);
+
+      remove(STORE1);
+      remove(STORE2);
+
+      /* fresh store */
+      prog.limit = 0;
+      check_factors(n, STORE1, NULL, 0, &prog, "new store");
+      calls = prog.calls;
+
+      check_store(&rels, &done, n, STORE1, "new store");
+
+      if (prog.loaded != 0 || rels == 0 || done == 0)
+      {
+         flint_printf("FAIL (new store):\n");
+         flint_printf("%wd relations loaded, %wd stored, checkpoint %wd\n",
+                                                   prog.loaded, rels, done);
+         abort();
+      }
+
+      /* interrupt a run half way, then resume it */
+      remove(STORE1);
+
+      prog.limit = calls/2 + 1;
+      if (check_factors(n, STORE1, NULL, 0, &prog, "interrupted"))
+      {
+         flint_printf("FAIL (interrupted):\n");
+         flint_printf("not cancelled\n");
+         abort();
+      }
+
+      check_store(&rels1, &done1, n, STORE1, "interrupted");
+
+      prog.limit = 0;
+      check_factors(n, STORE1, NULL, 0, &prog, "resume");
+
+      check_store(&rels2, &done, n, STORE1, "resume");
+
+      /*
+         the relations sieved before are loaded and only the A after the
+         checkpoint are sieved, so together the runs did the work of one
+      */
+      if (rels1 == 0 || done1 == 0 || prog.loaded == 0
+       || prog.calls != calls - done1 || rels2 != rels)
+      {
+         flint_printf("FAIL (resume):\n");
+         flint_printf("%wd relations loaded of %wd, %wd A sieved of %wd "
+            "after %wd, %wd relations of %wd\n", prog.loaded, rels1,
+            prog.calls, calls, done1, rels2, rels);
+         fmpz_print(n); flint_printf("\n");
+         abort();
+      }
+
+      /* a torn record at the end of the store is discarded */
+      file = fopen(STORE1, "ab");
+      fputs("R\x7fgarbage", file);
+      fclose(file);
+
+      prog.limit = 0;
+      check_factors(n, STORE1, NULL, 0, &prog, "torn store");
+
+      /* check_store fails if the torn record was left in the store */
+      check_store(&rels1, &done1, n, STORE1, "torn store");
+
+      if (prog.loaded == 0 || rels1 < rels2 || done1 < done)
+      {
+         flint_printf("FAIL (torn store):\n");
+         flint_printf("%wd relations loaded, %wd before, %wd after\n",
+                                                 prog.loaded, rels2, rels1);
+         abort();
+      }
+
+      /* read the relations of another process */
+      merge[0] = STORE1;
+      prog.limit = 0;
+      check_factors(n, STORE2, merge, 1, &prog, "merge");
+
+      if (prog.loaded == 0)
+      {
+         flint_printf("FAIL (merge):\n");
+         flint_printf("no relations loaded from the other store\n");
+         abort();
+      }
+
+      /* a store for a different n is overwritten */
+      fmpz_add_ui(x, x, 2);
+      while (!fmpz_is_probabprime(x) || fmpz_equal(x, y))
+         fmpz_add_ui(x, x, 2);
+      fmpz_mul(n, x, y);
+
+      prog.limit = 0;
+      check_factors(n, STORE1, NULL, 0, &prog, "different n");
+
+      /* check_store fails unless every relation is one for the new n */
+      check_store(&rels, &done, n, STORE1, "different n");
+
+      if (prog.loaded != 0 || rels == 0)
+      {
+         flint_printf("FAIL (different n):\n");
+         flint_printf("%wd relations loaded, %wd stored\n", prog.loaded, rels);
+         abort();
+      }
+   }
+
+   remove(STORE1);
+   remove(STORE2);
+
+   fmpz_clear(n);
+   fmpz_clear(x);
+   fmpz_clear(y);
+
+   FLINT_TEST_CLEANUP(state);
+
+   flint_printf("PASS\n");
+   return 0;
+}
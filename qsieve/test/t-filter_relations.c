@@ -0,0 +1,176 @@
+/*
+    Copyright (C) 2026 agent
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <gmp.h>
+#include "flint.h"
+#include "ulong_extras.h"
+#include "fmpz.h"
+#include "qsieve.h"
+
+/* number of rows the relation has an odd exponent in, counted in weight */
+slong relation_rows(qs_t qs_inf, relation_t * rel, slong * weight)
+{
+   slong i, n = 0;
+
+   for (i = 0; i < qs_inf->small_primes; i++)
+   {
+      if (rel->small[i] & 1)
+      {
+         if (weight != NULL)
+            weight[i]++;
+         n++;
+      }
+   }
+
+   for (i = 0; i < rel->num_factors; i++)
+   {
+      if (rel->factor[i].exp & 1)
+      {
+         if (weight != NULL)
+            weight[rel->factor[i].ind]++;
+         n++;
+      }
+   }
+
+   return n;
+}
+
+int main(void)
+{
+   slong i, j, k;
+   FLINT_TEST_INIT(state);
+
+   flint_printf("filter_relations....");
+   fflush(stdout);
+
+   for (i = 0; i < 100 * flint_test_multiplier(); i++)
+   {
+      qs_t qs_inf;
+      relation_t * rels;
+      slong num_rows, num_rels, excess, nrows, kept, active;
+      slong * weight, * orig, * seen;
+
+      qs_inf->small_primes = 3;
+      qs_inf->num_primes = 10 + n_randint(state, 200);
+      qs_inf->ks_primes = n_randint(state, 10);
+
+      num_rows = qs_inf->num_primes + qs_inf->ks_primes;
+      num_rels = n_randint(state, 2*num_rows);
+      excess = n_randint(state, 40);
+
+      rels = flint_malloc(FLINT_MAX(num_rels, 1)*sizeof(relation_t));
+
+      /* random relations, with primes near the start of the factor base
+         more likely, as for real relations */
+      for (j = 0; j < num_rels; j++)
+      {
+         slong ind = qs_inf->small_primes;
+
+         rels[j].lp = j; /* to identify the relation */
+         rels[j].small = flint_malloc(qs_inf->small_primes*sizeof(slong));
+         rels[j].factor = flint_malloc(num_rows*sizeof(fac_t));
+         rels[j].num_factors = 0;
+
+         for (k = 0; k < qs_inf->small_primes; k++)
+            rels[j].small[k] = n_randint(state, 3);
+
+         while (1)
+         {
+            ind += 1 + n_randint(state, 1 + n_randint(state, num_rows/4 + 1));
+            if (ind >= num_rows)
+               break;
+
+            rels[j].factor[rels[j].num_factors].ind = ind;
+            rels[j].factor[rels[j].num_factors].exp = 1 + n_randint(state, 3);
+            rels[j].num_factors++;
+         }
+      }
+
+      orig = flint_malloc(FLINT_MAX(num_rels, 1)*sizeof(slong));
+      for (j = 0; j < num_rels; j++)
+         orig[j] = relation_rows(qs_inf, rels + j, NULL);
+
+      kept = qsieve_filter_relations(qs_inf, &nrows, rels, num_rels, excess);
+
+      /* the remaining relations are distinct, unchanged and in order */
+      seen = flint_calloc(FLINT_MAX(num_rels, 1), sizeof(slong));
+
+      for (j = 0; j < num_rels; j++)
+      {
+         if (seen[rels[j].lp]++ || relation_rows(qs_inf, rels + j, NULL) != orig[rels[j].lp]
+             || (j > 0 && j < kept && rels[j].lp < rels[j - 1].lp))
+         {
+            flint_printf("FAIL:\n");
+            flint_printf("relations lost or reordered\n");
+            abort();
+         }
+      }
+
+      /* no singletons remain and the row count is right */
+      weight = flint_calloc(num_rows, sizeof(slong));
+
+      for (j = 0; j < kept; j++)
+         relation_rows(qs_inf, rels + j, weight);
+
+      for (j = 0, active = 0; j < num_rows; j++)
+      {
+         if (weight[j] == 1)
+         {
+            flint_printf("FAIL:\n");
+            flint_printf("row %wd is a singleton\n", j);
+            abort();
+         }
+
+         active += (weight[j] != 0);
+      }
+
+      if (active != nrows)
+      {
+         flint_printf("FAIL:\n");
+         flint_printf("nrows = %wd, active rows = %wd\n", nrows, active);
+         abort();
+      }
+
+      /* the excess is reduced to the target, but no further */
+      if (kept - nrows > excess)
+      {
+         flint_printf("FAIL:\n");
+         flint_printf("kept = %wd, nrows = %wd, excess = %wd\n",
+                                                       kept, nrows, excess);
+         abort();
+      }
+
+      if (num_rels - num_rows >= excess && kept - nrows < excess)
+      {
+         flint_printf("FAIL:\n");
+         flint_printf("excess %wd reduced below %wd\n", kept - nrows, excess);
+         abort();
+      }
+
+      for (j = 0; j < num_rels; j++)
+      {
+         flint_free(rels[j].small);
+         flint_free(rels[j].factor);
+      }
+
+      flint_free(rels);
+      flint_free(orig);
+      flint_free(seen);
+      flint_free(weight);
+   }
+
+   FLINT_TEST_CLEANUP(state);
+
+   flint_printf("PASS\n");
+   return 0;
+}
@@ -0,0 +1,427 @@
+/*
+    Copyright (C) 2026 agent
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <gmp.h>
+#include "flint.h"
+#include "ulong_extras.h"
+#include "fmpz.h"
+#include "qsieve.h"
+
+void randprime(fmpz_t p, flint_rand_t state, slong bits)
+{
+    fmpz_randbits(p, state, bits);
+
+    if (fmpz_sgn(p) < 0)
+       fmpz_neg(p, p);
+
+    if (fmpz_is_even(p))
+       fmpz_add_ui(p, p, 1);
+
+    while (!fmpz_is_probabprime(p))
+       fmpz_add_ui(p, p, 2);
+}
+
+/*
+   lower the sieve threshold by d bits and allow two large primes, as
+   qsieve_primes_init does for large n
+*/
+void force_dlp(qs_t qs_inf, slong d)
+{
+   slong bits = qs_inf->sieve_bits - qs_inf->sieve_fill - d;
+
+   qs_inf->dlp_bits += d;
+
+   if (bits >= 64)
+   {
+      qs_inf->sieve_bits = bits;
+      qs_inf->sieve_fill = 0;
+   } else
+   {
+      qs_inf->sieve_bits = 64;
+      qs_inf->sieve_fill = 64 - bits;
+   }
+}
+
+/*
+   sieve as qsieve_factor does until qsieve_process_relation succeeds,
+   returning its value, or 0 if the polynomials run out
+*/
+int sieve_relations(qs_t qs_inf, unsigned char * sieve)
+{
+   slong j;
+   int ok;
+
+   if (!qsieve_init_A0(qs_inf))
+      return 0;
+
+   do
+   {
+      if (!qsieve_store_own_A0(qs_inf))
+         continue;
+
+      qsieve_compute_pre_data(qs_inf);
+
+      for (j = qs_inf->num_primes;
+                         j < qs_inf->num_primes + qs_inf->ks_primes; j++)
+      {
+         qs_inf->q_idx = j;
+         qsieve_collect_relations(qs_inf, sieve);
+
+         qs_inf->num_cycles = qs_inf->edges + qs_inf->components
+                                                         - qs_inf->vertices;
+
+         if (qs_inf->full_relation + qs_inf->num_cycles >=
+                   ((slong) (1.10*qs_inf->num_primes) + qs_inf->ks_primes
+                                                     + qs_inf->extra_rels))
+         {
+            ok = qsieve_process_relation(qs_inf);
+
+            if (ok != 0)
+               return ok;
+         }
+
+         qsieve_store_checkpoint(qs_inf);
+      }
+   } while (qsieve_next_A0(qs_inf));
+
+   return 0;
+}
+
+/*
+   edges + components - vertices for the graph with the given edges,
+   with components found by propagating the least label along edges
+*/
+slong count_cycles(const mp_limb_t * lp, const mp_limb_t * lp2, slong num)
+{
+   mp_limb_t * v = flint_malloc(2*num*sizeof(mp_limb_t));
+   slong * label, * a, * b;
+   slong i, j, nv, nc;
+   int changed;
+
+   for (i = 0; i < num; i++)
+   {
+      v[2*i] = lp[i];
+      v[2*i + 1] = lp2[i];
+   }
+
+   /* the distinct vertices, in increasing order */
+   for (i = 1; i < 2*num; i++)
+   {
+      mp_limb_t t = v[i];
+
+      for (j = i; j > 0 && v[j - 1] > t; j--)
+         v[j] = v[j - 1];
+
+      v[j] = t;
+   }
+
+   for (i = 0, nv = 0; i < 2*num; i++)
+   {
+      if (nv == 0 || v[i] != v[nv - 1])
+         v[nv++] = v[i];
+   }
+
+   label = flint_malloc(nv*sizeof(slong));
+   a = flint_malloc(num*sizeof(slong));
+   b = flint_malloc(num*sizeof(slong));
+
+   for (i = 0; i < nv; i++)
+      label[i] = i;
+
+   for (i = 0; i < num; i++)
+   {
+      for (a[i] = 0; v[a[i]] != lp[i]; a[i]++) ;
+      for (b[i] = 0; v[b[i]] != lp2[i]; b[i]++) ;
+   }
+
+   do
+   {
+      changed = 0;
+
+      for (i = 0; i < num; i++)
+      {
+         if (label[a[i]] != label[b[i]])
+         {
+            label[a[i]] = label[b[i]] = FLINT_MIN(label[a[i]], label[b[i]]);
+            changed = 1;
+         }
+      }
+   } while (changed);
+
+   for (i = 0, nc = 0; i < nv; i++)
+      nc += (label[i] == i);
+
+   flint_free(v);
+   flint_free(label);
+   flint_free(a);
+   flint_free(b);
+
+   return num + nc - nv;
+}
+
+int main(void)
+{
+   slong i, j, k, done = 0;
+   fmpz_t n, x, y;
+   FLINT_TEST_INIT(state);
+
+   fmpz_init(x);
+   fmpz_init(y);
+   fmpz_init(n);
+
+   flint_printf("large_prime_variant....");
+   fflush(stdout);
+
+   for (i = 0; done < 2 && i < 10; i++)
+   {
+      qs_t qs_inf;
+      unsigned char * sieve, * buf = NULL;
+      slong alloc = 0, len, num = 0, num_slp = 0, num_dlp = 0, num_full = 0;
+      slong cycles, cycles_slp, pos;
+      mp_limb_t * lp, * lp2, * slp, * slp2, p, q;
+      FILE * file;
+      long fpos = 0;
+      int tag, ok;
+      fmpz_t r, s;
+
+      randprime(x, state, 50);
+      do {
+         randprime(y, state, 50);
+      } while (fmpz_equal(x, y));
+
+      fmpz_mul(n, x, y);
+
+      qsieve_init(qs_inf, n);
+
+      if (qsieve_knuth_schroeppel(qs_inf))
+      {
+         qsieve_clear(qs_inf);
+         continue;
+      }
+
+      fmpz_mul_ui(qs_inf->kn, qs_inf->n, qs_inf->k);
+      qs_inf->bits = fmpz_bits(qs_inf->kn);
+
+      if (qsieve_primes_init(qs_inf))
+      {
+         qsieve_clear(qs_inf);
+         continue;
+      }
+
+      qsieve_store_open(qs_inf, NULL, NULL, 0);
+
+      /* n is far too small for the tuning table to enable this */
+      force_dlp(qs_inf, 20);
+
+      qsieve_linalg_init(qs_inf);
+      qsieve_store_count_partials(qs_inf);
+
+      sieve = flint_malloc((qs_inf->sieve_size + sizeof(ulong) + 64)
+                                                       *qs_inf->num_threads);
+
+      qs_inf->q_idx = qs_inf->num_primes;
+
+      for (j = qs_inf->small_primes; j < qs_inf->num_primes; j++)
+      {
+         if (qs_inf->factor_base[j].p > BLOCK_SIZE)
+            break;
+      }
+
+      qs_inf->second_prime = j;
+
+      ok = sieve_relations(qs_inf, sieve);
+
+      if (ok != 1)
+         goto cleanup;
+
+      done++;
+
+      /* relations given to linear algebra satisfy Y^2 = product mod kn */
+      fmpz_init(r);
+      fmpz_init(s);
+
+      for (j = 0; j < qs_inf->columns; j++)
+      {
+         pos = qs_inf->matrix[j].orig*2*qs_inf->max_factors;
+
+         fmpz_one(r);
+
+         for (k = 0; k < qs_inf->relation[pos]; k++)
+         {
+            fmpz_set_si(s, qs_inf->factor_base[qs_inf->relation[pos
+                                                          + 2*k + 1]].p);
+            fmpz_pow_ui(s, s, qs_inf->relation[pos + 2*k + 2]);
+            fmpz_mul(r, r, s);
+            fmpz_mod(r, r, qs_inf->kn);
+         }
+
+         fmpz_mul(s, qs_inf->Y_arr + qs_inf->matrix[j].orig,
+                     qs_inf->Y_arr + qs_inf->matrix[j].orig);
+         fmpz_mod(s, s, qs_inf->kn);
+
+         if (!fmpz_equal(r, s))
+         {
+            flint_printf("FAIL:\n");
+            flint_printf("relation %wd of %wd is not smooth\n",
+                                                      j, qs_inf->columns);
+            fmpz_print(n); flint_printf("\n");
+            abort();
+         }
+      }
+
+      fmpz_clear(r);
+      fmpz_clear(s);
+
+      /* the store (format version 2) holds partials with two primes */
+      file = qsieve_store_begin(qs_inf, 0, &fpos);
+
+      if (file == NULL)
+      {
+         flint_printf("FAIL:\n");
+         flint_printf("relation store not readable\n");
+         abort();
+      }
+
+      while (qsieve_store_read(file, &tag, &buf, &alloc, &len))
+         num += (tag == 'R');
+
+      qsieve_store_end(qs_inf, 0, file, fpos);
+
+      lp = flint_malloc((num + 1)*sizeof(mp_limb_t));
+      lp2 = flint_malloc((num + 1)*sizeof(mp_limb_t));
+      slp = flint_malloc((num + 1)*sizeof(mp_limb_t));
+      slp2 = flint_malloc((num + 1)*sizeof(mp_limb_t));
+
+      file = qsieve_store_begin(qs_inf, 0, &fpos);
+      num = 0;
+
+      while (qsieve_store_read(file, &tag, &buf, &alloc, &len))
+      {
+         relation_t rel;
+
+         if (tag != 'R')
+            continue;
+
+         p = qsieve_store_relation_lp(&q, buf, len);
+
+         if (p == 1)
+         {
+            num_full++;
+            continue;
+         }
+
+         lp[num] = p;
+         lp2[num++] = q;
+
+         if (q == 1)
+         {
+            slp[num_slp] = p;
+            slp2[num_slp++] = q;
+            continue;
+         }
+
+         num_dlp++;
+
+         /* both primes of a split cofactor exceed the factor base */
+         rel = qsieve_parse_relation(qs_inf, buf, len);
+
+         if (!n_is_prime(p) || !n_is_prime(q) || q > p
+          || q <= qs_inf->factor_base[qs_inf->num_primes
+                                              + qs_inf->ks_primes - 1].p
+          || rel.num_factors < 0 || !qsieve_is_relation(qs_inf, rel))
+         {
+            flint_printf("FAIL:\n");
+            flint_printf("bad partial with large primes %wu, %wu\n", p, q);
+            fmpz_print(n); flint_printf("\n");
+            abort();
+         }
+
+         flint_free(rel.small);
+         flint_free(rel.factor);
+         fmpz_clear(rel.Y);
+      }
+
+      qsieve_store_end(qs_inf, 0, file, fpos);
+      flint_free(buf);
+
+      /* the incremental count of cycles agrees with the graph */
+      qsieve_store_count_partials(qs_inf);
+      cycles = count_cycles(lp, lp2, num);
+      cycles_slp = count_cycles(slp, slp2, num_slp);
+
+      if (num_dlp == 0 || cycles <= cycles_slp
+       || qs_inf->full_relation != num_full || qs_inf->edges != num
+       || qs_inf->edges + qs_inf->components - qs_inf->vertices != cycles)
+      {
+         flint_printf("FAIL:\n");
+         flint_printf("%wd partials with two large primes, %wd cycles, "
+            "%wd without them, %wd counted\n", num_dlp, cycles, cycles_slp,
+            qs_inf->edges + qs_inf->components - qs_inf->vertices);
+         fmpz_print(n); flint_printf("\n");
+         abort();
+      }
+
+      flint_free(lp);
+      flint_free(lp2);
+      flint_free(slp);
+      flint_free(slp2);
+
+      /* cycles of a small graph, including a repeated edge */
+      {
+         const mp_limb_t e[8][2] = { {101, 1}, {103, 1}, {103, 101},
+              {107, 109}, {109, 107}, {113, 1}, {107, 113}, {109, 101} };
+         const slong expect[8] = { 0, 0, 1, 1, 2, 2, 2, 3 };
+
+         qsieve_reset_hashtable(qs_inf);
+         qs_inf->edges = 0;
+
+         for (j = 0; j < 8; j++)
+         {
+            qsieve_add_edge(qs_inf, e[j][0], e[j][1]);
+
+            if (qs_inf->edges + qs_inf->components - qs_inf->vertices
+                                                              != expect[j])
+            {
+               flint_printf("FAIL:\n");
+               flint_printf("wrong number of cycles after %wd edges\n",
+                                                                     j + 1);
+               abort();
+            }
+         }
+      }
+
+cleanup:
+
+      flint_free(sieve);
+      qsieve_clear(qs_inf);
+      qsieve_linalg_clear(qs_inf);
+      qsieve_poly_clear(qs_inf);
+      qsieve_store_close(qs_inf);
+   }
+
+   if (done == 0)
+   {
+      flint_printf("FAIL:\n");
+      flint_printf("no relations processed\n");
+      abort();
+   }
+
+   fmpz_clear(n);
+   fmpz_clear(x);
+   fmpz_clear(y);
+
+   FLINT_TEST_CLEANUP(state);
+
+   flint_printf("PASS\n");
+   return 0;
+}
@@ -0,0 +1,182 @@
+/*
+    Copyright (C) 2026 agent
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include <pthread.h>
+#include "flint.h"
+#include "ulong_extras.h"
+
+typedef struct
+{
+    slong * counts;
+    slong inner;
+    pthread_mutex_t * mutex;
+    slong * total;
+}
+count_arg_t;
+
+void count_fn(void * arg_ptr, slong i)
+{
+    count_arg_t * arg = (count_arg_t *) arg_ptr;
+
+    arg->counts[i]++;
+}
+
+void nested_fn(void * arg_ptr, slong i)
+{
+    count_arg_t * arg = (count_arg_t *) arg_ptr;
+    count_arg_t inner;
+    slong j, * counts;
+
+    counts = flint_calloc(arg->inner, sizeof(slong));
+
+    inner.counts = counts;
+
+    flint_parallel_for(0, arg->inner, 0, count_fn, &inner);
+
+    /* a nested loop sees the thread count of the loop it runs in */
+    if (flint_get_num_threads() != arg->counts[0])
+    {
+        flint_printf("FAIL:\n");
+        flint_printf("nested loop sees %d threads\n", flint_get_num_threads());
+        abort();
+    }
+
+    pthread_mutex_lock(arg->mutex);
+    for (j = 0; j < arg->inner; j++)
+        (*arg->total) += counts[j];
+    pthread_mutex_unlock(arg->mutex);
+
+    flint_free(counts);
+}
+
+typedef struct
+{
+    slong i;
+    ulong x;
+}
+do_arg_t;
+
+void * do_fn(void * arg_ptr)
+{
+    do_arg_t * arg = (do_arg_t *) arg_ptr;
+
+    arg->x = n_nth_prime(arg->i + 1);
+
+    /* must not free the prime cache of a thread still using it */
+    flint_cleanup();
+
+    return NULL;
+}
+
+int main(void)
+{
+    int i;
+    FLINT_TEST_INIT(state);
+
+    flint_printf("thread_pool....");
+    fflush(stdout);
+
+    /* every iteration is run exactly once */
+    for (i = 0; i < 200 * flint_test_multiplier(); i++)
+    {
+        slong start, stop, chunk, j, * counts;
+        count_arg_t arg;
+
+        flint_set_num_threads(1 + n_randint(state, 6));
+
+        start = n_randint(state, 100);
+        stop = start + n_randint(state, 1000);
+        chunk = n_randint(state, 20);
+
+        counts = flint_calloc(stop + 1, sizeof(slong));
+        arg.counts = counts;
+
+        flint_parallel_for(start, stop, chunk, count_fn, &arg);
+
+        for (j = 0; j <= stop; j++)
+        {
+            if (counts[j] != (j >= start && j < stop))
+            {
+                flint_printf("FAIL:\n");
+                flint_printf("start = %wd, stop = %wd, chunk = %wd, j = %wd, "
+                             "count = %wd\n", start, stop, chunk, j, counts[j]);
+                abort();
+            }
+        }
+
+        flint_free(counts);
+    }
+
+    /* nested loops */
+    for (i = 0; i < 50 * flint_test_multiplier(); i++)
+    {
+        slong outer, total = 0, threads[1];
+        count_arg_t arg;
+        pthread_mutex_t mutex;
+
+        threads[0] = 1 + n_randint(state, 6);
+        flint_set_num_threads(threads[0]);
+
+        pthread_mutex_init(&mutex, NULL);
+
+        outer = n_randint(state, 30);
+        arg.counts = threads;
+        arg.inner = n_randint(state, 300);
+        arg.mutex = &mutex;
+        arg.total = &total;
+
+        flint_parallel_for(0, outer, 1, nested_fn, &arg);
+
+        pthread_mutex_destroy(&mutex);
+
+        if (total != outer*arg.inner)
+        {
+            flint_printf("FAIL:\n");
+            flint_printf("outer = %wd, inner = %wd, total = %wd\n",
+                                                     outer, arg.inner, total);
+            abort();
+        }
+    }
+
+    /* fork and join */
+    for (i = 0; i < 50 * flint_test_multiplier(); i++)
+    {
+        slong j, num = n_randint(state, 50);
+        do_arg_t * args = flint_malloc(num*sizeof(do_arg_t));
+
+        flint_set_num_threads(1 + n_randint(state, 6));
+
+        for (j = 0; j < num; j++)
+            args[j].i = j;
+
+        flint_parallel_do(do_fn, args, sizeof(do_arg_t), num);
+
+        for (j = 0; j < num; j++)
+        {
+            if (args[j].x != n_nth_prime(j + 1))
+            {
+                flint_printf("FAIL:\n");
+                flint_printf("j = %wd, x = %wu\n", j, args[j].x);
+                abort();
+            }
+        }
+
+        flint_free(args);
+    }
+
+    flint_set_num_threads(1);
+    flint_thread_pool_clear();
+
+    FLINT_TEST_CLEANUP(state);
+
+    flint_printf("PASS\n");
+    return 0;
+}
@@ -0,0 +1,294 @@
+/*
+    Copyright (C) 2026 agent
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include <pthread.h>
+#include "flint.h"
+
+/*
+   A pool of worker threads shared by the whole library. It is created on
+   first use and grown to flint_get_num_threads() - 1 threads as needed.
+
+   A parallel loop is posted as a job. The calling thread claims chunks of
+   iterations of its own job until none are left, while idle pool threads
+   claim chunks of any posted job, the most recently posted first. So no
+   thread ever waits for work it could do itself, and a loop started from
+   inside a chunk (a nested loop) is shared only with threads that are
+   idle, never with extra threads. Every job in progress can therefore
+   finish and the machine is not oversubscribed.
+*/
+
+typedef struct _flint_job_s
+{
+   flint_parallel_fn_t fn;
+   void * arg;
+   slong next;                /* first unclaimed iteration */
+   slong stop;
+   slong chunk;               /* iterations claimed at a time */
+   slong helpers;             /* pool threads working on the job */
+   slong max_helpers;
+   slong running;             /* chunks being executed */
+   int num_threads;           /* thread count for loops nested in the job */
+   pthread_cond_t done;
+   struct _flint_job_s * prev;
+   struct _flint_job_s * next_job;
+} _flint_job_struct;
+
+static pthread_mutex_t _flint_pool_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t _flint_pool_wake = PTHREAD_COND_INITIALIZER;
+static _flint_job_struct * _flint_pool_jobs = NULL; /* jobs with work left */
+static pthread_t * _flint_pool_threads = NULL;
+static slong _flint_pool_size = 0;
+static slong _flint_pool_idle = 0;
+static int _flint_pool_exit = 0;
+
+/* nesting depth of parallel loops executing on this thread */
+FLINT_TLS_PREFIX slong _flint_parallel_depth = 0;
+
+#if HAVE_TLS
+extern FLINT_TLS_PREFIX int _flint_num_threads;
+#endif
+
+int _flint_parallel_in_task(void)
+{
+   return _flint_parallel_depth != 0;
+}
+
+static void _flint_job_unlink(_flint_job_struct * job)
+{
+   if (job->prev != NULL)
+      job->prev->next_job = job->next_job;
+   else
+      _flint_pool_jobs = job->next_job;
+
+   if (job->next_job != NULL)
+      job->next_job->prev = job->prev;
+}
+
+static void _flint_job_chunk(_flint_job_struct * job, slong i, slong j)
+{
+#if HAVE_TLS
+   int num_threads = _flint_num_threads;
+
+   _flint_num_threads = job->num_threads;
+#endif
+
+   _flint_parallel_depth++;
+
+   for ( ; i < j; i++)
+      job->fn(job->arg, i);
+
+   _flint_parallel_depth--;
+
+#if HAVE_TLS
+   _flint_num_threads = num_threads;
+#endif
+}
+
+/*
+   Claim and execute chunks of the job until none are left. Must be called
+   with the pool lock held, which is released while a chunk executes.
+*/
+static void _flint_job_run(_flint_job_struct * job)
+{
+   slong i, j;
+
+   while (job->next < job->stop)
+   {
+      i = job->next;
+      j = FLINT_MIN(i + job->chunk, job->stop);
+      job->next = j;
+
+      if (j == job->stop)
+         _flint_job_unlink(job);
+
+      job->running++;
+
+      pthread_mutex_unlock(&_flint_pool_lock);
+
+      _flint_job_chunk(job, i, j);
+
+      pthread_mutex_lock(&_flint_pool_lock);
+
+      job->running--;
+   }
+
+   if (job->running == 0)
+      pthread_cond_signal(&job->done);
+}
+
+static void * _flint_pool_worker(void * arg_ptr)
+{
+   _flint_job_struct * job;
+
+   pthread_mutex_lock(&_flint_pool_lock);
+
+   while (1)
+   {
+      for (job = _flint_pool_jobs; job != NULL; job = job->next_job)
+      {
+         if (job->helpers < job->max_helpers)
+            break;
+      }
+
+      if (job != NULL)
+      {
+         /*
+            the owner of the job cannot return before we release the lock
+            with no chunk of it running, so job is valid until then
+         */
+         job->helpers++;
+         _flint_job_run(job);
+         job->helpers--;
+      } else if (_flint_pool_exit)
+         break;
+      else
+      {
+         _flint_pool_idle++;
+         pthread_cond_wait(&_flint_pool_wake, &_flint_pool_lock);
+         _flint_pool_idle--;
+      }
+   }
+
+   pthread_mutex_unlock(&_flint_pool_lock);
+
+   flint_cleanup();
+   return NULL;
+}
+
+/* grow the pool to size threads, must be called with the pool lock held */
+static void _flint_pool_fit_size(slong size)
+{
+   if (size <= _flint_pool_size || _flint_pool_exit)
+      return;
+
+   _flint_pool_threads = flint_realloc(_flint_pool_threads,
+                                                      size*sizeof(pthread_t));
+
+   while (_flint_pool_size < size)
+   {
+      if (pthread_create(_flint_pool_threads + _flint_pool_size, NULL,
+                                                _flint_pool_worker, NULL) != 0)
+         break; /* make do with the threads we have */
+
+      _flint_pool_size++;
+   }
+}
+
+void flint_parallel_for(slong start, slong stop, slong chunk,
+                                          flint_parallel_fn_t fn, void * arg)
+{
+   _flint_job_struct job[1];
+   slong num_threads = flint_get_num_threads();
+   slong len = stop - start;
+
+   if (len <= 0)
+      return;
+
+   if (chunk <= 0)
+      chunk = FLINT_MAX(len/(4*FLINT_MAX(num_threads, 1)), 1);
+
+   job->fn = fn;
+   job->arg = arg;
+   job->next = start;
+   job->stop = stop;
+   job->chunk = chunk;
+   job->helpers = 0;
+   job->max_helpers = FLINT_MIN(num_threads, (len + chunk - 1)/chunk) - 1;
+   job->running = 0;
+   job->num_threads = num_threads;
+
+   if (job->max_helpers <= 0)
+   {
+      _flint_job_chunk(job, start, stop);
+      return;
+   }
+
+   pthread_cond_init(&job->done, NULL);
+
+   pthread_mutex_lock(&_flint_pool_lock);
+
+   /* only a top level loop grows the pool, nested ones use idle threads */
+   if (_flint_parallel_depth == 0)
+      _flint_pool_fit_size(job->max_helpers);
+
+   job->prev = NULL;
+   job->next_job = _flint_pool_jobs;
+   if (_flint_pool_jobs != NULL)
+      _flint_pool_jobs->prev = job;
+   _flint_pool_jobs = job;
+
+   if (_flint_pool_idle != 0)
+      pthread_cond_broadcast(&_flint_pool_wake);
+
+   _flint_job_run(job);
+
+   while (job->running != 0)
+      pthread_cond_wait(&job->done, &_flint_pool_lock);
+
+   pthread_mutex_unlock(&_flint_pool_lock);
+
+   pthread_cond_destroy(&job->done);
+}
+
+typedef struct
+{
+   flint_thread_fn_t fn;
+   char * args;
+   size_t size;
+}
+_flint_parallel_do_arg_t;
+
+static void _flint_parallel_do_fn(void * arg_ptr, slong i)
+{
+   _flint_parallel_do_arg_t * arg = (_flint_parallel_do_arg_t *) arg_ptr;
+
+   arg->fn(arg->args + i*arg->size);
+}
+
+void flint_parallel_do(flint_thread_fn_t fn, void * args, size_t size,
+                                                                   slong num)
+{
+   _flint_parallel_do_arg_t arg;
+
+   arg.fn = fn;
+   arg.args = (char *) args;
+   arg.size = size;
+
+   flint_parallel_for(0, num, 1, _flint_parallel_do_fn, &arg);
+}
+
+void flint_thread_pool_clear(void)
+{
+   slong i, size;
+   pthread_t * threads;
+
+   pthread_mutex_lock(&_flint_pool_lock);
+
+   _flint_pool_exit = 1;
+   pthread_cond_broadcast(&_flint_pool_wake);
+
+   threads = _flint_pool_threads;
+   size = _flint_pool_size;
+
+   pthread_mutex_unlock(&_flint_pool_lock);
+
+   for (i = 0; i < size; i++)
+      pthread_join(threads[i], NULL);
+
+   pthread_mutex_lock(&_flint_pool_lock);
+
+   flint_free(_flint_pool_threads);
+   _flint_pool_threads = NULL;
+   _flint_pool_size = 0;
+   _flint_pool_exit = 0;
+
+   pthread_mutex_unlock(&_flint_pool_lock);
+}